@@ -0,0 +1,217 @@
+//*************************************************************************
+//* ===================
+//*  EXBMHarness Class
+//* ===================
+//*
+//* (Description)
+//*   Minimal benchmark harness.
+//* (Requires)
+//*     TKalStats
+//* (Provides)
+//*     class EXBMHarness
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Use the TKalStats allocation counts
+//*                                 when built with __KALSTATS_ALLOC__.
+//*************************************************************************
+//
+#include "EXBMHarness.h"
+#include "TKalStats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+
+using namespace std;
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Allocation counting
+//  -----------------------------------
+//
+namespace {
+   Double_t Now()
+   {
+      return chrono::duration<Double_t>(
+                chrono::steady_clock::now().time_since_epoch()).count();
+   }
+}
+
+#ifdef __KALSTATS_ALLOC__
+// the library replaces operator new and counts per fit stage
+
+ULong64_t EXBMHarness::GetAllocCount()
+{
+   TKalStats::Snapshot s;
+   TKalStats::GetSnapshot(s);
+   ULong64_t n = 0;
+   for (Int_t i=0; i<TKalStats::kNallocTags; i++) n += s.fAllocs[i];
+   return n;
+}
+
+ULong64_t EXBMHarness::GetAllocBytes()
+{
+   TKalStats::Snapshot s;
+   TKalStats::GetSnapshot(s);
+   ULong64_t n = 0;
+   for (Int_t i=0; i<TKalStats::kNallocTags; i++) n += s.fBytes[i];
+   return n;
+}
+#else
+namespace {
+   atomic<ULong64_t> gAllocCount(0);
+   atomic<ULong64_t> gAllocBytes(0);
+
+   void *CountedAlloc(size_t n)
+   {
+      gAllocCount.fetch_add(1, memory_order_relaxed);
+      gAllocBytes.fetch_add(n, memory_order_relaxed);
+      void *p = malloc(n ? n : 1);
+      if (!p) throw bad_alloc();
+      return p;
+   }
+}
+
+void *operator new  (size_t n)                         { return CountedAlloc(n); }
+void *operator new[](size_t n)                         { return CountedAlloc(n); }
+void *operator new  (size_t n, const nothrow_t &) noexcept
+{
+   try { return CountedAlloc(n); } catch (...) { return 0; }
+}
+void *operator new[](size_t n, const nothrow_t &) noexcept
+{
+   try { return CountedAlloc(n); } catch (...) { return 0; }
+}
+void  operator delete  (void *p) noexcept              { free(p); }
+void  operator delete[](void *p) noexcept              { free(p); }
+void  operator delete  (void *p, size_t) noexcept      { free(p); }
+void  operator delete[](void *p, size_t) noexcept      { free(p); }
+
+ULong64_t EXBMHarness::GetAllocCount() { return gAllocCount.load(memory_order_relaxed); }
+ULong64_t EXBMHarness::GetAllocBytes() { return gAllocBytes.load(memory_order_relaxed); }
+#endif
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Cases
+//  -----------------------------------
+//
+void EXBMHarness::Add(const string &name, Func f)
+{
+   Case c;
+   c.fName = name;
+   c.fFunc = f;
+   fCases.push_back(c);
+}
+
+void EXBMHarness::Run(const string &filter)
+{
+   printf("%-36s %12s %12s %12s %10s\n",
+          "case", "ns/op", "allocs/op", "bytes/op", "ops");
+
+   for (UInt_t i=0; i<fCases.size(); i++) {
+      const Case &c = fCases[i];
+      if (c.fName.find(filter) == string::npos) continue;
+
+      // calibrate: double n until one repetition takes fMinTime
+
+      Long64_t n = 1;
+      while (1) {
+         Double_t t0 = Now();
+         c.fFunc(n);
+         if (Now() - t0 >= fMinTime || n >= (1LL << 40)) break;
+         n *= 2;
+      }
+
+      Double_t  t[kNreps];
+      ULong64_t na = GetAllocCount();
+      ULong64_t nb = GetAllocBytes();
+      for (Int_t r=0; r<kNreps; r++) {
+         Double_t t0 = Now();
+         c.fFunc(n);
+         t[r] = Now() - t0;
+      }
+      sort(t, t + kNreps);
+
+      Result res;
+      res.fName        = c.fName;
+      res.fNops        = n;
+      res.fNsPerOp     = t[kNreps/2] / n * 1.e9;
+      res.fAllocsPerOp = Double_t(GetAllocCount() - na) / (kNreps * n);
+      res.fBytesPerOp  = Double_t(GetAllocBytes() - nb) / (kNreps * n);
+      fResults.push_back(res);
+
+      printf("%-36s %12.1f %12.2f %12.1f %10lld\n", res.fName.c_str(),
+             res.fNsPerOp, res.fAllocsPerOp, res.fBytesPerOp, res.fNops);
+      fflush(stdout);
+   }
+}
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Baseline
+//  -----------------------------------
+//
+Bool_t EXBMHarness::WriteBaseline(const Char_t *name) const
+{
+   ofstream out(name);
+   for (UInt_t i=0; i<fResults.size(); i++) {
+      const Result &r = fResults[i];
+      out << "{\"name\":\""         << r.fName
+          << "\",\"ns_per_op\":"    << r.fNsPerOp
+          << ",\"allocs_per_op\":"  << r.fAllocsPerOp
+          << ",\"bytes_per_op\":"   << r.fBytesPerOp << "}" << endl;
+   }
+   if (!out) {
+      cerr << ">>>> Error!! EXBMHarness::WriteBaseline >>>>>>>>>>>" << endl
+           << " Cannot write " << name << endl;
+      return kFALSE;
+   }
+   return kTRUE;
+}
+
+Int_t EXBMHarness::Compare(const Char_t *name, Double_t tolerance) const
+{
+   ifstream in(name);
+   if (!in) {
+      cerr << ">>>> Error!! EXBMHarness::Compare >>>>>>>>>>>>>>>>>" << endl
+           << " Cannot open " << name << endl;
+      return -1;
+   }
+
+   // only reads what WriteBaseline() writes
+
+   map<string, Double_t> base, baseallocs;
+   string line;
+   while (getline(in, line)) {
+      string::size_type n0 = line.find("\"name\":\"");
+      string::size_type t0 = line.find("\"ns_per_op\":");
+      string::size_type a0 = line.find("\"allocs_per_op\":");
+      if (n0 == string::npos || t0 == string::npos || a0 == string::npos) continue;
+      n0 += 8;
+      string key = line.substr(n0, line.find('"', n0) - n0);
+      base      [key] = atof(line.c_str() + t0 + 12);
+      baseallocs[key] = atof(line.c_str() + a0 + 16);
+   }
+
+   printf("\n%-36s %12s %12s %8s\n", "case", "ns/op", "baseline", "ratio");
+   Int_t nslow = 0;
+   for (UInt_t i=0; i<fResults.size(); i++) {
+      const Result &r = fResults[i];
+      if (!base.count(r.fName)) continue;
+      Double_t ratio  = r.fNsPerOp / base[r.fName];
+      Bool_t   slower = ratio > 1. + tolerance;
+      Bool_t   more   = r.fAllocsPerOp > baseallocs[r.fName] + 0.5;
+      const Char_t *flag = slower ? (more ? "  SLOWER, MORE ALLOCS" : "  SLOWER")
+                                  : (more ? "  MORE ALLOCS"         : "");
+      if (slower || more) nslow++;
+      printf("%-36s %12.1f %12.1f %8.2f%s\n", r.fName.c_str(),
+             r.fNsPerOp, base[r.fName], ratio, flag);
+   }
+   return nslow;
+}
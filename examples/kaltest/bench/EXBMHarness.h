@@ -0,0 +1,80 @@
+#ifndef __EXBMHARNESS__
+#define __EXBMHARNESS__
+//*************************************************************************
+//* ===================
+//*  EXBMHarness Class
+//* ===================
+//*
+//* (Description)
+//*   Minimal benchmark harness. A case is a name and a function that
+//*   performs a given number of operations. Run() calibrates the
+//*   number of operations to fill a minimum time, repeats the timing
+//*   kNreps times and keeps the median, and reports ns/op together
+//*   with heap allocations and bytes per op, counted by the global
+//*   operator new of this program.
+//*
+//*   Results are written as one JSON object per line,
+//*     {"name":"...","ns_per_op":..,"allocs_per_op":..,"bytes_per_op":..}
+//*   which Compare() reads back as a baseline.
+//* (Requires)
+//*     none
+//* (Provides)
+//*     class EXBMHarness
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "Rtypes.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class EXBMHarness {
+public:
+   typedef std::function<void (Long64_t)> Func;   // performs n operations
+
+   struct Result {
+      std::string fName;          // case name
+      Double_t    fNsPerOp;       // median time per operation [ns]
+      Double_t    fAllocsPerOp;   // allocations per operation
+      Double_t    fBytesPerOp;    // allocated bytes per operation
+      Long64_t    fNops;          // operations per repetition
+   };
+
+   enum { kNreps = 5 };
+
+   EXBMHarness(Double_t mintime = 0.1) : fMinTime(mintime) {}
+
+   void Add(const std::string &name, Func f);
+
+   // Run the cases whose name contains filter and print a table
+
+   void Run(const std::string &filter = "");
+
+   const std::vector<Result> & GetResults() const { return fResults; }
+
+   Bool_t WriteBaseline(const Char_t *name) const;
+
+   // Print the ratio to the baseline in file name; returns the number
+   // of cases slower by more than tolerance (0.2 = 20%) or making more
+   // allocations per op, -1 if the file cannot be read
+
+   Int_t  Compare(const Char_t *name, Double_t tolerance = 0.2) const;
+
+   static ULong64_t GetAllocCount();
+   static ULong64_t GetAllocBytes();
+
+private:
+   struct Case {
+      std::string fName;
+      Func        fFunc;
+   };
+
+   Double_t            fMinTime;   // minimum time per repetition [s]
+   std::vector<Case>   fCases;     // registered cases
+   std::vector<Result> fResults;   // results of Run()
+};
+
+#endif
@@ -0,0 +1,55 @@
+//*************************************************************************
+//* ===================
+//*  EXBMKalSite Class
+//* ===================
+//*
+//* (Description)
+//*   Measurement site with a linear measurement for the benchmarks.
+//* (Requires)
+//*     TVKalSite, EXBMKalState
+//* (Provides)
+//*     class EXBMKalSite
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "EXBMKalSite.h"
+#include "EXBMKalState.h"
+
+ClassImp(EXBMKalSite)
+
+EXBMKalSite::EXBMKalSite(Int_t m, Int_t p)
+            : TVKalSite(m, p),
+              fHmat(m, p)
+{
+   // H measures a mix of all the parameters, V is diagonal
+
+   for (Int_t i=0; i<m; i++) {
+      for (Int_t j=0; j<p; j++) fHmat(i,j) = 1. / (1 + i + j);
+      GetMeasVec     ()(i,0) = 0.1 * (i + 1);
+      GetMeasNoiseMat()(i,i) = 1.e-2;
+   }
+}
+
+TVKalState & EXBMKalSite::CreateState(const TKalMatrix &sv, Int_t type)
+{
+   return *(new EXBMKalState(sv, type));
+}
+
+TVKalState & EXBMKalSite::CreateState(const TKalMatrix &sv, const TKalMatrix &c,
+                                      Int_t type)
+{
+   return *(new EXBMKalState(sv, c, type));
+}
+
+Int_t EXBMKalSite::CalcExpectedMeasVec(const TVKalState &a, TKalMatrix &h)
+{
+   h = fHmat * a;
+   return 1;
+}
+
+Int_t EXBMKalSite::CalcMeasVecDerivative(const TVKalState &, TKalMatrix &H)
+{
+   H = fHmat;
+   return 1;
+}
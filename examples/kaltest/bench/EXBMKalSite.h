@@ -0,0 +1,47 @@
+#ifndef __EXBMKALSITE__
+#define __EXBMKALSITE__
+//*************************************************************************
+//* ===================
+//*  EXBMKalSite Class
+//* ===================
+//*
+//* (Description)
+//*   Measurement site with a linear measurement h = H a of dimension
+//*   m on a state of dimension p, so that TVKalSite::Filter() and
+//*   Smooth() can be timed for any (m, p) whatever kSdim is.
+//* (Requires)
+//*     TVKalSite, EXBMKalState
+//* (Provides)
+//*     class EXBMKalSite
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "TVKalSite.h"
+
+class EXBMKalSite : public TVKalSite {
+public:
+   // Ctors and Dtor
+
+   EXBMKalSite(Int_t m = 2, Int_t p = 5);
+   virtual ~EXBMKalSite() {}
+
+   // Implementation of paraent class pure virtuals
+
+   Int_t  CalcExpectedMeasVec  (const TVKalState &a, TKalMatrix &h);
+   Int_t  CalcMeasVecDerivative(const TVKalState &a, TKalMatrix &H);
+   Bool_t IsAccepted()       { return kTRUE; }
+   void   DebugPrint() const {}
+
+private:
+   TVKalState & CreateState(const TKalMatrix &sv, Int_t type = 0);
+   TVKalState & CreateState(const TKalMatrix &sv, const TKalMatrix &c,
+                            Int_t type = 0);
+
+private:
+   TKalMatrix fHmat;   // measurement matrix
+
+   ClassDef(EXBMKalSite,1)   // Benchmark measurement site
+};
+
+#endif
@@ -0,0 +1,53 @@
+//*************************************************************************
+//* ====================
+//*  EXBMKalState Class
+//* ====================
+//*
+//* (Description)
+//*   State vector of any dimension for the filter benchmarks.
+//* (Requires)
+//*     TVKalState
+//* (Provides)
+//*     class EXBMKalState
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "EXBMKalState.h"
+#include "TVKalSite.h"
+
+ClassImp(EXBMKalState)
+
+EXBMKalState::EXBMKalState(const TKalMatrix &sv, Int_t type)
+             : TVKalState(sv, type, sv.GetNrows())
+{
+}
+
+EXBMKalState::EXBMKalState(const TKalMatrix &sv, const TKalMatrix &c, Int_t type)
+             : TVKalState(sv, c, type, sv.GetNrows())
+{
+}
+
+EXBMKalState::EXBMKalState(const TKalMatrix &sv, const TVKalSite &site, Int_t type)
+             : TVKalState(sv, site, type, sv.GetNrows())
+{
+}
+
+EXBMKalState * EXBMKalState::MoveTo(TVKalSite  &to,
+                                    TKalMatrix &F,
+                                    TKalMatrix *QPtr) const
+{
+   F.UnitMatrix();
+   if (QPtr) {
+      QPtr->Zero();
+      return new EXBMKalState(*this, to, TVKalSite::kPredicted);
+   }
+   return 0;
+}
+
+EXBMKalState & EXBMKalState::MoveTo(TVKalSite  &to,
+                                    TKalMatrix &F,
+                                    TKalMatrix &Q) const
+{
+   return *MoveTo(to, F, &Q);
+}
@@ -0,0 +1,42 @@
+#ifndef __EXBMKALSTATE__
+#define __EXBMKALSTATE__
+//*************************************************************************
+//* ====================
+//*  EXBMKalState Class
+//* ====================
+//*
+//* (Description)
+//*   State vector of any dimension for the filter benchmarks: the
+//*   propagator is the unit matrix and there is no process noise.
+//* (Requires)
+//*     TVKalState
+//* (Provides)
+//*     class EXBMKalState
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "TVKalState.h"
+
+class EXBMKalState : public TVKalState {
+public:
+   // Ctors and Dtor
+
+   EXBMKalState(const TKalMatrix &sv, Int_t type = 0);
+   EXBMKalState(const TKalMatrix &sv, const TKalMatrix &c, Int_t type = 0);
+   EXBMKalState(const TKalMatrix &sv, const TVKalSite &site, Int_t type = 0);
+   virtual ~EXBMKalState() {}
+
+   // Implementation of paraent class pure virtuals
+
+   EXBMKalState * MoveTo(TVKalSite  &to,
+                         TKalMatrix &F,
+                         TKalMatrix *QPtr = 0) const;
+   EXBMKalState & MoveTo(TVKalSite  &to,
+                         TKalMatrix &F,
+                         TKalMatrix &Q) const;
+
+   ClassDef(EXBMKalState,1)   // Benchmark state vector
+};
+
+#endif
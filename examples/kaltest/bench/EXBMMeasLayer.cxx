@@ -0,0 +1,18 @@
+//*************************************************************************
+//* =====================
+//*  EXBMMeasLayer Class
+//* =====================
+//*
+//* (Description)
+//*   Cylindrical layer for the benchmarks of TVMeasLayer.
+//* (Requires)
+//*     TVMeasLayer, TCylinder
+//* (Provides)
+//*     class EXBMMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "EXBMMeasLayer.h"
+
+ClassImp(EXBMMeasLayer)
@@ -0,0 +1,47 @@
+#ifndef __EXBMMEASLAYER__
+#define __EXBMMEASLAYER__
+//*************************************************************************
+//* =====================
+//*  EXBMMeasLayer Class
+//* =====================
+//*
+//* (Description)
+//*   Cylindrical layer for timing TVMeasLayer::CalcQms() and
+//*   GetEnergyLoss(); it takes no hits.
+//* (Requires)
+//*     TVMeasLayer, TCylinder
+//* (Provides)
+//*     class EXBMMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Added GetShape().
+//*************************************************************************
+//
+#include "TVMeasLayer.h"
+#include "TCylinder.h"
+
+class EXBMMeasLayer : public TVMeasLayer, public TCylinder {
+public:
+   // Ctors and Dtor
+
+   EXBMMeasLayer(TMaterial &min, TMaterial &mout, Double_t r, Double_t hlen)
+               : TVMeasLayer(min, mout, kTRUE, "BMML"), TCylinder(r, hlen) {}
+   virtual ~EXBMMeasLayer() {}
+
+   // Implementation of paraent class pure virtuals
+
+   TKalMatrix XvToMv  (const TVTrackHit &, const TVector3 &) const
+                      { return TKalMatrix(2,1); }
+   TVector3   HitToXv (const TVTrackHit &)                   const
+                      { return TVector3(); }
+   void       CalcDhDa(const TVTrackHit &, const TVector3 &,
+                       const TKalMatrix &,       TKalMatrix &) const {}
+
+   // crossings as those of TCylinder, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kCylinder; }
+
+   ClassDef(EXBMMeasLayer,1)   // Benchmark measurement layer
+};
+
+#endif
@@ -0,0 +1,287 @@
+//*************************************************************************
+//* ============
+//*  EXKalBench
+//* ============
+//*
+//* (Description)
+//*   Microbenchmarks of the geomlib and kallib kernels:
+//*     helix_moveto[_F|_FC]      THelicalTrack::MoveTo without and with
+//*                               the propagator and covariance matrices
+//*     xing_<surface>            TVSurface::CalcXingPointWith for
+//*                               TCylinder, THype, TCutCone and TPlane
+//*     helix_dxda, helix_dxdphi  THelicalTrack::CalcDxDa, CalcDxDphi
+//*     layer_calcqms, _eloss     TVMeasLayer::CalcQms, GetEnergyLoss
+//*     site_filter/m:M/p:P       TVKalSite::Filter, Smooth for an M
+//*     site_smooth/m:M/p:P       dimensional measurement on a P
+//*                               dimensional state (P = 5, 6)
+//*     rk_step                   TRungeKuttaTrack::StepRungeKutta
+//*
+//*   Usage: EXKalBench [-f filter] [-t mintime] [-o baseline.json]
+//*                     [-c baseline.json] [-r tolerance]
+//*     -f  run only the cases whose name contains filter
+//*     -t  minimum time per repetition in seconds (0.1)
+//*     -o  write the results as a baseline
+//*     -c  compare with a baseline; the exit code is 1 if a case is
+//*         slower by more than the tolerance (0.2) or allocates more
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "EXBMHarness.h"
+#include "EXBMKalSite.h"
+#include "EXBMKalState.h"
+#include "EXBMMeasLayer.h"
+
+#include "THelicalTrack.h"
+#include "TRungeKuttaTrack.h"
+#include "TCylinder.h"
+#include "THype.h"
+#include "TCutCone.h"
+#include "TPlane.h"
+#include "TMaterial.h"
+#include "TMath.h"
+#include "TString.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+   // Keeps the results of the cases alive so that the compiler cannot
+   // drop the work.
+
+   volatile Double_t gSink = 0.;
+
+   void AddHelixCases(EXBMHarness &bm)
+   {
+      // a 1 GeV track; the pivot jumps back and forth by 30 cm
+
+      THelicalTrack hel(0., 0., 1., 0., 0.5, 0., 0., 0., 3.);
+      Double_t phi = -0.4;
+      TVector3 x1  = hel.CalcXAt(phi);
+      TVector3 x0(0., 0., 0.);
+
+      bm.Add("helix_moveto", [=] (Long64_t n) {
+         THelicalTrack h(hel);
+         for (Long64_t i=0; i<n; i++) {
+            Double_t fid = 0.;
+            h.MoveTo(i % 2 ? x0 : x1, fid);
+            gSink = fid;
+         }
+      });
+
+      bm.Add("helix_moveto_F", [=] (Long64_t n) {
+         THelicalTrack h(hel);
+         TMatrixD F(5,5);
+         for (Long64_t i=0; i<n; i++) {
+            Double_t fid = 0.;
+            h.MoveTo(i % 2 ? x0 : x1, fid, &F);
+            gSink = F(0,0);
+         }
+      });
+
+      bm.Add("helix_moveto_FC", [=] (Long64_t n) {
+         THelicalTrack h(hel);
+         TMatrixD F(5,5);
+         TMatrixD C(5,5);
+         for (Long64_t i=0; i<n; i++) {
+            Double_t fid = 0.;
+            C.UnitMatrix();
+            h.MoveTo(i % 2 ? x0 : x1, fid, &F, &C);
+            gSink = C(0,0);
+         }
+      });
+
+      bm.Add("helix_dxda", [=] (Long64_t n) {
+         for (Long64_t i=0; i<n; i++) gSink = hel.CalcDxDa(phi)(0,0);
+      });
+
+      bm.Add("helix_dxdphi", [=] (Long64_t n) {
+         for (Long64_t i=0; i<n; i++) gSink = hel.CalcDxDphi(phi)(0,0);
+      });
+   }
+
+   void AddXingCase(EXBMHarness     &bm,
+                    const Char_t    *name,
+                    const TVSurface *sp,
+                    Double_t         phi0 = 0.)
+   {
+      // a 1 GeV track leaving (20,0,0) radially with tan(lambda) = 2;
+      // each op starts the search at phi0
+
+      THelicalTrack hel(0., -TMath::PiOver2(), 1., 0., 2., 20., 0., 0., 3.);
+      bm.Add(name, [=] (Long64_t n) {
+         TVector3 xx;
+         for (Long64_t i=0; i<n; i++) {
+            Double_t phi = phi0;
+            sp->CalcXingPointWith(hel, xx, phi, 0);
+            gSink = phi;
+         }
+      });
+   }
+
+   void AddXingCases(EXBMHarness &bm)
+   {
+      // never deleted: the cases refer to them; all are crossed at
+      // r = 30 cm except the cone, at r = z = 40 cm
+
+      AddXingCase(bm, "xing_cylinder", new TCylinder(30., 100.));
+      AddXingCase(bm, "xing_hype",     new THype(30., 100., 0.1));
+
+      // cone from (z,r) = (10,10) to (50,50), built as in EXBPConeMeasLayer;
+      // started near the crossing, which is otherwise on the far nappe
+
+      Double_t z1 = 10., r1 = 10., z2 = 50., r2 = 50.;
+      AddXingCase(bm, "xing_cutcone",
+                  new TCutCone(r1*(z2-z1)/(r2-r1), r2*(z2-z1)/(r2-r1),
+                               (r2-r1)/(z2-z1), 0., 0., (r2*z1-r1*z2)/(r2-r1)),
+                  -0.015);
+
+      AddXingCase(bm, "xing_plane",
+                  new TPlane(TVector3(30., 0., 0.), TVector3(1., 0., 0.)));
+   }
+
+   void AddLayerCases(EXBMHarness &bm)
+   {
+      static TMaterial si("Si", "", 28.0855, 14., 2.33, 9.36, 0.);
+      static TMaterial air("Air", "", 14.61, 7.3, 0.001205, 30420., 0.);
+      static EXBMMeasLayer ml(air, si, 30., 100.);
+
+      THelicalTrack hel(0., 0., 1., 0., 0.5, 0., 0., 0., 3.);
+      bm.Add("layer_calcqms", [=] (Long64_t n) {
+         TKalMatrix Qms(kSdim, kSdim);
+         for (Long64_t i=0; i<n; i++) {
+            ml.CalcQms(kTRUE, hel, -0.01, Qms);
+            gSink = Qms(1,1);
+         }
+      });
+
+      bm.Add("layer_eloss", [=] (Long64_t n) {
+         for (Long64_t i=0; i<n; i++) gSink = ml.GetEnergyLoss(kTRUE, hel, -0.01);
+      });
+   }
+
+   // Sets up a predicted state at site: a in (0.1, 0.2, ...), C = 1e-2
+
+   void Predict(EXBMKalSite &site, Int_t p)
+   {
+      TKalMatrix sv(p,1);
+      TKalMatrix C (p,p);
+      for (Int_t i=0; i<p; i++) {
+         sv(i,0) = 0.1 * (i + 1);
+         C (i,i) = 1.e-2;
+      }
+      EXBMKalState a(sv, C);
+      a.Propagate(site);
+   }
+
+   void AddSiteCases(EXBMHarness &bm)
+   {
+      for (Int_t p=5; p<=6; p++) {
+         for (Int_t m=1; m<=2; m++) {
+            ostringstream tag;
+            tag << "/m:" << m << "/p:" << p;
+
+            // Filter: a site with a predicted state; the filtered one
+            // is removed after each op
+
+            EXBMKalSite *fp = new EXBMKalSite(m, p);
+            Predict(*fp, p);
+            bm.Add("site_filter" + tag.str(), [=] (Long64_t n) {
+               for (Long64_t i=0; i<n; i++) {
+                  fp->Filter();
+                  gSink = fp->GetDeltaChi2();
+                  delete fp->RemoveAt(TVKalSite::kFiltered);
+               }
+            });
+
+            // Smooth: A filtered, propagated to B, B filtered and taken
+            // as smoothed; the smoothed state of A is removed after each op
+
+            EXBMKalSite *ap = new EXBMKalSite(m, p);
+            EXBMKalSite *bp = new EXBMKalSite(m, p);
+            Predict(*ap, p);
+            ap->Filter();
+            ap->GetCurState().Propagate(*bp);
+            bp->Filter();
+            TVKalState &bf = bp->GetCurState();
+            bp->Add(new EXBMKalState(bf, bf.GetCovMat(), TVKalSite::kSmoothed));
+            bm.Add("site_smooth" + tag.str(), [=] (Long64_t n) {
+               for (Long64_t i=0; i<n; i++) {
+                  ap->Smooth(*bp);
+                  gSink = ap->GetDeltaChi2();
+                  delete ap->RemoveAt(TVKalSite::kSmoothed);
+               }
+            });
+         }
+      }
+   }
+
+   void AddRKCases(EXBMHarness &bm)
+   {
+      // 1 GeV track in the default uniform field, 1 cm steps
+
+      TRungeKuttaTrack rk0(0., 0., 1., 0., 0.5, 0., 0., 0., 3.);
+      bm.Add("rk_step", [=] (Long64_t n) {
+         TRungeKuttaTrack rk(rk0);
+         for (Long64_t i=0; i<n; i++) {
+            if (i % 1000 == 0) rk = rk0;   // stay near the origin
+            rk.StepRungeKutta(1.);
+         }
+         gSink = rk.GetCurPosition().X();
+      });
+   }
+}
+
+int main(Int_t argc, Char_t **argv)
+{
+   // ===================================================================
+   //  Get job parameters from command line arguments, if any
+   // ===================================================================
+
+   TString  filter;
+   Double_t mintime   = 0.1;
+   Double_t tolerance = 0.2;
+   const Char_t *outname = 0;
+   const Char_t *refname = 0;
+   for (Int_t i=1; i<argc; i++) {
+      TString opt(argv[i]);
+      if (i + 1 >= argc) {
+         cerr << "Usage: " << argv[0] << " [-f filter] [-t mintime]"
+              << " [-o baseline.json] [-c baseline.json] [-r tolerance]" << endl;
+         return 2;
+      }
+      if      (opt == "-f") filter    = argv[++i];
+      else if (opt == "-t") mintime   = atof(argv[++i]);
+      else if (opt == "-o") outname   = argv[++i];
+      else if (opt == "-c") refname   = argv[++i];
+      else if (opt == "-r") tolerance = atof(argv[++i]);
+      else {
+         cerr << "Unknown option " << opt << endl;
+         return 2;
+      }
+   }
+
+   // ===================================================================
+   //  Register and run the cases
+   // ===================================================================
+
+   EXBMHarness bm(mintime);
+   AddHelixCases(bm);
+   AddXingCases (bm);
+   AddLayerCases(bm);
+   AddSiteCases (bm);
+   AddRKCases   (bm);
+
+   bm.Run(filter.Data());
+
+   if (outname && !bm.WriteBaseline(outname)) return 2;
+   if (refname) {
+      Int_t nslow = bm.Compare(refname, tolerance);
+      if (nslow < 0) return 2;
+      if (nslow > 0) return 1;
+   }
+   return 0;
+}
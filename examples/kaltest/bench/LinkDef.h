@@ -0,0 +1,11 @@
+#ifdef __CINT__
+
+#pragma link off all globals;
+#pragma link off all classes;
+#pragma link off all functions;
+
+#pragma link C++ class EXBMKalState;
+#pragma link C++ class EXBMKalSite;
+#pragma link C++ class EXBMMeasLayer;
+
+#endif
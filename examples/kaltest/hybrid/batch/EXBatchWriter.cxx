@@ -0,0 +1,82 @@
+//*************************************************************************
+//* =====================
+//*  EXBatchWriter Class
+//* =====================
+//*
+//* (Description)
+//*   Asynchronous output for the batch driver.
+//* (Requires)
+//*     none
+//* (Provides)
+//*     class EXBatchWriter
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "EXBatchWriter.h"
+
+using namespace std;
+
+EXBatchWriter::EXBatchWriter(ostream &out, Int_t depth)
+             : fOut(out),
+               fDepth(depth > 0 ? depth : 1),
+               fClosed(kFALSE),
+               fNblocks(0),
+               fNbytes(0),
+               fNstalls(0),
+               fThread(&EXBatchWriter::Run, this)
+{
+}
+
+EXBatchWriter::~EXBatchWriter()
+{
+   Close();
+}
+
+void EXBatchWriter::Push(string &block)
+{
+   unique_lock<mutex> lock(fMutex);
+   if (Int_t(fQueue.size()) >= fDepth) {
+      fNstalls++;
+      fNotFull.wait(lock, [this] { return Int_t(fQueue.size()) < fDepth; });
+   }
+   fQueue.push_back(string());
+   fQueue.back().swap(block);
+   lock.unlock();
+   fNotEmpty.notify_one();
+}
+
+Bool_t EXBatchWriter::Close()
+{
+   {
+      lock_guard<mutex> lock(fMutex);
+      fClosed = kTRUE;
+   }
+   fNotEmpty.notify_one();
+   if (fThread.joinable()) fThread.join();
+   fOut.flush();
+   return fOut.good();
+}
+
+void EXBatchWriter::Run()
+{
+   // take everything queued at once and write it without the lock
+
+   deque<string> blocks;
+   while (1) {
+      {
+         unique_lock<mutex> lock(fMutex);
+         fNotEmpty.wait(lock, [this] { return !fQueue.empty() || fClosed; });
+         if (fQueue.empty()) return;
+         blocks.swap(fQueue);
+      }
+      fNotFull.notify_all();
+
+      for (UInt_t i=0; i<blocks.size(); i++) {
+         fOut.write(blocks[i].data(), blocks[i].size());
+         fNbytes += blocks[i].size();
+      }
+      fNblocks += blocks.size();
+      blocks.clear();
+   }
+}
@@ -0,0 +1,66 @@
+#ifndef __EXBATCHWRITER__
+#define __EXBATCHWRITER__
+//*************************************************************************
+//* =====================
+//*  EXBatchWriter Class
+//* =====================
+//*
+//* (Description)
+//*   Asynchronous output for the batch driver. Fitting threads hand
+//*   over finished output blocks with Push(); a background thread
+//*   writes them to the stream in the order they arrive. The queue
+//*   holds at most depth blocks: Push() waits while it is full, so a
+//*   slow disk throttles the fit instead of filling the memory.
+//* (Requires)
+//*     none
+//* (Provides)
+//*     class EXBatchWriter
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "Rtypes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+class EXBatchWriter {
+public:
+   EXBatchWriter(std::ostream &out, Int_t depth = 256);
+   ~EXBatchWriter();
+
+   // Queue block for writing; block is left empty
+
+   void     Push(std::string &block);
+
+   // Write what is queued and stop the writer thread; returns kFALSE
+   // if the stream went bad
+
+   Bool_t   Close();
+
+   inline Long64_t GetNblocks() const { return fNblocks; }
+   inline Long64_t GetNbytes () const { return fNbytes;  }
+   inline Long64_t GetNstalls() const { return fNstalls; }   // full-queue waits
+
+private:
+   void     Run();
+
+private:
+   std::ostream            &fOut;       // output stream
+   Int_t                    fDepth;     // max. queued blocks
+   std::deque<std::string>  fQueue;     // queued blocks
+   std::mutex               fMutex;     // guards the queue and fClosed
+   std::condition_variable  fNotEmpty;
+   std::condition_variable  fNotFull;
+   Bool_t                   fClosed;    // no more blocks
+   Long64_t                 fNblocks;   // blocks written
+   Long64_t                 fNbytes;    // bytes written
+   Long64_t                 fNstalls;   // Push() calls that waited
+   std::thread              fThread;    // writer thread
+};
+
+#endif
@@ -0,0 +1,365 @@
+//*************************************************************************
+//* ============
+//*  EXHYBBatch
+//* ============
+//*
+//* (Description)
+//*   Headless batch reconstruction on the hybrid toy detector: reads
+//*   the events from a TKalHitFile, fits them as EXKalTest does (seed
+//*   fit, Kalman filter from outside in, smoothing back to the first
+//*   site) on nthreads threads and writes the fitted tracks as
+//*   TKalTrackWriter records through an EXBatchWriter thread. There
+//*   is no TApplication, no event display and no ntuple; the drawing
+//*   code lives in main/EXHYBDisplay and is not linked, nor are ROOT's
+//*   graphics libraries.
+//*
+//*   Records are written in the order the fits finish; the track id
+//*   of a record is its event number in the hit file.
+//*
+//*   Reported are the startup time (process start to the first fit),
+//*   the steady-state throughput, measured after the first nwarm
+//*   events, and the bytes per track of the records against those of
+//*   the matrices a ROOT stream of the track would hold. compare.sh
+//*   runs EXKalTest -b on the same configuration for reference.
+//*
+//*   Usage: EXHYBBatch [-j nthreads] [-q depth] [-W nwarm]
+//*                     [-o tracks.ktr] [-g geofile] hits.khf
+//*          EXHYBBatch -w [-n nevents] [-p pt] [-t t0] [-c cosmin,cosmax]
+//*                     [-s seed] [-g geofile] hits.khf
+//*     -j  number of fitting threads (1)
+//*     -q  max. output blocks queued for the writer thread (256)
+//*     -W  events fitted before the throughput is measured (10%)
+//*     -o  output file (tracks.ktr)
+//*     -g  take the detector from a geometry file
+//*     -w  generate nevents (1000) toy tracks, as EXKalTest does,
+//*         and write their hits to hits.khf
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Report bytes per track.
+//*   2026/10/18                    Linked without the drawing code.
+//*************************************************************************
+//
+#include "TKalDetCradle.h"
+#include "TKalTrackState.h"
+#include "TKalTrackSite.h"
+#include "TKalTrackSeeder.h"
+#include "TKalTrackWriter.h"
+#include "TKalCradleSnapshot.h"
+#include "TKalHitFile.h"
+#include "TKalHitView.h"
+#include "EXTPCKalDetector.h"
+#include "EXITKalDetector.h"
+#include "EXBPKalDetector.h"
+#include "EXVTXKalDetector.h"
+#include "EXGeoKalDetector.h"
+#include "EXEventGen.h"
+#include "EXHYBTrack.h"
+#include "EXBatchWriter.h"
+
+#include "TROOT.h"
+#include "TRandom.h"
+#include "TMath.h"
+#include "TString.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+   Double_t Now()
+   {
+      return chrono::duration<Double_t>(
+                chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   // Seconds since this process started, from /proc; -1 if unknown
+
+   Double_t GetProcessAge()
+   {
+      ifstream stat("/proc/self/stat");
+      ifstream uptime("/proc/uptime");
+      string line;
+      Double_t up;
+      if (!getline(stat, line) || !(uptime >> up)) return -1.;
+
+      // starttime is field 22; the command name in () may contain blanks
+
+      istringstream in(line.substr(line.rfind(')') + 2));
+      string field;
+      for (Int_t i=3; i<22 && in >> field; i++) ;
+      Double_t ticks;
+      if (!(in >> ticks)) return -1.;
+      return up - ticks / sysconf(_SC_CLK_TCK);
+   }
+
+   // ---------------------------
+   //  Fit one event as EXKalTest
+   // ---------------------------
+
+   Bool_t FitEvent(TObjArray &kalhits, TKalTrackSeeder &seeder, EXHYBTrack &kaltrack)
+   {
+      if (kalhits.GetEntries() < 3) return kFALSE;
+
+      // dummy site from the outermost hit
+
+      TKalHitView &hitd = *new TKalHitView(*static_cast<TKalHitView *>
+                                           (kalhits.At(kalhits.GetEntries() - 1)));
+      hitd(0,1) = 1.e6;
+      if (hitd.GetDimension() > 1) hitd(1,1) = 1.e6;
+
+      TKalTrackSite &sited = *new TKalTrackSite(hitd);
+      sited.SetHitOwner();
+      sited.SetOwner();
+
+      // seed
+
+      TObjArray seedhits;
+      TIter     nextseed(&kalhits, kIterBackward);
+      TObject  *objp;
+      while ((objp = nextseed())) seedhits.Add(objp);
+
+      if (!seeder.Fit(seedhits, kIterBackward)) {
+         delete &sited;
+         return kFALSE;
+      }
+      seeder.InitSite(sited);
+
+      // filter and smooth
+
+      kaltrack.Add(&sited);
+
+      TIter next(&kalhits, kIterBackward);
+      TVTrackHit *hitp;
+      while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+         TKalTrackSite &site = *new TKalTrackSite(*hitp);
+         if (!kaltrack.AddAndFilter(site)) delete &site;
+      }
+      if (kaltrack.GetEntries() < 4) return kFALSE;
+      kaltrack.SmoothBackTo(1);
+      return kTRUE;
+   }
+
+   void Usage(const Char_t *name)
+   {
+      cerr << "Usage: " << name << " [-j nthreads] [-q depth] [-W nwarm]"
+           << " [-o tracks.ktr] [-g geofile] hits.khf" << endl
+           << "       " << name << " -w [-n nevents] [-p pt] [-t t0]"
+           << " [-c cosmin,cosmax] [-s seed] [-g geofile] hits.khf" << endl;
+   }
+}
+
+int main(Int_t argc, Char_t **argv)
+{
+   Double_t tmain = Now();
+
+   // ===================================================================
+   //  Get job parameters from command line arguments, if any
+   // ===================================================================
+
+   Int_t    nthreads = 1;
+   Int_t    depth    = 256;
+   Int_t    nwarm    = -1;
+   Bool_t   generate = kFALSE;
+   Int_t    nevents  = 1000;
+   Double_t pt       =  1.;
+   Double_t t0in     = 14.;
+   Double_t cosmin   = -0.97;
+   Double_t cosmax   =  0.97;
+   UInt_t   seed     = 4357;
+   const Char_t *outname = "tracks.ktr";
+   const Char_t *geofile = 0;
+   const Char_t *hitname = 0;
+   for (Int_t i=1; i<argc; i++) {
+      TString opt(argv[i]);
+      if (opt == "-w") {
+         generate = kTRUE;
+         continue;
+      }
+      if (opt[0] != '-') {
+         hitname = argv[i];
+         continue;
+      }
+      if (i + 1 >= argc) {
+         Usage(argv[0]);
+         return 2;
+      }
+      if      (opt == "-j") nthreads = TMath::Max(1, atoi(argv[++i]));
+      else if (opt == "-q") depth    = atoi(argv[++i]);
+      else if (opt == "-W") nwarm    = atoi(argv[++i]);
+      else if (opt == "-o") outname  = argv[++i];
+      else if (opt == "-g") geofile  = argv[++i];
+      else if (opt == "-n") nevents  = atoi(argv[++i]);
+      else if (opt == "-p") pt       = atof(argv[++i]);
+      else if (opt == "-t") t0in     = atof(argv[++i]);
+      else if (opt == "-s") seed     = atoi(argv[++i]);
+      else if (opt == "-c") {
+         if (sscanf(argv[++i], "%lf,%lf", &cosmin, &cosmax) == 1) cosmax = cosmin;
+      } else {
+         Usage(argv[0]);
+         return 2;
+      }
+   }
+   if (!hitname) {
+      Usage(argv[0]);
+      return 2;
+   }
+   if (nthreads > 1) ROOT::EnableThreadSafety();
+
+   // ===================================================================
+   //  Prepare a detector
+   // ===================================================================
+
+   TKalDetCradle    toygld;
+   EXBPKalDetector  bmpipe;
+   EXVTXKalDetector vtxdet;
+   EXITKalDetector  itdet;
+   EXTPCKalDetector tpcdet;
+   EXGeoKalDetector geodet;
+
+   if (geofile) {
+      if (!geodet.Load(geofile)) return 1;
+      toygld.Install(geodet);
+   } else {
+      toygld.Install(bmpipe);
+      toygld.Install(vtxdet);
+      toygld.Install(itdet);
+      toygld.Install(tpcdet);
+   }
+   TString snapfile = geofile ? TString(geofile) + ".snp" : TString("toygld.snp");
+   if (!TKalCradleSnapshot::Restore(snapfile.Data(), toygld)) {
+      toygld.Close();
+      TKalCradleSnapshot::Save(snapfile.Data(), toygld);
+   }
+   toygld.Sort();
+   bmpipe.PowerOff();
+
+   // ===================================================================
+   //  -w: generate events and write their hits
+   // ===================================================================
+
+   if (generate) {
+      TKalHitFile hitfile(hitname, "RECREATE");
+      if (!hitfile.IsOpen()) return 1;
+
+      gRandom->SetSeed(seed);
+      TObjArray  kalhits;
+      kalhits.SetOwner();
+      EXEventGen gen(toygld, kalhits);
+      gen.SetT0(t0in);
+      for (Int_t i=0; i<nevents; i++) {
+         kalhits.Delete();
+         THelicalTrack hel = gen.GenerateHelix(pt, cosmin, cosmax);
+         gen.Swim(hel);
+         gen.WriteHits(hitfile, i);
+      }
+      hitfile.Close();
+      cerr << "Wrote " << nevents << " events to " << hitname << endl;
+      return 0;
+   }
+
+   // ===================================================================
+   //  Fit the events on nthreads threads
+   // ===================================================================
+
+   TKalHitFile hitfile(hitname);
+   if (!hitfile.IsOpen()) return 1;
+   nevents = hitfile.GetNevents();
+   if (nwarm < 0) nwarm = nevents / 10;
+   nwarm = TMath::Min(nwarm, TMath::Max(nevents - 1, 0));
+
+   ofstream      out(outname, ios::binary);
+   EXBatchWriter writer(out, depth);
+
+   atomic<Int_t>    nextev(0);
+   atomic<Int_t>    ndone(0);
+   atomic<Int_t>    nfit(0);
+   atomic<Long64_t> nmatbytes(0);  // site matrices of the fitted tracks
+   atomic<Double_t> tfirst(0.);   // start of the first fit
+   atomic<Double_t> twarm(0.);    // nwarm events done
+
+   auto worker = [&] () {
+      TKalHitFile      file(hitname);     // own views; the mapping is shared
+      TKalTrackSeeder  seeder;
+      seeder.SetCovScale(1.e2);
+      ostringstream    buf;
+      TKalTrackWriter  recwriter(buf);
+      string           block;
+      TObjArray        kalhits;
+      const size_t     kBlockSize = 1 << 16;
+
+      Int_t i;
+      while ((i = nextev.fetch_add(1)) < nevents) {
+         if (i == 0) tfirst = Now();
+         file.GetEvent(i, toygld, kalhits);
+
+         EXHYBTrack kaltrack;
+         kaltrack.SetOwner();
+         if (FitEvent(kalhits, seeder, kaltrack)) {
+            recwriter.WriteTrack(kaltrack, TKalTrackWriter::kFirstSite
+                                         | TKalTrackWriter::kLastSite, i);
+            nmatbytes += TKalTrackWriter::GetMatrixSize(kaltrack);
+            nfit++;
+         }
+         if (++ndone == nwarm) twarm = Now();
+
+         if (buf.tellp() >= Long64_t(kBlockSize)) {
+            block = buf.str();
+            buf.str("");
+            writer.Push(block);
+         }
+      }
+      block = buf.str();
+      if (!block.empty()) writer.Push(block);
+   };
+
+   if (nthreads == 1) {
+      worker();
+   } else {
+      vector<thread> pool;
+      for (Int_t i=0; i<nthreads; i++) pool.push_back(thread(worker));
+      for (Int_t i=0; i<nthreads; i++) pool[i].join();
+   }
+   Double_t tfit = Now();
+   Bool_t   ok   = writer.Close();
+   Double_t tend = Now();
+
+   // ===================================================================
+   //  Report
+   // ===================================================================
+
+   Double_t age     = GetProcessAge() - (tend - tfirst);
+   Double_t steady  = (nevents - nwarm) / (tfit - (nwarm ? twarm.load() : tfirst.load()));
+   printf("events         : %d read, %d fitted, %d threads\n", nevents, nfit.load(), nthreads);
+   if (age >= 0.) {
+      printf("startup        : %.1f ms from process start (%.1f ms in main)\n",
+             age * 1.e3, (tfirst - tmain) * 1.e3);
+   } else {
+      printf("startup        : %.1f ms in main\n", (tfirst - tmain) * 1.e3);
+   }
+   printf("throughput     : %.1f events/s overall, %.1f events/s after %d events\n",
+          nevents / (tfit - tfirst), steady, nwarm);
+   printf("output         : %lld bytes in %lld blocks, %lld writer stalls, %.1f ms to drain\n",
+          writer.GetNbytes(), writer.GetNblocks(), writer.GetNstalls(), (tend - tfit) * 1.e3);
+   if (nfit) {
+      printf("bytes/track    : %.1f in records, %.1f in the matrices of the sites"
+             " (at least that much ROOT streamed)\n",
+             Double_t(writer.GetNbytes()) / nfit, Double_t(nmatbytes) / nfit);
+   }
+
+   if (!ok) {
+      cerr << "Cannot write " << outname << endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,26 @@
+#!/bin/sh
+# Startup time and throughput of EXHYBBatch against EXKalTest -b on
+# the same toy events. Usage: ./compare.sh [nevents] [pt] [nthreads]
+nevt=${1:-1000}
+pt=${2:-1.}
+nthr=${3:-4}
+kaltest=${KALTEST:-../../main/prod/EXKalTest}
+
+now() { date +%s.%N; }
+elapsed() { echo "$2 - $1" | bc; }
+
+echo "== EXKalTest -b 1 $pt (startup + 1 event)"
+t1=`now`; $kaltest -b 1 $pt > /dev/null 2>&1; t2=`now`
+echo "   `elapsed $t1 $t2` s"
+
+echo "== EXKalTest -b $nevt $pt"
+t1=`now`; $kaltest -b $nevt $pt > /dev/null 2>&1; t2=`now`
+echo "   `elapsed $t1 $t2` s"
+
+./EXHYBBatch -w -n $nevt -p $pt hits.khf
+echo "== EXHYBBatch -j 1"
+t1=`now`; ./EXHYBBatch -j 1 hits.khf; t2=`now`
+echo "   `elapsed $t1 $t2` s"
+echo "== EXHYBBatch -j $nthr"
+t1=`now`; ./EXHYBBatch -j $nthr hits.khf; t2=`now`
+echo "   `elapsed $t1 $t2` s"
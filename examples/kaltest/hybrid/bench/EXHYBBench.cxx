@@ -0,0 +1,620 @@
+//*************************************************************************
+//* ============
+//*  EXHYBBench
+//* ============
+//*
+//* (Description)
+//*   Headless reconstruction throughput benchmark on the hybrid toy
+//*   detector (BP+VTX+IT+TPC). Tracks are generated with EXEventGen
+//*   at fixed seeds on a pT x cos(theta) grid, then fitted as in
+//*   EXKalTest: seed fit, Kalman filter from outside in and smoothing
+//*   back to the first site.
+//*
+//*   Reported are tracks/s, the p50/p99 latency per track, the peak
+//*   RSS, heap allocations per track, the mean and width of the pulls
+//*   of the 5 helix parameters at the innermost site against the true
+//*   helix there, and the flatness of the chi2 probability (KS distance
+//*   to the uniform distribution and the fraction below 1%). They are
+//*   meant to be compared between versions: the toy generator and the
+//*   fit do not treat the energy loss identically, so the kappa pulls
+//*   are off already at 1 GeV.
+//*
+//*   Built with -D__KALSTATS_ALLOC__ the allocations are counted by
+//*   TKalStats instead, which also splits them by fit stage. Built
+//*   with -D__KALSTATS__ it also reports, per surface type, how many
+//*   crossing searches the bounding volumes saved in Transport(), and
+//*   the Newton steps per search from a predicted start and from the
+//*   pivot.
+//*
+//*   Per pT point the fits/s of one thread, the tracks fitted and the
+//*   rate of failed fits are listed as well; -p 0.05,0.1,0.2,0.5,1
+//*   scans the low-pT tracks that curl inside the tracker (a 50 MeV
+//*   track turns back at a radius of about 11 cm), for which it also
+//*   reports the turning points passed in Transport().
+//*
+//*   With -f 2 the tracks are smoothed by TKalTrack::FilterAndSmooth(),
+//*   which runs a backward filter alongside the forward one on a second
+//*   thread and takes the weighted mean of the two, instead of by
+//*   SmoothBackTo(1). Its latency is to be compared with that of -f 1;
+//*   with -m the dummy site at the outermost hit is booked as well.
+//*   With -f 0 only the state at the first hit is smoothed, by
+//*   GetSmoothedState(1), leaving the residuals of the sites on the
+//*   way as filtered; with -m only that site is booked then.
+//*
+//*   Nothing is drawn and no file is written unless -o or -m is given.
+//*
+//*   With -a the benchmark doubles as a regression test of the heap
+//*   traffic: it exits with 1 if the allocations per site, counted
+//*   over all hits offered to the fits, exceed maxallocs.
+//*
+//*   Usage: EXHYBBench [-n ntracks] [-j nthreads] [-s seed]
+//*                     [-p pt1,pt2,..] [-c cos1,cos2,..] [-o result.json]
+//*                     [-m residuals.json] [-f nfilters] [-a maxallocs]
+//*     -n  tracks per grid point (100)
+//*     -j  number of fitting threads (1)
+//*     -s  seed of the first grid point; point i uses seed + i (4357)
+//*     -p  pT values [GeV] (1,2,5,10)
+//*     -c  cos(theta) values (0,0.5,0.8,0.95)
+//*     -o  write the results as one JSON object
+//*     -m  monitor the smoothed residuals and pulls per layer with
+//*         TKalResMonitor and write its summary
+//*     -f  0: filter and smoothing of the first hit only,
+//*         1: filter and smoother, 2: two-filter smoother (1)
+//*     -a  max. allocations per site (no limit)
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Allocations per fit stage.
+//*   2026/10/18                    Residual monitor (-m).
+//*   2026/10/18                    Bounding-volume rejection rates.
+//*   2026/10/18                    Newton steps of warm-started searches.
+//*   2026/10/18                    Fits/s and failure rates per pT.
+//*   2026/10/18                    Two-filter smoothing (-f 2).
+//*   2026/10/18                    Lazy smoothing (-f 0).
+//*   2026/10/18                    Allocation budget (-a).
+//*************************************************************************
+//
+#include "TKalDetCradle.h"
+#include "TKalTrackState.h"
+#include "TKalTrackSite.h"
+#include "TKalTrackSeeder.h"
+#include "TKalStats.h"
+#include "TKalResMonitor.h"
+#include "TVTrackHit.h"
+#include "EXTPCKalDetector.h"
+#include "EXITKalDetector.h"
+#include "EXBPKalDetector.h"
+#include "EXVTXKalDetector.h"
+#include "EXVTXHit.h"
+#include "EXITHit.h"
+#include "EXITFBHit.h"
+#include "EXTPCHit.h"
+#include "EXEventGen.h"
+#include "EXHYBTrack.h"
+
+#include "TROOT.h"
+#include "TRandom.h"
+#include "TMath.h"
+#include "TString.h"
+#include "TVector2.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Allocation counting
+//  -----------------------------------
+//
+#ifdef __KALSTATS_ALLOC__
+namespace {
+   // the library replaces operator new and counts per fit stage
+
+   void GetAllocs(ULong64_t &count, ULong64_t &bytes)
+   {
+      TKalStats::Snapshot s;
+      TKalStats::GetSnapshot(s);
+      count = bytes = 0;
+      for (Int_t i=0; i<TKalStats::kNallocTags; i++) {
+         count += s.fAllocs[i];
+         bytes += s.fBytes [i];
+      }
+   }
+}
+#else
+namespace {
+   atomic<ULong64_t> gAllocCount(0);
+   atomic<ULong64_t> gAllocBytes(0);
+
+   void *CountedAlloc(size_t n)
+   {
+      gAllocCount.fetch_add(1, memory_order_relaxed);
+      gAllocBytes.fetch_add(n, memory_order_relaxed);
+      void *p = malloc(n ? n : 1);
+      if (!p) throw bad_alloc();
+      return p;
+   }
+
+   void GetAllocs(ULong64_t &count, ULong64_t &bytes)
+   {
+      count = gAllocCount.load();
+      bytes = gAllocBytes.load();
+   }
+}
+
+void *operator new  (size_t n)                         { return CountedAlloc(n); }
+void *operator new[](size_t n)                         { return CountedAlloc(n); }
+void *operator new  (size_t n, const nothrow_t &) noexcept
+{
+   try { return CountedAlloc(n); } catch (...) { return 0; }
+}
+void *operator new[](size_t n, const nothrow_t &) noexcept
+{
+   try { return CountedAlloc(n); } catch (...) { return 0; }
+}
+void  operator delete  (void *p) noexcept              { free(p); }
+void  operator delete[](void *p) noexcept              { free(p); }
+void  operator delete  (void *p, size_t) noexcept      { free(p); }
+void  operator delete[](void *p, size_t) noexcept      { free(p); }
+#endif
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Events and fit results
+//  -----------------------------------
+//
+namespace {
+   struct Event {
+      Double_t       fPt;         // generated pT
+      Double_t       fCos;        // generated cos(theta)
+      TObjArray     *fHitsPtr;    // hits, in the order of Swim()
+      THelicalTrack  fTruth;      // true helix at the first hit
+   };
+
+   struct Result {
+      Bool_t   fOK;               // fitted
+      Bool_t   fReversed;         // fitted against the generated direction
+      Double_t fTime;             // fit time [s]
+      Int_t    fNsites;           // hits offered to the fit
+      Int_t    fNdf;
+      Double_t fChi2;
+      Double_t fPull[5];          // (fit - true) / error at the first hit
+   };
+
+   Double_t Now()
+   {
+      return chrono::duration<Double_t>(
+                chrono::steady_clock::now().time_since_epoch()).count();
+   }
+
+   vector<Double_t> ParseList(const Char_t *s)
+   {
+      vector<Double_t> v;
+      stringstream in(s);
+      string item;
+      while (getline(in, item, ',')) v.push_back(atof(item.c_str()));
+      return v;
+   }
+
+   TVTrackHit *CloneHit(TVTrackHit *ht1p)
+   {
+      if (dynamic_cast<EXVTXHit *>(ht1p)) {
+         return new EXVTXHit(*dynamic_cast<EXVTXHit *>(ht1p));
+      } else if (dynamic_cast<EXITHit *>(ht1p)) {
+         return new EXITHit(*dynamic_cast<EXITHit *>(ht1p));
+      } else if (dynamic_cast<EXITFBHit *>(ht1p)) {
+         return new EXITFBHit(*dynamic_cast<EXITFBHit *>(ht1p));
+      } else if (dynamic_cast<EXTPCHit *>(ht1p)) {
+         return new EXTPCHit(*dynamic_cast<EXTPCHit *>(ht1p));
+      }
+      return 0;
+   }
+
+   // ---------------------------
+   //  Fit one event as EXKalTest
+   // ---------------------------
+
+   void FitEvent(const Event     &ev,
+                 TKalTrackSeeder &seeder,
+                 TKalResMonitor  *monp,
+                 Int_t            nfilters,
+                 Result          &res)
+   {
+      res.fOK = kFALSE;
+
+      TObjArray &kalhits = *ev.fHitsPtr;
+      res.fNsites = kalhits.GetEntries();
+      if (kalhits.GetEntries() < 3) return;
+
+      // dummy site from the outermost hit
+
+      TVTrackHit *htdp = CloneHit(dynamic_cast<TVTrackHit *>
+                                  (kalhits.At(kalhits.GetEntries() - 1)));
+      if (!htdp) return;
+      TVTrackHit &hitd = *htdp;
+      hitd(0,1) = 1.e6;
+      if (hitd.GetDimension() > 1) hitd(1,1) = 1.e6;
+
+      TKalTrackSite &sited = *new TKalTrackSite(hitd);
+      sited.SetHitOwner();
+      sited.SetOwner();
+
+      // seed
+
+      TObjArray seedhits;
+      TIter     nextseed(&kalhits, kIterBackward);
+      TObject  *objp;
+      while ((objp = nextseed())) seedhits.Add(objp);
+
+      if (!seeder.Fit(seedhits, kIterBackward)) {
+         delete &sited;
+         return;
+      }
+      seeder.InitSite(sited);
+
+      // filter and smooth
+
+      EXHYBTrack kaltrack;
+      kaltrack.SetOwner();
+      kaltrack.SetResMonitor(monp);
+      kaltrack.Add(&sited);
+
+      TIter next(&kalhits, kIterBackward);
+      TVTrackHit *hitp;
+      if (nfilters == 2) {
+         TObjArray sites;
+         sites.SetOwner();
+         while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+            sites.Add(new TKalTrackSite(*hitp));
+         }
+         kaltrack.FilterAndSmooth(sites);            // rejected sites stay in sites
+         if (kaltrack.GetEntries() < 4) return;
+      } else {
+         while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+            TKalTrackSite &site = *new TKalTrackSite(*hitp);
+            if (!kaltrack.AddAndFilter(site)) delete &site;
+         }
+         if (kaltrack.GetEntries() < 4) return;
+         if (nfilters) kaltrack.SmoothBackTo(1);
+         else          kaltrack.GetSmoothedState(1, monp != 0);
+      }
+
+      // pulls at the innermost site, the last one filtered
+
+      TKalTrackSite  &cursite = static_cast<TKalTrackSite &>(*kaltrack.Last());
+      TVKalState     &a       = cursite.GetCurState();
+      const TKalMatrix &C     = a.GetCovMat();
+
+      THelicalTrack truth(ev.fTruth);
+      Double_t fid = 0.;
+      truth.MoveTo(cursite.GetPivot(), fid);
+      Double_t t[5] = { truth.GetDrho(), truth.GetPhi0(), truth.GetKappa(),
+                        truth.GetDz(),   truth.GetTanLambda() };
+
+      // EXEventGen::Swim() may run a track backwards through the plane
+      // layers; the hits then describe the same helix in the opposite
+      // direction
+
+      res.fReversed = a(2,0) * t[2] < 0.;
+      if (res.fReversed) {
+         t[0] = -t[0];
+         t[1] += TMath::Pi();
+         t[2] = -t[2];
+         t[4] = -t[4];
+      }
+      for (Int_t i=0; i<5; i++) {
+         Double_t d = a(i,0) - t[i];
+         if (i == 1) d = TVector2::Phi_mpi_pi(d);
+         res.fPull[i] = d / TMath::Sqrt(C(i,i));
+      }
+      res.fNdf  = kaltrack.GetNDF();
+      res.fChi2 = kaltrack.GetChi2();
+      res.fOK   = kTRUE;
+   }
+
+   void Summarize(const vector<Double_t> &x, Double_t &mean, Double_t &rms)
+   {
+      mean = rms = 0.;
+      if (x.empty()) return;
+      for (UInt_t i=0; i<x.size(); i++) mean += x[i];
+      mean /= x.size();
+      for (UInt_t i=0; i<x.size(); i++) rms += (x[i] - mean) * (x[i] - mean);
+      rms = TMath::Sqrt(rms / x.size());
+   }
+}
+
+int main(Int_t argc, Char_t **argv)
+{
+   // ===================================================================
+   //  Get job parameters from command line arguments, if any
+   // ===================================================================
+
+   Int_t    ntracks  = 100;
+   Int_t    nthreads = 1;
+   UInt_t   seed     = 4357;
+   vector<Double_t> pts  = ParseList("1,2,5,10");
+   vector<Double_t> coss = ParseList("0,0.5,0.8,0.95");
+   const Char_t *outname = 0;
+   const Char_t *monname = 0;
+   Int_t    nfilters = 1;
+   Double_t maxallocs = -1.;
+   for (Int_t i=1; i<argc; i++) {
+      TString opt(argv[i]);
+      if (i + 1 >= argc) {
+         cerr << "Usage: " << argv[0] << " [-n ntracks] [-j nthreads] [-s seed]"
+              << " [-p pt1,pt2,..] [-c cos1,cos2,..] [-o result.json]"
+              << " [-m residuals.json] [-f nfilters] [-a maxallocs]" << endl;
+         return 2;
+      }
+      if      (opt == "-n") ntracks  = atoi(argv[++i]);
+      else if (opt == "-j") nthreads = TMath::Max(1, atoi(argv[++i]));
+      else if (opt == "-s") seed     = atoi(argv[++i]);
+      else if (opt == "-p") pts      = ParseList(argv[++i]);
+      else if (opt == "-c") coss     = ParseList(argv[++i]);
+      else if (opt == "-o") outname  = argv[++i];
+      else if (opt == "-m") monname  = argv[++i];
+      else if (opt == "-f") nfilters = atoi(argv[++i]);
+      else if (opt == "-a") maxallocs = atof(argv[++i]);
+      else {
+         cerr << "Unknown option " << opt << endl;
+         return 2;
+      }
+   }
+   if (nthreads > 1) ROOT::EnableThreadSafety();
+
+   // ===================================================================
+   //  Prepare a detector
+   // ===================================================================
+
+   TKalDetCradle    toygld;
+   EXBPKalDetector  bmpipe;
+   EXVTXKalDetector vtxdet;
+   EXITKalDetector  itdet;
+   EXTPCKalDetector tpcdet;
+
+   toygld.Install(bmpipe);
+   toygld.Install(vtxdet);
+   toygld.Install(itdet);
+   toygld.Install(tpcdet);
+   toygld.Close();
+   toygld.Sort();
+   bmpipe.PowerOff();
+
+   // ===================================================================
+   //  Generate all events first: EXEventGen uses gRandom
+   // ===================================================================
+
+   vector<Event> events;
+   for (UInt_t ip=0; ip<pts.size(); ip++) {
+      for (UInt_t ic=0; ic<coss.size(); ic++) {
+         gRandom->SetSeed(seed + ip * coss.size() + ic);
+         for (Int_t i=0; i<ntracks; i++) {
+            Event ev;
+            ev.fPt      = pts[ip];
+            ev.fCos     = coss[ic];
+            ev.fHitsPtr = new TObjArray;
+            ev.fHitsPtr->SetOwner();
+            EXEventGen gen(toygld, *ev.fHitsPtr);
+            THelicalTrack hel = gen.GenerateHelix(pts[ip], coss[ic], coss[ic]);
+            gen.Swim(hel);
+            ev.fTruth = gen.GetFirstHitHelix();
+            events.push_back(ev);
+         }
+      }
+   }
+
+   // ===================================================================
+   //  Fit them on nthreads threads
+   // ===================================================================
+
+   Int_t          nevents = events.size();
+   vector<Result> results(nevents);
+   atomic<Int_t>  nextev(0);
+   TKalResMonitor monitor(toygld.GetEntries());
+   TKalResMonitor *monp = monname ? &monitor : 0;
+
+   auto worker = [&] () {
+      TKalTrackSeeder seeder;
+      seeder.SetCovScale(1.e2);
+      Int_t i;
+      while ((i = nextev.fetch_add(1)) < nevents) {
+         Double_t t0 = Now();
+         FitEvent(events[i], seeder, monp, nfilters, results[i]);
+         results[i].fTime = Now() - t0;
+      }
+   };
+
+   TKalStats::Reset();
+   ULong64_t na0, nb0;
+   GetAllocs(na0, nb0);
+   Double_t  t0  = Now();
+   if (nthreads == 1) {
+      worker();
+   } else {
+      vector<thread> pool;
+      for (Int_t i=0; i<nthreads; i++) pool.push_back(thread(worker));
+      for (Int_t i=0; i<nthreads; i++) pool[i].join();
+   }
+   Double_t  wall   = Now() - t0;
+   ULong64_t nalloc, nbytes;
+   GetAllocs(nalloc, nbytes);
+   nalloc -= na0;
+   nbytes -= nb0;
+
+   // ===================================================================
+   //  Report
+   // ===================================================================
+
+   vector<Double_t> lat, prob, pull[5];
+   for (Int_t i=0; i<nevents; i++) {
+      const Result &r = results[i];
+      lat.push_back(r.fTime);
+      if (!r.fOK) continue;
+      prob.push_back(TMath::Prob(r.fChi2, r.fNdf));
+      for (Int_t k=0; k<5; k++) pull[k].push_back(r.fPull[k]);
+   }
+   Int_t nfit = prob.size();
+   Int_t nrev = 0;
+   for (Int_t i=0; i<nevents; i++) if (results[i].fOK && results[i].fReversed) nrev++;
+   Long64_t nsites = 0;
+   for (Int_t i=0; i<nevents; i++) nsites += results[i].fNsites;
+   Double_t allocs = nsites ? Double_t(nalloc) / nsites : 0.;
+
+   sort(lat.begin(), lat.end());
+   Double_t p50 = nevents ? lat[(nevents - 1) / 2]    : 0.;
+   Double_t p99 = nevents ? lat[(nevents - 1) * 99 / 100] : 0.;
+
+   // KS distance of the chi2 probability to the uniform distribution
+
+   sort(prob.begin(), prob.end());
+   Double_t ks = 0.;
+   Int_t    nlow = 0;
+   for (Int_t i=0; i<nfit; i++) {
+      ks = TMath::Max(ks, TMath::Max(prob[i] - Double_t(i) / nfit,
+                                     Double_t(i + 1) / nfit - prob[i]));
+      if (prob[i] < 0.01) nlow++;
+   }
+
+   struct rusage ru;
+   getrusage(RUSAGE_SELF, &ru);
+   Double_t rss = ru.ru_maxrss / 1024.;   // [MB]
+
+   Double_t mean[5], width[5];
+   for (Int_t k=0; k<5; k++) Summarize(pull[k], mean[k], width[k]);
+
+   const Char_t *names[5] = { "drho", "phi0", "kappa", "dz", "tanl" };
+   printf("tracks         : %d generated, %d fitted (%d reversed), %d threads\n",
+          nevents, nfit, nrev, nthreads);
+   printf("throughput     : %.1f tracks/s\n", nevents / wall);
+   printf("latency        : p50 %.1f us, p99 %.1f us\n", p50 * 1.e6, p99 * 1.e6);
+   printf("peak RSS       : %.1f MB\n", rss);
+   printf("allocations    : %.1f /track, %.0f bytes/track, %.2f /site\n",
+          Double_t(nalloc) / nevents, Double_t(nbytes) / nevents, allocs);
+   printf("chi2 prob.     : KS distance %.4f, %.2f%% below 1%%\n",
+          ks, nfit ? 100. * nlow / nfit : 0.);
+   for (Int_t k=0; k<5; k++) {
+      printf("pull %-9s : mean %+.3f  width %.3f\n", names[k], mean[k], width[k]);
+   }
+
+   // per pT point; the events are in the order of the grid
+
+   Int_t ncos = coss.size();
+   vector<Int_t>    ptfit(pts.size(), 0), ptlow(pts.size(), 0);
+   vector<Double_t> pttime(pts.size(), 0.);
+   for (Int_t i=0; i<nevents; i++) {
+      const Result &r  = results[i];
+      Int_t         ip = i / (ncos * ntracks);
+      pttime[ip] += r.fTime;
+      if (!r.fOK) continue;
+      ptfit[ip]++;
+      if (TMath::Prob(r.fChi2, r.fNdf) < 0.01) ptlow[ip]++;
+   }
+   Int_t ntpt = ncos * ntracks;
+   printf("pT [GeV]       :   fits/s  fitted   failed  chi2 prob. < 1%%\n");
+   for (UInt_t ip=0; ip<pts.size(); ip++) {
+      printf("  %-12g : %8.1f  %6d  %6.2f%%  %6.2f%%\n", pts[ip],
+             pttime[ip] > 0. ? ntpt / pttime[ip] : 0., ptfit[ip],
+             ntpt ? 100. * (ntpt - ptfit[ip]) / ntpt : 0.,
+             ptfit[ip] ? 100. * ptlow[ip] / ptfit[ip] : 0.);
+   }
+   if (TKalStats::IsAllocEnabled()) {
+      TKalStats::Snapshot s;
+      TKalStats::GetSnapshot(s);
+      for (Int_t i=0; i<TKalStats::kNallocTags; i++) {
+         TKalStats::EAllocTag t = TKalStats::EAllocTag(i);
+         printf("  %-12s : %.1f /track, %.0f bytes/track\n", TKalStats::GetAllocTagName(t),
+                Double_t(s.fAllocs[i]) / nevents, Double_t(s.fBytes[i]) / nevents);
+      }
+   }
+   if (TKalStats::IsEnabled()) {
+      TKalStats::Snapshot s;
+      TKalStats::GetSnapshot(s);
+      const Char_t *shapes[4] = { "other", "cylinder", "plane", "cutcone" };
+      for (Int_t i=0; i<4; i++) {
+         ULong64_t nchk = s.fCount[TKalStats::kBVCheckOther  + i];
+         ULong64_t nrej = s.fCount[TKalStats::kBVRejectOther + i];
+         if (!nchk) continue;
+         printf("bv %-11s : %.1f%% of %llu crossing searches rejected\n",
+                shapes[i], 100. * nrej / nchk, nchk);
+      }
+      ULong64_t nwarm = s.fCount[TKalStats::kXingWarmStarts];
+      ULong64_t iwarm = s.fCount[TKalStats::kXingWarmIterations];
+      ULong64_t nxing = s.fCalls[TKalStats::kXing];
+      ULong64_t ncold = nxing > nwarm ? nxing - nwarm : 0;
+      ULong64_t icold = s.fCount[TKalStats::kXingIterations] - iwarm;
+      if (nwarm) {
+         printf("xing warm      : %llu searches, %.2f steps/search (%.2f from the pivot)\n",
+                nwarm, Double_t(iwarm) / nwarm, ncold ? Double_t(icold) / ncold : 0.);
+      }
+      ULong64_t nturn = s.fCount[TKalStats::kLooperTurns];
+      ULong64_t nretg = s.fCount[TKalStats::kLooperRetargets];
+      if (nturn || nretg) {
+         printf("loopers        : %llu turning points passed, %llu destinations at the hit\n",
+                nturn, nretg);
+      }
+   }
+   if (TKalStats::IsEnabled() || TKalStats::IsAllocEnabled()) TKalStats::WriteJSON(cout);
+
+   if (outname) {
+      ofstream out(outname);
+      out << "{\"tracks\":" << nevents << ",\"fitted\":" << nfit
+          << ",\"reversed\":" << nrev
+          << ",\"threads\":" << nthreads
+          << ",\"tracks_per_s\":" << nevents / wall
+          << ",\"latency_p50_us\":" << p50 * 1.e6
+          << ",\"latency_p99_us\":" << p99 * 1.e6
+          << ",\"peak_rss_mb\":" << rss
+          << ",\"allocs_per_track\":" << Double_t(nalloc) / nevents
+          << ",\"bytes_per_track\":" << Double_t(nbytes) / nevents
+          << ",\"allocs_per_site\":" << allocs
+          << ",\"chi2prob_ks\":" << ks
+          << ",\"chi2prob_below_1pc\":" << (nfit ? Double_t(nlow) / nfit : 0.)
+          << ",\"pulls\":{";
+      for (Int_t k=0; k<5; k++) {
+         out << (k ? "," : "") << "\"" << names[k] << "\":{\"mean\":" << mean[k]
+             << ",\"width\":" << width[k] << "}";
+      }
+      out << "},\"per_pt\":[";
+      for (UInt_t ip=0; ip<pts.size(); ip++) {
+         out << (ip ? "," : "") << "{\"pt\":" << pts[ip]
+             << ",\"fits_per_s\":" << (pttime[ip] > 0. ? ntpt / pttime[ip] : 0.)
+             << ",\"fitted\":" << ptfit[ip]
+             << ",\"failed\":" << (ntpt ? Double_t(ntpt - ptfit[ip]) / ntpt : 0.)
+             << "}";
+      }
+      out << "]}" << endl;
+      if (!out) {
+         cerr << "Cannot write " << outname << endl;
+         return 2;
+      }
+   }
+
+   if (monname) {
+      ofstream out(monname);
+      monitor.WriteJSON(out);
+      if (!out) {
+         cerr << "Cannot write " << monname << endl;
+         return 2;
+      }
+   }
+
+   for (Int_t i=0; i<nevents; i++) delete events[i].fHitsPtr;
+
+   if (maxallocs >= 0. && allocs > maxallocs) {
+      printf("allocation budget exceeded: %.2f /site > %g\n", allocs, maxallocs);
+      return 1;
+   }
+   return 0;
+}
@@ -1,6 +1,5 @@
 #include "EXBPConeHit.h"
 #include "EXBPConeMeasLayer.h"
-#include "TMath.h"
 
 #include <iostream>
 #include <iomanip>
@@ -41,28 +40,7 @@ EXBPConeHit::~EXBPConeHit()
 
 TKalMatrix EXBPConeHit::XvToMv(const TVector3 &xv, Double_t /*t0*/) const
 {
-   const EXBPConeMeasLayer &ms
-                 = dynamic_cast<const EXBPConeMeasLayer &>(GetMeasLayer());
-   TKalMatrix h  = ms.XvToMv(xv);
-   TVector3 xxv  = xv - ms.GetXc();
-   Double_t tana = ms.GetTanA();
-   Double_t r    = xxv.Z() * tana;
-   Double_t rm   = ((*this)(1,0)-ms.GetXc().Z()) * tana;
-
-   Double_t phih = h(0,0) / r;
-   Double_t phim = (*this)(0,0) / rm;
-   Double_t dphi = phih - phim;
-
-   static const Double_t kPi    = TMath::Pi();
-   static const Double_t kTwoPi = 2 * kPi;
-
-   while (dphi < -kPi) dphi += kTwoPi;
-   while (dphi >  kPi) dphi -= kTwoPi;
-
-   h(0,0)  = r * (phim + dphi);
-   h(1,0) += 0.;
-
-   return h;
+   return GetMeasLayer().XvToMv(*this, xv);
 }
 
 void EXBPConeHit::DebugPrint(Option_t *) const
@@ -10,6 +10,7 @@
 //*     class EXBPConeMeasLayer
 //* (Update Recored)
 //*   2012/01/19  K.Fujii       Original version.
+//*   2026/10/18                Accept TKalHitView hits.
 //*
 //*************************************************************************
 //
@@ -20,9 +21,6 @@
 #include "TRandom.h"
 #include "TMath.h"
 
-#include "TVirtualPad.h"
-#include "TCONE.h"
-#include "TNode.h"
 #include "TString.h"
 
 #if 1
@@ -74,15 +72,30 @@ TKalMatrix EXBPConeMeasLayer::XvToMv(const TVector3 &xxv) const
    return mv;
 }
 
-TKalMatrix EXBPConeMeasLayer::XvToMv(const TVTrackHit &,
+TKalMatrix EXBPConeMeasLayer::XvToMv(const TVTrackHit &ht,
                                      const TVector3   &xv) const
 {
-   return XvToMv(xv);
+   // r*phi taken within pi of the hit
+
+   TKalMatrix h    = XvToMv(xv);
+   Double_t   r    = (xv.Z() - GetXc().Z()) * GetTanA();
+   Double_t   rm   = (ht(1,0) - GetXc().Z()) * GetTanA();
+   Double_t   phim = ht(0,0) / rm;
+   Double_t   dphi = h(0,0) / r - phim;
+
+   static const Double_t kPi    = TMath::Pi();
+   static const Double_t kTwoPi = 2 * kPi;
+
+   while (dphi < -kPi) dphi += kTwoPi;
+   while (dphi >  kPi) dphi -= kTwoPi;
+
+   h(0,0) = r * (phim + dphi);
+   return h;
 }
 
 TVector3 EXBPConeMeasLayer::HitToXv(const TVTrackHit &vht) const
 {
-   const EXBPConeHit &ht = dynamic_cast<const EXBPConeHit &>(vht);
+   const TVTrackHit &ht = vht;   // also a TKalHitView
 
    Double_t r   = ht(1,0) * GetTanA();
    Double_t phi = ht(0,0) / r;
@@ -172,27 +185,3 @@ void EXBPConeMeasLayer::ProcessHit(const TVector3  &xx,
    Double_t b = EXBPKalDetector::GetBfield();
    hits.Add(new EXBPConeHit(*this, meas, dmeas, xx, b));
 }
-
-// -----------------
-//  Draw
-// -----------------
-//    Drawing method for event display
-//
-void EXBPConeMeasLayer::Draw(Int_t color, const Char_t *opt)
-{
-   if (!gPad) return;
-   if (!IsActive()) return;
-   if (!GetNodePtr()) {
-      const Char_t *name  = GetMLName().Data();
-      const Char_t *nname = (GetMLName() + "Node").Data();
-      Double_t hlen = TMath::Abs(fZ2-fZ1)/2;
-      Double_t r1   = fZ2 > fZ1 ? fR1 : fR2;
-      Double_t r2   = fZ2 > fZ1 ? fR2 : fR1;
-      TCONE *conep = new TCONE(name, name, "void", hlen, r1, r1, r2, r2);
-      conep->SetBit(kCanDelete);
-      TNode *nodep = new TNode(nname,nname,name,0.,0.,(fZ1+fZ2)/2);
-      nodep->SetLineColor(color);
-      nodep->SetLineWidth(0.01);
-      SetNodePtr(nodep);
-   }
-}
@@ -12,6 +12,9 @@
 //*     class EXBPConeMeasLayer
 //* (Update Recored)
 //*   2012/01/19  K.Fujii       Original version.
+//*   2026/10/18                Draw() moved to EXHYBDisplay; added
+//*                             accessors to the end faces.
+//*   2026/10/18                Added GetShape().
 //*
 //*************************************************************************
 //
@@ -61,8 +64,14 @@ public:
    Double_t GetSigmaX() const { return fSigmaX; }
    Double_t GetSigmaZ() const { return fSigmaZ; }
 
-   using TAttDrawable::Draw;
-   virtual void Draw(Int_t color, const Char_t *opt);
+   Double_t GetFrontZ() const { return fZ1; }
+   Double_t GetFrontR() const { return fR1; }
+   Double_t GetBackZ () const { return fZ2; }
+   Double_t GetBackR () const { return fR2; }
+
+   // crossings as those of TCutCone, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kCutCone; }
 
 private:
    Double_t fZ1;      // z of front face
@@ -1,6 +1,5 @@
 #include "EXBPHit.h"
 #include "EXBPMeasLayer.h"
-#include "TMath.h"
 
 #include <iostream>
 #include <iomanip>
@@ -41,24 +40,7 @@ EXBPHit::~EXBPHit()
 
 TKalMatrix EXBPHit::XvToMv(const TVector3 &xv, Double_t /*t0*/) const
 {
-   const EXBPMeasLayer &ms
-                 = dynamic_cast<const EXBPMeasLayer &>(GetMeasLayer());
-   TKalMatrix h  = ms.XvToMv(xv);
-   Double_t r    = ms.GetR();
-   Double_t phih = h(0,0) / r;
-   Double_t phim = (*this)(0,0) / r;
-   Double_t dphi = phih - phim;
-
-   static Double_t kPi    = TMath::Pi();
-   static Double_t kTwoPi = 2 * kPi;
-
-   while (dphi < -kPi) dphi += kTwoPi;
-   while (dphi >  kPi) dphi -= kTwoPi;
-
-   h(0,0)  = r * (phim + dphi);
-   h(1,0) += 0.;
-
-   return h;
+   return GetMeasLayer().XvToMv(*this, xv);
 }
 
 void EXBPHit::DebugPrint(Option_t *) const
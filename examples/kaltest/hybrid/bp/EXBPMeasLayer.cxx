@@ -10,6 +10,7 @@
 //*     class EXBPMeasLayer
 //* (Update Recored)
 //*   2012/01/19  K.Fujii       Original version.
+//*   2026/10/18                Accept TKalHitView hits.
 //*
 //*************************************************************************
 //
@@ -20,9 +21,6 @@
 #include "TRandom.h"
 #include "TMath.h"
 
-#include "TVirtualPad.h"
-#include "TTUBE.h"
-#include "TNode.h"
 #include "TString.h"
 
 ClassImp(EXBPMeasLayer)
@@ -58,15 +56,29 @@ TKalMatrix EXBPMeasLayer::XvToMv(const TVector3 &xv) const
    return mv;
 }
 
-TKalMatrix EXBPMeasLayer::XvToMv(const TVTrackHit &,
+TKalMatrix EXBPMeasLayer::XvToMv(const TVTrackHit &ht,
                                const TVector3   &xv) const
 {
-   return XvToMv(xv);
+   // r*phi taken within pi of the hit
+
+   TKalMatrix h    = XvToMv(xv);
+   Double_t   r    = GetR();
+   Double_t   phim = ht(0,0) / r;
+   Double_t   dphi = h(0,0) / r - phim;
+
+   static const Double_t kPi    = TMath::Pi();
+   static const Double_t kTwoPi = 2 * kPi;
+
+   while (dphi < -kPi) dphi += kTwoPi;
+   while (dphi >  kPi) dphi -= kTwoPi;
+
+   h(0,0) = r * (phim + dphi);
+   return h;
 }
 
 TVector3 EXBPMeasLayer::HitToXv(const TVTrackHit &vht) const
 {
-   const EXBPHit &ht = dynamic_cast<const EXBPHit &>(vht);
+   const TVTrackHit &ht = vht;   // also a TKalHitView
 
    Double_t phi = ht(0,0) / GetR();
    Double_t z   = ht(1,0);
@@ -131,26 +143,3 @@ void EXBPMeasLayer::ProcessHit(const TVector3  &xx,
    Double_t b = EXBPKalDetector::GetBfield();
    hits.Add(new EXBPHit(*this, meas, dmeas, xx, b));
 }
-
-// -----------------
-//  Draw
-// -----------------
-//    Drawing method for event display
-//
-void EXBPMeasLayer::Draw(Int_t color, const Char_t *opt)
-{
-   if (!gPad) return;
-   if (!IsActive()) return;
-   if (!GetNodePtr()) {
-      const Char_t *name  = GetMLName().Data();
-      const Char_t *nname = (GetMLName() + "Node").Data();
-      Double_t r    = GetR();
-      Double_t hlen = GetZmax();
-      TTUBE *tubep = new TTUBE(name,name,"void",r,r,hlen);
-      tubep->SetBit(kCanDelete);
-      TNode *nodep = new TNode(nname,nname,name);
-      nodep->SetLineColor(color);
-      nodep->SetLineWidth(0.01);
-      SetNodePtr(nodep);
-   }
-}
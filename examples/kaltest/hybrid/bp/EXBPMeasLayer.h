@@ -12,6 +12,8 @@
 //*     class EXBPMeasLayer
 //* (Update Recored)
 //*   2012/01/19  K.Fujii       Original version.
+//*   2026/10/18                Draw() moved to EXHYBDisplay.
+//*   2026/10/18                Added GetShape().
 //*
 //*************************************************************************
 //
@@ -55,8 +57,9 @@ public:
    Double_t GetSigmaX() const { return fSigmaX; }
    Double_t GetSigmaZ() const { return fSigmaZ; }
 
-   using TAttDrawable::Draw;
-   virtual void Draw(Int_t color, const Char_t *opt);
+   // crossings as those of TCylinder, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kCylinder; }
 
 private:
    Double_t fSigmaX;  // sigma_x
@@ -0,0 +1,1362 @@
+//*************************************************************************
+//* ============
+//*  EXHYBCheck
+//* ============
+//*
+//* (Description)
+//*   Headless consistency checks on the hybrid toy detector
+//*   (BP+VTX+IT+TPC). Each check compares a fast or alternative code
+//*   path against a brute-force or reference one on tracks generated
+//*   with EXEventGen, prints one line per check and the program exits
+//*   with 1 if any of them fails.
+//*
+//*     hitstore : TKalHitStore::FindCompatibleHits() against a loop
+//*                over all hits of the layer that computes the chi2 of
+//*                each with the site's own H and V. Every hit within
+//*                nsigma must be returned; the surplus of the (phi, z)
+//*                or (u, v) window is reported.
+//*     helixfit : TKalTrack::FitToHelix() with the site loop on 4
+//*                threads against 1 thread, which must agree to the
+//*                last bit, and kGaussNewton against
+//*                kLevenbergMarquardt on the tracks a single helix
+//*                describes (chi2/ndf < 5), which must agree to 1e-5
+//*                in chi2 and to 0.05 of the errors.
+//*     band     : TKalBandMatrix::Solve() and GetInverse() on random
+//*                positive definite bordered band matrices against the
+//*                dense TKalMatrix inverse.
+//*     gbl      : TKalBrokenLines states and errors at every site
+//*                against those of the Kalman smoother, with multiple
+//*                scattering off and on (energy loss off). At most 1%
+//*                of the sites may differ by more than 0.1 of the errors
+//*                or by more than 5% in the errors: the two walk the
+//*                layers in opposite directions and may then cross
+//*                overlapping VTX ladders differently.
+//*     extrap   : TKalExtrapolator against TKalDetCradle::Transport()
+//*                from the first site of a track on its way out, low
+//*                pT loopers included, with the material off and on
+//*                (then in the TPC only, as the two walk overlapping
+//*                VTX ladders differently): to the crossing with the
+//*                layer of every later hit, as a point and, before any
+//*                turn, as a surface, and to a point half way to the
+//*                next hit on the adjacent layer as Transport() plus a
+//*                last step in the material of the layer. States and
+//*                covariance matrices must agree to 1e-5 of the errors.
+//*     twofilter: TKalTrack::FilterAndSmooth() against AddAndFilter()
+//*                and SmoothAll(), with the material off and on, on all
+//*                hits and on the 2-dim ones only. Smoothed states must
+//*                agree to 1e-6 of the errors and the errors to 0.1%;
+//*                with the backward filter on a second thread (2-dim
+//*                hits, material off) at most 1% of the sites may
+//*                differ by more than 0.1 of the errors or 5% in them.
+//*     seeder   : TKalTrackSeeder on all hits of a track against the
+//*                true helix at the seed pivot, with the material and
+//*                the TPC drift time offset off. The rms pulls of the 5
+//*                parameters must be within 0.8 and 1.25, and at most
+//*                1% of the seeds may have a pull beyond 5.
+//*     unbiased : TVKalSystem::CalcUnbiasedResiduals() against refits
+//*                without the hit of the site, for 4 sites of each of
+//*                a quarter of the tracks whose fit takes all hits,
+//*                with the material off and on. The hit is dropped by
+//*                scaling its V by 1e12. The residual of the hit to the
+//*                smoothed state of the refit may differ by more than
+//*                0.01 of the errors or 0.1% in them, with the material
+//*                0.05 and 1%, at 1% of the sites at most. Site 1, which
+//*                has the hit of the seed, is not refitted.
+//*     records  : TKalTrackWriter and TKalTrackReader round trip of the
+//*                smoothed states at all sites, in double and in float.
+//*                Every number read back must be the one written, to
+//*                1e-7 for floats, and a corrupt last block must stop
+//*                the reading there.
+//*     allocs   : heap allocations per fitted site of each fit stage,
+//*                counted by TKalStats while filtering and smoothing,
+//*                against a budget some 20% above the counts of today.
+//*                Run only when built with -D__KALSTATS_ALLOC__.
+//*     smoothed : TVKalSystem::GetSmoothedState() at the innermost and
+//*                the outermost hit and 3 random sites of each track,
+//*                in random order, every other one with its residual,
+//*                against SmoothAll(). States, covariance matrices and
+//*                residuals must be the same numbers, a second query
+//*                must return the same state, and no site below the
+//*                lowest one asked for may be smoothed, nor any other
+//*                residual.
+//*
+//*   Usage: EXHYBCheck [-n ntracks] [-s seed] [-t check1,check2,..]
+//*     -n  tracks per check (200)
+//*     -s  random seed (4357)
+//*     -t  checks to run (all)
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    helixfit check.
+//*   2026/10/18                    band and gbl checks.
+//*   2026/10/18                    extrap check.
+//*   2026/10/18                    twofilter check.
+//*   2026/10/18                    seeder check.
+//*   2026/10/18                    unbiased check.
+//*   2026/10/18                    records check.
+//*   2026/10/18                    allocs check.
+//*   2026/10/18                    smoothed check.
+//*************************************************************************
+//
+#include "TKalDetCradle.h"
+#include "TKalTrackState.h"
+#include "TKalTrackSite.h"
+#include "TKalTrackSeeder.h"
+#include "TKalHitStore.h"
+#include "TKalResidualArray.h"
+#include "TKalTrackWriter.h"
+#include "TKalTrackReader.h"
+#include "TKalBandMatrix.h"
+#include "TKalBrokenLines.h"
+#include "TKalExtrapolator.h"
+#include "TKalStats.h"
+#include "TVTrackHit.h"
+#include "TVMeasLayer.h"
+#include "TVSurface.h"
+#include "THelicalTrack.h"
+#include "EXTPCKalDetector.h"
+#include "EXTPCMeasLayer.h"
+#include "EXITKalDetector.h"
+#include "EXBPKalDetector.h"
+#include "EXVTXKalDetector.h"
+#include "EXEventGen.h"
+#include "EXHYBTrack.h"
+
+#include "TRandom.h"
+#include "TMath.h"
+#include "TString.h"
+#include "TVector2.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+   vector<string> ParseNames(const Char_t *s)
+   {
+      vector<string> v;
+      stringstream in(s);
+      string item;
+      while (getline(in, item, ',')) v.push_back(item);
+      return v;
+   }
+
+   // ---------------------------
+   //  Generate ntracks tracks
+   // ---------------------------
+   //  EXEventGen::Swim() may take the crossings of the inner plane
+   //  layers on the arm of the helix behind the IP (see EXHYBBench).
+   //  With outward set, such hits are dropped and tracks whose hits
+   //  do not then follow one another along the helix are not kept.
+
+   Bool_t KeepOutward(const THelicalTrack &hel, TObjArray &hits)
+   {
+      Double_t dfi = hel.GetRho() > 0. ? -1.e-3 : 1.e-3;
+      TVector3 x0  = hel.CalcXAt(0.);
+      TVector3 u0  = hel.CalcXAt(dfi) - x0;
+      for (Int_t i=0; i<hits.GetEntriesFast(); i++) {
+         TVTrackHit *hitp = static_cast<TVTrackHit *>(hits.At(i));
+         if ((hitp->GetMeasLayer().HitToXv(*hitp) - x0).Dot(u0) < 0.) {
+            delete hits.RemoveAt(i);
+         }
+      }
+      hits.Compress();
+
+      TVector3 xlast, dlast;
+      for (Int_t i=0; i<hits.GetEntries(); i++) {
+         const TVTrackHit &ht = *static_cast<TVTrackHit *>(hits.At(i));
+         TVector3 x = ht.GetMeasLayer().HitToXv(ht);
+         if (i) {
+            TVector3 d = x - xlast;
+            if (i > 1 && d.Dot(dlast) < 0.) return kFALSE;
+            dlast = d;
+         }
+         xlast = x;
+      }
+      return kTRUE;
+   }
+
+   void Generate(TKalDetCradle        &det,
+                 Int_t                 ntracks,
+                 Double_t              ptmin,
+                 Double_t              ptmax,
+                 vector<TObjArray *>  &tracks,
+                 Bool_t                outward = kFALSE)
+   {
+      while ((Int_t)tracks.size() < ntracks) {
+         TObjArray *hitsp = new TObjArray;
+         hitsp->SetOwner();
+         EXEventGen gen(det, *hitsp);
+         Double_t pt = gRandom->Uniform(ptmin, ptmax);
+         THelicalTrack hel = gen.GenerateHelix(pt, -0.9, 0.9);
+         THelicalTrack hel0(hel);
+         gen.Swim(hel);
+         if (outward && !KeepOutward(hel0, *hitsp)) {
+            delete hitsp;
+            continue;
+         }
+         tracks.push_back(hitsp);
+      }
+   }
+
+   // ---------------------------
+   //  Filter from outside in
+   // ---------------------------
+
+   Bool_t Filter(TObjArray &kalhits, TKalTrackSeeder &seeder, EXHYBTrack &kaltrack)
+   {
+      if (kalhits.GetEntries() < 3) return kFALSE;
+
+      TObjArray seedhits;
+      TIter     nextseed(&kalhits, kIterBackward);
+      TObject  *objp;
+      while ((objp = nextseed())) seedhits.Add(objp);
+      if (!seeder.Fit(seedhits, kIterBackward)) return kFALSE;
+
+      // the seed site sits on the outermost hit; it is never filtered
+
+      TKalTrackSite &sited = *new TKalTrackSite(*static_cast<TVTrackHit *>(kalhits.Last()));
+      seeder.InitSite(sited);
+
+      kaltrack.SetOwner();
+      kaltrack.Add(&sited);
+
+      TIter next(&kalhits, kIterBackward);
+      TVTrackHit *hitp;
+      while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+         TKalTrackSite &site = *new TKalTrackSite(*hitp);
+         if (!kaltrack.AddAndFilter(site)) delete &site;
+      }
+      return kaltrack.GetEntries() >= 4;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  hitstore
+   //  -----------------------------------
+   //
+   Int_t CheckHitStore(TKalDetCradle &det, Int_t ntracks)
+   {
+      // Tracks are piled up in events of 50 so that the windows see
+      // more than the track's own hit.
+
+      const Int_t    nperev = 50;
+      const Double_t nsigma = 4.;
+
+      Int_t nqueries = 0, nbrute = 0, nfound = 0, nlost = 0, nown = 0;
+
+      TKalTrackSeeder seeder;
+      seeder.SetCovScale(1.e2);
+      TKalHitStore    store;
+      for (Int_t i0=0; i0<ntracks; i0+=nperev) {
+         vector<TObjArray *> tracks;
+         Generate(det, TMath::Min(nperev, ntracks - i0), 0.5, 5., tracks);
+
+         vector<const TVTrackHit *> allhits;
+         store.Clear();
+         for (UInt_t t=0; t<tracks.size(); t++) {
+            store.Add(*tracks[t]);
+            TIter next(tracks[t]);
+            TObject *objp;
+            while ((objp = next())) allhits.push_back(static_cast<TVTrackHit *>(objp));
+         }
+         store.Build();
+
+         for (UInt_t t=0; t<tracks.size(); t++) {
+            EXHYBTrack kaltrack;
+            if (!Filter(*tracks[t], seeder, kaltrack)) continue;
+
+            for (Int_t k=1; k<kaltrack.GetEntries(); k++) {
+               TKalTrackSite        &site = *static_cast<TKalTrackSite *>(kaltrack.At(k));
+               const TKalTrackState &a    = static_cast<const TKalTrackState &>
+                                               (site.GetState(TVKalSite::kPredicted));
+               const TVMeasLayer    &ml   = site.GetHit().GetMeasLayer();
+               const TKalMatrix     &C    = a.GetCovMat();
+
+               vector<const TVTrackHit *> found;
+               store.FindCompatibleHits(a, ml, nsigma, found);
+               sort(found.begin(), found.end());
+               nqueries++;
+               nfound += found.size();
+
+               // brute force: the predicted chi2 of every hit on the layer
+
+               for (UInt_t h=0; h<allhits.size(); h++) {
+                  const TVTrackHit &ht = *allhits[h];
+                  if (ht.GetMeasLayer().GetIndex() != ml.GetIndex()) continue;
+                  TKalTrackSite cand(ht);
+                  TKalMatrix hv(ht.GetDimension(), 1);
+                  TKalMatrix H (ht.GetDimension(), a.GetNrows());
+                  if (!cand.CalcExpectedMeasVec  (a, hv)) continue;
+                  if (!cand.CalcMeasVecDerivative(a, H )) continue;
+                  TKalMatrix r  = cand.GetMeasVec() - hv;
+                  TKalMatrix rt(TKalMatrix::kTransposed, r);
+                  TKalMatrix Ht(TKalMatrix::kTransposed, H);
+                  TKalMatrix R  = cand.GetMeasNoiseMat() + H * C * Ht;
+                  TKalMatrix Rinv(TKalMatrix::kInverted, R);
+                  Double_t chi2 = (rt * Rinv * r)(0,0);
+                  if (chi2 > nsigma * nsigma) continue;
+                  nbrute++;
+                  if (&ht == &site.GetHit()) nown++;
+                  if (!binary_search(found.begin(), found.end(), &ht)) {
+                     nlost++;
+                     printf("  lost hit on layer %d: chi2 %.2f\n", ml.GetIndex(), chi2);
+                  }
+               }
+            }
+         }
+         for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+      }
+
+      printf("hitstore       : %d queries, %d hits within %.0f sigma, %d returned"
+             " (%.2f per query), %d lost, %d own hits\n",
+             nqueries, nbrute, nsigma, nfound,
+             nqueries ? Double_t(nfound) / nqueries : 0., nlost, nown);
+      return nlost || !nqueries ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  helixfit
+   //  -----------------------------------
+   //
+   Int_t CheckHelixFit(TKalDetCradle &det, Int_t ntracks)
+   {
+      const Int_t nthreads = 4;
+
+      Int_t    nfits = 0, ngood = 0, nthrdiff = 0, ngndiff = 0;
+      Double_t maxdchi2 = 0., maxpull = 0.;
+
+      vector<TObjArray *> tracks;
+      Generate(det, ntracks, 2., 10., tracks);
+
+      TKalTrackSeeder seeder;
+      seeder.SetCovScale(1.e2);
+      Int_t nthreads0 = TKalTrack::GetNThreads();
+      for (UInt_t t=0; t<tracks.size(); t++) {
+         TObjArray &kalhits = *tracks[t];
+         if (kalhits.GetEntries() < 3) continue;
+         TObjArray seedhits;
+         TIter     nextseed(&kalhits, kIterBackward);
+         TObject  *objp;
+         while ((objp = nextseed())) seedhits.Add(objp);
+         if (!seeder.Fit(seedhits, kIterBackward)) continue;
+
+         // all hits to one helix from the seed; the seed site is locked
+
+         EXHYBTrack kaltrack;
+         kaltrack.SetOwner();
+         TKalTrackSite &sited = *new TKalTrackSite(*static_cast<TVTrackHit *>(kalhits.Last()));
+         seeder.InitSite(sited);
+         sited.Lock();
+         kaltrack.Add(&sited);
+         TIter next(&kalhits);
+         TVTrackHit *hitp;
+         while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+            kaltrack.Add(new TKalTrackSite(*hitp));
+         }
+
+         const TKalTrackState &a0 = static_cast<const TKalTrackState &>(sited.GetCurState());
+         TKalTrackState a[3] = { a0, a0, a0 };
+         TKalMatrix     C[3];
+         Int_t          ndf[3];
+         Double_t       chi2[3];
+         for (Int_t i=0; i<3; i++) C[i].ResizeTo(a0.GetNrows(), a0.GetNrows());
+
+         TKalTrack::SetNThreads(1);
+         chi2[0] = kaltrack.FitToHelix(a[0], C[0], ndf[0], TKalTrack::kLevenbergMarquardt);
+         TKalTrack::SetNThreads(nthreads);
+         chi2[1] = kaltrack.FitToHelix(a[1], C[1], ndf[1], TKalTrack::kLevenbergMarquardt);
+         TKalTrack::SetNThreads(1);
+         chi2[2] = kaltrack.FitToHelix(a[2], C[2], ndf[2], TKalTrack::kGaussNewton);
+         nfits++;
+
+         Bool_t same = chi2[1] == chi2[0] && ndf[1] == ndf[0];
+         for (Int_t i=0; i<a0.GetNrows(); i++) {
+            same = same && a[1](i,0) == a[0](i,0);
+            for (Int_t j=0; j<a0.GetNrows(); j++) same = same && C[1](i,j) == C[0](i,j);
+         }
+         if (!same) nthrdiff++;
+
+         // Gauss-Newton against Levenberg-Marquardt where a single helix
+         // describes the hits. Both stop where a site's crossing appears
+         // or disappears along the step, so they are only required to
+         // agree to 1e-5 in chi2 and 0.05 of the errors.
+
+         if (ndf[0] <= 0 || chi2[0] > 5. * ndf[0]) continue;
+         ngood++;
+         Double_t dchi2 = TMath::Abs(chi2[2] - chi2[0]) / chi2[0];
+         Double_t pull  = 0.;
+         for (Int_t i=0; i<a0.GetNrows(); i++) {
+            pull = TMath::Max(pull, TMath::Abs(a[2](i,0) - a[0](i,0)) / TMath::Sqrt(C[0](i,i)));
+         }
+         maxdchi2 = TMath::Max(maxdchi2, dchi2);
+         maxpull  = TMath::Max(maxpull,  pull);
+         if (dchi2 > 1.e-5 || pull > 0.05 || ndf[2] != ndf[0]) ngndiff++;
+      }
+      TKalTrack::SetNThreads(nthreads0);
+      for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+
+      printf("helixfit       : %d fits, %d differ on %d threads; %d with chi2/ndf < 5,"
+             " %d differ with Gauss-Newton (max. dchi2/chi2 %.1e, max. |da|/sigma %.1e)\n",
+             nfits, nthrdiff, nthreads, ngood, ngndiff, maxdchi2, maxpull);
+      return nthrdiff || ngndiff || !ngood ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  band
+   //  -----------------------------------
+   //
+   Int_t CheckBand(Int_t ntrials)
+   {
+      Int_t    nbad = 0;
+      Double_t maxdx = 0., maxdinv = 0.;
+      for (Int_t t=0; t<ntrials; t++) {
+         Int_t n  = 1 + gRandom->Integer(60);
+         Int_t w  = gRandom->Integer(5);
+         Int_t nb = gRandom->Integer(3);
+         Int_t nn = n + nb;
+
+         // random symmetric matrix, made positive definite by its diagonal
+
+         TKalBandMatrix A(n, w, nb);
+         TKalMatrix     Ad(nn, nn);
+         for (Int_t i=0; i<nn; i++) {
+            for (Int_t j=0; j<i; j++) {
+               if (i < n && i - j > w) continue;
+               Double_t v = gRandom->Uniform(-1., 1.);
+               Ad(i,j) = Ad(j,i) = v;
+            }
+         }
+         for (Int_t i=0; i<nn; i++) {
+            Double_t sum = 0.;
+            for (Int_t j=0; j<nn; j++) if (j != i) sum += TMath::Abs(Ad(i,j));
+            Ad(i,i) = sum + gRandom->Uniform(0.1, 2.);
+         }
+         for (Int_t i=0; i<nn; i++) {
+            for (Int_t j=0; j<=i; j++) if (Ad(i,j) != 0.) A.AddAt(i, j, Ad(i,j));
+         }
+
+         TKalMatrix Adinv(TKalMatrix::kInverted, Ad);
+         if (!A.Decompose()) {
+            nbad++;
+            continue;
+         }
+
+         vector<Double_t> b(nn), x(nn);
+         for (Int_t i=0; i<nn; i++) b[i] = gRandom->Gaus();
+         A.Solve(&b[0], &x[0]);
+         A.Invert();
+
+         Double_t scale = 0.;
+         for (Int_t i=0; i<nn; i++) {
+            for (Int_t j=0; j<nn; j++) scale = TMath::Max(scale, TMath::Abs(Adinv(i,j)));
+         }
+         Double_t dx = 0., dinv = 0.;
+         for (Int_t i=0; i<nn; i++) {
+            Double_t xd = 0.;
+            for (Int_t j=0; j<nn; j++) xd += Adinv(i,j) * b[j];
+            dx = TMath::Max(dx, TMath::Abs(x[i] - xd) / scale);
+            for (Int_t j=0; j<=i; j++) {
+               if (i < n && i - j > w) continue;
+               dinv = TMath::Max(dinv, TMath::Abs(A.GetInverse(i,j) - Adinv(i,j)) / scale);
+               dinv = TMath::Max(dinv, TMath::Abs(A.GetInverse(j,i) - Adinv(i,j)) / scale);
+            }
+         }
+         maxdx   = TMath::Max(maxdx,   dx);
+         maxdinv = TMath::Max(maxdinv, dinv);
+         if (dx > 1.e-10 || dinv > 1.e-10) nbad++;
+      }
+
+      printf("band           : %d matrices, %d differ from the dense inverse"
+             " (max. |dx| %.1e, max. |dinv| %.1e relative to max. |inv|)\n",
+             ntrials, nbad, maxdx, maxdinv);
+      return nbad ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  gbl
+   //  -----------------------------------
+   //
+   Int_t CheckBrokenLines(TKalDetCradle &det, Int_t ntracks)
+   {
+      // The seed is weakened to a negligible constraint, so that both
+      // fits see the hits only.
+
+      const Double_t kCovScale = 1.e6;
+
+      Int_t nfailed = 0;
+      det.SwitchOffDEDX();
+      for (Int_t ms=0; ms<2; ms++) {
+         if (ms) det.SwitchOnMS();
+         else    det.SwitchOffMS();
+
+         vector<TObjArray *> tracks;
+         Generate(det, ntracks, 2., 10., tracks, kTRUE);
+
+         TKalTrackSeeder seeder;
+         seeder.SetCovScale(kCovScale);
+         Int_t    nfits = 0, nsites = 0, nbad = 0;
+         Double_t maxpull = 0., maxratio = 0., sumchi2 = 0.;
+         for (UInt_t t=0; t<tracks.size(); t++) {
+            EXHYBTrack kaltrack;
+            if (!Filter(*tracks[t], seeder, kaltrack)) continue;
+            kaltrack.SmoothBackTo(1);
+            static_cast<TKalTrackSite *>(kaltrack.First())->Lock();
+
+            TKalBrokenLines gbl;
+            gbl.SetMaxIter(2);
+            if (!gbl.Fit(kaltrack)) continue;
+            nfits++;
+            sumchi2 += gbl.GetChi2() / kaltrack.GetChi2();
+
+            // Smoothed state moved to the pivot of the broken lines state
+
+            for (Int_t i=0; i<gbl.GetNsites(); i++) {
+               TKalMatrix sv, C;
+               if (!gbl.GetState(i, sv, C)) continue;
+               TKalTrackSite  &site = gbl.GetSite(i);
+               TKalTrackState &a    = static_cast<TKalTrackState &>
+                                         (site.GetState(TVKalSite::kSmoothed));
+               if (!&a) continue;
+               std::unique_ptr<TVTrack> hel(&a.CreateTrack());
+               TKalMatrix Cs(a.GetCovMat());
+               Double_t   fid = 0.;
+               hel->MoveTo(gbl.GetPivot(i), fid, Cs);
+               TKalMatrix as(a.GetNrows(), 1);
+               hel->PutInto(as);
+               Double_t pull = 0., ratio = 0.;
+               for (Int_t k=0; k<5; k++) {
+                  Double_t d = sv(k,0) - as(k,0);
+                  if (k == 1) d = TVector2::Phi_mpi_pi(d);
+                  pull  = TMath::Max(pull,  TMath::Abs(d) / TMath::Sqrt(Cs(k,k)));
+                  ratio = TMath::Max(ratio, TMath::Abs(TMath::Sqrt(C(k,k) / Cs(k,k)) - 1.));
+               }
+               maxpull  = TMath::Max(maxpull,  pull);
+               maxratio = TMath::Max(maxratio, ratio);
+               if (pull > 0.1 || ratio > 0.05) nbad++;
+               nsites++;
+            }
+         }
+         for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+
+         Bool_t failed = !nfits || nbad > 0.01 * nsites;
+         printf("gbl (MS %-3s)   : %d fits, %d sites, chi2 GBL/Kalman %.4f,"
+                " max. |da|/sigma %.1e, max. |sigma ratio - 1| %.1e,"
+                " %d sites beyond 0.1 sigma or 5%%\n",
+                ms ? "on" : "off", nfits, nsites, nfits ? sumchi2 / nfits : 0.,
+                maxpull, maxratio, nbad);
+         if (failed) nfailed++;
+      }
+      det.SwitchOnMS();
+      det.SwitchOnDEDX();
+      return nfailed ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  extrap
+   //  -----------------------------------
+   //
+   //  Largest difference of the extrapolated state and covariance
+   //  matrix, moved to the pivot x0, from sv and C, in units of the
+   //  errors
+
+   Double_t Deviation(const TKalExtrapolator &ext,
+                      const TVector3         &x0,
+                            Double_t          b,
+                      const TKalMatrix       &sv,
+                      const TKalMatrix       &C)
+   {
+      TKalMatrix    sve(ext.GetStateVec());
+      TKalMatrix    Ce (ext.GetCovMat());
+      TKalMatrix    F  (sve.GetNrows(), sve.GetNrows());
+      THelicalTrack hel(sve, ext.GetPivot(), b);
+      Double_t      fid = 0.;
+      hel.MoveTo(x0, fid, &F, &Ce);
+      hel.PutInto(sve);
+
+      Double_t dev = 0.;
+      for (Int_t i=0; i<sv.GetNrows(); i++) {
+         if (C(i,i) <= 0.) continue;
+         Double_t d = sve(i,0) - sv(i,0);
+         if (i == 1) d = TVector2::Phi_mpi_pi(d);
+         dev = TMath::Max(dev, TMath::Abs(d) / TMath::Sqrt(C(i,i)));
+         for (Int_t j=0; j<sv.GetNrows(); j++) {
+            if (C(j,j) <= 0.) continue;
+            dev = TMath::Max(dev, TMath::Abs(Ce(i,j) - C(i,j)) / TMath::Sqrt(C(i,i) * C(j,j)));
+         }
+      }
+      return dev;
+   }
+
+   Bool_t IsTPC(const TKalTrackSite &site)
+   {
+      return dynamic_cast<const EXTPCMeasLayer *>(&site.GetHit().GetMeasLayer()) != 0;
+   }
+
+   // A hit EXEventGen takes on the arm of the helix behind the IP (see
+   // Generate()) is on the way in: the track passes by the z axis, and
+   // Transport() may then step more than half a turn at once.
+
+   Bool_t IsOutgoing(const TKalTrackSite &site)
+   {
+      const TKalTrackState &a = static_cast<const TKalTrackState &>(site.GetCurState());
+      std::unique_ptr<TVTrack> hel(&a.CreateTrack());
+      const THelicalTrack *hp = dynamic_cast<const THelicalTrack *>(hel.get());
+      Double_t phiturn = 0.;
+      Int_t    type    = 0;
+      return hp && hp->CalcTurningPoint(-hp->GetRho(), phiturn, type) && type > 0;
+   }
+
+   Int_t CheckExtrapolator(TKalDetCradle &det, Int_t ntracks)
+   {
+      const Double_t kMaxDev  = 1.e-5;
+      const Double_t kMaxDist = 1.e-4;   // [cm]
+
+      Int_t nfailed = 0;
+      for (Int_t mat=0; mat<2; mat++) {
+         if (mat) { det.SwitchOnMS();  det.SwitchOnDEDX();  }
+         else     { det.SwitchOffMS(); det.SwitchOffDEDX(); }
+
+         vector<TObjArray *> tracks;
+         Generate(det, ntracks, 0.2, 2., tracks);
+
+         TKalTrackSeeder seeder;
+         seeder.SetCovScale(1.e2);
+         Int_t    ntrks = 0, npoints = 0, nloopers = 0, nsurfs = 0, nmids = 0, nbad = 0;
+         Double_t maxdev = 0.;
+         for (UInt_t t=0; t<tracks.size(); t++) {
+            EXHYBTrack kaltrack;
+            if (!Filter(*tracks[t], seeder, kaltrack)) continue;
+
+            // from the first hit along the track that is on its way out
+            // to all the others. With the material on, the TPC only: the
+            // VTX ladders overlap and Transport() walks them in index
+            // order up to the ladder of the hit, whereas the extrapolator
+            // steps on every ladder the track crosses before the target.
+
+            Int_t kfr = kaltrack.GetEntries() - 1;
+            for (; kfr > 1; kfr--) {
+               const TKalTrackSite &site = *static_cast<TKalTrackSite *>(kaltrack.At(kfr));
+               if (IsOutgoing(site) && (!mat || IsTPC(site))) break;
+            }
+            if (kfr < 2) continue;
+            ntrks++;
+            const TKalTrackSite  &from = *static_cast<TKalTrackSite *>(kaltrack.At(kfr));
+            const TKalTrackState &a    = static_cast<const TKalTrackState &>(from.GetCurState());
+            Int_t    sdim = a.GetNrows();
+            Double_t b    = from.GetBfield();
+            std::unique_ptr<TVTrack> hel0(&a.CreateTrack());
+            const THelicalTrack *h0p = dynamic_cast<const THelicalTrack *>(hel0.get());
+            TKalExtrapolator ext(&det, sdim);
+
+            for (Int_t k=kfr-1; k>=1; k--) {
+               const TKalTrackSite &site = *static_cast<TKalTrackSite *>(kaltrack.At(k));
+               if (mat && !IsTPC(site)) continue;
+               const TVTrackHit  &ht = site.GetHit();
+               const TVMeasLayer &ml = ht.GetMeasLayer();
+               TVector3 xhit = ml.HitToXv(ht);
+
+               std::unique_ptr<TVTrack> help(&a.CreateTrack());
+               TVector3   x0;
+               TKalMatrix sv(sdim,1), F(sdim,sdim), Q(sdim,sdim);
+               det.Transport(from, ml, x0, sv, F, Q, help, &xhit);
+               const TVSurface &ms = dynamic_cast<const TVSurface &>(ml);
+               if (!ms.IsOnSurface(x0)) continue;     // not reached
+               TKalMatrix Ft(TKalMatrix::kTransposed, F);
+               TKalMatrix C = F * a.GetCovMat() * Ft + Q;
+
+               // to the crossing as a point, and as a surface if the track
+               // does not turn on the way; hits behind the first site are
+               // no targets
+
+               THelicalTrack hx(*h0p);
+               Double_t fix = 0., phiturn = 0.;
+               Int_t    type = 0;
+               hx.MoveTo(x0, fix);
+               fix += TMath::TwoPi() * TMath::Nint((x0.Z() - h0p->CalcXAt(fix).Z())
+                                       / (-h0p->GetRho() * h0p->GetTanLambda() * TMath::TwoPi()));
+               if (fix * h0p->GetRho() >= 0.) continue;
+               Bool_t turn = h0p->CalcTurningPoint(fix, phiturn, type)
+                          && TMath::Abs(phiturn) < TMath::Abs(fix);
+               if (turn && type > 0) nloopers++;
+
+               for (Int_t s=0; s<2; s++) {
+                  if (s && turn) continue;
+                  if (s) ext.SetTarget(ms, +1);
+                  else   ext.SetTarget(x0);
+                  Double_t dev = ext.Extrapolate(a)
+                               && (ext.GetPivot() - x0).Mag() < kMaxDist
+                               ? Deviation(ext, x0, b, sv, C) : 1.;
+                  maxdev = TMath::Max(maxdev, dev);
+                  if (dev > kMaxDev) nbad++;
+                  if (s) nsurfs++;
+                  else   npoints++;
+               }
+
+               // half way to the hit of the next site, if it is on the
+               // adjacent layer and the track does not turn on the way
+
+               if (k == 1) continue;
+               const TKalTrackSite &next = *static_cast<TKalTrackSite *>(kaltrack.At(k-1));
+               const TVTrackHit    &hn   = next.GetHit();
+               if (mat && !IsTPC(next)) continue;
+               if (TMath::Abs(hn.GetMeasLayer().GetIndex() - ml.GetIndex()) != 1) continue;
+               THelicalTrack &hel = dynamic_cast<THelicalTrack &>(*help);
+               THelicalTrack  hc(hel);
+               Double_t fnext = 0.;
+               hc.MoveTo(hn.GetMeasLayer().HitToXv(hn), fnext);
+               Double_t fmid = fnext / 2.;
+               if (fmid * hel.GetRho() >= 0.) continue;
+               if (hel.CalcTurningPoint(fmid, phiturn, type)
+                && TMath::Abs(phiturn) < TMath::Abs(fmid)) continue;
+
+               TVector3 xmid  = hel.CalcXAt(fmid);
+               Bool_t   isout = xmid.Perp() > x0.Perp();
+               if (det.IsMSOn()) {
+                  TKalMatrix Qms(sdim,sdim);
+                  ml.CalcQms(isout, hel, fmid, Qms);
+                  C += Qms;
+               }
+               Double_t fid = fmid;
+               hel.PropagateTo(xmid, fid, F, &C);
+               hel.PutInto(sv);
+               if (det.IsDEDXOn()) sv(2,0) += ml.GetEnergyLoss(isout, hel, fid);
+
+               ext.SetTarget(xmid);
+               Double_t dev = ext.Extrapolate(a)
+                            && (ext.GetPivot() - xmid).Mag() < kMaxDist
+                            ? Deviation(ext, xmid, b, sv, C) : 1.;
+               maxdev = TMath::Max(maxdev, dev);
+               if (dev > kMaxDev) nbad++;
+               nmids++;
+            }
+         }
+         for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+
+         printf("extrap (mat %-3s): %d tracks, %d points (%d after a turn), %d surfaces,"
+                " %d half way, max. deviation %.1e sigma, %d beyond %.0e\n",
+                mat ? "on" : "off", ntrks, npoints, nloopers, nsurfs, nmids,
+                maxdev, nbad, kMaxDev);
+         if (!ntrks || !nloopers || nbad) nfailed++;
+      }
+      det.SwitchOnMS();
+      det.SwitchOnDEDX();
+      return nfailed ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  twofilter
+   //  -----------------------------------
+   //
+   Int_t CheckTwoFilter(TKalDetCradle &det, Int_t ntracks)
+   {
+      const Double_t kMaxPull  = 1.e-6;    // after the forward filter
+      const Double_t kMaxRatio = 1.e-3;
+      const Double_t kMaxPullT = 0.1;      // on a second thread
+      const Double_t kMaxRatioT = 0.05;
+
+      Int_t nfailed = 0;
+      for (Int_t mat=0; mat<2; mat++) {
+         if (mat) { det.SwitchOnMS();  det.SwitchOnDEDX();  }
+         else     { det.SwitchOffMS(); det.SwitchOffDEDX(); }
+
+         vector<TObjArray *> tracks;
+         Generate(det, ntracks, 0.5, 5., tracks, kTRUE);
+
+         TKalTrackSeeder seeder;
+         seeder.SetCovScale(1.e2);
+         Int_t    nfits[2]    = { 0, 0 }, nsites[2] = { 0, 0 }, nbad[2] = { 0, 0 };
+         Double_t maxpull[2]  = { 0., 0. };
+         Double_t maxratio[2] = { 0., 0. };
+         for (UInt_t t=0; t<tracks.size(); t++) {
+            TObjArray &kalhits = *tracks[t];
+            if (kalhits.GetEntries() < 4) continue;
+            TObjArray seedhits;
+            TIter     nextseed(&kalhits, kIterBackward);
+            TObject  *objp;
+            while ((objp = nextseed())) seedhits.Add(objp);
+            if (!seeder.Fit(seedhits, kIterBackward)) continue;
+
+            // all hits, and the 2-dim ones only, which FilterAndSmooth()
+            // filters backwards on a second thread if the material is off
+
+            for (Int_t twod=0; twod<2; twod++) {
+               Int_t thr = twod && !mat;
+               EXHYBTrack ref, two;
+               ref.SetOwner();
+               two.SetOwner();
+               TObjArray sites;
+               sites.SetOwner();
+               const TVTrackHit &seedht = *static_cast<TVTrackHit *>(kalhits.Last());
+               for (Int_t k=0; k<2; k++) {
+                  TKalTrackSite &sited = *new TKalTrackSite(seedht);
+                  seeder.InitSite(sited);
+                  (k ? two : ref).Add(&sited);
+               }
+               TIter next(&kalhits, kIterBackward);
+               TVTrackHit *hitp;
+               while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+                  if (twod && hitp->GetDimension() < 2) continue;
+                  TKalTrackSite &site = *new TKalTrackSite(*hitp);
+                  if (!ref.AddAndFilter(site)) delete &site;
+                  sites.Add(new TKalTrackSite(*hitp));
+               }
+               ref.SmoothAll();
+               two.FilterAndSmooth(sites);
+               if (ref.GetEntries() < 4 || two.GetEntries() != ref.GetEntries()) continue;
+               nfits[thr]++;
+
+               for (Int_t i=1; i<ref.GetEntries(); i++) {
+                  TVKalState &as = static_cast<TVKalSite *>(ref.At(i))->GetState(TVKalSite::kSmoothed);
+                  TVKalState &at = static_cast<TVKalSite *>(two.At(i))->GetState(TVKalSite::kSmoothed);
+                  nsites[thr]++;
+                  if (!&as || !&at) {
+                     nbad[thr]++;
+                     continue;
+                  }
+                  const TKalMatrix &Cs = as.GetCovMat();
+                  const TKalMatrix &Ct = at.GetCovMat();
+                  Double_t pull = 0., ratio = 0.;
+                  for (Int_t k=0; k<5; k++) {
+                     Double_t d = at(k,0) - as(k,0);
+                     if (k == 1) d = TVector2::Phi_mpi_pi(d);
+                     pull  = TMath::Max(pull,  TMath::Abs(d) / TMath::Sqrt(Cs(k,k)));
+                     ratio = TMath::Max(ratio, TMath::Abs(TMath::Sqrt(Ct(k,k) / Cs(k,k)) - 1.));
+                  }
+                  maxpull [thr] = TMath::Max(maxpull [thr], pull);
+                  maxratio[thr] = TMath::Max(maxratio[thr], ratio);
+                  if (pull > (thr ? kMaxPullT : kMaxPull) || ratio > (thr ? kMaxRatioT : kMaxRatio)) {
+                     nbad[thr]++;
+                  }
+               }
+            }
+         }
+         for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+
+         printf("twofilter (mat %-3s): %d fits, %d sites, max. |da|/sigma %.1e,"
+                " max. |sigma ratio - 1| %.1e, %d beyond %.0e or %.0e",
+                mat ? "on" : "off", nfits[0], nsites[0], maxpull[0], maxratio[0],
+                nbad[0], kMaxPull, kMaxRatio);
+         if (!mat) {
+            printf("; on a second thread %d fits, %d sites, max. |da|/sigma %.1e,"
+                   " max. |sigma ratio - 1| %.1e, %d beyond %.1f sigma or %.0f%%",
+                   nfits[1], nsites[1], maxpull[1], maxratio[1],
+                   nbad[1], kMaxPullT, 100. * kMaxRatioT);
+         }
+         printf("\n");
+         if (!nfits[0] || nbad[0])                          nfailed++;
+         if (!mat && (!nfits[1] || nbad[1] > 0.01 * nsites[1])) nfailed++;
+      }
+      det.SwitchOnMS();
+      det.SwitchOnDEDX();
+      return nfailed ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  seeder
+   //  -----------------------------------
+   //
+   Int_t CheckSeeder(TKalDetCradle &det, Int_t ntracks)
+   {
+      const Double_t kMaxPull = 5.;
+      const Double_t kMinRms  = 0.8;
+      const Double_t kMaxRms  = 1.25;
+
+      // no material and no TPC drift time offset, which the seed does
+      // not fit, so that the true helix is that of all the hits
+
+      det.SwitchOffMS();
+      det.SwitchOffDEDX();
+      Double_t t0 = EXEventGen::GetT0();
+      EXEventGen::SetT0(0.);
+
+      TKalTrackSeeder seeder;
+      Int_t    nfits = 0, nbeyond = 0;
+      Double_t sum2[5] = { 0., 0., 0., 0., 0. };
+      Double_t maxpull = 0.;
+      for (Int_t t=0; t<ntracks; t++) {
+         TObjArray hits;
+         hits.SetOwner();
+         EXEventGen gen(det, hits);
+         THelicalTrack hel = gen.GenerateHelix(gRandom->Uniform(0.5, 5.), -0.9, 0.9);
+         gen.Swim(hel);
+         if (hits.GetEntries() < 4 || !seeder.Fit(hits, kIterForward)) continue;
+         nfits++;
+
+         const TKalMatrix &sv = seeder.GetStateVec();
+         const TKalMatrix &C  = seeder.GetCovMat();
+         THelicalTrack truth(gen.GetFirstHitHelix());
+         Double_t fid = 0.;
+         truth.MoveTo(seeder.GetPivot(), fid);
+         Double_t a[5] = { truth.GetDrho(), truth.GetPhi0(), truth.GetKappa(),
+                           truth.GetDz(),   truth.GetTanLambda() };
+         Double_t pull = 0.;
+         for (Int_t i=0; i<5; i++) {
+            Double_t d = sv(i,0) - a[i];
+            if (i == 1) d = TVector2::Phi_mpi_pi(d);
+            Double_t p = d / TMath::Sqrt(C(i,i));
+            sum2[i] += p * p;
+            pull     = TMath::Max(pull, TMath::Abs(p));
+         }
+         maxpull = TMath::Max(maxpull, pull);
+         if (pull > kMaxPull) nbeyond++;
+      }
+
+      Double_t rms[5];
+      Int_t    nrms = 0;
+      for (Int_t i=0; i<5; i++) {
+         rms[i] = nfits ? TMath::Sqrt(sum2[i] / nfits) : 0.;
+         if (rms[i] < kMinRms || rms[i] > kMaxRms) nrms++;
+      }
+      printf("seeder         : %d fits, rms pulls of the 5 parameters"
+             " %.2f %.2f %.2f %.2f %.2f, max. |pull| %.1f, %d beyond %.0f\n",
+             nfits, rms[0], rms[1], rms[2], rms[3], rms[4], maxpull,
+             nbeyond, kMaxPull);
+      EXEventGen::SetT0(t0);
+      det.SwitchOnMS();
+      det.SwitchOnDEDX();
+      return !nfits || nrms || nbeyond > 0.01 * nfits ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  unbiased
+   //  -----------------------------------
+   //
+   Int_t CheckUnbiased(TKalDetCradle &det, Int_t ntracks)
+   {
+      const Int_t    kNrefits = 4;        // sites refitted per track
+      const Double_t kInflate = 1.e12;    // V scale that drops a hit
+      // the refit filters through the material at states that differ
+      // by the pull of the dropped hit, hence a looser limit with it
+
+      const Double_t kMaxPull [2] = { 0.01,  0.05 };
+      const Double_t kMaxRatio[2] = { 1.e-3, 0.01 };
+
+      Int_t nfailed = 0;
+      for (Int_t mat=0; mat<2; mat++) {
+         if (mat) { det.SwitchOnMS();  det.SwitchOnDEDX();  }
+         else     { det.SwitchOffMS(); det.SwitchOffDEDX(); }
+
+         // a refit per site is a fit per site: a quarter of the tracks
+
+         vector<TObjArray *> tracks;
+         Generate(det, TMath::Max(ntracks/4, 1), 0.5, 5., tracks, kTRUE);
+
+         TKalTrackSeeder seeder;
+         seeder.SetCovScale(1.e2);
+         Int_t    nfits = 0, nrefits = 0, nbad = 0;
+         Double_t maxpull = 0., maxratio = 0.;
+         for (UInt_t t=0; t<tracks.size(); t++) {
+            TObjArray &kalhits = *tracks[t];
+            // fits that take all hits only, the refits being compared
+            // site by site
+
+            EXHYBTrack kaltrack;
+            if (!Filter(kalhits, seeder, kaltrack)) continue;
+            if (kaltrack.GetEntries() != kalhits.GetEntries() + 1) continue;
+            TKalResidualArray res;
+            Int_t nres = kaltrack.CalcUnbiasedResiduals(res);
+            nfits++;
+
+            // refit with the hit of site k dropped, by a measurement
+            // noise so large that the filter does not move, and take
+            // the residual of the hit to the smoothed state there. Site
+            // 1 has the hit of the seed, and its refit would filter the
+            // next site from the seed only, with the material of the
+            // seed state: sites 2 .. n-1 are refitted.
+
+            for (Int_t r=0; r<kNrefits; r++) {
+               Int_t i = 1 + (r * (nres - 2)) / (kNrefits - 1);
+               Int_t k = res.GetSiteIndex(i);
+               TKalTrackSite    &site = *static_cast<TKalTrackSite *>(kaltrack.At(k));
+               const TVTrackHit &ht   = site.GetHit();
+
+               EXHYBTrack refit;
+               refit.SetOwner();
+               TKalTrackSite &sited = *new TKalTrackSite(*static_cast<TVTrackHit *>(kalhits.Last()));
+               seeder.InitSite(sited);
+               refit.Add(&sited);
+               TKalTrackSite *exclp = 0;
+               TIter next(&kalhits, kIterBackward);
+               TVTrackHit *hitp;
+               while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+                  TKalTrackSite &s = *new TKalTrackSite(*hitp);
+                  if (hitp == &ht) {
+                     s.GetMeasNoiseMat() *= kInflate;
+                     exclp = &s;
+                  }
+                  if (!refit.AddAndFilter(s)) {
+                     if (exclp == &s) exclp = 0;
+                     delete &s;
+                  }
+               }
+               if (!exclp) continue;
+               refit.SmoothAll();
+               nrefits++;
+
+               TVKalState &as = exclp->GetState(TVKalSite::kSmoothed);
+               Int_t m = ht.GetDimension();
+               TKalMatrix hv(m, 1);
+               TKalMatrix H (m, as.GetNrows());
+               exclp->CalcExpectedMeasVec  (as, hv);
+               exclp->CalcMeasVecDerivative(as, H );
+               TKalMatrix Ht(TKalMatrix::kTransposed, H);
+               TKalMatrix rs = exclp->GetMeasVec() - hv;
+               TKalMatrix Rs = site.GetMeasNoiseMat() + H * as.GetCovMat() * Ht;
+
+               Double_t pull = 0., ratio = 0.;
+               for (Int_t j=0; j<m; j++) {
+                  Double_t sigma = TMath::Sqrt(Rs(j,j));
+                  pull  = TMath::Max(pull,  TMath::Abs(res.GetResidual(i,j) - rs(j,0)) / sigma);
+                  ratio = TMath::Max(ratio, TMath::Abs(TMath::Sqrt(res.GetCovariance(i,j,j)) / sigma - 1.));
+               }
+               maxpull  = TMath::Max(maxpull,  pull);
+               maxratio = TMath::Max(maxratio, ratio);
+               if (pull > kMaxPull[mat] || ratio > kMaxRatio[mat]) nbad++;
+            }
+         }
+         for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+
+         printf("unbiased (mat %-3s): %d fits, %d sites refitted without their hit,"
+                " max. |dr|/sigma %.1e, max. |sigma ratio - 1| %.1e, %d beyond %.2f sigma or %.1f%%\n",
+                mat ? "on" : "off", nfits, nrefits, maxpull, maxratio, nbad,
+                kMaxPull[mat], 100. * kMaxRatio[mat]);
+         if (!nrefits || nbad > 0.01 * nrefits) nfailed++;
+      }
+      det.SwitchOnMS();
+      det.SwitchOnDEDX();
+      return nfailed ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  records
+   //  -----------------------------------
+   //
+   Int_t CheckRecords(TKalDetCradle &det, Int_t ntracks)
+   {
+      const Double_t kFloatTol = 1.e-7;   // > 2^-24, relative
+
+      vector<TObjArray *> tracks;
+      Generate(det, ntracks, 0.5, 5., tracks);
+
+      // smoothed tracks, written with the states at all sites
+
+      TKalTrackSeeder seeder;
+      seeder.SetCovScale(1.e2);
+      vector<EXHYBTrack *> fits;
+      for (UInt_t t=0; t<tracks.size(); t++) {
+         EXHYBTrack *ktp = new EXHYBTrack;
+         if (!Filter(*tracks[t], seeder, *ktp)) {
+            delete ktp;
+            continue;
+         }
+         ktp->SmoothAll();
+         fits.push_back(ktp);
+      }
+
+      Int_t nfailed = 0;
+      for (Int_t f32=0; f32<2; f32++) {
+         Int_t flags = f32 ? TKalTrackWriter::kFloat32 : 0;
+         ostringstream   os;
+         TKalTrackWriter writer(os, flags);
+         for (UInt_t t=0; t<fits.size(); t++) {
+            writer.WriteTrack(*fits[t], TKalTrackWriter::kAllSites, t);
+         }
+         string buf = os.str();
+
+         // every number read back must be the one written, to float
+         // precision for kFloat32
+
+         TKalTrackReader reader(buf.data(), buf.size());
+         Int_t    nread = 0, nstates = 0, nbad = 0;
+         Double_t maxdev = 0.;
+         auto compare = [&] (Double_t r, Double_t w) {
+            Double_t d = TMath::Abs(r - w);
+            if (f32) {
+               maxdev = TMath::Max(maxdev, w != 0. ? d / TMath::Abs(w) : d);
+               return d <= kFloatTol * TMath::Abs(w);
+            }
+            maxdev = TMath::Max(maxdev, d);
+            return d == 0.;
+         };
+         while (reader.Next()) {
+            Int_t t = reader.GetTrackID();
+            if (t != nread++ || t >= (Int_t)fits.size()) {
+               nbad++;
+               break;
+            }
+            EXHYBTrack &kt = *fits[t];
+            Bool_t ok = reader.GetNstates() == kt.GetEntries()
+                     && reader.GetNDF()     == kt.GetNDF()
+                     && reader.GetChi2()    == kt.GetChi2();
+            for (Int_t i=0; ok && i<reader.GetNstates(); i++) {
+               TVKalSite  &site = *static_cast<TVKalSite *>(kt.At(reader.GetSiteIndex(i)));
+               TVKalState &a    = site.GetState(TVKalSite::EStType(reader.GetStateType(i)));
+               TVector3    x0   = reader.GetPivot(i);
+               TVector3    w0   = static_cast<TKalTrackSite &>(site).GetPivot();
+               nstates++;
+               for (Int_t j=0; j<3; j++) ok = compare(x0[j], w0[j]) && ok;
+               for (Int_t j=0; j<a.GetNrows(); j++) {
+                  ok = compare(reader.GetStateVec(i, j), a(j,0)) && ok;
+                  for (Int_t k=0; k<=j; k++) {
+                     ok = compare(reader.GetCovMat(i, j, k), a.GetCovMat()(j,k)) && ok;
+                  }
+               }
+            }
+            if (!ok) nbad++;
+         }
+         if (reader.IsBad()) nbad++;
+
+         // a corrupt last block ends the reading there
+
+         string bad = buf;
+         bad[bad.size() - 10] ^= 0x10;
+         TKalTrackReader badreader(bad.data(), bad.size());
+         Int_t nbadread = 0;
+         while (badreader.Next()) nbadread++;
+         Bool_t caught = badreader.IsBad() && nbadread == nread - 1;
+
+         printf("records (%s): %d tracks, %d states, %.1f bytes per track,"
+                " max. deviation %.1e%s, %d differ, corrupt block %s\n",
+                f32 ? "float " : "double", nread, nstates,
+                writer.GetBytesPerTrack(), maxdev, f32 ? " relative" : "",
+                nbad, caught ? "caught" : "MISSED");
+         if (!nread || nread != (Int_t)fits.size() || nbad || !caught) nfailed++;
+      }
+      for (UInt_t t=0; t<fits.size();   t++) delete fits[t];
+      for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+      return nfailed ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  allocs
+   //  -----------------------------------
+   //
+   Int_t CheckAllocs(TKalDetCradle &det, Int_t ntracks)
+   {
+      // allocations per fitted site that each fit stage may make, in
+      // the order of TKalStats::EAllocTag, some 20% above those of
+      // today; "other" has the seeds and the sites themselves
+
+      const Double_t kMaxPerSite[TKalStats::kNallocTags] = { 10., 20., 90., 48., 2., 1. };
+
+      if (!TKalStats::IsAllocEnabled()) {
+         printf("allocs         : skipped, built without __KALSTATS_ALLOC__\n");
+         return 0;
+      }
+
+      vector<TObjArray *> tracks;
+      Generate(det, ntracks, 0.5, 5., tracks);
+
+      // only the fits are counted: filter from outside in and smooth
+
+      TKalStats::Reset();
+      TKalTrackSeeder seeder;
+      seeder.SetCovScale(1.e2);
+      Int_t nfits = 0, nsites = 0;
+      for (UInt_t t=0; t<tracks.size(); t++) {
+         EXHYBTrack kaltrack;
+         if (!Filter(*tracks[t], seeder, kaltrack)) continue;
+         kaltrack.SmoothAll();
+         nfits++;
+         nsites += kaltrack.GetEntries();
+      }
+      TKalStats::Snapshot s;
+      TKalStats::GetSnapshot(s);
+
+      Int_t     nover = 0;
+      ULong64_t bytes = 0;
+      printf("allocs         : %d fits, %d sites, allocations per site", nfits, nsites);
+      for (Int_t i=0; i<TKalStats::kNallocTags; i++) {
+         Double_t n = nsites ? Double_t(s.fAllocs[i]) / nsites : 0.;
+         printf("%s %s %.1f", i ? "," : "",
+                TKalStats::GetAllocTagName(TKalStats::EAllocTag(i)), n);
+         if (n > kMaxPerSite[i]) nover++;
+         bytes += s.fBytes[i];
+      }
+      printf(" (%.0f bytes), %d stages over budget\n",
+             nsites ? Double_t(bytes) / nsites : 0., nover);
+      for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+      return !nsites || nover ? 1 : 0;
+   }
+
+   //_____________________________________________________________________
+   //  -----------------------------------
+   //  smoothed
+   //  -----------------------------------
+   //
+   Int_t CheckSmoothedState(TKalDetCradle &det, Int_t ntracks)
+   {
+      const Int_t kNrandom = 3;           // sites asked for besides the ends
+
+      vector<TObjArray *> tracks;
+      Generate(det, ntracks, 0.5, 5., tracks);
+
+      TKalTrackSeeder seeder;
+      seeder.SetCovScale(1.e2);
+      Int_t nfits = 0, nasked = 0, nbad = 0, nuncached = 0, nextra = 0;
+      for (UInt_t t=0; t<tracks.size(); t++) {
+         EXHYBTrack ref, lazy;
+         if (!Filter(*tracks[t], seeder, ref) || !Filter(*tracks[t], seeder, lazy) ||
+             lazy.GetEntries() != ref.GetEntries()) continue;
+         ref.SmoothAll();
+         nfits++;
+
+         // the innermost and the outermost hit and a few in between, in
+         // random order, every other one with its residual
+
+         Int_t nsites = lazy.GetEntries();
+         vector<Int_t> ks;
+         ks.push_back(nsites-1);
+         ks.push_back(1);
+         for (Int_t r=0; r<kNrandom; r++) ks.push_back(1 + gRandom->Integer(nsites-1));
+         for (Int_t j=ks.size()-1; j>0; j--) swap(ks[j], ks[gRandom->Integer(j+1)]);
+
+         vector<Bool_t> withres(nsites, kFALSE);
+         for (UInt_t j=0; j<ks.size(); j++) {
+            Int_t       k    = ks[j];
+            Bool_t      res  = j % 2;
+            TVKalState &a    = lazy.GetSmoothedState(k, res);
+            TVKalSite  &site = *static_cast<TVKalSite *>(lazy.At(k));
+            TVKalSite  &refs = *static_cast<TVKalSite *>(ref.At(k));
+            TVKalState &as   = refs.GetState(TVKalSite::kSmoothed);
+            withres[k] = withres[k] || res;
+            nasked++;
+
+            // the same arithmetic as SmoothAll(), so the same numbers
+
+            Bool_t ok = &a == &site.GetState(TVKalSite::kSmoothed) && &as;
+            for (Int_t i=0; ok && i<a.GetNrows(); i++) {
+               ok = a(i,0) == as(i,0);
+               for (Int_t l=0; ok && l<a.GetNrows(); l++) {
+                  ok = a.GetCovMat()(i,l) == as.GetCovMat()(i,l);
+               }
+            }
+            if (ok && res) {
+               ok = site.IsResSmoothed() && site.GetDeltaChi2() == refs.GetDeltaChi2();
+               for (Int_t i=0; ok && i<site.GetResVec().GetNrows(); i++) {
+                  ok = site.GetResVec()(i,0) == refs.GetResVec()(i,0);
+               }
+            }
+            if (!ok) nbad++;
+
+            // asked again, the state is the one at the site
+
+            if (&lazy.GetSmoothedState(k, res) != &a) nuncached++;
+         }
+
+         // nothing smoothed below the lowest site asked for, and no
+         // residual but those asked for and that of the last site
+
+         Int_t kmin = *min_element(ks.begin(), ks.end());
+         for (Int_t i=0; i<nsites-1; i++) {
+            TVKalSite &site = *static_cast<TVKalSite *>(lazy.At(i));
+            if ((i < kmin && &site.GetState(TVKalSite::kSmoothed)) ||
+                (site.IsResSmoothed() && !withres[i])) nextra++;
+         }
+      }
+      for (UInt_t t=0; t<tracks.size(); t++) delete tracks[t];
+
+      printf("smoothed       : %d fits, %d sites asked for, %d differ from SmoothAll(),"
+             " %d not cached, %d sites smoothed beyond need\n",
+             nfits, nasked, nbad, nuncached, nextra);
+      return !nfits || nbad || nuncached || nextra ? 1 : 0;
+   }
+}
+
+int main(Int_t argc, Char_t **argv)
+{
+   // ===================================================================
+   //  Get job parameters from command line arguments, if any
+   // ===================================================================
+
+   Int_t  ntracks = 200;
+   UInt_t seed    = 4357;
+   vector<string> checks = ParseNames("hitstore,helixfit,band,gbl,extrap,twofilter,seeder,unbiased,records,allocs,smoothed");
+   for (Int_t i=1; i<argc; i++) {
+      TString opt(argv[i]);
+      if (i + 1 >= argc) {
+         cerr << "Usage: " << argv[0] << " [-n ntracks] [-s seed]"
+              << " [-t check1,check2,..]" << endl;
+         return 2;
+      }
+      if      (opt == "-n") ntracks = atoi(argv[++i]);
+      else if (opt == "-s") seed    = atoi(argv[++i]);
+      else if (opt == "-t") checks  = ParseNames(argv[++i]);
+      else {
+         cerr << "Unknown option " << opt << endl;
+         return 2;
+      }
+   }
+
+   // ===================================================================
+   //  Prepare a detector
+   // ===================================================================
+
+   TKalDetCradle    toygld;
+   EXBPKalDetector  bmpipe;
+   EXVTXKalDetector vtxdet;
+   EXITKalDetector  itdet;
+   EXTPCKalDetector tpcdet;
+
+   toygld.Install(bmpipe);
+   toygld.Install(vtxdet);
+   toygld.Install(itdet);
+   toygld.Install(tpcdet);
+   toygld.Close();
+   toygld.Sort();
+   bmpipe.PowerOff();
+
+   // ===================================================================
+   //  Run the checks
+   // ===================================================================
+
+   Int_t nfailed = 0;
+   for (UInt_t i=0; i<checks.size(); i++) {
+      gRandom->SetSeed(seed);
+      Int_t failed;
+      if (checks[i] == "hitstore") {
+         failed = CheckHitStore(toygld, ntracks);
+      } else if (checks[i] == "helixfit") {
+         failed = CheckHelixFit(toygld, ntracks);
+      } else if (checks[i] == "band") {
+         failed = CheckBand(ntracks);
+      } else if (checks[i] == "gbl") {
+         failed = CheckBrokenLines(toygld, ntracks);
+      } else if (checks[i] == "extrap") {
+         failed = CheckExtrapolator(toygld, ntracks);
+      } else if (checks[i] == "twofilter") {
+         failed = CheckTwoFilter(toygld, ntracks);
+      } else if (checks[i] == "seeder") {
+         failed = CheckSeeder(toygld, ntracks);
+      } else if (checks[i] == "unbiased") {
+         failed = CheckUnbiased(toygld, ntracks);
+      } else if (checks[i] == "records") {
+         failed = CheckRecords(toygld, ntracks);
+      } else if (checks[i] == "allocs") {
+         failed = CheckAllocs(toygld, ntracks);
+      } else if (checks[i] == "smoothed") {
+         failed = CheckSmoothedState(toygld, ntracks);
+      } else {
+         cerr << "Unknown check " << checks[i] << endl;
+         return 2;
+      }
+      if (failed) printf("  %s FAILED\n", checks[i].c_str());
+      nfailed += failed;
+   }
+   return nfailed ? 1 : 0;
+}
@@ -3,6 +3,8 @@
 #include "EXVMeasLayer.h"
 #include "TPlane.h"
 #include "TRandom.h"
+#include "TKalHitFile.h"
+#include "EXTPCHit.h"
 
 //-----------------------------------
 // Track Parameters
@@ -57,6 +59,7 @@ void EXEventGen::Swim(THelicalTrack &heltrk)
    Int_t    nlayers   = fCradlePtr->GetEntries();
    Int_t    dlyr      = 1;
    Double_t dfisum    = 0.;
+   Int_t    nhits0    = fHitBufPtr->GetEntriesFast(); // -1 after 1st hit
 
    for (Int_t lyr = 0; lyr >= 0; lyr += dlyr) { // loop over layers
       // change direction if it starts looping back
@@ -66,7 +69,10 @@ void EXEventGen::Swim(THelicalTrack &heltrk)
       TVSurface    &ms = *dynamic_cast<TVSurface *>(fCradlePtr->At(lyr));
       TVector3 xx;
       Double_t dfis = dfi;
+      // mode 1 asks for a crossing ahead of the track, but the Newtonian
+      // search that planes use returns the nearest one on either side
       if (!ms.CalcXingPointWith(heltrk,xx,dfi,1)
+       || dfi * heltrk.GetKappa() > 0.
        || TMath::Abs(dfi) > TMath::Pi()
        || TMath::Abs(dfi + dfisum) > TMath::TwoPi()) {
          dfi = dfis;
@@ -96,6 +102,7 @@ void EXEventGen::Swim(THelicalTrack &heltrk)
 #endif
          // recalculate crossing point
          if (!ms.CalcXingPointWith(heltrk,xx,dfi,1)
+          || dfi * heltrk.GetKappa() > 0.
           || TMath::Abs(dfi) > TMath::Pi()
           || TMath::Abs(dfi + dfisum) > TMath::TwoPi()) {
             dfi = dfis;
@@ -115,7 +122,33 @@ void EXEventGen::Swim(THelicalTrack &heltrk)
       }
       if (ml.IsActive() && dynamic_cast<const EXVKalDetector &>(ml.GetParent(kFALSE)).IsPowerOn()) {
          ml.ProcessHit(xx, *fHitBufPtr); // create hit point
+         if (nhits0 >= 0 && fHitBufPtr->GetEntriesFast() > nhits0) {
+            fFirstHitHelix = heltrk;                // true helix at 1st hit
+            nhits0 = -1;
+         }
       }
       if (lyr == nlayers - 1) break;
    }
 }
+
+void EXEventGen::WriteHits(TKalHitFile &file, Int_t trackid) const
+{
+   // -------------------------------------
+   //  Add the hits of this event to file
+   // -------------------------------------
+   //  TPC hits keep their side as flag and the drift velocity as
+   //  d(drift distance)/d(t0).
+
+   TIter next(fHitBufPtr);
+   TVTrackHit *hitp;
+   while ((hitp = dynamic_cast<TVTrackHit *>(next()))) {
+      EXTPCHit *tpchitp = dynamic_cast<EXTPCHit *>(hitp);
+      if (tpchitp) {
+         Double_t dhdt0[2] = { 0., tpchitp->GetVdrift() };
+         file.AddHit(*hitp, dhdt0, tpchitp->GetSide(), trackid);
+      } else {
+         file.AddHit(*hitp, 0, 0, trackid);
+      }
+   }
+   file.EndEvent();
+}
@@ -4,6 +4,8 @@
 #include "TKalDetCradle.h"
 #include "THelicalTrack.h"
 
+class TKalHitFile;
+
 class EXEventGen {
 public:
    EXEventGen(TKalDetCradle &cradle, TObjArray &kalhits)
@@ -14,6 +16,10 @@ public:
                                Double_t cosmin,
                                Double_t cosmax);
    void          Swim(THelicalTrack &heltrk);
+   void          WriteHits(TKalHitFile &file, Int_t trackid = 0) const;
+
+   // true helix at the first hit made by the last Swim(), pivot at the hit
+   const THelicalTrack &GetFirstHitHelix() const { return fFirstHitHelix; }
 
    static void     SetT0(Double_t t0) { fgT0 = t0;   }
    static Double_t GetT0()            { return fgT0; }
@@ -21,6 +27,7 @@ public:
 private:
    TKalDetCradle *fCradlePtr;     // pointer to detector system
    TObjArray     *fHitBufPtr;     // pointer to hit array
+   THelicalTrack  fFirstHitHelix; // helix at the first hit
 
    static Double_t  fgT0;         // t0
 
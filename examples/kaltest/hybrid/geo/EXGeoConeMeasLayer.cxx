@@ -0,0 +1,62 @@
+//*************************************************************************
+//* ==========================
+//*  EXGeoConeMeasLayer Class
+//* ==========================
+//*
+//* (Description)
+//*   Conical measurement layer read from a geometry file.
+//* (Requires)
+//*     EXGeoMeasLayer, TCutCone
+//* (Provides)
+//*     class EXGeoConeMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+
+#include "EXGeoConeMeasLayer.h"
+#include "TMath.h"
+
+ClassImp(EXGeoConeMeasLayer)
+
+EXGeoConeMeasLayer::EXGeoConeMeasLayer(TMaterial &min,
+                                       TMaterial &mout,
+                                       Double_t   z1,
+                                       Double_t   r1,
+                                       Double_t   z2,
+                                       Double_t   r2,
+                                       Int_t      ndim,
+                                       Double_t   sigma0,
+                                       Double_t   sigma1,
+                                       Bool_t     type,
+                                 const Char_t    *name)
+                  : EXGeoMeasLayer(min, mout, kRPhiZ, ndim, sigma0, sigma1, type, name),
+                    TCutCone(r1*(z2-z1)/(r2-r1),
+                             r2*(z2-z1)/(r2-r1),
+                                (r2-r1)/(z2-z1),
+                             0.,0.,(r2*z1-r1*z2)/(r2-r1)),
+                    fZ1(z1),
+                    fZ2(z2)
+{
+   SetRref(0.5 * (r1 + r2));
+}
+
+EXGeoConeMeasLayer::~EXGeoConeMeasLayer()
+{
+}
+
+Double_t EXGeoConeMeasLayer::GetRadius(Double_t z) const
+{
+   return TMath::Abs((z - GetXc().Z()) * GetTanA());
+}
+
+Bool_t EXGeoConeMeasLayer::IsOnSurface(const TVector3 &xx) const
+{
+   TVector3 xxc = xx - GetXc();
+   Double_t r   = xxc.Perp();
+   Double_t z   = xxc.Z();
+   Double_t s   = (r - GetTanA()*z) * (r + GetTanA()*z);
+   const Double_t kTol = 1.e-8;
+
+   return (TMath::Abs(s) < kTol && ((xx.Z()-fZ1)*(xx.Z()-fZ2) <= 0.));
+}
@@ -0,0 +1,56 @@
+#ifndef __EXGEOCONEMEASLAYER__
+#define __EXGEOCONEMEASLAYER__
+//*************************************************************************
+//* ==========================
+//*  EXGeoConeMeasLayer Class
+//* ==========================
+//*
+//* (Description)
+//*   Conical measurement layer read from a geometry file, spanning
+//*   from (z1, r1) to (z2, r2) about the z axis. Measures (Rref*phi, z)
+//*   or Rref*phi, Rref being the mean of r1 and r2.
+//* (Requires)
+//*     EXGeoMeasLayer, TCutCone
+//* (Provides)
+//*     class EXGeoConeMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Added GetShape().
+//*************************************************************************
+//
+#include "TCutCone.h"
+#include "EXGeoMeasLayer.h"
+
+class EXGeoConeMeasLayer : public EXGeoMeasLayer, public TCutCone {
+public:
+   // Ctors and Dtor
+
+   EXGeoConeMeasLayer(TMaterial &min,
+                      TMaterial &mout,
+                      Double_t   z1,
+                      Double_t   r1,
+                      Double_t   z2,
+                      Double_t   r2,
+                      Int_t      ndim,
+                      Double_t   sigma0,
+                      Double_t   sigma1,
+                      Bool_t     type = EXVMeasLayer::kActive,
+                const Char_t    *name = "GeoConeML");
+   virtual ~EXGeoConeMeasLayer();
+
+   virtual const TVector3 & GetXc      ()                   const { return TCutCone::GetXc(); }
+   virtual       Double_t   GetRadius  (Double_t z)         const;
+   virtual       Bool_t     IsOnSurface(const TVector3 &xx) const;
+
+   // crossings as those of TCutCone, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kCutCone; }
+
+private:
+   Double_t fZ1;      // z of end 1
+   Double_t fZ2;      // z of end 2
+
+   ClassDef(EXGeoConeMeasLayer,1)   // Conical geometry file layer
+};
+
+#endif
@@ -0,0 +1,39 @@
+//*************************************************************************
+//* =========================
+//*  EXGeoCylMeasLayer Class
+//* =========================
+//*
+//* (Description)
+//*   Cylindrical measurement layer read from a geometry file.
+//* (Requires)
+//*     EXGeoMeasLayer, TCylinder
+//* (Provides)
+//*     class EXGeoCylMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+
+#include "EXGeoCylMeasLayer.h"
+
+ClassImp(EXGeoCylMeasLayer)
+
+EXGeoCylMeasLayer::EXGeoCylMeasLayer(TMaterial &min,
+                                     TMaterial &mout,
+                                     Double_t   r0,
+                                     Double_t   lhalf,
+                               const TVector3  &xc,
+                                     Int_t      ndim,
+                                     Double_t   sigma0,
+                                     Double_t   sigma1,
+                                     Bool_t     type,
+                               const Char_t    *name)
+                 : EXGeoMeasLayer(min, mout, kRPhiZ, ndim, sigma0, sigma1, type, name),
+                   TCylinder(r0, lhalf, xc.X(), xc.Y(), xc.Z())
+{
+   SetRref(r0);
+}
+
+EXGeoCylMeasLayer::~EXGeoCylMeasLayer()
+{
+}
@@ -0,0 +1,48 @@
+#ifndef __EXGEOCYLMEASLAYER__
+#define __EXGEOCYLMEASLAYER__
+//*************************************************************************
+//* =========================
+//*  EXGeoCylMeasLayer Class
+//* =========================
+//*
+//* (Description)
+//*   Cylindrical measurement layer read from a geometry file.
+//*   Measures (R*phi, z) or R*phi.
+//* (Requires)
+//*     EXGeoMeasLayer, TCylinder
+//* (Provides)
+//*     class EXGeoCylMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Added GetShape().
+//*************************************************************************
+//
+#include "TCylinder.h"
+#include "EXGeoMeasLayer.h"
+
+class EXGeoCylMeasLayer : public EXGeoMeasLayer, public TCylinder {
+public:
+   // Ctors and Dtor
+
+   EXGeoCylMeasLayer(TMaterial &min,
+                     TMaterial &mout,
+                     Double_t   r0,
+                     Double_t   lhalf,
+               const TVector3  &xc,
+                     Int_t      ndim,
+                     Double_t   sigma0,
+                     Double_t   sigma1,
+                     Bool_t     type = EXVMeasLayer::kActive,
+               const Char_t    *name = "GeoCylML");
+   virtual ~EXGeoCylMeasLayer();
+
+   virtual const TVector3 & GetXc() const { return TCylinder::GetXc(); }
+
+   // crossings as those of TCylinder, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kCylinder; }
+
+   ClassDef(EXGeoCylMeasLayer,1)   // Cylindrical geometry file layer
+};
+
+#endif
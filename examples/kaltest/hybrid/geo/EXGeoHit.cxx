@@ -0,0 +1,76 @@
+//*************************************************************************
+//* ================
+//*  EXGeoHit Class
+//* ================
+//*
+//* (Description)
+//*   Hit class on the layers read from a geometry file.
+//* (Requires)
+//*     TVTrackHit, EXGeoMeasLayer
+//* (Provides)
+//*     class EXGeoHit
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+
+#include "EXGeoHit.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+ClassImp(EXGeoHit)
+
+//_____________________________________________________________________
+//  ----------------------------------
+//  Ctors and Dtor
+//  ----------------------------------
+
+EXGeoHit::EXGeoHit(Int_t m)
+        : TVTrackHit(m)
+{
+}
+
+EXGeoHit::EXGeoHit(const EXGeoMeasLayer &ms,
+                         Double_t       *x,
+                         Double_t       *dx,
+                   const TVector3       &xx,
+                         Double_t        b,
+                         Int_t           m)
+        : TVTrackHit(ms, x, dx, b, m),
+          fXX(xx)
+{
+}
+
+EXGeoHit::~EXGeoHit()
+{
+}
+
+//_____________________________________________________________________
+//  ----------------------------------
+//  Implementation of public methods
+//  ----------------------------------
+
+TKalMatrix EXGeoHit::XvToMv(const TVector3 &xv, Double_t /*t0*/) const
+{
+   return GetMeasLayer().XvToMv(*this, xv);
+}
+
+void EXGeoHit::DebugPrint(Option_t *) const
+{
+   cerr << "------------------- Site Info -------------------------" << endl;
+
+   for (Int_t i=0; i<GetDimension(); i++) {
+      Double_t x  = (*this)(i,0);
+      Double_t dx = (*this)(i,1);
+      cerr << " x[" << i << "] = " << setw(8) << setprecision(5) << x
+           << "    "
+           << "dx[" << i << "] = " << setw(6) << setprecision(2) << dx
+           << setprecision(7)
+           << resetiosflags(ios::showpoint)
+           << endl;
+   }
+   cerr << "-------------------------------------------------------" << endl;
+}
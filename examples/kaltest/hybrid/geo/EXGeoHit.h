@@ -0,0 +1,48 @@
+#ifndef __EXGEOHIT__
+#define __EXGEOHIT__
+//*************************************************************************
+//* ================
+//*  EXGeoHit Class
+//* ================
+//*
+//* (Description)
+//*   Hit class on the layers read from a geometry file. The expected
+//*   measurement vector is that of the layer.
+//* (Requires)
+//*     TVTrackHit, EXGeoMeasLayer
+//* (Provides)
+//*     class EXGeoHit
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "KalTrackDim.h"
+#include "TVTrackHit.h"
+#include "EXGeoMeasLayer.h"
+
+class EXGeoHit : public TVTrackHit {
+public:
+   EXGeoHit(Int_t m = kMdim);
+
+   EXGeoHit(const EXGeoMeasLayer &ms,
+                  Double_t       *x,
+                  Double_t       *dx,
+            const TVector3       &xx,
+                  Double_t        b,
+                  Int_t           m = kMdim);
+
+   virtual ~EXGeoHit();
+
+   virtual TKalMatrix XvToMv (const TVector3 &xv, Double_t t0) const;
+
+   virtual void       DebugPrint(Option_t *opt = "")           const;
+
+   inline  const TVector3 GetExactX() const { return fXX;     }
+
+private:
+   TVector3 fXX;        // exact hit position
+
+   ClassDef(EXGeoHit,1)      // Geometry file hit class
+};
+
+#endif
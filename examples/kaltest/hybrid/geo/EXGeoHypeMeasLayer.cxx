@@ -0,0 +1,47 @@
+//*************************************************************************
+//* ==========================
+//*  EXGeoHypeMeasLayer Class
+//* ==========================
+//*
+//* (Description)
+//*   Hyperboloidal (stereo) measurement layer read from a geometry file.
+//* (Requires)
+//*     EXGeoMeasLayer, THype
+//* (Provides)
+//*     class EXGeoHypeMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+
+#include "EXGeoHypeMeasLayer.h"
+#include "TMath.h"
+
+ClassImp(EXGeoHypeMeasLayer)
+
+EXGeoHypeMeasLayer::EXGeoHypeMeasLayer(TMaterial &min,
+                                       TMaterial &mout,
+                                       Double_t   r0,
+                                       Double_t   lhalf,
+                                       Double_t   tana,
+                                 const TVector3  &xc,
+                                       Int_t      ndim,
+                                       Double_t   sigma0,
+                                       Double_t   sigma1,
+                                       Bool_t     type,
+                                 const Char_t    *name)
+                  : EXGeoMeasLayer(min, mout, kRPhiZ, ndim, sigma0, sigma1, type, name),
+                    THype(r0, lhalf, tana, xc.X(), xc.Y(), xc.Z())
+{
+   SetRref(r0);
+}
+
+EXGeoHypeMeasLayer::~EXGeoHypeMeasLayer()
+{
+}
+
+Double_t EXGeoHypeMeasLayer::GetRadius(Double_t z) const
+{
+   Double_t dz = (z - GetXc().Z()) * GetTanA();
+   return TMath::Sqrt(GetR0() * GetR0() + dz * dz);
+}
@@ -0,0 +1,46 @@
+#ifndef __EXGEOHYPEMEASLAYER__
+#define __EXGEOHYPEMEASLAYER__
+//*************************************************************************
+//* ==========================
+//*  EXGeoHypeMeasLayer Class
+//* ==========================
+//*
+//* (Description)
+//*   Hyperboloidal (stereo) measurement layer read from a geometry
+//*   file. Measures (R0*phi, z) or R0*phi, R0 being the radius at the
+//*   center.
+//* (Requires)
+//*     EXGeoMeasLayer, THype
+//* (Provides)
+//*     class EXGeoHypeMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "THype.h"
+#include "EXGeoMeasLayer.h"
+
+class EXGeoHypeMeasLayer : public EXGeoMeasLayer, public THype {
+public:
+   // Ctors and Dtor
+
+   EXGeoHypeMeasLayer(TMaterial &min,
+                      TMaterial &mout,
+                      Double_t   r0,
+                      Double_t   lhalf,
+                      Double_t   tana,
+                const TVector3  &xc,
+                      Int_t      ndim,
+                      Double_t   sigma0,
+                      Double_t   sigma1,
+                      Bool_t     type = EXVMeasLayer::kActive,
+                const Char_t    *name = "GeoHypeML");
+   virtual ~EXGeoHypeMeasLayer();
+
+   virtual const TVector3 & GetXc    ()           const { return THype::GetXc(); }
+   virtual       Double_t   GetRadius(Double_t z) const;
+
+   ClassDef(EXGeoHypeMeasLayer,1)   // Hyperboloidal geometry file layer
+};
+
+#endif
@@ -0,0 +1,204 @@
+//*************************************************************************
+//* ========================
+//*  EXGeoKalDetector Class
+//* ========================
+//*
+//* (Description)
+//*   Detector built from a geometry file.
+//* (Requires)
+//*     EXVKalDetector, EXGeoMeasLayer
+//* (Provides)
+//*     class EXGeoKalDetector
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Far side planes sort after the near side.
+//*************************************************************************
+
+#include "EXGeoKalDetector.h"
+#include "EXGeoCylMeasLayer.h"
+#include "EXGeoHypeMeasLayer.h"
+#include "EXGeoConeMeasLayer.h"
+#include "EXGeoPlaneMeasLayer.h"
+#include "TMaterial.h"
+#include "TMath.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+ClassImp(EXGeoKalDetector)
+
+EXGeoKalDetector::EXGeoKalDetector(const Char_t *name, Int_t m)
+                : EXVKalDetector(m)
+{
+   SetOwner();
+   fMaterials.SetOwner();
+   if (name) Load(name);
+}
+
+EXGeoKalDetector::~EXGeoKalDetector()
+{
+}
+
+TMaterial *EXGeoKalDetector::GetMaterial(const Char_t *name) const
+{
+   for (Int_t i=0; i<fMaterials.GetEntriesFast(); i++) {
+      TMaterial *mp = static_cast<TMaterial *>(fMaterials.At(i));
+      if (!strcmp(mp->GetName(), name)) return mp;
+   }
+   return 0;
+}
+
+Bool_t EXGeoKalDetector::Load(const Char_t *name)
+{
+   ifstream in(name);
+   if (!in) {
+      cerr << ">>>> Error!! EXGeoKalDetector::Load >>>>>>>>>>>>>>" << endl
+           << " Cannot open " << name << endl;
+      return kFALSE;
+   }
+
+   string line;
+   Int_t  lineno = 0;
+   while (getline(in, line)) {
+      lineno++;
+      string::size_type c = line.find('#');
+      if (c != string::npos) line.erase(c);
+
+      istringstream is(line);
+      string key;
+      if (!(is >> key)) continue;
+
+      const Char_t *err = 0;
+      if (key == "material") {
+         string   mname;
+         Double_t A, Z, density, radlen;
+         if (!(is >> mname >> A >> Z >> density >> radlen)) {
+            err = "Bad material";
+         } else if (GetMaterial(mname.c_str())) {
+            err = "Material defined twice";
+         } else {
+            fMaterials.Add(new TMaterial(mname.c_str(), "", A, Z, density, radlen, 0.));
+         }
+      } else {
+         string   lname, min, mout, type;
+         Int_t    ndim;
+         Double_t sigma0, sigma1, x;
+         vector<Double_t> par, sort;
+         if (!(is >> lname >> min >> mout >> type >> ndim >> sigma0 >> sigma1)) {
+            err = "Bad layer";
+         } else {
+            while (is >> x) par.push_back(x);
+            string sortkey;
+            if (!is.eof()) {
+               is.clear();
+               if (is >> sortkey && sortkey == "sort") {
+                  while (is >> x) sort.push_back(x);
+               }
+            }
+            TMaterial *minp  = GetMaterial(min .c_str());
+            TMaterial *moutp = GetMaterial(mout.c_str());
+            if      (!is.eof())                           err = "Bad number";
+            else if (!sortkey.empty() && (sort.empty() || sort.size() > 2))
+                                                          err = "Bad sort";
+            else if (!minp || !moutp)                     err = "Unknown material";
+            else if (type != "active" && type != "dummy") err = "Bad layer type";
+            else if (ndim < 1 || ndim > 2)                err = "Bad dimension";
+            else {
+               Bool_t active = type == "active" ? EXVMeasLayer::kActive
+                                                : EXVMeasLayer::kDummy;
+               err = AddLayers(key, lname, *minp, *moutp, active, ndim,
+                               sigma0, sigma1, par, sort);
+            }
+         }
+      }
+      if (err) {
+         cerr << ">>>> Error!! EXGeoKalDetector::Load >>>>>>>>>>>>>>" << endl
+              << " " << name << ":" << lineno << ": " << err << endl;
+         return kFALSE;
+      }
+   }
+   return kTRUE;
+}
+
+const Char_t *EXGeoKalDetector::AddLayers(const string           &shape,
+                                          const string           &name,
+                                                TMaterial        &min,
+                                                TMaterial        &mout,
+                                                Bool_t            type,
+                                                Int_t             ndim,
+                                                Double_t          sigma0,
+                                                Double_t          sigma1,
+                                          const vector<Double_t> &par,
+                                          const vector<Double_t> &sort)
+{
+   // ring ladders and disc copies get distinct sorting policies,
+   // see EXVTXKalDetector; a plane on the far side of the origin
+   // (xc.n < 0) sorts just after its mirror image, as the backward
+   // petals of EXITKalDetector do
+
+   static const Double_t kEps    = 1.e-6;
+   static const Double_t kEpsFar = 1.e-4;
+
+   // number of shape parameters without and with the repetition
+
+   Int_t npar, nrep;
+   if      (shape == "cylinder") { npar = 2; nrep = 4; }
+   else if (shape == "hype"    ) { npar = 3; nrep = 0; }
+   else if (shape == "cone"    ) { npar = 4; nrep = 0; }
+   else if (shape == "plane"   ) { npar = 8; nrep = 10; }
+   else if (shape == "disc"    ) { npar = 3; nrep = 5; }
+   else return "Unknown keyword";
+
+   Int_t n = par.size();
+   if (n != npar && n != nrep) return "Wrong number of parameters";
+
+   Int_t    ncopies = n == nrep ? TMath::Nint(par[npar]) : 1;
+   Double_t step    = n == nrep ? par[npar+1]           : 0.;
+   if (ncopies < 1) return "Bad number of copies";
+   if (sort.size() && shape != "plane" && shape != "disc") return "Sort not allowed";
+   Double_t dsort = sort.size() > 1 ? sort[1] : kEps;
+
+   for (Int_t i=0; i<ncopies; i++) {
+      if (n == nrep) {
+         ostringstream os;
+         os << name << "_" << i;
+         fNames.push_back(os.str());
+      } else {
+         fNames.push_back(name);
+      }
+      const Char_t *lname = fNames.back().c_str();   // kept by TVMeasLayer
+
+      if (shape == "cylinder") {
+         Add(new EXGeoCylMeasLayer(min, mout, par[0] + i * step, par[1],
+                                   TVector3(), ndim, sigma0, sigma1, type, lname));
+      } else if (shape == "hype") {
+         Add(new EXGeoHypeMeasLayer(min, mout, par[0], par[1], par[2],
+                                    TVector3(), ndim, sigma0, sigma1, type, lname));
+      } else if (shape == "cone") {
+         if (par[3] == par[1] || par[2] == par[0]) return "Degenerate cone";
+         Add(new EXGeoConeMeasLayer(min, mout, par[0], par[1], par[2], par[3],
+                                    ndim, sigma0, sigma1, type, lname));
+      } else if (shape == "plane") {
+         TVector3 xc(par[0], par[1], par[2]);
+         TVector3 nv(par[3], par[4], par[5]);
+         if (nv.Mag() == 0.) return "Null normal";
+         xc.RotateZ(i * step * TMath::DegToRad());
+         nv.RotateZ(i * step * TMath::DegToRad());
+         Double_t d = xc * nv.Unit();
+         Double_t s = sort.size() ? sort[0] : TMath::Abs(d) + (d < 0. ? kEpsFar : 0.);
+         Add(new EXGeoPlaneMeasLayer(min, mout, xc, nv, par[6], par[7], 0., 0.,
+                                     s + i * dsort, ndim, sigma0, sigma1, type, lname));
+      } else {
+         TVector3 xc(0., 0., par[0] + i * step);
+         Double_t s = sort.size() ? sort[0] : TMath::Abs(xc.Z()) + (xc.Z() < 0. ? kEpsFar : 0.);
+         Add(new EXGeoPlaneMeasLayer(min, mout, xc, TVector3(0., 0., 1.), 0., 0.,
+                                     par[1], par[2], s + i * dsort,
+                                     ndim, sigma0, sigma1, type, lname));
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,86 @@
+#ifndef __EXGEODETECTOR__
+#define __EXGEODETECTOR__
+//*************************************************************************
+//* ========================
+//*  EXGeoKalDetector Class
+//* ========================
+//*
+//* (Description)
+//*   Detector built from a geometry file instead of compiled in
+//*   constants. The file is text, one item per line, '#' starting a
+//*   comment; lengths in cm, angles in degrees:
+//*
+//*   material <name> <A> <Z> <density [g/cm^3]> <X0 [cm]>
+//*   <shape>  <name> <mat in> <mat out> <active|dummy> <ndim>
+//*            <sigma0> <sigma1> <shape parameters> [sort <s> [<ds>]]
+//*
+//*   with <shape parameters>
+//*
+//*   cylinder <r> <half length> [<n> <dr>]
+//*   hype     <r0> <half length> <tan(stereo angle)>
+//*   cone     <z1> <r1> <z2> <r2>
+//*   plane    <xc> <yc> <zc> <nx> <ny> <nz> <hu> <hv> [<n> <dphi>]
+//*   disc     <z> <rmin> <rmax> [<n> <dz>]
+//*
+//*   Cylinders, hyperboloids and cones are centered on the z axis and
+//*   measure (R*phi, z); planes and discs measure (u, v), see
+//*   EXGeoPlaneMeasLayer. ndim = 1 keeps the first coordinate only.
+//*   The optional <n> repeats a layer n times, stepping the radius,
+//*   the azimuth about the z axis or z; the copies are named
+//*   <name>_0 ... <name>_n-1. Planes and discs are sorted by the
+//*   distance of the plane from the origin, plus 1e-4 on the far side
+//*   (xc.n < 0) so that -z discs follow their +z mirror images, unless
+//*   sort gives the sorting policy s; copy i adds i*ds (default 1e-6).
+//*   Discs crossed by forward tracks at small radii need s, placing
+//*   them among the barrel layers in the order tracks cross them.
+//*   Materials and layers are owned by the detector.
+//* (Requires)
+//*     EXVKalDetector, EXGeoMeasLayer
+//* (Provides)
+//*     class EXGeoKalDetector
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Far side planes sort after the near side.
+//*************************************************************************
+
+#include "EXVKalDetector.h"
+#include "TObjArray.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+class TMaterial;
+
+class EXGeoKalDetector : public EXVKalDetector {
+public:
+   EXGeoKalDetector(const Char_t *name = 0, Int_t m = 100);
+   virtual ~EXGeoKalDetector();
+
+   // Add the materials and layers of geometry file name.
+   // Returns kFALSE at the first error.
+
+   Bool_t     Load(const Char_t *name);
+
+   TMaterial *GetMaterial(const Char_t *name) const;
+
+private:
+   const Char_t *AddLayers(const std::string           &shape,
+                           const std::string           &name,
+                                 TMaterial             &min,
+                                 TMaterial             &mout,
+                                 Bool_t                 type,
+                                 Int_t                  ndim,
+                                 Double_t               sigma0,
+                                 Double_t               sigma1,
+                           const std::vector<Double_t> &par,
+                           const std::vector<Double_t> &sort);
+
+private:
+   TObjArray              fMaterials;   // materials
+   std::list<std::string> fNames;       //! layer names
+
+   ClassDef(EXGeoKalDetector,1)   // Detector from a geometry file
+};
+
+#endif
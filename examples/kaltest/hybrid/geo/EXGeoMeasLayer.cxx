@@ -0,0 +1,166 @@
+//*************************************************************************
+//* ======================
+//*  EXGeoMeasLayer Class
+//* ======================
+//*
+//* (Description)
+//*   Base class of the measurement layers read from a geometry file.
+//* (Requires)
+//*     EXVMeasLayer
+//* (Provides)
+//*     class EXGeoMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+
+#include "EXGeoMeasLayer.h"
+#include "EXGeoHit.h"
+#include "EXVKalDetector.h"
+#include "TRandom.h"
+#include "TMath.h"
+
+ClassImp(EXGeoMeasLayer)
+
+EXGeoMeasLayer::EXGeoMeasLayer(TMaterial &min,
+                               TMaterial &mout,
+                               Int_t      model,
+                               Int_t      ndim,
+                               Double_t   sigma0,
+                               Double_t   sigma1,
+                               Bool_t     type,
+                         const Char_t    *name)
+              : EXVMeasLayer(min, mout, type, name),
+                fModel(model),
+                fNdim(ndim),
+                fRref(0.),
+                fU(1., 0., 0.),
+                fV(0., 1., 0.)
+{
+   fSigma[0] = sigma0;
+   fSigma[1] = sigma1;
+}
+
+EXGeoMeasLayer::~EXGeoMeasLayer()
+{
+}
+
+void EXGeoMeasLayer::SetAxes(const TVector3 &normal)
+{
+   // u perpendicular to the normal in the xy plane (along x for a
+   // plane normal to z), v = u x n.
+
+   TVector3 n = normal.Unit();
+   if (n.Perp() > 1.e-9) fU.SetXYZ(n.Y() / n.Perp(), -n.X() / n.Perp(), 0.);
+   else                  fU.SetXYZ(1., 0., 0.);
+   fV = fU.Cross(n);
+}
+
+TKalMatrix EXGeoMeasLayer::XvToMv(const TVector3 &xv) const
+{
+   // Calculate hit coordinate information:
+   //   kRPhiZ: mv(0,0) = Rref * phi,     (1,0) = z
+   //   kUV   : mv(0,0) = (xv - xc) * u,  (1,0) = (xv - xc) * v
+
+   TKalMatrix mv(fNdim,1);
+   TVector3   xx = xv - GetXc();
+
+   if (fModel == kRPhiZ) {
+      mv(0,0) = fRref * TMath::ATan2(xx.Y(), xx.X());
+      if (fNdim > 1) mv(1,0) = xv.Z();
+   } else {
+      mv(0,0) = xx * fU;
+      if (fNdim > 1) mv(1,0) = xx * fV;
+   }
+   return mv;
+}
+
+TKalMatrix EXGeoMeasLayer::XvToMv(const TVTrackHit &ht,
+                                  const TVector3   &xv) const
+{
+   // Rref*phi taken within pi of the hit
+
+   TKalMatrix h = XvToMv(xv);
+   if (fModel != kRPhiZ) return h;
+
+   Double_t phim = ht(0,0) / fRref;
+   Double_t dphi = h(0,0) / fRref - phim;
+
+   static const Double_t kPi    = TMath::Pi();
+   static const Double_t kTwoPi = 2 * kPi;
+
+   while (dphi < -kPi) dphi += kTwoPi;
+   while (dphi >  kPi) dphi -= kTwoPi;
+
+   h(0,0) = fRref * (phim + dphi);
+   return h;
+}
+
+TVector3 EXGeoMeasLayer::HitToXv(const TVTrackHit &ht) const
+{
+   // An unmeasured coordinate is taken at the layer center.
+
+   if (fModel == kRPhiZ) {
+      Double_t phi = ht(0,0) / fRref;
+      Double_t z   = fNdim > 1 ? ht(1,0) : GetXc().Z();
+      Double_t r   = GetRadius(z);
+      return TVector3(GetXc().X() + r * TMath::Cos(phi),
+                      GetXc().Y() + r * TMath::Sin(phi), z);
+   }
+   Double_t v = fNdim > 1 ? ht(1,0) : 0.;
+   return GetXc() + ht(0,0) * fU + v * fV;
+}
+
+void EXGeoMeasLayer::CalcDhDa(const TVTrackHit &,
+                              const TVector3   &xxv,
+                              const TKalMatrix &dxphiada,
+                                    TKalMatrix &H)  const
+{
+   // Calculate
+   //    H = (@h/@a) = (@h0/@a, @h1/@a)^t
+   // where
+   //        h(a) = (h0, h1)^t: expected meas vector
+   //        a = (drho, phi0, kappa, dz, tanl, t0)
+   //
+
+   Int_t sdim = H.GetNcols();
+   Int_t hdim = TMath::Max(5,sdim-1);
+
+   if (fModel == kRPhiZ) {
+      TVector3 xx   = xxv - GetXc();
+      Double_t xxyy = xx.X() * xx.X() + xx.Y() * xx.Y();
+      for (Int_t i=0; i<hdim; i++) {
+         H(0,i) = fRref * (- (xx.Y() / xxyy) * dxphiada(0,i)
+                           + (xx.X() / xxyy) * dxphiada(1,i));
+         if (fNdim > 1) H(1,i) = dxphiada(2,i);
+      }
+   } else {
+      for (Int_t i=0; i<hdim; i++) {
+         H(0,i) = fU.X() * dxphiada(0,i) + fU.Y() * dxphiada(1,i)
+                + fU.Z() * dxphiada(2,i);
+         if (fNdim > 1) {
+            H(1,i) = fV.X() * dxphiada(0,i) + fV.Y() * dxphiada(1,i)
+                   + fV.Z() * dxphiada(2,i);
+         }
+      }
+   }
+   if (sdim == 6) {
+      for (Int_t j=0; j<fNdim; j++) H(j,sdim-1) = 0.;
+   }
+}
+
+void EXGeoMeasLayer::ProcessHit(const TVector3  &xx,
+                                      TObjArray &hits)
+{
+   TKalMatrix h = XvToMv(xx);
+
+   Double_t meas [2];
+   Double_t dmeas[2];
+   for (Int_t i=0; i<fNdim; i++) {
+      meas [i] = h(i,0) + gRandom->Gaus(0., fSigma[i]);   // smearing
+      dmeas[i] = fSigma[i];
+   }
+
+   Double_t b = EXVKalDetector::GetBfield();
+   hits.Add(new EXGeoHit(*this, meas, dmeas, xx, b, fNdim));
+}
@@ -0,0 +1,87 @@
+#ifndef __EXGEOMEASLAYER__
+#define __EXGEOMEASLAYER__
+//*************************************************************************
+//* ======================
+//*  EXGeoMeasLayer Class
+//* ======================
+//*
+//* (Description)
+//*   Base class of the measurement layers read from a geometry file.
+//*   Two measurement models are provided:
+//*     kRPhiZ : (Rref*phi, z), phi about the z axis through the layer
+//*              center, Rref a fixed reference radius of the layer
+//*     kUV    : (u, v) along two orthogonal axes in a plane
+//*   Either model measures the first (1-dim) or both (2-dim)
+//*   coordinates. The concrete layers add the surface.
+//* (Requires)
+//*     EXVMeasLayer
+//* (Provides)
+//*     class EXGeoMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*************************************************************************
+//
+#include "TVector3.h"
+#include "TKalMatrix.h"
+#include "EXVMeasLayer.h"
+#include "KalTrackDim.h"
+
+class TVTrackHit;
+
+class EXGeoMeasLayer : public EXVMeasLayer {
+public:
+   enum EModel { kRPhiZ = 0, kUV };
+
+   // Ctors and Dtor
+
+   EXGeoMeasLayer(TMaterial &min,
+                  TMaterial &mout,
+                  Int_t      model,
+                  Int_t      ndim,
+                  Double_t   sigma0,
+                  Double_t   sigma1,
+                  Bool_t     type = EXVMeasLayer::kActive,
+            const Char_t    *name = "GeoML");
+   virtual ~EXGeoMeasLayer();
+
+   // Parrent's pure virtuals that must be implemented
+
+   virtual TKalMatrix XvToMv    (const TVTrackHit &ht,
+                                 const TVector3   &xv) const;
+   virtual TKalMatrix XvToMv    (const TVector3   &xv) const;
+   virtual TVector3   HitToXv   (const TVTrackHit &ht) const;
+   virtual void       CalcDhDa  (const TVTrackHit &ht,
+                                 const TVector3   &xv,
+                                 const TKalMatrix &dxphiada,
+                                       TKalMatrix &H)  const;
+   virtual void       ProcessHit(const TVector3   &xx,
+                                       TObjArray  &hits);
+
+   // Surface dependent parts
+
+   virtual const TVector3 & GetXc    ()           const = 0;
+   virtual       Double_t   GetRadius(Double_t /* z */) const { return fRref; }
+
+   inline Int_t    GetModel   ()        const { return fModel;    }
+   inline Int_t    GetNdim    ()        const { return fNdim;     }
+   inline Double_t GetSigma   (Int_t i) const { return fSigma[i]; }
+   inline Double_t GetRref    ()        const { return fRref;     }
+   inline const TVector3 & GetUaxis() const { return fU;        }
+   inline const TVector3 & GetVaxis() const { return fV;        }
+
+protected:
+   void SetRref(Double_t r) { fRref = r; }
+   void SetAxes(const TVector3 &normal);
+
+private:
+   Int_t    fModel;      // EModel
+   Int_t    fNdim;       // measurement dimension
+   Double_t fSigma[2];   // resolutions
+   Double_t fRref;       // reference radius (kRPhiZ)
+   TVector3 fU;          // u axis (kUV)
+   TVector3 fV;          // v axis (kUV)
+
+   ClassDef(EXGeoMeasLayer,1)   // Base of geometry file layers
+};
+
+#endif
@@ -0,0 +1,88 @@
+//*************************************************************************
+//* ===========================
+//*  EXGeoPlaneMeasLayer Class
+//* ===========================
+//*
+//* (Description)
+//*   Planar measurement layer read from a geometry file.
+//* (Requires)
+//*     EXGeoMeasLayer, TPlane
+//* (Provides)
+//*     class EXGeoPlaneMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Added GetBoundingVolume().
+//*************************************************************************
+//
+
+#include "EXGeoPlaneMeasLayer.h"
+#include "TMath.h"
+
+ClassImp(EXGeoPlaneMeasLayer)
+
+EXGeoPlaneMeasLayer::EXGeoPlaneMeasLayer(TMaterial &min,
+                                         TMaterial &mout,
+                                   const TVector3  &xc,
+                                   const TVector3  &normal,
+                                         Double_t   hu,
+                                         Double_t   hv,
+                                         Double_t   rmin,
+                                         Double_t   rmax,
+                                         Double_t   sortingpolicy,
+                                         Int_t      ndim,
+                                         Double_t   sigma0,
+                                         Double_t   sigma1,
+                                         Bool_t     type,
+                                   const Char_t    *name)
+                   : EXGeoMeasLayer(min, mout, kUV, ndim, sigma0, sigma1, type, name),
+                     TPlane(xc, normal),
+                     fHu(hu),
+                     fHv(hv),
+                     fRmin(rmin),
+                     fRmax(rmax),
+                     fSortingPolicy(sortingpolicy)
+{
+   SetAxes(normal);
+}
+
+EXGeoPlaneMeasLayer::~EXGeoPlaneMeasLayer()
+{
+}
+
+Bool_t EXGeoPlaneMeasLayer::IsOnSurface(const TVector3 &xx) const
+{
+   const Double_t kTol = 1.e-4;
+
+   TVector3 dx = xx - GetXc();
+   if (TMath::Abs(dx * GetNormal().Unit()) > kTol) return kFALSE;
+
+   Double_t u = dx * GetUaxis();
+   Double_t v = dx * GetVaxis();
+   if (fHu > 0. && TMath::Abs(u) > fHu) return kFALSE;
+   if (fHv > 0. && TMath::Abs(v) > fHv) return kFALSE;
+   Double_t rr = u * u + v * v;
+   if (rr < fRmin * fRmin)              return kFALSE;
+   if (fRmax > 0. && rr > fRmax * fRmax) return kFALSE;
+   return kTRUE;
+}
+
+Bool_t EXGeoPlaneMeasLayer::GetBoundingVolume(BoundingVolume &bv) const
+{
+   // the rectangle |u| <= hu, |v| <= hv, cut to the square around rmax
+
+   Double_t hu = fHu > 0. ? fHu : fRmax;
+   Double_t hv = fHv > 0. ? fHv : fRmax;
+   if (fRmax > 0.) {
+      hu = TMath::Min(hu, fRmax);
+      hv = TMath::Min(hv, fRmax);
+   }
+   if (hu <= 0. || hv <= 0.) return kFALSE;
+
+   TVector3 xx[4];
+   xx[0] = GetXc() - hu * GetUaxis() - hv * GetVaxis();
+   xx[1] = GetXc() + hu * GetUaxis() - hv * GetVaxis();
+   xx[2] = GetXc() + hu * GetUaxis() + hv * GetVaxis();
+   xx[3] = GetXc() - hu * GetUaxis() + hv * GetVaxis();
+   SetPolygonVolume(4, xx, bv);
+   return kTRUE;
+}
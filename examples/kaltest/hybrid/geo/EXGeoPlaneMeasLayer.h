@@ -0,0 +1,67 @@
+#ifndef __EXGEOPLANEMEASLAYER__
+#define __EXGEOPLANEMEASLAYER__
+//*************************************************************************
+//* ===========================
+//*  EXGeoPlaneMeasLayer Class
+//* ===========================
+//*
+//* (Description)
+//*   Planar measurement layer read from a geometry file: a rectangle
+//*   |u| <= hu, |v| <= hv (ladders) and/or an annulus rmin <= |(u,v)|
+//*   <= rmax (discs) about its center. A zero bound is not applied.
+//*   Measures (u, v) or u, u being perpendicular to the normal in the
+//*   xy plane (x for a plane normal to z) and v = u x n.
+//*   The sorting policy is given explicitly, as for EXVTXMeasLayer.
+//* (Requires)
+//*     EXGeoMeasLayer, TPlane
+//* (Provides)
+//*     class EXGeoPlaneMeasLayer
+//* (Update Recored)
+//*   2026/10/18                    Original version.
+//*   2026/10/18                    Added GetBoundingVolume().
+//*   2026/10/18                    Added GetShape().
+//*************************************************************************
+//
+#include "TPlane.h"
+#include "EXGeoMeasLayer.h"
+
+class EXGeoPlaneMeasLayer : public EXGeoMeasLayer, public TPlane {
+public:
+   // Ctors and Dtor
+
+   EXGeoPlaneMeasLayer(TMaterial &min,
+                       TMaterial &mout,
+                 const TVector3  &xc,
+                 const TVector3  &normal,
+                       Double_t   hu,
+                       Double_t   hv,
+                       Double_t   rmin,
+                       Double_t   rmax,
+                       Double_t   sortingpolicy,
+                       Int_t      ndim,
+                       Double_t   sigma0,
+                       Double_t   sigma1,
+                       Bool_t     type = EXVMeasLayer::kActive,
+                 const Char_t    *name = "GeoPlaneML");
+   virtual ~EXGeoPlaneMeasLayer();
+
+   virtual const TVector3 & GetXc      ()                   const { return TPlane::GetXc(); }
+   virtual       Bool_t     IsOnSurface(const TVector3 &xx) const;
+   virtual       Bool_t     GetBoundingVolume(BoundingVolume &bv) const;
+   virtual       Double_t   GetSortingPolicy()             const { return fSortingPolicy; }
+
+   // crossings as those of TPlane, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kPlane; }
+
+private:
+   Double_t fHu;      // half width along u
+   Double_t fHv;      // half width along v
+   Double_t fRmin;    // inner radius
+   Double_t fRmax;    // outer radius
+   Double_t fSortingPolicy; // sorting policy
+
+   ClassDef(EXGeoPlaneMeasLayer,1)   // Planar geometry file layer
+};
+
+#endif
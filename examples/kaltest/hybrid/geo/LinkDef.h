@@ -0,0 +1,15 @@
+#ifdef __CINT__
+
+#pragma link off all globals;
+#pragma link off all classes;
+#pragma link off all functions;
+
+#pragma link C++ class EXGeoKalDetector+;
+#pragma link C++ class EXGeoHit+;
+#pragma link C++ class EXGeoMeasLayer+;
+#pragma link C++ class EXGeoCylMeasLayer+;
+#pragma link C++ class EXGeoHypeMeasLayer+;
+#pragma link C++ class EXGeoConeMeasLayer+;
+#pragma link C++ class EXGeoPlaneMeasLayer+;
+
+#endif
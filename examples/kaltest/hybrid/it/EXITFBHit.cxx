@@ -39,7 +39,7 @@ EXITFBHit::~EXITFBHit()
 
 TKalMatrix EXITFBHit::XvToMv(const TVector3 &xv, Double_t /*t0*/) const
 {
-   return dynamic_cast<const EXITFBMeasLayer &>(GetMeasLayer()).XvToMv(xv);
+   return GetMeasLayer().XvToMv(*this, xv);
 }
 
 void EXITFBHit::DebugPrint(Option_t *) const
@@ -13,6 +13,8 @@
 //*   2005/07/25  Kim, Youngim      Forward & Backward versoin.
 //*
 //*   2011/06/30  D.Kamai       Modified to handle turbine-blade-like FTD.
+//*   2026/10/18                Accept TKalHitView hits.
+//*   2026/10/18                Added GetBoundingVolume().
 //*************************************************************************
 //
 
@@ -24,9 +26,6 @@
 #include <iostream>
 #include <iomanip>
 
-#include "TVirtualPad.h"
-#include "TTRAP.h"
-#include "TNode.h"
 #include "TString.h"
 
 using namespace std;
@@ -83,7 +82,7 @@ TKalMatrix EXITFBMeasLayer::XvToMv(const TVTrackHit &,
 
 TVector3 EXITFBMeasLayer::HitToXv(const TVTrackHit &vht) const
 {
-   const EXITFBHit &ht = dynamic_cast<const EXITFBHit &>(vht);
+   const TVTrackHit &ht = vht;   // also a TKalHitView
    
    Double_t x = ht(0,0)*Cosphi()*Cosalpha() + ht(1,0)*Sinphi();
    Double_t y = -ht(0,0)*Sinphi()*Cosalpha() + ht(1,0)*Cosphi();
@@ -135,6 +134,24 @@ Bool_t EXITFBMeasLayer::IsOnSurface(const TVector3 &xx) const
   return kFALSE;
 }
 
+Bool_t EXITFBMeasLayer::GetBoundingVolume(BoundingVolume &bv) const
+{
+  // the trapezoid Rin <= y <= Rout, |x| <= y*dxMax/(2*Rout) of IsOnSurface()
+
+  Double_t x[4] = { -GetRin()*GetdxMax()/(2*GetRout()), +GetRin()*GetdxMax()/(2*GetRout()),
+                    +GetdxMax()/2,                      -GetdxMax()/2 };
+  Double_t y[4] = { GetRin(), GetRin(), GetRout(), GetRout() };
+
+  TVector3 xx[4];
+  for (Int_t i=0; i<4; i++) {
+    xx[i].SetXYZ( x[i]*Cosphi()*Cosalpha() + y[i]*Sinphi(),
+                 -x[i]*Sinphi()*Cosalpha() + y[i]*Cosphi(),
+                  GetXc().Z() + x[i]*Sinalpha());
+  }
+  SetPolygonVolume(4, xx, bv);
+  return kTRUE;
+}
+
 void EXITFBMeasLayer::ProcessHit(const TVector3  &xx,
                                        TObjArray &hits)
 {
@@ -157,46 +174,3 @@ void EXITFBMeasLayer::ProcessHit(const TVector3  &xx,
    Double_t b = EXITKalDetector::GetBfield();
    hits.Add(new EXITFBHit(*this, meas, dmeas, xx, b));
 }
-
-// -----------------
-//  Draw
-// -----------------
-//    Drawing method for event display
-//
-void EXITFBMeasLayer::Draw(Int_t color, const Char_t *opt)
-{
-  Double_t upperbase = 0;
-  Double_t lowerbase = 0;
-  Double_t theta = 0;
-  Double_t dy = (GetRout()-GetRin())/2;
-  Double_t thick = 0.02; // [cm]
-  Double_t z = GetXc().Z();
-  {z >0 ? z += thick/2 : z -= thick/2; }
-  if (!gPad) return;
-  if (!IsActive()) return;
-  if (!GetNodePtr()) {
-    const Char_t *name  = GetMLName().Data();
-    const Char_t *nname = (GetMLName() + "Node").Data();
-
-    if(GetMode()==0){
-      upperbase = GetdxMax()/2;
-      lowerbase = GetdxMin()/2;
-    }else{
-      upperbase = GetdxMax()/4;
-      lowerbase = GetdxMin()/4;
-      theta = GetMode()*TMath::ATan((upperbase-lowerbase)/(2*dy))*180/TMath::Pi();
-    }
-    TTRAP *trap = new TTRAP(name,name,"Si",dy,theta, 0,
-			    thick/2, lowerbase, lowerbase, 0,
-			    thick/2, upperbase, upperbase, 0 );      
-    trap->SetBit(kCanDelete);
-    Double_t rmat[9]   = { Cosphi()*Cosalpha(), -Sinphi()*Cosalpha(), Sinalpha(),
-                	   -Cosphi()*Sinalpha(), Sinphi()*Sinalpha(),  Cosalpha(),
-			   Sinphi(),           Cosphi(),             0};
-    TRotMatrix *rmatp   = new TRotMatrix( "rmat", "rmat", rmat);
-    TNode *nodep = new TNode(nname,nname,trap,GetXc().X()+GetMode()*(GetdxMax()+GetdxMin())/8,GetXc().Y(),z+Sinalpha()*GetMode()*(GetdxMax()+GetdxMin())/8,rmatp,"");
-    nodep->SetLineColor(color);
-    nodep->SetLineWidth(0.01);
-    SetNodePtr(nodep);
-  }
-}
@@ -13,8 +13,11 @@
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
 //*   2005/07/25  Kim, Youngim      Forward & Backward version.
+//*   2026/10/18                    Added GetShape().
 //*
 //*   2011/06/30  D.Kamai       Modified to handle turbine-blade-like FTD.
+//*   2026/10/18                Added GetBoundingVolume().
+//*   2026/10/18                Draw() moved to EXHYBDisplay.
 //*************************************************************************
 //
 #include "TVector3.h"
@@ -60,6 +63,7 @@ public:
 
    
    virtual Bool_t     IsOnSurface       (const TVector3 &xx) const;
+   virtual Bool_t     GetBoundingVolume (BoundingVolume &bv) const;
 
    virtual void       ProcessHit        (const TVector3  &xx,
                                          TObjArray &hits);
@@ -78,8 +82,9 @@ public:
    inline Double_t Cosalpha() const {return TMath::Abs(GetNormal().Z()/GetNormal().Mag()); }
    inline Double_t Sinalpha() const {return -TMath::Abs(GetNormal().X()/Cosphi()); }
    
-   using TAttDrawable::Draw;
-   virtual void Draw(Int_t color, const Char_t *opt);
+   // crossings as those of TPlane, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kPlane; }
 
 private:
    Double_t fSortingPolicy;
@@ -1,5 +1,4 @@
 #include "EXITHit.h"
-#include "TMath.h"
 
 #include <iostream>
 #include <iomanip>
@@ -40,26 +39,7 @@ EXITHit::~EXITHit()
 
 TKalMatrix EXITHit::XvToMv(const TVector3 &xv, Double_t /*t0*/) const
 {
-   const EXVMeasLayer &ms
-                 = dynamic_cast<const EXVMeasLayer &>(GetMeasLayer());
-   TKalMatrix h  = ms.XvToMv(*this,xv);
-   Double_t r    = xv.Pt();                 // by Kim, Youngim  2005/07/25
-   Double_t phih = h(0,0) / r;
-   Double_t phim = (*this)(0,0) / r;
-   Double_t dphi = phih - phim;
-
-   static Double_t kPi    = TMath::Pi();
-   static Double_t kTwoPi = 2 * kPi;
-
-   while (dphi < -kPi) dphi += kTwoPi;
-   while (dphi >  kPi) dphi -= kTwoPi;
-
-   h(0,0)  = r * (phim + dphi);
-#ifdef TWO_DIM
-   h(1,0) += 0.;
-#endif
-
-   return h;
+   return GetMeasLayer().XvToMv(*this, xv);
 }
 
 void EXITHit::DebugPrint(Option_t *) const
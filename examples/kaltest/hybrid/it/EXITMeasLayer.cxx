@@ -11,6 +11,7 @@
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
 //*   2005/07/25  Kim, Youngim
+//*   2026/10/18                    Accept TKalHitView hits.
 //*************************************************************************
 //
 
@@ -20,9 +21,6 @@
 #include "TMath.h"
 #include "EXITKalDetector.h"
 
-#include "TVirtualPad.h"
-#include "TTUBE.h"
-#include "TNode.h"
 #include "TString.h"
 
 ClassImp(EXITMeasLayer)
@@ -63,15 +61,29 @@ TKalMatrix EXITMeasLayer::XvToMv(const TVector3 &xv) const
    return mv;
 }
 
-TKalMatrix EXITMeasLayer::XvToMv(const TVTrackHit &,
+TKalMatrix EXITMeasLayer::XvToMv(const TVTrackHit &ht,
                                  const TVector3   &xv) const
 {
-   return XvToMv(xv);
+   // r*phi taken within pi of the hit
+
+   TKalMatrix h    = XvToMv(xv);
+   Double_t   r    = xv.Pt();
+   Double_t   phim = ht(0,0) / r;
+   Double_t   dphi = h(0,0) / r - phim;
+
+   static const Double_t kPi    = TMath::Pi();
+   static const Double_t kTwoPi = 2 * kPi;
+
+   while (dphi < -kPi) dphi += kTwoPi;
+   while (dphi >  kPi) dphi -= kTwoPi;
+
+   h(0,0) = r * (phim + dphi);
+   return h;
 }
 
 TVector3 EXITMeasLayer::HitToXv(const TVTrackHit &vht) const
 {
-   const EXITHit &ht = dynamic_cast<const EXITHit &>(vht);
+   const TVTrackHit &ht = vht;   // also a TKalHitView
 
    Double_t phi = ht(0,0) / GetR();
 #ifdef TWO_DIM
@@ -157,26 +169,3 @@ void EXITMeasLayer::ProcessHit(const TVector3  &xx,
    Double_t b = EXITKalDetector::GetBfield();
    hits.Add(new EXITHit(*this, meas, dmeas, xx, b));
 }
-
-// -----------------
-//  Draw
-// -----------------
-//    Drawing method for event display
-//
-void EXITMeasLayer::Draw(Int_t color, const Char_t *opt)
-{
-   if (!gPad) return;
-   if (!IsActive()) return;
-   if (!GetNodePtr()) {
-      const Char_t *name  = GetMLName().Data();
-      const Char_t *nname = (GetMLName() + "Node").Data();
-      Double_t r    = GetR();
-      Double_t hlen = GetZmax();
-      TTUBE *tubep = new TTUBE(name,name,"void",r,r,hlen);
-      tubep->SetBit(kCanDelete);
-      TNode *nodep = new TNode(nname,nname,name);
-      nodep->SetLineColor(color);
-      nodep->SetLineWidth(0.01);
-      SetNodePtr(nodep);
-   }
-}
@@ -13,6 +13,8 @@
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
 //*   2005/07/25  Kim, Youngim 
+//*   2026/10/18                    Draw() moved to EXHYBDisplay.
+//*   2026/10/18                    Added GetShape().
 //*************************************************************************
 //
 #include "TVector3.h"
@@ -52,8 +54,9 @@ public:
    Double_t GetSigmaX() const { return fSigmaX; }
    Double_t GetSigmaZ() const { return fSigmaZ; }
 
-   using TAttDrawable::Draw;
-   virtual void Draw(Int_t color, const Char_t *opt);
+   // crossings as those of TCylinder, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kCylinder; }
 
 private:
    Double_t fSigmaX;      // sigma_x
@@ -3,12 +3,10 @@
 
 #include "TVector3.h"
 #include "TVKalDetector.h"
-#include "TAttDrawable.h"
 
 class TVMeasLayer;
-class TNode;
 
-class EXVKalDetector : public TVKalDetector, public TAttDrawable {
+class EXVKalDetector : public TVKalDetector {
 public:
    EXVKalDetector(Int_t m = 100);
    virtual ~EXVKalDetector();
@@ -20,16 +18,9 @@ public:
    static Double_t GetBfield (const TVector3 &xx = TVector3(0., 0., 0.))
                              { return fgBfield; }
 
-   using  TAttDrawable::Draw;
-   virtual void Draw(Int_t color, const Char_t *opt = "");
-
-   static void   SetNodePtr(TNode *nodep) { fgNodePtr = nodep; }
-   static TNode *GetNodePtr();
-
 private:
    Bool_t  fIsPowerOn;         // power status
    static Double_t fgBfield;   // magnetic field [kG]
-   static TNode   *fgNodePtr;  // pointer to TNode
 
    ClassDef(EXVKalDetector,1)   // Sample hit class
 };
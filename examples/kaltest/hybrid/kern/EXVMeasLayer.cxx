@@ -26,8 +26,7 @@ EXVMeasLayer::EXVMeasLayer(TMaterial &min,
                            Bool_t     isactive,
                      const Char_t    *name)  
             : TVMeasLayer(min, mout, isactive),
-	      fName(name),
-	      fNodePtr(0)
+	      fName(name)
 {
 }
 
@@ -12,6 +12,7 @@
 //*     class EXVMeasLayer
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
+//*   2026/10/18                    Drawing moved to EXHYBDisplay.
 //*
 //*************************************************************************
 //
@@ -19,14 +20,12 @@
 #include "TKalMatrix.h"
 #include "TCylinder.h"
 #include "TVMeasLayer.h"
-#include "TAttDrawable.h"
 #include "KalTrackDim.h"
 #include "TString.h"
 
 class TVTrackHit;
-class TNode;
 
-class EXVMeasLayer : public TVMeasLayer, public TAttDrawable {
+class EXVMeasLayer : public TVMeasLayer {
 public:
    static Bool_t kActive;
    static Bool_t kDummy;
@@ -43,13 +42,9 @@ public:
                                  TObjArray &hits) = 0;
 
    inline TString GetMLName () const { return fName;    }
-   inline TNode  *GetNodePtr() const { return fNodePtr; }
-
-   inline void    SetNodePtr(TNode *nodep) { fNodePtr = nodep; }
 
 private:
    TString  fName;      // layer name
-   TNode   *fNodePtr;   // node pointer
 
    ClassDef(EXVMeasLayer,1)     // Sample measurement layer class
 };
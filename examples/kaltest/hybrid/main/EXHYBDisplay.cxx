@@ -0,0 +1,257 @@
+//*************************************************************************
+//* ===================
+//*  EXHYBDisplay Class
+//* ===================
+//*
+//* (Description)
+//*   Very primitive event display for the hybrid example.
+//* (Requires)
+//*     EXVKalDetector, EXVMeasLayer, TKalTrack
+//* (Provides)
+//*     class EXHYBDisplay
+//* (Update Recored)
+//*   2026/10/18              Original version.
+//*
+//*************************************************************************
+
+#include "EXHYBDisplay.h"
+#include "EXVKalDetector.h"
+#include "EXTPCKalDetector.h"
+#include "EXTPCMeasLayer.h"
+#include "EXBPMeasLayer.h"
+#include "EXBPConeMeasLayer.h"
+#include "EXITMeasLayer.h"
+#include "EXITFBMeasLayer.h"
+#include "EXVTXMeasLayer.h"
+#include "TKalTrack.h"         // from KalTrackLib
+#include "TKalTrackSite.h"     // from KalTrackLib
+
+#include "TVirtualPad.h"       // from ROOT
+#include "TPolyMarker3D.h"     // from ROOT
+#include "TRotMatrix.h"        // from ROOT
+#include "TNode.h"             // from ROOT
+#include "TTUBE.h"             // from ROOT
+#include "TCONE.h"             // from ROOT
+#include "TTRAP.h"             // from ROOT
+#include "TBRIK.h"             // from ROOT
+#include "TString.h"           // from ROOT
+#include "TMath.h"             // from ROOT
+
+TNode                          *EXHYBDisplay::fgNodePtr = 0;
+std::map<const void *, TNode *> EXHYBDisplay::fgNodes;
+
+//_________________________________________________________________________
+// -----------------
+//  GetNodePtr
+// -----------------
+//    World node all detector nodes are attached to
+//
+TNode *EXHYBDisplay::GetNodePtr()
+{
+   if (!fgNodePtr) {
+      new TRotMatrix("rotm","rotm", 10.,80.,10.,80.,10.,80.);
+      new TTUBE("Det","Det","void",210.,210.,260.);
+      fgNodePtr = new TNode("World","World","Det",0.,0.,0.,"rotm");
+   }
+   return fgNodePtr;
+}
+
+//_________________________________________________________________________
+// -----------------
+//  Draw
+// -----------------
+//    Drawing method for a detector: its nodes are created on the first
+//    call and drawn together with the world node
+//
+void EXHYBDisplay::Draw(const EXVKalDetector &det, Int_t color, const Char_t *)
+{
+   if (!gPad) return;
+   TNode *nodep = GetNodePtr();
+   nodep->cd();
+
+   const EXTPCKalDetector *tpcp = dynamic_cast<const EXTPCKalDetector *>(&det);
+   if (tpcp && !fgNodes.count(tpcp)) {
+      TNode *tpcnodep = MakeNode(*tpcp);
+      tpcnodep->SetLineColor(color);
+      tpcnodep->SetLineWidth(0.01);
+      fgNodes[tpcp] = tpcnodep;
+   }
+
+   TIter next(&det);
+   TObject *objp;
+   while ((objp = next())) {
+      const EXVMeasLayer *mlp = dynamic_cast<const EXVMeasLayer *>(objp);
+      if (mlp) DrawLayer(*mlp, color);
+   }
+   nodep->Draw("pad same");
+}
+
+//_________________________________________________________________________
+// -----------------
+//  Draw
+// -----------------
+//    Drawing method for a track: a marker at the pivot of each site
+//
+void EXHYBDisplay::Draw(const TKalTrack &track, Int_t color, const Char_t *)
+{
+   if (!gPad || !track.GetEntries()) return;
+   gPad->cd();
+
+   TPolyMarker3D *pm3dp = new TPolyMarker3D(track.GetEntries());
+   pm3dp->SetBit(TObject::kCanDelete);
+   pm3dp->SetMarkerColor(color);
+   pm3dp->SetMarkerStyle(6);
+
+   Int_t nhits = 0;
+   TIter next(&track);
+   TKalTrackSite *sitep = 0;
+   while ((sitep = static_cast<TKalTrackSite *>(next()))) {
+      TVector3 pos = sitep->GetPivot();
+      pm3dp->SetPoint(nhits, pos.X(), pos.Y(), pos.Z());
+      nhits++;
+   }
+   pm3dp->Draw();
+   gPad->Update();
+}
+
+//_________________________________________________________________________
+// -----------------
+//  DrawLayer
+// -----------------
+//    Creates the node of a layer once; layers without a shape of their
+//    own (TPC, geometry file) and inactive layers are not drawn
+//
+void EXHYBDisplay::DrawLayer(const EXVMeasLayer &ml, Int_t color)
+{
+   if (fgNodes.count(&ml)) return;
+
+   TNode *nodep = 0;
+   if (const EXVTXMeasLayer *p = dynamic_cast<const EXVTXMeasLayer *>(&ml)) {
+      nodep = MakeNode(*p);
+   } else if (!ml.IsActive()) {
+      return;
+   } else if (const EXITMeasLayer *p = dynamic_cast<const EXITMeasLayer *>(&ml)) {
+      nodep = MakeNode(*p);
+   } else if (const EXITFBMeasLayer *p = dynamic_cast<const EXITFBMeasLayer *>(&ml)) {
+      nodep = MakeNode(*p);
+   } else if (const EXBPMeasLayer *p = dynamic_cast<const EXBPMeasLayer *>(&ml)) {
+      nodep = MakeNode(*p);
+   } else if (const EXBPConeMeasLayer *p = dynamic_cast<const EXBPConeMeasLayer *>(&ml)) {
+      nodep = MakeNode(*p);
+   }
+   if (!nodep) return;
+
+   nodep->SetLineColor(color);
+   nodep->SetLineWidth(0.01);
+   fgNodes[&ml] = nodep;
+}
+
+//_________________________________________________________________________
+// -----------------
+//  MakeNode
+// -----------------
+//    Volumes of the detectors and layers
+//
+TNode *EXHYBDisplay::MakeNode(const EXTPCKalDetector &det)
+{
+   EXTPCMeasLayer *inp  = static_cast<EXTPCMeasLayer *>(det.First());
+   EXTPCMeasLayer *outp = static_cast<EXTPCMeasLayer *>(det.Last());
+   Double_t rin  = inp->GetR();
+   Double_t rout = outp->GetR();
+   Double_t hlen = outp->GetZmax();
+   const Char_t *name  = "TPC";
+   const Char_t *nname = "TPCNode";
+   TTUBE *tubep = new TTUBE(name,name,"void",rin,rout,hlen);
+   tubep->SetBit(TObject::kCanDelete);
+   return new TNode(nname,nname,name);
+}
+
+TNode *EXHYBDisplay::MakeNode(const EXBPMeasLayer &ml)
+{
+   TString name  = ml.GetMLName();
+   TString nname = name + "Node";
+   Double_t r    = ml.GetR();
+   Double_t hlen = ml.GetZmax();
+   TTUBE *tubep = new TTUBE(name,name,"void",r,r,hlen);
+   tubep->SetBit(TObject::kCanDelete);
+   return new TNode(nname,nname,name);
+}
+
+TNode *EXHYBDisplay::MakeNode(const EXBPConeMeasLayer &ml)
+{
+   TString name  = ml.GetMLName();
+   TString nname = name + "Node";
+   Double_t z1   = ml.GetFrontZ();
+   Double_t z2   = ml.GetBackZ();
+   Double_t hlen = TMath::Abs(z2-z1)/2;
+   Double_t r1   = z2 > z1 ? ml.GetFrontR() : ml.GetBackR();
+   Double_t r2   = z2 > z1 ? ml.GetBackR()  : ml.GetFrontR();
+   TCONE *conep = new TCONE(name, name, "void", hlen, r1, r1, r2, r2);
+   conep->SetBit(TObject::kCanDelete);
+   return new TNode(nname,nname,name,0.,0.,(z1+z2)/2);
+}
+
+TNode *EXHYBDisplay::MakeNode(const EXITMeasLayer &ml)
+{
+   TString name  = ml.GetMLName();
+   TString nname = name + "Node";
+   Double_t r    = ml.GetR();
+   Double_t hlen = ml.GetZmax();
+   TTUBE *tubep = new TTUBE(name,name,"void",r,r,hlen);
+   tubep->SetBit(TObject::kCanDelete);
+   return new TNode(nname,nname,name);
+}
+
+TNode *EXHYBDisplay::MakeNode(const EXITFBMeasLayer &ml)
+{
+   TString name  = ml.GetMLName();
+   TString nname = name + "Node";
+   Double_t upperbase = 0;
+   Double_t lowerbase = 0;
+   Double_t theta = 0;
+   Double_t dy    = (ml.GetRout()-ml.GetRin())/2;
+   Double_t thick = 0.02; // [cm]
+   Double_t z     = ml.GetXc().Z();
+   z > 0 ? z += thick/2 : z -= thick/2;
+
+   if (ml.GetMode() == 0) {
+      upperbase = ml.GetdxMax()/2;
+      lowerbase = ml.GetdxMin()/2;
+   } else {
+      upperbase = ml.GetdxMax()/4;
+      lowerbase = ml.GetdxMin()/4;
+      theta = ml.GetMode()*TMath::ATan((upperbase-lowerbase)/(2*dy))*180/TMath::Pi();
+   }
+   TTRAP *trap = new TTRAP(name,name,"Si",dy,theta, 0,
+                           thick/2, lowerbase, lowerbase, 0,
+                           thick/2, upperbase, upperbase, 0 );
+   trap->SetBit(TObject::kCanDelete);
+   Double_t rmat[9] = {  ml.Cosphi()*ml.Cosalpha(), -ml.Sinphi()*ml.Cosalpha(), ml.Sinalpha(),
+                        -ml.Cosphi()*ml.Sinalpha(),  ml.Sinphi()*ml.Sinalpha(), ml.Cosalpha(),
+                         ml.Sinphi(),                ml.Cosphi(),               0};
+   TRotMatrix *rmatp = new TRotMatrix("rmat", "rmat", rmat);
+   Double_t dxz = ml.GetMode()*(ml.GetdxMax()+ml.GetdxMin())/8;
+   return new TNode(nname,nname,trap,
+                    ml.GetXc().X()+dxz, ml.GetXc().Y(), z+ml.Sinalpha()*dxz,
+                    rmatp,"");
+}
+
+TNode *EXHYBDisplay::MakeNode(const EXVTXMeasLayer &ml)
+{
+   static const Double_t kPhi0 = TMath::PiOver2();
+
+   TString name  = ml.GetMLName();
+   TString nname = name + "Node";
+   TBRIK *brikp = new TBRIK(name,name,"Si",ml.GetXiwidth()/2,0,ml.GetZetawidth()/2);
+   brikp->SetBit(TObject::kCanDelete);
+   Double_t phi  = ml.GetNormal().Phi();
+   Double_t dphi = phi - kPhi0;
+   Double_t rmat[9] = {  TMath::Cos(dphi), TMath::Sin(dphi), 0,
+                        -TMath::Sin(dphi), TMath::Cos(dphi), 0,
+                                        0,                0, 1};
+   TRotMatrix *rmatp = new TRotMatrix("rmat", "rmat", rmat);
+   return new TNode(nname,nname,brikp,
+                    ml.GetXc().X() - ml.GetXioffset()*TMath::Sin(phi),
+                    ml.GetXc().Y() + ml.GetXioffset()*TMath::Cos(phi), 0,
+                    rmatp,"");
+}
@@ -0,0 +1,60 @@
+#ifndef __EXHYBDISPLAY__
+#define __EXHYBDISPLAY__
+//*************************************************************************
+//* ===================
+//*  EXHYBDisplay Class
+//* ===================
+//*
+//* (Description)
+//*   Very primitive event display for the hybrid example: draws the
+//*   detectors as TNode/TShape volumes and a track as the pivots of
+//*   its sites. Kept out of the detector, layer and track classes so
+//*   that programs without graphics (EXHYBBatch, EXHYBBench, ...) do
+//*   not link the 3D drawing code.
+//* (Requires)
+//*     EXVKalDetector, EXVMeasLayer, TKalTrack
+//* (Provides)
+//*     class EXHYBDisplay
+//* (Update Recored)
+//*   2026/10/18              Original version; taken from the Draw()
+//*                           methods of the detector and layer classes.
+//*
+//*************************************************************************
+
+#include "Rtypes.h"
+#include <map>
+
+class TNode;
+class TKalTrack;
+class EXVKalDetector;
+class EXVMeasLayer;
+class EXTPCKalDetector;
+class EXBPMeasLayer;
+class EXBPConeMeasLayer;
+class EXITMeasLayer;
+class EXITFBMeasLayer;
+class EXVTXMeasLayer;
+
+class EXHYBDisplay {
+public:
+   static void   Draw(const EXVKalDetector &det,   Int_t color, const Char_t *opt = "");
+   static void   Draw(const TKalTrack      &track, Int_t color, const Char_t *opt = "");
+
+   static TNode *GetNodePtr();
+
+private:
+   static void   DrawLayer(const EXVMeasLayer &ml, Int_t color);
+
+   static TNode *MakeNode(const EXTPCKalDetector  &det);
+   static TNode *MakeNode(const EXBPMeasLayer     &ml);
+   static TNode *MakeNode(const EXBPConeMeasLayer &ml);
+   static TNode *MakeNode(const EXITMeasLayer     &ml);
+   static TNode *MakeNode(const EXITFBMeasLayer   &ml);
+   static TNode *MakeNode(const EXVTXMeasLayer    &ml);
+
+private:
+   static TNode                           *fgNodePtr; // world node
+   static std::map<const void *, TNode *>  fgNodes;   // nodes of drawn objects
+};
+
+#endif
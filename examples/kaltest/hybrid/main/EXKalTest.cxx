@@ -15,25 +15,34 @@
 #include "EXITHit.h"
 #include "EXITFBHit.h"
 #include "EXTPCHit.h"
+#include "EXGeoKalDetector.h"
+#include "EXGeoHit.h"
 #include "EXEventGen.h"
 #include "EXHYBTrack.h"
+#include "EXHYBDisplay.h"
+#include "TKalTrackSeeder.h"
+#include "TKalTrackWriter.h"
+#include "TKalCradleSnapshot.h"
 
 #include "TCanvas.h"
 #include "TView.h"
-#include "TRotMatrix.h"
-#include "TTUBE.h"
-#include "TNode.h"
 #include "TString.h"
 
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <fstream>
 
 
 /**************************************************************************
  * Changes:
  * F.Gaede, 10.11.2010 : added track parameters d0,tnl and errors^2 
  *                       d0err2,fi0err2,cpaerr2,dzerr2,tnlerr2 to ntuple
+ * 2026/10/18          : write fitted tracks to h.ktr (TKalTrackWriter)
+ *                       and compare its size with ROOT streaming
+ * 2026/10/18          : restore the closed cradle from toygld.snp
+ * 2026/10/18          : -g <file> takes the detector from a geometry file
+ * 2026/10/18          : event display drawn by EXHYBDisplay
  **************************************************************************/
 
 //FG: if this is active errors^2 for fi0, tnl and cpa are partly negative !?
@@ -51,9 +60,18 @@ int main (Int_t argc, Char_t **argv)
    // ===================================================================
 
    Int_t    offset  = 0;
-   if (argc > 1 && TString(argv[1]) == "-b") {
-      offset = 1;
-      gROOT->SetBatch();   // batch mode without event display
+   const Char_t *geofile = 0;   // geometry file, if any
+   while (argc > offset + 1) {
+      TString opt(argv[1+offset]);
+      if (opt == "-b") {
+         offset++;
+         gROOT->SetBatch();   // batch mode without event display
+      } else if (opt == "-g" && argc > offset + 2) {
+         geofile = argv[2+offset];
+         offset += 2;
+      } else {
+         break;
+      }
    }
 
    Double_t pt      =  1.;   // default Pt [GeV]
@@ -109,12 +127,22 @@ int main (Int_t argc, Char_t **argv)
    EXVTXKalDetector vtxdet; // vertex detector (vtx)
    EXITKalDetector  itdet;  // intermediate tracker (it)
    EXTPCKalDetector tpcdet; // TPC (tpc)
-
-   toygld.Install(bmpipe);  // install bp into its toygld
-   toygld.Install(vtxdet);  // install vtx into its toygld
-   toygld.Install(itdet);   // install it into its toygld
-   toygld.Install(tpcdet);  // install tpc into its toygld
-   toygld.Close();          // close the cradle
+   EXGeoKalDetector geodet; // detector from a geometry file (-g)
+
+   if (geofile) {
+      if (!geodet.Load(geofile)) return 1;
+      toygld.Install(geodet);  // install it instead
+   } else {
+      toygld.Install(bmpipe);  // install bp into its toygld
+      toygld.Install(vtxdet);  // install vtx into its toygld
+      toygld.Install(itdet);   // install it into its toygld
+      toygld.Install(tpcdet);  // install tpc into its toygld
+   }
+   TString snapfile = geofile ? TString(geofile) + ".snp" : TString("toygld.snp");
+   if (!TKalCradleSnapshot::Restore(snapfile.Data(), toygld)) {
+      toygld.Close();       // close the cradle
+      TKalCradleSnapshot::Save(snapfile.Data(), toygld);
+   }
    toygld.Sort();           // sort meas. layers from inside to outside
 
    bmpipe.PowerOff();       // power off bp not to process hit
@@ -162,6 +190,10 @@ int main (Int_t argc, Char_t **argv)
    sout << ends;
    TNtupleD *hTrackMonitor = new TNtupleD("track", "", sout.str().data());
 
+   ofstream        recfile("h.ktr", ios::binary);
+   TKalTrackWriter recwriter(recfile);   // compact track records
+   Long64_t        nbytesroot = 0;       // same tracks, ROOT streamed
+
    // ===================================================================
    //  Prepare an Event Generator
    // ===================================================================
@@ -201,16 +233,7 @@ int main (Int_t argc, Char_t **argv)
          continue;
       }
 
-      Int_t i1, i2, i3; // (i1,i2,i3) = (1st,mid,last) hit to filter
-      if (gkDir == kIterBackward) {
-         i3 = 0;
-         i1 = kalhits.GetEntries() - 1;
-         i2 = i1 / 2;
-      } else {
-         i1 = 0;
-         i3 = kalhits.GetEntries() - 1;
-         i2 = i3 / 2;
-      }
+      Int_t i1 = gkDir == kIterBackward ? kalhits.GetEntries() - 1 : 0; // 1st hit to filter
 
       // ---------------------------
       //  Create a dummy site: sited
@@ -226,47 +249,41 @@ int main (Int_t argc, Char_t **argv)
          htdp = new EXITFBHit(*dynamic_cast<EXITFBHit *>(ht1p));
       } else if (dynamic_cast<EXTPCHit *>(ht1p)) {
          htdp = new EXTPCHit(*dynamic_cast<EXTPCHit *>(ht1p));
+      } else if (dynamic_cast<EXGeoHit *>(ht1p)) {
+         htdp = new EXGeoHit(*dynamic_cast<EXGeoHit *>(ht1p));
       }
       TVTrackHit &hitd = *htdp;
 
       hitd(0,1) = 1.e6;   // give a huge error to d
-      hitd(1,1) = 1.e6;   // give a huge error to z
+      if (hitd.GetDimension() > 1)
+         hitd(1,1) = 1.e6;   // give a huge error to z
 
       TKalTrackSite &sited = *new TKalTrackSite(hitd);
       sited.SetHitOwner();// site owns hit
       sited.SetOwner();   // site owns states
 
       // ---------------------------
-      //  Create initial helix
+      //  Fit all hits for a seed
       // ---------------------------
 
-      TVTrackHit &h1 = *dynamic_cast<TVTrackHit *>(kalhits.At(i1)); // first hit
-      TVTrackHit &h2 = *dynamic_cast<TVTrackHit *>(kalhits.At(i2)); // middle hit
-      TVTrackHit &h3 = *dynamic_cast<TVTrackHit *>(kalhits.At(i3)); // last hit
-      TVector3    x1 = h1.GetMeasLayer().HitToXv(h1);
-      TVector3    x2 = h2.GetMeasLayer().HitToXv(h2);
-      TVector3    x3 = h3.GetMeasLayer().HitToXv(h3);
-      THelicalTrack helstart(x1, x2, x3, h1.GetBfield(), gkDir); // initial helix 
+      TObjArray seedhits;              // hits in filtering order
+      TIter     nextseed(&kalhits, gkDir);
+      TObject  *objp;
+      while ((objp = nextseed())) seedhits.Add(objp);
+
+      static TKalTrackSeeder seeder;
+      seeder.SetCovScale(1.e2);        // the same hits are filtered below
+      if (!seeder.Fit(seedhits, gkDir)) {
+         cerr << "<<<<<< Seed fit failed! >>>>>>" << endl;
+         delete &sited;
+         continue;
+      }
 
       // ---------------------------
-      //  Set dummy state to sited
+      //  Set seed state to sited
       // ---------------------------
 
-      static TKalMatrix svd(kSdim,1);
-      svd(0,0) = 0.;                        // dr
-      svd(1,0) = helstart.GetPhi0();        // phi0
-      svd(2,0) = helstart.GetKappa();       // kappa
-      svd(3,0) = 0.;                        // dz
-      svd(4,0) = helstart.GetTanLambda();   // tan(lambda)
-      if (kSdim == 6) svd(5,0) = 0.;        // t0
-
-      static TKalMatrix C(kSdim,kSdim);
-      for (Int_t i=0; i<kSdim; i++) {
-         C(i,i) = 1.e4;   // dummy error matrix
-      }
-
-      sited.Add(new TKalTrackState(svd,C,sited,TVKalSite::kPredicted));
-      sited.Add(new TKalTrackState(svd,C,sited,TVKalSite::kFiltered));
+      seeder.InitSite(sited);
 
       // ---------------------------
       //  Add sited to the kaltrack
@@ -323,6 +340,10 @@ int main (Int_t argc, Char_t **argv)
 
       const TKalMatrix& covK = cursite.GetCurState().GetCovMat() ; 
 
+      recwriter.WriteTrack(kaltrack, TKalTrackWriter::kFirstSite
+                                   | TKalTrackWriter::kLastSite, eventno);
+      nbytesroot += TKalTrackWriter::GetStreamedSize(kaltrack);
+
       // errors^2 of track parameters
       double d0err2  = covK( 0 , 0 )   ;
       double fi0err2 = covK( 1 , 1 )   ;
@@ -389,11 +410,12 @@ int main (Int_t argc, Char_t **argv)
          Int_t ierr;
          vwp->SetView(10.,80.,80.,ierr);
 
-         bmpipe.Draw(40);
-         vtxdet.Draw(40);
-         itdet.Draw(40);
-         tpcdet.Draw(40);
-         kaltrack.Draw(2,"");         
+         EXHYBDisplay::Draw(bmpipe, 40);
+         EXHYBDisplay::Draw(vtxdet, 40);
+         EXHYBDisplay::Draw(itdet,  40);
+         EXHYBDisplay::Draw(tpcdet, 40);
+         EXHYBDisplay::Draw(geodet, 40);
+         EXHYBDisplay::Draw(kaltrack, 2);
 
          cout << "Next? [yes/no/edit/quit] " << flush;
          static const Int_t kMaxLen = 1024;
@@ -419,5 +441,11 @@ int main (Int_t argc, Char_t **argv)
 
    hfile.Write();
 
+   if (recwriter.GetNtracks()) {
+      cerr << "Bytes per track: " << recwriter.GetBytesPerTrack() << " (h.ktr), "
+           << Double_t(nbytesroot) / recwriter.GetNtracks()
+           << " (ROOT streamed)" << endl;
+   }
+
    return 0;
 }
@@ -1,6 +1,5 @@
 #include "EXTPCHit.h"
 #include "EXTPCMeasLayer.h"
-#include "TMath.h"
 
 #include <iostream>
 #include <iomanip>
@@ -47,23 +46,8 @@ EXTPCHit::~EXTPCHit()
 
 TKalMatrix EXTPCHit::XvToMv(const TVector3 &xv, Double_t t0) const
 {
-   const EXTPCMeasLayer &ms
-                 = dynamic_cast<const EXTPCMeasLayer &>(GetMeasLayer());
-   TKalMatrix h  = ms.XvToMv(xv, GetSide());
-   Double_t r    = ms.GetR();
-   Double_t phih = h(0,0) / r;
-   Double_t phim = (*this)(0,0) / r;
-   Double_t dphi = phih - phim;
-
-   static Double_t kPi    = TMath::Pi();
-   static Double_t kTwoPi = 2 * kPi;
-
-   while (dphi < -kPi) dphi += kTwoPi;
-   while (dphi >  kPi) dphi -= kTwoPi;
-
-   h(0,0)  = r * (phim + dphi);
+   TKalMatrix h = GetMeasLayer().XvToMv(*this, xv);
    h(1,0) += fVdrift * t0;
-
    return h;
 }
 
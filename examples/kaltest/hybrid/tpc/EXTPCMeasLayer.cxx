@@ -10,12 +10,14 @@
 //*     class EXTPCMeasLayer
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
+//*   2026/10/18                    Accept TKalHitView hits.
 //*
 //*************************************************************************
 //
 
 #include "EXTPCMeasLayer.h"
 #include "EXTPCHit.h"
+#include "TKalHitView.h"
 #include "EXTPCKalDetector.h"
 #include "EXEventGen.h"
 #include "TRandom.h"
@@ -59,15 +61,29 @@ TKalMatrix EXTPCMeasLayer::XvToMv(const TVector3 &xv,
 TKalMatrix EXTPCMeasLayer::XvToMv(const TVTrackHit &vht,
                                   const TVector3   &xv) const
 {
-   return XvToMv(xv, dynamic_cast<const EXTPCHit &>(vht).GetSide());
+   // r*phi taken within pi of the hit
+
+   TKalMatrix h    = XvToMv(xv, GetSide(vht));
+   Double_t   r    = GetR();
+   Double_t   phim = vht(0,0) / r;
+   Double_t   dphi = h(0,0) / r - phim;
+
+   static const Double_t kPi    = TMath::Pi();
+   static const Double_t kTwoPi = 2 * kPi;
+
+   while (dphi < -kPi) dphi += kTwoPi;
+   while (dphi >  kPi) dphi -= kTwoPi;
+
+   h(0,0) = r * (phim + dphi);
+   return h;
 }
 
 TVector3 EXTPCMeasLayer::HitToXv(const TVTrackHit &vht) const
 {
-   const EXTPCHit &ht = dynamic_cast<const EXTPCHit &>(vht);
+   const TVTrackHit &ht = vht;
 
    Double_t phi = ht(0,0) / GetR();
-   Double_t z   = ht.GetSide() * (GetLength() * 0.5 - ht(1,0));
+   Double_t z   = GetSide(ht) * (GetLength() * 0.5 - ht(1,0));
    Double_t x   = GetR() * TMath::Cos(phi);
    Double_t y   = GetR() * TMath::Sin(phi);
 
@@ -79,7 +95,7 @@ void EXTPCMeasLayer::CalcDhDa(const TVTrackHit &vht,
                               const TKalMatrix &dxphiada,
                                     TKalMatrix &H)  const
 {
-   const EXTPCHit &ht = dynamic_cast<const EXTPCHit &>(vht);
+   const TVTrackHit &ht = vht;
 
    // Calculate
    //    H = (@h/@a) = (@phi/@a, @z/@a)^t
@@ -101,14 +117,30 @@ void EXTPCMeasLayer::CalcDhDa(const TVTrackHit &vht,
       H(0,i) = - (yv / xxyy) * dxphiada(0,i) 
                + (xv / xxyy) * dxphiada(1,i);
       H(0,i) *= GetR();
-      H(1,i) = - ht.GetSide() *  dxphiada(2,i);
+      H(1,i) = - GetSide(ht) *  dxphiada(2,i);
    }
    if (sdim == 6) {
       H(0,sdim-1) = 0.;
-      H(1,sdim-1) = ht.GetVdrift();
+      H(1,sdim-1) = GetVdrift(ht);
    }
 }
 
+Int_t EXTPCMeasLayer::GetSide(const TVTrackHit &ht)
+{
+   // EXTPCHit, or TKalHitView with the side as flag
+
+   const EXTPCHit *hp = dynamic_cast<const EXTPCHit *>(&ht);
+   return hp ? hp->GetSide() : dynamic_cast<const TKalHitView &>(ht).GetFlag();
+}
+
+Double_t EXTPCMeasLayer::GetVdrift(const TVTrackHit &ht)
+{
+   // EXTPCHit, or TKalHitView with the drift velocity as d(d)/d(t0)
+
+   const EXTPCHit *hp = dynamic_cast<const EXTPCHit *>(&ht);
+   return hp ? hp->GetVdrift() : dynamic_cast<const TKalHitView &>(ht).GetDhDt0(1);
+}
+
 Double_t EXTPCMeasLayer::GetSigmaX(Double_t zdrift) const
 {
    return TMath::Sqrt(fSigmaX0 * fSigmaX0 + fSigmaX1 * fSigmaX1 * zdrift);
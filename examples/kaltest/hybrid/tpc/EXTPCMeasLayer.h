@@ -12,6 +12,8 @@
 //*     class EXTPCMeasLayer
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
+//*   2026/10/18                    Added GetSide() and GetVdrift().
+//*   2026/10/18                    Added GetShape().
 //*
 //*************************************************************************
 //
@@ -55,6 +57,15 @@ public:
    Double_t GetSigmaX(Double_t z) const;
    Double_t GetSigmaZ()           const { return fSigmaZ; }
 
+   // Side and drift velocity of an EXTPCHit or a TKalHitView
+
+   static Int_t    GetSide  (const TVTrackHit &ht);
+   static Double_t GetVdrift(const TVTrackHit &ht);
+
+   // crossings as those of TCylinder, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kCylinder; }
+
 private:
    Double_t fSigmaX0;   // xy resolution
    Double_t fSigmaX1;   // xy resolution
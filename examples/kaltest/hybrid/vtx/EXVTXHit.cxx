@@ -1,6 +1,5 @@
 #include "EXVTXHit.h"
 #include "EXVTXMeasLayer.h"
-#include "TMath.h"
 
 #include <iostream>
 #include <iomanip>
@@ -41,7 +40,7 @@ EXVTXHit::~EXVTXHit()
 
 TKalMatrix EXVTXHit::XvToMv(const TVector3 &xv, Double_t /*t0*/) const
 {
-   return dynamic_cast<const EXVTXMeasLayer &>(GetMeasLayer()).XvToMv(xv);
+   return GetMeasLayer().XvToMv(*this, xv);
 }
 
 void EXVTXHit::DebugPrint(Option_t *) const
@@ -12,6 +12,8 @@
 //*   2003/09/30  Y.Nakashima       Original version.
 //*
 //*   2011/06/17  D.Kamai           Modified to handle ladder structure.
+//*   2026/10/18                    Accept TKalHitView hits.
+//*   2026/10/18                    Added GetBoundingVolume().
 //*************************************************************************
 //
 #include <iostream>
@@ -22,10 +24,6 @@
 #include "TVector3.h"
 #include "TRandom.h"
 #include "TMath.h"
-#include "TRotMatrix.h"
-#include "TVirtualPad.h"
-#include "TBRIK.h"
-#include "TNode.h"
 #include "TString.h"
 
 ClassImp(EXVTXMeasLayer)
@@ -79,7 +77,7 @@ TKalMatrix EXVTXMeasLayer::XvToMv(const TVTrackHit &,
 
 TVector3 EXVTXMeasLayer::HitToXv(const TVTrackHit &vht) const
 {
-   const EXVTXHit &ht = dynamic_cast<const EXVTXHit &>(vht);
+   const TVTrackHit &ht = vht;   // also a TKalHitView
 
    Double_t z = ht(1,0);
    Double_t x = ht(0,0)*GetNormal().Y()/GetNormal().Perp() + GetXc().X();
@@ -157,34 +155,26 @@ Bool_t EXVTXMeasLayer::IsOnSurface(const TVector3 &xx) const
   return kFALSE;
 }
 
-
 // -----------------
-//  Draw
+//  GetBoundingVolume
 // -----------------
-//    Drawing method for event display
+//    the ladder rectangle, for ladders parallel to z
 //
-void EXVTXMeasLayer::Draw(Int_t color, const Char_t *opt)
+Bool_t EXVTXMeasLayer::GetBoundingVolume(BoundingVolume &bv) const
 {
-  Double_t phi0 =  1.570796327;
-  Double_t phi;
-   if (!gPad) return;
-   //if (!IsActive()) return;
-   if (!GetNodePtr()){
-     const Char_t *name  = GetMLName().Data();
-     const Char_t *nname = (GetMLName() + "Node").Data();
-     TBRIK *brikp        = new TBRIK(name,name, "Si", GetXiwidth()/2, 0, GetZetawidth()/2);
-     brikp->SetBit(kCanDelete);
-     phi = GetNormal().Phi();
-     Double_t dphi = (Double_t)(phi - phi0);
-     Double_t rmat[9]   = {  TMath::Cos(dphi), TMath::Sin(dphi), 0,
-			    -TMath::Sin(dphi), TMath::Cos(dphi), 0,
-			                   0 ,               0 , 1};
-     TRotMatrix *rmatp   = new TRotMatrix( "rmat", "rmat", rmat);
-     TNode *nodep        = new TNode(nname,nname,brikp, GetXc().X() - GetXioffset()*TMath::Sin(phi), GetXc().Y() + GetXioffset()*TMath::Cos(phi), 0, rmatp,"");
-     nodep->SetLineColor(color);
-     nodep->SetLineWidth(0.01);	 
-     SetNodePtr(nodep);    
-
-   }
-
+  if (GetNormal().Z() != 0.) return kFALSE;
+
+  Double_t tx    =  GetNormal().Y()/GetNormal().Perp();
+  Double_t ty    = -GetNormal().X()/GetNormal().Perp();
+  Double_t ximin = -GetXiwidth()/2 - GetXioffset();
+  Double_t ximax =  GetXiwidth()/2 - GetXioffset();
+  Double_t zeta  =  GetZetawidth()/2;
+
+  TVector3 xx[4];
+  xx[0].SetXYZ(GetXc().X() + ximin*tx, GetXc().Y() + ximin*ty, -zeta);
+  xx[1].SetXYZ(GetXc().X() + ximax*tx, GetXc().Y() + ximax*ty, -zeta);
+  xx[2].SetXYZ(GetXc().X() + ximax*tx, GetXc().Y() + ximax*ty, +zeta);
+  xx[3].SetXYZ(GetXc().X() + ximin*tx, GetXc().Y() + ximin*ty, +zeta);
+  SetPolygonVolume(4, xx, bv);
+  return kTRUE;
 }
@@ -12,8 +12,11 @@
 //*     class EXVTXMeasLayer
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
+//*   2026/10/18                    Added GetShape().
 //*
 //*   2011/06/17  D.Kamai           Modified to handle ladder structure.
+//*   2026/10/18                    Added GetBoundingVolume().
+//*   2026/10/18                    Draw() moved to EXHYBDisplay.
 //*************************************************************************
 //
 #include "TVector3.h"
@@ -56,6 +59,7 @@ public:
    
    
    inline virtual Bool_t   IsOnSurface (const TVector3 &xx) const;
+   virtual Bool_t          GetBoundingVolume(BoundingVolume &bv) const;
    
    virtual void       ProcessHit(const TVector3   &xx,
                                        TObjArray  &hits);
@@ -66,10 +70,11 @@ public:
    Double_t GetXioffset() const { return fXioffset; }
    Double_t GetSigmaXi() const { return fSigmaXi; }
    Double_t GetSigmaZeta() const { return fSigmaZeta; }
-
-   using TAttDrawable::Draw;
-   virtual void Draw(Int_t color, const Char_t *opt);
    
+   // crossings as those of TPlane, see TVSurface::GetShape()
+
+   virtual Int_t      GetShape() const { return TVSurface::kPlane; }
+
  private:
    Double_t fSortingPolicy;
    Double_t fXiwidth;
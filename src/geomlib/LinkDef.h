@@ -7,6 +7,7 @@
 #pragma link C++ class TCircle+;
 #pragma link C++ class TCutCone+;
 #pragma link C++ class TCylinder+;
+#pragma link C++ class TCylinderBank+;
 #pragma link C++ class TPlane+;
 #pragma link C++ class THype+;
 #pragma link C++ class TTube+;
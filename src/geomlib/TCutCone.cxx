@@ -16,6 +16,8 @@
 //*                             both -ve and +ve sides. If you want to
 //*                             restrict them to one side, override
 //*                             IsOnSurface(), etc.
+//*   2026/10/18                Closed-form crossing with a straight
+//*                             track.
 //*************************************************************************
 //
 #include <iostream>
@@ -37,6 +39,41 @@ const Double_t TCutCone::kTol = 1.e-5; // tolerance
 
 ClassImp(TCutCone)
 
+//_____________________________________________________________________
+//  -----------------------------------
+//  Calculate crossing point with track
+//  -----------------------------------
+//
+//  With x = x0 + t dx/dt relative to the apex, S = r^2 - (tanA z)^2 is
+//  quadratic in t for a straight track; the crossing closest to phi is
+//  taken whatever the mode, as with the Newtonian method. Helices go to
+//  TVSurface.
+//
+Int_t TCutCone::CalcXingPointWith(const TVTrack  &hel,
+                                        TVector3 &xx,
+                                        Double_t &phi,
+                                        Int_t     mode,
+                                        Double_t  eps) const
+{
+   if (hel.IsInB()) return TVSurface::CalcXingPointWith(hel, xx, phi, mode, eps);
+
+   Double_t fi0  = hel.GetPhi0();
+   Double_t csf0 = TMath::Cos(fi0);
+   Double_t snf0 = TMath::Sin(fi0);
+   Double_t dr   = hel.GetDrho();
+   Double_t tnl  = hel.GetTanLambda();
+   Double_t x0   = hel.GetPivot().X() + dr*csf0 - fXc.X();
+   Double_t y0   = hel.GetPivot().Y() + dr*snf0 - fXc.Y();
+   Double_t z0   = hel.GetPivot().Z() + hel.GetDz() - fXc.Z();
+   Double_t tan2 = fTanA*fTanA;
+   Double_t a    = 1. - tan2*tnl*tnl;
+   Double_t b    = -x0*snf0 + y0*csf0 - tan2*z0*tnl;
+   Double_t c    = x0*x0 + y0*y0 - tan2*z0*z0;
+   if (!CalcLineRoot(a, b, c, phi, phi)) return 0;
+   xx = hel.CalcXAt(phi);
+   return (IsOnSurface(xx) ? 1 : 0);
+}
+
 //_____________________________________________________________________
 //  -----------------------------------
 //  Calculate S
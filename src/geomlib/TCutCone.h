@@ -18,6 +18,9 @@
 //*                             both -ve and +ve sides. If you want to
 //*                             restrict them to one side, override
 //*                             IsOnSurface(), etc.
+//*   2026/10/18                Added GetBoundingVolume().
+//*   2026/10/18                Added CalcXingPointWith() for
+//*                             straight tracks.
 //*************************************************************************
 //
 #include "TVSurface.h"
@@ -48,6 +51,13 @@ public:
 
    virtual ~TCutCone() {}
 
+   using TVSurface::CalcXingPointWith;
+   virtual Int_t    CalcXingPointWith(const TVTrack  &hel,
+                                            TVector3 &xx,
+                                            Double_t &phi,
+                                            Int_t     mode,
+                                            Double_t  eps = 1.e-8) const;
+
    virtual Double_t CalcS   (const TVector3 &xx) const;
    virtual TMatrixD CalcDSDx(const TVector3 &xx) const;
 
@@ -55,6 +65,7 @@ public:
    inline virtual       Bool_t     IsOutside  (const TVector3 &xx) const;
 
    inline virtual       Double_t   GetSortingPolicy()              const;
+   inline virtual       Bool_t     GetBoundingVolume(BoundingVolume &bv) const;
 
    inline virtual       Double_t   GetZ1     () const { return fZ1;   } 
    inline virtual const TVector3 & GetXc     () const { return fXc;   } 
@@ -114,6 +125,20 @@ Bool_t TCutCone::IsOutside(const TVector3 &xx) const
    return (r*r > R2 || z < GetZmin() || z > GetZmax());
 } 
 
+Bool_t TCutCone::GetBoundingVolume(BoundingVolume &bv) const
+{
+   Double_t r1 = TMath::Abs((GetZmin() - fXc.Z()) * fTanA);
+   Double_t r2 = TMath::Abs((GetZmax() - fXc.Z()) * fTanA);
+   Bool_t   apex = GetZmin() <= fXc.Z() && fXc.Z() <= GetZmax();
+   bv.fXc   = fXc.X();
+   bv.fYc   = fXc.Y();
+   bv.fRmin = apex ? 0. : TMath::Min(r1, r2);
+   bv.fRmax = TMath::Max(r1, r2);
+   bv.fZmin = GetZmin();
+   bv.fZmax = GetZmax();
+   return kTRUE;
+}
+
 Double_t TCutCone::GetSortingPolicy() const
 {
    return GetZ1()*GetTanA();
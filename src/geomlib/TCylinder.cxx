@@ -13,6 +13,9 @@
 //*   2003/10/03  K.Fujii       Original version.  Currently fXc is 
 //*                             supposed to be at the origin
 //*   2009/05/30  K.Fujii       Now allow nonzero fXc.
+//*   2026/10/18                TKalStats allocation tag.
+//*   2026/10/18                Closed-form crossing with a straight
+//*                             track.
 //*
 //*************************************************************************
 //
@@ -21,6 +24,7 @@
 #include "TCylinder.h"
 #include "TVTrack.h"
 #include "TBField.h"
+#include "TKalStats.h"
 
 using namespace std;
 
@@ -70,8 +74,30 @@ Int_t TCylinder::CalcXingPointWith(const TVTrack  &hel,
                                          Int_t     mode,
                                          Double_t  eps) const
 {
-   // If B = 0,  use the Newtonian method to calculate the crossing point.
-   if(!hel.IsInB() || !TBField::IsUsingUniformBfield()) return TVSurface::CalcXingPointWith(hel, xx, phi, mode, eps);
+   KALSTATS_ALLOC_TAG(kAllocXing);
+
+   // If B = 0, the track is a straight line,
+   //    x = x0 + drho*(cos(phi0), sin(phi0)) + t*(-sin(phi0), cos(phi0)),
+   // with a unit direction in xy: t^2 + 2 b t + c = 0 at the crossings.
+   // As with the Newtonian method, the one closest to phi is taken
+   // whatever the mode.
+
+   if (!hel.IsInB()) {
+      Double_t fi0  = hel.GetPhi0();
+      Double_t csf0 = TMath::Cos(fi0);
+      Double_t snf0 = TMath::Sin(fi0);
+      Double_t dr   = hel.GetDrho();
+      Double_t x0   = hel.GetPivot().X() + dr*csf0 - fXc.X();
+      Double_t y0   = hel.GetPivot().Y() + dr*snf0 - fXc.Y();
+      Double_t b    = -x0*snf0 + y0*csf0;
+      Double_t c    = x0*x0 + y0*y0 - fR*fR;
+      if (!CalcLineRoot(1., b, c, phi, phi)) return 0;
+      xx = hel.CalcXAt(phi);
+      return (IsOnSurface(xx) ? 1 : 0);
+   }
+
+   // In a non-uniform field use the Newtonian method.
+   if (!TBField::IsUsingUniformBfield()) return TVSurface::CalcXingPointWith(hel, xx, phi, mode, eps);
    
    // This assumes nonzero B field.
    //
@@ -14,6 +14,7 @@
 //* (Update Recored)
 //*   2003/10/03  K.Fujii       Original version.
 //*   2005/02/23  K.Fujii       Added GetSortingPolicy().
+//*   2026/10/18                Added GetBoundingVolume().
 //*
 //*************************************************************************
 //
@@ -51,6 +52,7 @@ public:
    inline virtual       Bool_t     IsOutside  (const TVector3 &xx) const;
 
    inline virtual       Double_t   GetSortingPolicy()              const;
+   inline virtual       Bool_t     GetBoundingVolume(BoundingVolume &bv) const;
 
    inline virtual       Double_t   GetR      () const { return fR;    } 
    inline virtual const TVector3 & GetXc     () const { return fXc;   } 
@@ -96,6 +98,17 @@ Bool_t TCylinder::IsOutside(const TVector3 &xx) const
    return (r > fR || z < GetZmin() || z > GetZmax());
 } 
 
+Bool_t TCylinder::GetBoundingVolume(BoundingVolume &bv) const
+{
+   bv.fXc   = fXc.X();
+   bv.fYc   = fXc.Y();
+   bv.fRmin = fR;
+   bv.fRmax = fR;
+   bv.fZmin = GetZmin();
+   bv.fZmax = GetZmax();
+   return kTRUE;
+}
+
 Double_t TCylinder::GetSortingPolicy() const
 {
    return GetR();
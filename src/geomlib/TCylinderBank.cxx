@@ -0,0 +1,189 @@
+//*************************************************************************
+//* ======================
+//*  TCylinderBank Class
+//* ======================
+//*
+//* (Description)
+//*   A run of coaxial cylinders with batched helix crossings.
+//* (Requires)
+//*     TCylinder, TVTrack
+//* (Provides)
+//*     class TCylinderBank
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+//
+#include "TCylinderBank.h"
+#include "TCylinder.h"
+#include "TVTrack.h"
+#include "TBField.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Cylinder Bank Class
+//  -----------------------------------
+
+ClassImp(TCylinderBank)
+
+TCylinderBank::TCylinderBank(Int_t index)
+              : fIndex(index), fXc(0.), fYc(0.)
+{
+}
+
+void TCylinderBank::Add(const TCylinder &c)
+{
+   if (fCylPtrs.empty()) {
+      fXc = c.GetXc().X();
+      fYc = c.GetXc().Y();
+   }
+   fR      .push_back(c.GetR());
+   fZmin   .push_back(c.GetZmin());
+   fZmax   .push_back(c.GetZmax());
+   fCylPtrs.push_back(&c);
+}
+
+Bool_t TCylinderBank::IsCoaxial(const TCylinder &c) const
+{
+   return fCylPtrs.empty() || (c.GetXc().X() == fXc && c.GetXc().Y() == fYc);
+}
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Calculate crossing points with track
+//  -----------------------------------
+//
+//  The arithmetic is that of TCylinder::CalcXingPointWith() and
+//  TCircle::CalcXingPointWith() term by term, so that the crossings
+//  agree to the last bit with those of the single cylinders.
+//
+Bool_t TCylinderBank::CalcXingPointsWith(const TVTrack &hel,
+                                               Int_t    first,
+                                               Int_t    n,
+                                               Xings   &xs,
+                                               Double_t eps) const
+{
+   xs.Clear();
+   if (!hel.IsInB() || !TBField::IsUsingUniformBfield()) return kFALSE;
+
+   //
+   // Helix circle, common to all cylinders.
+   //
+
+   Double_t dr   = hel.GetDrho();
+   Double_t fi0  = hel.GetPhi0();
+   TVector3 X0   = hel.GetPivot();
+   Double_t rho  = hel.GetRho();
+   Double_t rdr  = rho + dr;
+   Double_t xc   = X0.X() + rdr*TMath::Cos(fi0);
+   Double_t yc   = X0.Y() + rdr*TMath::Sin(fi0);
+   Double_t r    = TMath::Abs(rho);
+
+   Double_t x12x = fXc - xc;
+   Double_t x12y = fYc - yc;
+   Double_t a    = x12x*x12x + x12y*x12y;
+   Double_t sqa  = TMath::Sqrt(a);
+   Double_t ainv = 1./sqa;
+
+   if (Int_t(xs.fNx.size()) < n) {
+      xs.fNx.resize(n);
+      for (Int_t ix=0; ix<2; ix++) {
+         xs.fX  [ix].resize(n);
+         xs.fY  [ix].resize(n);
+         xs.fAng[ix].resize(n);
+      }
+   }
+   const Double_t *rv  = &fR[first];
+         Int_t    *nx  = &xs.fNx[0];
+         Double_t *x0  = &xs.fX[0][0];
+         Double_t *y0  = &xs.fY[0][0];
+         Double_t *x1  = &xs.fX[1][0];
+         Double_t *y1  = &xs.fY[1][0];
+
+   //
+   // Intersection points with all radii: no branches and no calls but
+   // sqrt, so that the compiler can vectorise the loop. The points are
+   // used only where the circles intersect.
+   //
+
+   for (Int_t k=0; k<n; k++) {
+      Double_t radd = r + rv[k];
+      Double_t rsub = r - rv[k];
+      Double_t d    = (radd*rsub + a) * (0.5*ainv);
+      Double_t dp = std::sqrt(std::max((r+d)*(r-d), 0.))*ainv;
+      d  *= ainv;
+      Double_t d1x = xc + d*x12x;
+      Double_t d1y = yc + d*x12y;
+      x0[k] = d1x + dp*x12y;
+      y0[k] = d1y - dp*x12x;
+      x1[k] = d1x - dp*x12y;
+      y1[k] = d1y + dp*x12x;
+   }
+
+   //
+   // Which circles really intersect, and the azimuths of the points.
+   //
+
+   for (Int_t k=0; k<n; k++) {
+      Double_t radd  = r + rv[k];
+      Double_t arsub = TMath::Abs(r - rv[k]);
+      nx[k] = (sqa > radd-eps || sqa <= eps || sqa < arsub-eps) ? 0 : 2;
+      xs.fAng[0][k] = TMath::ATan2(y0[k] - yc, x0[k] - xc);
+      xs.fAng[1][k] = TMath::ATan2(y1[k] - yc, x1[k] - xc);
+   }
+
+   xs.fBankPtr = this;
+   xs.fFirst   = first;
+   xs.fN       = n;
+   return kTRUE;
+}
+
+Int_t TCylinderBank::GetXingPoint(const TVTrack  &hel,
+                                  const Xings    &xs,
+                                        Int_t     i,
+                                        TVector3 &xx,
+                                        Double_t &phi,
+                                        Int_t     mode) const
+{
+   Int_t k = i - xs.fFirst;
+   if (!xs.fNx[k]) return 0;
+
+   static const Double_t kPi     = TMath::Pi();
+   static const Double_t kHalfPi = 0.5*TMath::Pi();
+   static const Double_t kTwoPi  = 2.0*TMath::Pi();
+
+   Double_t fi0 = hel.GetPhi0();
+   Double_t cpa = hel.GetKappa();
+   Double_t rho = hel.GetRho();
+   Double_t tnl = hel.GetTanLambda();
+   Double_t zc  = hel.GetPivot().Z() + hel.GetDz();
+   Int_t    chg = (Int_t)TMath::Sign(1.1,cpa/hel.GetPtoR());
+
+   phi = 9999.;
+   for (Int_t ix=0; ix<2; ix++) {
+      Double_t dfi = xs.fAng[ix][k] - fi0 - kHalfPi*(1+chg);
+      if (!mode) {
+         while (dfi < -kPi) dfi += kTwoPi;
+         while (dfi >= kPi) dfi -= kTwoPi;
+      } else {
+         Int_t sign = (mode > 0 ? +1 : -1); // (+1,-1) = (fwd,bwd)
+         while (dfi <  0.)     dfi += kTwoPi;
+         while (dfi >= kTwoPi) dfi -= kTwoPi;
+         if (sign*chg > 0) dfi -= kTwoPi;
+      }
+      if (TMath::Abs(dfi) < TMath::Abs(phi)) {
+         phi = dfi;
+         xx.SetXYZ(xs.fX[ix][k], xs.fY[ix][k], zc - rho*tnl*phi);
+      }
+   }
+   // TCylinder::IsOnSurface()
+
+   Double_t dx = xx.X() - fXc;
+   Double_t dy = xx.Y() - fYc;
+   return (xx.Z() >= fZmin[i] && xx.Z() <= fZmax[i])
+       && std::fabs(TMath::Sqrt(dx*dx + dy*dy) - fR[i]) < 1.e-6 ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+#ifndef TCYLINDERBANK_H
+#define TCYLINDERBANK_H
+//*************************************************************************
+//* ======================
+//*  TCylinderBank Class
+//* ======================
+//*
+//* (Description)
+//*   A run of coaxial cylinders, i.e. cylinders with a common axis
+//*   (xc,yc) and increasing radii, such as the pad rows of a TPC.
+//*   CalcXingPointsWith() intersects a helix with n consecutive
+//*   cylinders of the bank in one pass: the helix circle is set up
+//*   once and the intersections with all radii are computed in a flat
+//*   loop over the radius list, followed by one ATan2 loop for the
+//*   azimuths of the crossing points around the helix centre.
+//*
+//*   The result is kept in a Xings buffer owned by the caller and
+//*   stays valid as long as the helix moves along its own circle
+//*   (MoveTo); GetXingPoint() then picks the crossing for a given mode
+//*   relative to the current pivot exactly as
+//*   TCylinder::CalcXingPointWith() does.
+//*
+//*   Banks reproduce TCylinder::CalcXingPointWith() and IsOnSurface()
+//*   and therefore hold only cylinders whose GetShape() is kCylinder.
+//* (Requires)
+//*     TCylinder, TVTrack
+//* (Provides)
+//*     class TCylinderBank
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+//
+#include "TObject.h"
+#include "TVector3.h"
+
+#include <vector>
+
+class TCylinder;
+class TVTrack;
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Cylinder Bank Class
+//  -----------------------------------
+
+class TCylinderBank : public TObject {
+public:
+   // Crossings of one helix with cylinders [fFirst, fFirst+fN) of a bank.
+   // For each cylinder: fNx = 2 if the circles intersect, else 0, and
+   // the two points and their azimuths around the helix centre.
+
+   struct Xings {
+      const TCylinderBank   *fBankPtr;
+      Int_t                  fFirst;
+      Int_t                  fN;
+      std::vector<Int_t>     fNx;
+      std::vector<Double_t>  fX[2];
+      std::vector<Double_t>  fY[2];
+      std::vector<Double_t>  fAng[2];
+
+      Xings() : fBankPtr(0), fFirst(0), fN(0) {}
+
+      inline void   Clear   ()        { fBankPtr = 0; fN = 0; }
+      inline Bool_t Contains(const TCylinderBank *bp, Int_t i) const
+                    { return bp == fBankPtr && i >= fFirst && i < fFirst + fN; }
+   };
+
+   TCylinderBank(Int_t index = 0);
+   virtual ~TCylinderBank() {}
+
+   // Append c, which must be coaxial with the cylinders already added
+
+   void     Add      (const TCylinder &c);
+   Bool_t   IsCoaxial(const TCylinder &c) const;
+
+   // Intersect hel with cylinders [first, first+n); returns kFALSE,
+   // leaving xs cleared, if hel is not a helix in a uniform field
+
+   Bool_t   CalcXingPointsWith(const TVTrack &hel,
+                                     Int_t    first,
+                                     Int_t    n,
+                                     Xings   &xs,
+                                     Double_t eps = 1.e-8) const;
+
+   // Crossing of hel with cylinder i from xs, as returned by
+   // TCylinder::CalcXingPointWith(hel, xx, phi, mode)
+
+   Int_t    GetXingPoint(const TVTrack  &hel,
+                         const Xings    &xs,
+                               Int_t     i,
+                               TVector3 &xx,
+                               Double_t &phi,
+                               Int_t     mode) const;
+
+   inline       Int_t       GetIndex    ()        const { return fIndex;    }
+   inline       Int_t       GetNcylinders()       const { return fR.size(); }
+   inline const TCylinder & GetCylinder (Int_t i) const { return *fCylPtrs[i]; }
+
+private:
+   Int_t                           fIndex;     // user index of cylinder 0
+   Double_t                        fXc;        // common axis
+   Double_t                        fYc;        //
+   std::vector<Double_t>           fR;         // radii
+   std::vector<Double_t>           fZmin;      // z ranges
+   std::vector<Double_t>           fZmax;      //
+   std::vector<const TCylinder *>  fCylPtrs;   //! cylinders
+
+   ClassDef(TCylinderBank,1)      // bank of coaxial cylinders
+};
+
+#endif
@@ -11,6 +11,8 @@
 //*     class THelicalTrack
 //* (Update Recored)
 //*   2003/10/03  K.Fujii       Original version.
+//*   2026/10/18                Added CalcTurningPoint().
+//*   2026/10/18                Added PropagateTo().
 //*
 //*************************************************************************
 //
@@ -21,6 +23,43 @@
 
 using namespace std;
 
+namespace {
+   // M = DF * M for a helix propagator matrix DF (in dapda), which
+   // differs from the unit matrix only in the rows of drho, phi0, and
+   // dz. The terms are added in the order of the full product, so that
+   // the results are the same.
+   void MultiplyRows(const Double_t (*dapda)[5], TMatrixD &M)
+   {
+      const Double_t *d0 = dapda[0];
+      const Double_t *d1 = dapda[1];
+      const Double_t *d3 = dapda[3];
+      Int_t     n = M.GetNcols();
+      Double_t *m = M.GetMatrixArray();
+      for (Int_t j=0; j<n; j++) {
+         Double_t m0 = m[j], m1 = m[n+j], m2 = m[2*n+j], m3 = m[3*n+j], m4 = m[4*n+j];
+         m[j]     =  (d0[0]*m0 + d0[1]*m1) + d0[2]*m2;
+         m[n+j]   =  (d1[0]*m0 + d1[1]*m1) + d1[2]*m2;
+         m[3*n+j] = (((d3[0]*m0 + d3[1]*m1) + d3[2]*m2) + m3) + d3[4]*m4;
+      }
+   }
+
+   // M = M * DF^t, likewise on the columns
+   void MultiplyCols(const Double_t (*dapda)[5], TMatrixD &M)
+   {
+      const Double_t *d0 = dapda[0];
+      const Double_t *d1 = dapda[1];
+      const Double_t *d3 = dapda[3];
+      Int_t     n = M.GetNcols();
+      Double_t *m = M.GetMatrixArray();
+      for (Int_t i=0; i<M.GetNrows(); i++, m+=n) {
+         Double_t m0 = m[0], m1 = m[1], m2 = m[2], m3 = m[3], m4 = m[4];
+         m[0] =  (m0*d0[0] + m1*d0[1]) + m2*d0[2];
+         m[1] =  (m0*d1[0] + m1*d1[1]) + m2*d1[2];
+         m[3] = (((m0*d3[0] + m1*d3[1]) + m2*d3[2]) + m3) + m4*d3[4];
+      }
+   }
+}
+
 //_____________________________________________________________________
 //  -----------------------------------
 //  Helical Track Class
@@ -91,11 +130,6 @@ void THelicalTrack::MoveTo(const TVector3 &globalPivot, // new global pivot
    // ---------------------------------------------------
    // (0) Preparation
    // ---------------------------------------------------
-   //   Define some numerical constants.
-   //
-
-   static const Double_t kPi    = TMath::Pi();
-   static const Double_t kTwoPi = 2.0*kPi;
 
    TVector3 xv0to = globalPivot;
 
@@ -104,69 +138,18 @@ void THelicalTrack::MoveTo(const TVector3 &globalPivot, // new global pivot
 	   xv0to = fFrame.Transform(globalPivot, TTrackFrame::kGlobalToLocal);
    }
 
-   //   Copy helix parmeters to local variables
-
-   Double_t dr    = fDrho;
-   Double_t fi0   = fPhi0;
-   while (fi0 < 0.)      fi0 += kTwoPi;
-   while (fi0 > kTwoPi)  fi0 -= kTwoPi;
-   Double_t cpa   = fKappa;
-   Double_t dz    = fDz;
-   Double_t tnl   = fTanL;
-
-   Double_t x0    = fX0.X();
-   Double_t y0    = fX0.Y();
-   Double_t z0    = fX0.Z();
-   Double_t xv    = xv0to.X();
-   Double_t yv    = xv0to.Y();
-   Double_t zv    = xv0to.Z();
-
    // ---------------------------------------------------
-   // (1) Calculate a' = f_k-1(a_k-1)
+   // (1) Calculate a' = f_k-1(a_k-1) and, if needed,
+   // (2) @a'/@a = @a'/a = F_k-1
    // ---------------------------------------------------
-   //        a' = (dr', fi0', cpa', dz', tnl')
-   //        a  = (dr , fi0 , cpa , dz , tnl )
-   //
-
-   Double_t r     = fAlpha/cpa;
-   Double_t rdr   = r + dr;
-   Double_t csf0  = TMath::Cos(fi0);
-   Double_t snf0  = TMath::Sqrt(TMath::Max(0.0, (1.0-csf0)*(1.0+csf0)));
-   if (fi0 > kPi) snf0 = -snf0;
-
-   Double_t xc    = x0 + rdr*csf0;
-   Double_t yc    = y0 + rdr*snf0;
-   Double_t fi0p  = 0.;
-
-   if (cpa/GetPtoR() > 0.) fi0p = TMath::ATan2((yc-yv),(xc-xv));
-   if (cpa/GetPtoR() < 0.) fi0p = TMath::ATan2((yv-yc),(xv-xc));
-   while (fi0p < 0.)      fi0p += kTwoPi;
-   while (fi0p > kTwoPi)  fi0p -= kTwoPi;
-
-   Double_t csf   = TMath::Cos(fi0p);
-   Double_t snf   = TMath::Sqrt(TMath::Max(0.0, (1.0-csf)*(1.0+csf)));
-   if (fi0p > kPi) snf = -snf;
 
-   Double_t anrm  = 1.0/TMath::Sqrt(csf*csf+snf*snf);
-            csf  *= anrm;
-            snf  *= anrm;
-   Double_t csfd  = csf*csf0 + snf*snf0;
-   Double_t snfd  = snf*csf0 - csf*snf0;
-
-   fid   = fi0p - fi0;
-   while (fid < 0)      fid += kTwoPi;
-   while (fid > kTwoPi) fid -= kTwoPi;
-   if    (fid > kPi)    fid -= kTwoPi;
-
-   Double_t drp   = (xc-xv)*csf + (yc-yv)*snf - r;
-   Double_t dzp   = z0 - zv + dz - r*tnl*fid;
+   Bool_t   needF = FPtr || CPtr || transform;
+   Double_t ap[5];
+   Double_t dapda[5][5];
+   CalcMove(xv0to, fid, ap, needF ? dapda : 0);
 
    TKalMatrix av(5,1);
-   av(0,0) = drp;
-   av(1,0) = fi0p;
-   av(2,0) = cpa;
-   av(3,0) = dzp;
-   av(4,0) = tnl;
+   for (Int_t i=0; i<5; i++) av(i,0) = ap[i];
 
    THelicalTrack helto(av,xv0to);
    helto.fAlpha = fAlpha;
@@ -178,7 +161,7 @@ void THelicalTrack::MoveTo(const TVector3 &globalPivot, // new global pivot
 
 
    
-   if (!FPtr && !CPtr && !transform) {
+   if (!needF) {
       *this = helto;
       return;
    }
@@ -186,50 +169,9 @@ void THelicalTrack::MoveTo(const TVector3 &globalPivot, // new global pivot
    TMatrixD Fdummy(5,5);
    TMatrixD &F = FPtr ? *FPtr : Fdummy;
 
-   // ---------------------------------------------------
-   // (2) Calculate @a'/@a = @a'/a = F_k-1
-   // ---------------------------------------------------
-   //        a' = (dr', fi0', cpa', dz', tnl')
-   //        a  = (dr , fi0 , cpa , dz , tnl )
-   //
-
-   Double_t rdrpr = 1.0/(r+drp);
-   Double_t rcpar = r/cpa;
-
-   // @drho'/@a
-   F(0,0) = csfd;
-   F(0,1) = rdr*snfd;
-   F(0,2) = rcpar*(1.0-csfd);
-   F(0,3) = 0;
-   F(0,4) = 0;
-
-   // @phi0'/@a
-   F(1,0) = -rdrpr*snfd;
-   F(1,1) =  rdr*rdrpr*csfd;
-   F(1,2) =  rcpar*rdrpr*snfd;
-   F(1,3) =  0;
-   F(1,4) =  0;
-
-   // @kappa'/@a
-   F(2,0) = 0;
-   F(2,1) = 0;
-   F(2,2) = 1;
-   F(2,3) = 0;
-   F(2,4) = 0;
-
-   // @dz'/@a
-   F(3,0) =  r*rdrpr*tnl*snfd;
-   F(3,1) =  r*tnl*(1.0-rdr*rdrpr*csfd);
-   F(3,2) =  rcpar*tnl*(fid-r*rdrpr*snfd);
-   F(3,3) =  1;
-   F(3,4) = -r*fid;
-
-   // @tanl'/@a
-   F(4,0) = 0;
-   F(4,1) = 0;
-   F(4,2) = 0;
-   F(4,3) = 0;
-   F(4,4) = 1;
+   for (Int_t i=0; i<5; i++) {
+      for (Int_t j=0; j<5; j++) F(i,j) = dapda[i][j];
+   }
 
    //
    //update helix for the new frame
@@ -264,13 +206,50 @@ void THelicalTrack::MoveTo(const TVector3 &globalPivot, // new global pivot
    // ---------------------------------------------------
 
    TMatrixD &C  = *CPtr;
-   TMatrixD  Ft = TMatrixD(TMatrixD::kTransposed, F);
-   TMatrixD  Cp = F * C * Ft;
-   C = Cp;
+   if (TBField::IsUsingUniformBfield()) {
+      MultiplyRows(dapda, C);            // F is still sparse
+      MultiplyCols(dapda, C);
+   } else {
+      TMatrixD  Ft = TMatrixD(TMatrixD::kTransposed, F);
+      TMatrixD  Cp = F * C * Ft;
+      C = Cp;
+   }
 
    *this = helto;
 }
 
+void THelicalTrack::PropagateTo(const TVector3 &globalPivot, // new global pivot
+                                      Double_t &fid,         // deflection angle
+                                      TMatrixD &F,           // propagator matrix
+                                      TMatrixD *QPtr,        // noise matrix
+                                      Bool_t    transform)   // flag of transforming
+{
+   // The frame of the new pivot would fill F: only in a uniform field
+   // is it kept sparse.
+
+   if (!TBField::IsUsingUniformBfield()) {
+      TVTrack::PropagateTo(globalPivot, fid, F, QPtr, transform);
+      return;
+   }
+
+   Double_t ap[5];
+   Double_t dapda[5][5];
+   CalcMove(globalPivot, fid, ap, dapda);
+
+   MultiplyRows(dapda, F);
+   if (QPtr) {
+      MultiplyRows(dapda, *QPtr);
+      MultiplyCols(dapda, *QPtr);
+   }
+
+   fDrho  = ap[0];
+   fPhi0  = ap[1];
+   fKappa = ap[2];
+   fDz    = ap[3];
+   fTanL  = ap[4];
+   fX0    = globalPivot;
+}
+
 TVector3 THelicalTrack::CalcXAt(Double_t phi) const
 {
    Double_t csf0 = TMath::Cos(fPhi0);
@@ -427,6 +406,32 @@ void THelicalTrack::CalcStartHelix(const TVector3 &x1g,
    SetTo(sv, x1);
 }
 
+Bool_t THelicalTrack::CalcTurningPoint(Double_t  dir,
+                                       Double_t &phi,
+                                       Int_t    &type) const
+{
+   // With the helix centre (xc,yc) at distance d from the z axis,
+   //    r^2(phi) = d^2 + rho^2 - 2*rho*d*cos(phi0 + phi - beta),
+   // beta = atan2(yc,xc), which has its extrema at phi0 + phi - beta
+   // = k*pi, maxima where rho*cos() < 0.
+
+   static const Double_t kPi     = TMath::Pi();
+   static const Double_t kMinPhi = 1.e-9;
+
+   Double_t rho = GetRho();
+   Double_t rdr = rho + fDrho;
+   Double_t xc  = fX0.X() + rdr*TMath::Cos(fPhi0);
+   Double_t yc  = fX0.Y() + rdr*TMath::Sin(fPhi0);
+   if (TMath::Abs(xc) + TMath::Abs(yc) < kMinPhi*TMath::Abs(rho)) return kFALSE;
+
+   Double_t beta = TMath::ATan2(yc, xc);
+   Double_t u    = dir < 0. ? fPhi0 - beta : beta - fPhi0;
+   u   -= kPi*TMath::Floor((u - kMinPhi)/kPi);      // in [kMinPhi, kMinPhi + pi)
+   phi  = dir < 0. ? -u : u;
+   type = rho*TMath::Cos(fPhi0 + phi - beta) < 0. ? +1 : -1;
+   return kTRUE;
+}
+
 Double_t THelicalTrack::GetMomentum() const
 {
    Double_t cpa    = GetKappa();
@@ -496,3 +501,131 @@ void THelicalTrack::CalcDapDa(Double_t  fid,
    F(4,4) = 1.;
 }
 
+//_____________________________________________________________________
+//  ----------------
+//  Private methods
+//  ----------------
+//
+//    a' (in ap) and, if dapda is given, @a'/@a for a move of the pivot
+//    to the local point xv0to; fid is the deflection angle to it.
+//
+void THelicalTrack::CalcMove(const TVector3 &xv0to,
+                                   Double_t &fid,
+                                   Double_t *ap,
+                                   Double_t (*dapda)[5]) const
+{
+   //   Define some numerical constants.
+
+   static const Double_t kPi    = TMath::Pi();
+   static const Double_t kTwoPi = 2.0*kPi;
+
+   //   Copy helix parmeters to local variables
+
+   Double_t dr    = fDrho;
+   Double_t fi0   = fPhi0;
+   while (fi0 < 0.)      fi0 += kTwoPi;
+   while (fi0 > kTwoPi)  fi0 -= kTwoPi;
+   Double_t cpa   = fKappa;
+   Double_t dz    = fDz;
+   Double_t tnl   = fTanL;
+
+   Double_t x0    = fX0.X();
+   Double_t y0    = fX0.Y();
+   Double_t z0    = fX0.Z();
+   Double_t xv    = xv0to.X();
+   Double_t yv    = xv0to.Y();
+   Double_t zv    = xv0to.Z();
+
+   // ---------------------------------------------------
+   // (1) Calculate a' = f_k-1(a_k-1)
+   // ---------------------------------------------------
+   //        a' = (dr', fi0', cpa', dz', tnl')
+   //        a  = (dr , fi0 , cpa , dz , tnl )
+   //
+
+   Double_t r     = fAlpha/cpa;
+   Double_t rdr   = r + dr;
+   Double_t csf0  = TMath::Cos(fi0);
+   Double_t snf0  = TMath::Sqrt(TMath::Max(0.0, (1.0-csf0)*(1.0+csf0)));
+   if (fi0 > kPi) snf0 = -snf0;
+
+   Double_t xc    = x0 + rdr*csf0;
+   Double_t yc    = y0 + rdr*snf0;
+   Double_t fi0p  = 0.;
+
+   if (cpa/GetPtoR() > 0.) fi0p = TMath::ATan2((yc-yv),(xc-xv));
+   if (cpa/GetPtoR() < 0.) fi0p = TMath::ATan2((yv-yc),(xv-xc));
+   while (fi0p < 0.)      fi0p += kTwoPi;
+   while (fi0p > kTwoPi)  fi0p -= kTwoPi;
+
+   Double_t csf   = TMath::Cos(fi0p);
+   Double_t snf   = TMath::Sqrt(TMath::Max(0.0, (1.0-csf)*(1.0+csf)));
+   if (fi0p > kPi) snf = -snf;
+
+   Double_t anrm  = 1.0/TMath::Sqrt(csf*csf+snf*snf);
+            csf  *= anrm;
+            snf  *= anrm;
+   Double_t csfd  = csf*csf0 + snf*snf0;
+   Double_t snfd  = snf*csf0 - csf*snf0;
+
+   fid   = fi0p - fi0;
+   while (fid < 0)      fid += kTwoPi;
+   while (fid > kTwoPi) fid -= kTwoPi;
+   if    (fid > kPi)    fid -= kTwoPi;
+
+   Double_t drp   = (xc-xv)*csf + (yc-yv)*snf - r;
+   Double_t dzp   = z0 - zv + dz - r*tnl*fid;
+
+   ap[0] = drp;
+   ap[1] = fi0p;
+   ap[2] = cpa;
+   ap[3] = dzp;
+   ap[4] = tnl;
+
+   if (!dapda) return;
+
+   // ---------------------------------------------------
+   // (2) Calculate @a'/@a = @a'/a = F_k-1
+   // ---------------------------------------------------
+   //        a' = (dr', fi0', cpa', dz', tnl')
+   //        a  = (dr , fi0 , cpa , dz , tnl )
+   //
+
+   Double_t rdrpr = 1.0/(r+drp);
+   Double_t rcpar = r/cpa;
+
+   // @drho'/@a
+   dapda[0][0] = csfd;
+   dapda[0][1] = rdr*snfd;
+   dapda[0][2] = rcpar*(1.0-csfd);
+   dapda[0][3] = 0;
+   dapda[0][4] = 0;
+
+   // @phi0'/@a
+   dapda[1][0] = -rdrpr*snfd;
+   dapda[1][1] =  rdr*rdrpr*csfd;
+   dapda[1][2] =  rcpar*rdrpr*snfd;
+   dapda[1][3] =  0;
+   dapda[1][4] =  0;
+
+   // @kappa'/@a
+   dapda[2][0] = 0;
+   dapda[2][1] = 0;
+   dapda[2][2] = 1;
+   dapda[2][3] = 0;
+   dapda[2][4] = 0;
+
+   // @dz'/@a
+   dapda[3][0] =  r*rdrpr*tnl*snfd;
+   dapda[3][1] =  r*tnl*(1.0-rdr*rdrpr*csfd);
+   dapda[3][2] =  rcpar*tnl*(fid-r*rdrpr*snfd);
+   dapda[3][3] =  1;
+   dapda[3][4] = -r*fid;
+
+   // @tanl'/@a
+   dapda[4][0] = 0;
+   dapda[4][1] = 0;
+   dapda[4][2] = 0;
+   dapda[4][3] = 0;
+   dapda[4][4] = 1;
+}
@@ -24,6 +24,9 @@
 //*     class THelicalTrack
 //* (Update Recored)
 //*   2003/10/03  K.Fujii       Original version.
+//*   2026/10/18                Added CalcTurningPoint().
+//*   2026/10/18                Added PropagateTo(), which keeps the
+//*                             propagator matrix sparse.
 //*
 //*************************************************************************
 //
@@ -79,6 +82,12 @@ public:
                              TMatrixD *C        = 0,
                              Bool_t   transform = kTRUE);
 
+   virtual void PropagateTo(const TVector3 &x0to,
+                                  Double_t &fid,
+                                  TMatrixD &F,
+                                  TMatrixD *Q        = 0,
+                                  Bool_t   transform = kTRUE);
+
    TVector3 CalcXAt   (Double_t phi) const;
    TMatrixD CalcDxDa  (Double_t phi) const;
    TMatrixD CalcDxDphi(Double_t phi) const;
@@ -87,6 +96,15 @@ public:
                        Double_t drp,
                        TMatrixD &F)  const;
 
+   // Turning point: the first phi beyond 0 in the direction of
+   // sign(dir) at which the distance from the z axis has an extremum,
+   // with type = +1 at a maximum and -1 at a minimum. kFALSE if the
+   // helix circle is centred on the axis.
+
+   Bool_t   CalcTurningPoint(Double_t  dir,
+                             Double_t &phi,
+                             Int_t    &type) const;
+
    virtual Double_t   GetMomentum() const;
 
 protected:
@@ -96,6 +114,11 @@ protected:
                              Bool_t    dir = kIterForward);
 
 private:
+   void CalcMove(const TVector3 &xv0to,
+                       Double_t &fid,
+                       Double_t *ap,
+                       Double_t (*dapda)[5]) const;
+
 
    ClassDef(THelicalTrack,1)      // circle class
 };
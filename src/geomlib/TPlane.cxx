@@ -12,10 +12,14 @@
 //* (Update Recored)
 //*   2004/10/30  A.Yamaguchi   Original version.  Currently fXc is 
 //*                             supposed to be at the origin
+//*   2026/10/18                Added SetPolygonVolume().
+//*   2026/10/18                Closed-form crossing with a straight
+//*                             track.
 //*
 //*************************************************************************
 //
 #include "TPlane.h"
+#include "TVTrack.h"
 
 
 //_____________________________________________________________________
@@ -40,6 +44,39 @@ TPlane::TPlane(const TVector3 &xc, const TVector3 &n)
 {
 } 
 
+//_____________________________________________________________________
+//  -----------------------------------
+//  Calculate crossing point with track
+//  -----------------------------------
+//
+//  A straight track crosses the plane once, at
+//    t = -(x0 - xc).n / (dx/dt).n,
+//  which is taken whatever the mode, as with the Newtonian method.
+//  Helices go to TVSurface.
+//
+Int_t TPlane::CalcXingPointWith(const TVTrack  &hel,
+                                      TVector3 &xx,
+                                      Double_t &phi,
+                                      Int_t     mode,
+                                      Double_t  eps) const
+{
+   if (hel.IsInB()) return TVSurface::CalcXingPointWith(hel, xx, phi, mode, eps);
+
+   Double_t fi0  = hel.GetPhi0();
+   Double_t csf0 = TMath::Cos(fi0);
+   Double_t snf0 = TMath::Sin(fi0);
+   Double_t dr   = hel.GetDrho();
+   TVector3 x0(hel.GetPivot().X() + dr*csf0,
+               hel.GetPivot().Y() + dr*snf0,
+               hel.GetPivot().Z() + hel.GetDz());
+   TVector3 dxdt(-snf0, csf0, hel.GetTanLambda());
+   Double_t ndx  = fNormal * dxdt;
+   if (ndx == 0.) return 0;
+   phi = -((x0 - fXc) * fNormal) / ndx;
+   xx  = hel.CalcXAt(phi);
+   return (IsOnSurface(xx) ? 1 : 0);
+}
+
 //_____________________________________________________________________
 //  -----------------------------------
 //  Calculate S
@@ -64,4 +101,37 @@ TMatrixD TPlane::CalcDSDx(const TVector3 &/*xx*/) const
    return dsdx;
 }
 
+//_____________________________________________________________________
+//  -----------------------------------
+//  Bounding volume of a convex polygon
+//  -----------------------------------
+//
+//  The polygon lies in the cylinder about the mean of its corners that
+//  holds all the corners, and in z between its lowest and highest one.
+//
+void TPlane::SetPolygonVolume(Int_t n, const TVector3 *xx, BoundingVolume &bv)
+{
+   Double_t xc = 0.;
+   Double_t yc = 0.;
+   for (Int_t i=0; i<n; i++) {
+      xc += xx[i].X();
+      yc += xx[i].Y();
+   }
+   xc /= n;
+   yc /= n;
 
+   Double_t r2max = 0.;
+   bv.fZmin = xx[0].Z();
+   bv.fZmax = xx[0].Z();
+   for (Int_t i=0; i<n; i++) {
+      Double_t dx = xx[i].X() - xc;
+      Double_t dy = xx[i].Y() - yc;
+      r2max    = TMath::Max(r2max, dx*dx + dy*dy);
+      bv.fZmin = TMath::Min(bv.fZmin, xx[i].Z());
+      bv.fZmax = TMath::Max(bv.fZmax, xx[i].Z());
+   }
+   bv.fXc   = xc;
+   bv.fYc   = yc;
+   bv.fRmin = 0.;
+   bv.fRmax = TMath::Sqrt(r2max);
+}
@@ -14,6 +14,9 @@
 //* (Update Recored)
 //*   2004/10/30  A.Yamaguchi       Original version.
 //*   2005/02/23  K.Fujii           Added GetSortingPolicy().
+//*   2026/10/18                    Added SetPolygonVolume().
+//*   2026/10/18                    Added CalcXingPointWith() for
+//*                                 straight tracks.
 //*
 //*************************************************************************
 //
@@ -36,6 +39,13 @@ public:
 
    virtual ~TPlane() {}
 
+   using TVSurface::CalcXingPointWith;
+   virtual Int_t    CalcXingPointWith(const TVTrack  &hel,
+                                            TVector3 &xx,
+                                            Double_t &phi,
+                                            Int_t     mode,
+                                            Double_t  eps = 1.e-8) const;
+
    virtual Double_t CalcS   (const TVector3 &xx) const;
    virtual TMatrixD CalcDSDx(const TVector3 &xx) const;
 
@@ -46,6 +56,11 @@ public:
 
    inline virtual       Double_t   GetSortingPolicy()              const;
 
+protected:
+   // Bounding volume of the convex polygon with the n corners xx, for
+   // bounded planes implementing GetBoundingVolume()
+
+   static void SetPolygonVolume(Int_t n, const TVector3 *xx, BoundingVolume &bv);
 
 private:
    TVector3 fXc{};          // center
@@ -6,6 +6,9 @@
 //* (Description)
 //* (Requires)
 //* (Provides)
+//* (Update Recored)
+//*   2026/10/18  TKalStats counters.
+//*   2026/10/18  TKalStats allocation tag.
 //*
 //*************************************************************************
 //
@@ -15,6 +18,7 @@
 #include "TRungeKuttaTrack.h"
 #include "TBField.h"
 #include "TRKMagField.h"
+#include "TKalStats.h"
 
 ClassImp(TRungeKuttaTrack)
 
@@ -117,6 +121,8 @@ void TRungeKuttaTrack::MoveTo(const TVector3    &globalPivot,
                                     Double_t    &step,     
 	                                TKalMatrix  &rkDF)
 {
+	KALSTATS_ALLOC_TAG(kAllocRKJacobian);
+
 	TVector3 xv0to = fFrame.Transform(globalPivot, TTrackFrame::kGlobalToLocal);
 
 	TKalMatrix F12(6,5);
@@ -559,6 +565,7 @@ TKalMatrix TRungeKuttaTrack::CalcDaDpx(TVector3& p) const
 
 TVector3 TRungeKuttaTrack::GetLocalBfield(TVector3 x0) const
 {
+	KALSTATS_COUNT(kFieldEvals);
 	TVector3 globalx0 = fFrame.Transform(x0, TTrackFrame::kLocalToGlobal);
 	TVector3 globalbf = TRKMagField::GetField(globalx0);
 	return fFrame.TransformBfield(globalbf, TTrackFrame::kGlobalToLocal);
@@ -794,6 +801,7 @@ void TRungeKuttaTrack::StepRungeKutta(Double_t  step,
 #endif
 
   do {
+    KALSTATS_COUNT(kRKSteps);
     rest  = step - tl;
     if (fabs(s) > fabs(rest)) s = rest;
 
@@ -11,6 +11,10 @@
 //*     class TStraightTrack
 //* (Update Recored)
 //*   2003/10/24  K.Fujii       Original version.
+//*   2026/10/18                MoveTo() updates the track in place.
+//*                             Added SetMomentum() and a default
+//*                             momentum, SetDefaultMomentum().
+//*   2026/10/18                Added PropagateTo().
 //*
 //*************************************************************************
 //
@@ -20,6 +24,8 @@
 
 using namespace std;
 
+Double_t TStraightTrack::fgDefaultMomentum = 5.;
+
 //_____________________________________________________________________
 //  -----------------------------------
 //  Straight Track Class
@@ -40,14 +46,14 @@ TStraightTrack::TStraightTrack(Double_t dr,
                                Double_t y0,
                                Double_t z0,
                                Double_t b)
-             : TVTrack(dr,phi0,0.,dz,tanl, x0,y0,z0, b), fMomentum(5.)
+             : TVTrack(dr,phi0,0.,dz,tanl, x0,y0,z0, b), fMomentum(fgDefaultMomentum)
 {
 }
 
 TStraightTrack::TStraightTrack(const TMatrixD &a,
                                const TVector3 &x0,
                                      Double_t  b)
-             : TVTrack(a, x0, b), fMomentum(5.)
+             : TVTrack(a, x0, b), fMomentum(fgDefaultMomentum)
 {
 }
 
@@ -104,82 +110,80 @@ void TStraightTrack::MoveTo(const TVector3 &xv0to,
    Double_t drp   = dr - (xv - x0) * csf0 - (yv - y0) * snf0;
    Double_t dzp   = dz - (zv - z0) + t * tnl;
 
-   TMatrixD av(5,1);
-   av(0,0) = drp;
-   av(1,0) = fi0;
-   av(2,0) = cpa;
-   av(3,0) = dzp;
-   av(4,0) = tnl;
-
-   TStraightTrack helto(av,xv0to);
-   helto.fAlpha = fAlpha;
-   
-   if (!FPtr && !CPtr) {
-      *this = helto;
-      return;
+   if (FPtr || CPtr) {
+      TMatrixD Fdummy(5,5);
+      TMatrixD &F = FPtr ? *FPtr : Fdummy;
+
+      // ---------------------------------------------------
+      // (2) Calculate @a'/@a = @a'/a = F_k-1
+      // ---------------------------------------------------
+      //        a' = (dr', fi0', cpa', dz', tnl')
+      //        a  = (dr , fi0 , cpa , dz , tnl )
+      //
+
+      CalcDapDa(t, dr, drp, F);
+
+      // ---------------------------------------------------
+      // (3) Calculate C' = C^k-1_k
+      // ---------------------------------------------------
+
+      if (CPtr) {
+         TMatrixD &C  = *CPtr;
+         TMatrixD  Ft = TMatrixD(TMatrixD::kTransposed, F);
+         TMatrixD  Cp = F * C * Ft;
+         C = Cp;
+      }
    }
 
-   TMatrixD Fdummy(5,5);
-   TMatrixD &F = FPtr ? *FPtr : Fdummy;
+   // The line stays the same, and so do its momentum and frame:
+   // only the parameters and the pivot change.
 
-   // ---------------------------------------------------
-   // (2) Calculate @a'/@a = @a'/a = F_k-1
-   // ---------------------------------------------------
-   //        a' = (dr', fi0', cpa', dz', tnl')
-   //        a  = (dr , fi0 , cpa , dz , tnl )
-   //
+   fDrho  = drp;
+   fPhi0  = fi0;
+   fKappa = cpa;
+   fDz    = dzp;
+   fX0    = xv0to;
+}
 
-   // @drho'/@a
-   F(0,0) =  1;
-   F(0,1) = -t;
-   F(0,2) =  0;
-   F(0,3) =  0;
-   F(0,4) =  0;
-                                                                                
-   // @phi0'/@a
-   F(1,0) =  0;
-   F(1,1) =  1;
-   F(1,2) =  0;
-   F(1,3) =  0;
-   F(1,4) =  0;
-                                                                                
-   // @kappa'/@a
+//_____________________________________________________________________
+//  ----------------
+//  PropagateTo
+//  ----------------
+//    the propagator matrix of a straight track, see CalcDapDa(), differs
+//    from the unit matrix only in DF(0,1), DF(3,1), and DF(3,4): rows 0
+//    and 3 of F and Q and then columns 0 and 3 of Q are updated in
+//    place, adding in the order of the full products so that the
+//    results are the same.
+//
+void TStraightTrack::PropagateTo(const TVector3 &xv0to,
+                                       Double_t &t,
+                                       TMatrixD &F,
+                                       TMatrixD *QPtr,
+                                       Bool_t    /*transform*/)
+{
+   Double_t dr = fDrho;
+   MoveTo(xv0to, t);
 
-   F(2,0) =  0;
-   F(2,1) =  0;
-   F(2,2) =  1;
-   F(2,3) =  0;
-   F(2,4) =  0;
-   
-   // @dz'/@a
-   F(3,0) =  0;
-   F(3,1) =  (drp - dr)* tnl;
-   F(3,2) =  0;
-   F(3,3) =  1;
-   F(3,4) =  t;
-    
-   // @tanl'/@a
-   F(4,0) = 0;
-   F(4,1) = 0;
-   F(4,2) = 0;
-   F(4,3) = 0;
-   F(4,4) = 1;
+   Double_t a01 = -t;
+   Double_t a31 = (fDrho - dr) * fTanL;
+   Double_t a34 = t;
+   Int_t    n   = F.GetNcols();
 
-   if (!CPtr) {
-      *this = helto;
-      return;
+   for (Int_t j=0; j<n; j++) {
+      F(0,j) = F(0,j) + a01*F(1,j);
+      F(3,j) = (a31*F(1,j) + F(3,j)) + a34*F(4,j);
    }
+   if (!QPtr) return;
 
-   // ---------------------------------------------------
-   // (3) Calculate C' = C^k-1_k
-   // ---------------------------------------------------
-
-   TMatrixD &C  = *CPtr;
-   TMatrixD  Ft = TMatrixD(TMatrixD::kTransposed, F);
-   TMatrixD  Cp = F * C * Ft;
-   C = Cp;
-
-   *this = helto;
+   TMatrixD &Q = *QPtr;
+   for (Int_t j=0; j<n; j++) {
+      Q(0,j) = Q(0,j) + a01*Q(1,j);
+      Q(3,j) = (a31*Q(1,j) + Q(3,j)) + a34*Q(4,j);
+   }
+   for (Int_t i=0; i<n; i++) {
+      Q(i,0) = Q(i,0) + a01*Q(i,1);
+      Q(i,3) = (a31*Q(i,1) + Q(i,3)) + a34*Q(i,4);
+   }
 }
 
 TVector3 TStraightTrack::CalcXAt(Double_t t) const
@@ -21,6 +21,10 @@
 //*     class TStraightTrack
 //* (Update Recored)
 //*   2003/10/24  K.Fujii       Original version.
+//*   2026/10/18                MoveTo() updates the track in place.
+//*                             Added SetMomentum() and a default
+//*                             momentum, SetDefaultMomentum().
+//*   2026/10/18                Added PropagateTo().
 //*
 //*************************************************************************
 //
@@ -59,6 +63,12 @@ public:
                              TMatrixD *C = 0,
 			     Bool_t   transform = kFALSE); //transform has no meaning for straight track
 
+   virtual void PropagateTo(const TVector3 &x0to,
+                                  Double_t &t,
+                                  TMatrixD &F,
+                                  TMatrixD *Q        = 0,
+                                  Bool_t   transform = kFALSE);
+
    TVector3 CalcXAt   (Double_t phi) const;
    TMatrixD CalcDxDa  (Double_t phi) const;
    TMatrixD CalcDxDphi(Double_t phi) const;
@@ -68,6 +78,13 @@ public:
                        TMatrixD &F)  const;
 
    inline virtual  Double_t   GetMomentum() const     { return fMomentum; }
+   inline          void       SetMomentum(Double_t p) { fMomentum = p;    }
+
+   // Momentum given to new straight tracks, 5 GeV unless set, e.g. to
+   // the beam momentum of a test beam
+
+   static inline   Double_t   GetDefaultMomentum()           { return fgDefaultMomentum; }
+   static inline   void       SetDefaultMomentum(Double_t p) { fgDefaultMomentum = p;    }
 
 private:
 
@@ -75,6 +92,8 @@ private:
    //However, a fixed value of momentum is used to calculate the multiple scattering.
    Double_t fMomentum;
 
+   static Double_t fgDefaultMomentum; //! momentum of new tracks
+
    ClassDef(TStraightTrack,1)      // circle class
 };
 
@@ -13,12 +13,16 @@
 //*   2003/10/03  K.Fujii       Original version.
 //*   2005/02/23  K.Fujii       Added new methods, Compare() and
 //*                             GetSortingPolicy().
+//*   2026/10/18                TKalStats counters.
+//*   2026/10/18                TKalStats allocation tag.
+//*   2026/10/18                Added CalcLineRoot().
 //*
 //*************************************************************************
 //
 #include <iostream>
 #include "TVSurface.h"
 #include "TVTrack.h"
+#include "TKalStats.h"
 
 using namespace std;
 
@@ -48,6 +52,9 @@ Int_t TVSurface::CalcXingPointWith(const TVTrack  &hel,
 				         Int_t     mode,
 				         Double_t  eps) const
 {
+   KALSTATS_TIMER(kXing);
+   KALSTATS_ALLOC_TAG(kAllocXing);
+
    eps = 1.e-5;
 
    // this Newtonian method is used for non-uniform b field,
@@ -86,9 +93,11 @@ Int_t TVSurface::CalcXingPointWith(const TVTrack  &hel,
 			  << "   eps    : " << eps    << endl
               << "   lambda : " << lambda << endl;
 #endif
+         KALSTATS_COUNT(kXingMaxCount);
          return 0;
       }
       count++;
+      KALSTATS_COUNT(kXingIterations);
       s  = CalcS(xx);
       if (TMath::Abs(s) < eps) break;
       if (TMath::Abs(s) < TMath::Abs(lasts)) {
@@ -117,7 +126,38 @@ Int_t TVSurface::CalcXingPointWith(const TVTrack  &hel,
      }
    }
    
-   return (IsOnSurface(xx) ? 1 : 0);
+   if (IsOnSurface(xx)) return 1;
+   KALSTATS_COUNT(kXingOffSurface);
+   return 0;
+}
+
+//_____________________________________________________________________
+//  -----------------------------------
+//  Root of a quadratic closest to t0
+//  -----------------------------------
+//
+//  The root of larger magnitude is taken from the sum of like signs and
+//  the other one from the product of the roots, so that neither loses
+//  precision to cancellation.
+//
+Bool_t TVSurface::CalcLineRoot(Double_t  a,
+                               Double_t  b,
+                               Double_t  c,
+                               Double_t  t0,
+                               Double_t &t)
+{
+   if (a == 0.) {
+      if (b == 0.) return kFALSE;
+      t = -0.5*c/b;
+      return kTRUE;
+   }
+   Double_t disc = b*b - a*c;
+   if (disc < 0.) return kFALSE;
+   Double_t q  = -(b + TMath::Sign(TMath::Sqrt(disc), b));
+   Double_t t1 = q/a;
+   Double_t t2 = q != 0. ? c/q : t1;
+   t = TMath::Abs(t1 - t0) <= TMath::Abs(t2 - t0) ? t1 : t2;
+   return kTRUE;
 }
 
 //_____________________________________________________________________
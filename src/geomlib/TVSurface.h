@@ -17,6 +17,9 @@
 //*                             GetSortingPolicy().
 //*
 //*   2011/06/17  D.Kamai       Added new method, GetOutwardNormal() 
+//*   2026/10/18                Added GetShape().
+//*   2026/10/18                Added GetBoundingVolume().
+//*   2026/10/18                Added CalcLineRoot().
 //*                             
 //*************************************************************************
 //
@@ -32,6 +35,29 @@ class TVTrack;
 
 class TVSurface : public TObject {
 public:
+   // Shapes that TKalDetCradle navigates with inline code. The shape
+   // classes themselves report kOther; a concrete layer opts in by
+   // overriding GetShape(), promising that CalcXingPointWith(), CalcS()
+   // and CalcDSDx() are those of its TCylinder, TPlane or TCutCone, and
+   // for kCylinder also IsOnSurface(). A class deriving from such a
+   // layer that overrides any of them must report kOther again. Layers
+   // reporting kOther are called virtually.
+
+   enum EShape { kOther = 0, kCylinder, kPlane, kCutCone };
+
+   // Volume around the part of the surface that IsOnSurface() accepts:
+   // z in [fZmin, fZmax] and a distance in [fRmin, fRmax] from the line
+   // (fXc, fYc) parallel to z. Tolerances of the crossing search are
+   // left to the user of the volume.
+
+   struct BoundingVolume {
+      Double_t fXc;
+      Double_t fYc;
+      Double_t fRmin;
+      Double_t fRmax;
+      Double_t fZmin;
+      Double_t fZmax;
+   };
 
    virtual Int_t    CalcXingPointWith(const TVTrack  &hel,
                                             TVector3 &xx,
@@ -53,6 +79,21 @@ public:
 
    virtual Int_t    Compare   (const TObject *obj) const;
    virtual Bool_t   IsSortable()                   const { return kTRUE; }
+
+   virtual Int_t    GetShape  ()                   const { return kOther; }
+
+   // Fills bv and returns kTRUE if the surface is bounded. A class that
+   // overrides IsOnSurface() must not accept points outside of the
+   // volume of its parent, or must override this as well.
+
+   virtual Bool_t   GetBoundingVolume(BoundingVolume &/* bv */) const { return kFALSE; }
+
+protected:
+   // Root t of a t^2 + 2 b t + c = 0 closest to t0, for the closed-form
+   // crossings of straight tracks; kFALSE if there is none
+
+   static Bool_t    CalcLineRoot(Double_t a, Double_t b, Double_t c,
+                                 Double_t t0, Double_t &t);
    
 private:
  
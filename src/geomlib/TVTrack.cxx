@@ -11,6 +11,7 @@
 //*     class TVTrack
 //* (Update Recored)
 //*   2003/10/24  K.Fujii       Original version.
+//*   2026/10/18                Added PropagateTo().
 //*
 //*************************************************************************
 //
@@ -90,3 +91,26 @@ TVTrack::TVTrack(const TMatrixD    &a,
    SetMagField(b);
 }
 
+
+//_____________________________________________________________________
+//  ----------------
+//  Utility methods
+//  ----------------
+
+void TVTrack::PropagateTo(const TVector3 &x0to,      // new pivot
+                                Double_t &fid,       // deflection angle
+                                TMatrixD &F,         // propagator matrix
+                                TMatrixD *QPtr,      // noise matrix
+                                Bool_t    transform) // flag of transforming
+{
+   Int_t    sdim = F.GetNrows();
+   TMatrixD DF(sdim, sdim);
+   MoveTo(x0to, fid, &DF, 0, transform);
+   if (sdim == 6) DF(5,5) = 1.;     // t0 stays the same
+
+   F = DF * F;
+   if (QPtr) {
+      TMatrixD DFt = TMatrixD(TMatrixD::kTransposed, DF);
+      *QPtr = DF * (*QPtr) * DFt;
+   }
+}
@@ -14,6 +14,7 @@
 //* (Update Recored)
 //*   2003/10/24  K.Fujii       Original version.
 //*   2005/08/14  K.Fujii       Added IsInB().
+//*   2026/10/18                Added PropagateTo().
 //*
 //*************************************************************************
 //
@@ -81,6 +82,19 @@ public:
       MoveTo(x0to,fid,&F,&C);
    }
 
+   // MoveTo() that carries a propagator matrix F and, if given, a
+   // noise matrix Q along to the new pivot:
+   //    F = DF * F,  Q = DF * Q * DF^t
+   // with DF the propagator matrix of the move, which leaves t0 (if
+   // sdim = 6) as it is. Tracks whose DF is sparse update F and Q in
+   // place.
+
+   virtual void PropagateTo(const TVector3 &x0to,
+                                  Double_t &fid,
+                                  TMatrixD &F,
+                                  TMatrixD *Q        = 0,
+                                  Bool_t   transform = kTRUE);
+
    inline virtual void ScatterBy(Double_t dphi, Double_t dtnl)
    {
       fPhi0  += dphi;
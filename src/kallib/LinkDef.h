@@ -8,5 +8,8 @@
 #pragma link C++ class TVKalSite+;
 #pragma link C++ class TVKalState+;
 #pragma link C++ class TVKalSystem+;
+#pragma link C++ class TKalBandMatrix+;
+#pragma link C++ class TKalResidualArray+;
+#pragma link C++ class TKalResMonitor+;
 
 #endif
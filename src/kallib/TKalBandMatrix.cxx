@@ -0,0 +1,259 @@
+//*************************************************************************
+//* =======================
+//*  TKalBandMatrix Class
+//* =======================
+//*
+//* (Description)
+//*   Symmetric positive definite band matrix with an optional dense
+//*   border, solved by a root-free Cholesky decomposition.
+//* (Requires)
+//*     TObject
+//* (Provides)
+//*     class TKalBandMatrix
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TKalBandMatrix.h"   // from KalLib
+#include "TKalMatrix.h"       // from KalLib
+#include "TMath.h"            // from ROOT
+#include <iostream>           // from STL
+
+using namespace std;
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Bordered band matrix
+//  ------------------------------
+//
+ClassImp(TKalBandMatrix)
+
+//-------------------------------------------------------
+// Ctor
+//-------------------------------------------------------
+
+TKalBandMatrix::TKalBandMatrix(Int_t n, Int_t width, Int_t nborder)
+              : fN(0),
+                fW(0),
+                fNb(0),
+                fIsDecomposed(kFALSE),
+                fIsInverted(kFALSE)
+{
+   ResizeTo(n, width, nborder);
+}
+
+//-------------------------------------------------------
+// ResizeTo, Zero
+//-------------------------------------------------------
+
+void TKalBandMatrix::ResizeTo(Int_t n, Int_t width, Int_t nborder)
+{
+   fN  = n;
+   fW  = TMath::Max(0, TMath::Min(width, n - 1));
+   fNb = nborder;
+   fBand  .resize((fW + 1) * fN);
+   fMixed .resize(fNb * fN);
+   fBorder.resize(fNb * fNb);
+   fAux   .resize(fN * fNb);
+   fSinv  .resize(fNb * fNb);
+   Zero();
+}
+
+void TKalBandMatrix::Zero()
+{
+   fBand  .assign(fBand  .size(), 0.);
+   fMixed .assign(fMixed .size(), 0.);
+   fBorder.assign(fBorder.size(), 0.);
+   fIsDecomposed = kFALSE;
+   fIsInverted   = kFALSE;
+}
+
+//-------------------------------------------------------
+// AddAt, AddBlock
+//-------------------------------------------------------
+
+void TKalBandMatrix::AddAt(Int_t i, Int_t j, Double_t v)
+{
+   if (i < j) { Int_t k = i; i = j; j = k; }    // lower triangle
+   if (j >= fN) {
+      fBorder[(i - fN) * fNb + (j - fN)] += v;
+      if (i != j) fBorder[(j - fN) * fNb + (i - fN)] += v;
+   } else if (i >= fN) {
+      fMixed[(i - fN) * fN + j] += v;
+   } else if (i - j <= fW) {
+      Band(i - j, j) += v;
+   }
+}
+
+void TKalBandMatrix::AddBlock(Int_t nidx, const Int_t *idx, const Double_t *m)
+{
+   for (Int_t i=0; i<nidx; i++) {
+      for (Int_t j=0; j<=i; j++) {
+         AddAt(idx[i], idx[j], m[i * nidx + j]);
+      }
+   }
+}
+
+//-------------------------------------------------------
+// Decompose
+//-------------------------------------------------------
+
+Int_t TKalBandMatrix::Decompose()
+{
+   // Band part: A = L*D*L^t with unit lower triangular L.
+   // D^-1 replaces the diagonal, L the off-diagonal elements.
+
+   std::vector<Double_t> diag(fN);
+   for (Int_t i=0; i<fN; i++) diag[i] = 16. * TMath::Abs(Band(0,i));
+
+   for (Int_t i=0; i<fN; i++) {
+      Double_t d = Band(0,i);
+      if (d <= 0. || d + diag[i] == diag[i]) {
+         cerr << ">>>> Error!! TKalBandMatrix::Decompose >>>>>>>>>>" << endl
+              << " Not positive definite at row " << i << endl;
+         return 0;
+      }
+      Band(0,i) = 1. / d;
+      Int_t nj = TMath::Min(fW + 1, fN - i);
+      for (Int_t j=1; j<nj; j++) {
+         Double_t rxw = Band(j,i) * Band(0,i);
+         for (Int_t k=0; k<nj-j; k++) Band(k,i+j) -= Band(k+j,i) * rxw;
+         Band(j,i) = rxw;
+      }
+   }
+   fIsDecomposed = kTRUE;
+   fIsInverted   = kFALSE;
+
+   if (!fNb) return 1;
+
+   // Border: Schur complement S = border - mixed * band^-1 * mixed^t
+
+   std::vector<Double_t> col(fN);
+   for (Int_t a=0; a<fNb; a++) {
+      for (Int_t i=0; i<fN; i++) col[i] = fMixed[a * fN + i];
+      SolveBand(&col[0]);
+      for (Int_t i=0; i<fN; i++) fAux[i * fNb + a] = col[i];
+   }
+
+   TKalMatrix s(fNb, fNb);
+   for (Int_t a=0; a<fNb; a++) {
+      for (Int_t b=0; b<fNb; b++) {
+         Double_t sum = fBorder[a * fNb + b];
+         for (Int_t i=0; i<fN; i++) sum -= fMixed[a * fN + i] * fAux[i * fNb + b];
+         s(a,b) = sum;
+      }
+      if (s(a,a) <= 0.) {
+         cerr << ">>>> Error!! TKalBandMatrix::Decompose >>>>>>>>>>" << endl
+              << " Border not positive definite at row " << a << endl;
+         fIsDecomposed = kFALSE;
+         return 0;
+      }
+   }
+   TKalMatrix sinv(TKalMatrix::kInverted, s);
+   for (Int_t a=0; a<fNb; a++) {
+      for (Int_t b=0; b<fNb; b++) fSinv[a * fNb + b] = sinv(a,b);
+   }
+   return 1;
+}
+
+//-------------------------------------------------------
+// Solve
+//-------------------------------------------------------
+
+void TKalBandMatrix::SolveBand(Double_t *x) const
+{
+   for (Int_t i=0; i<fN; i++) {
+      Int_t nj = TMath::Min(fW, fN - 1 - i);
+      for (Int_t j=1; j<=nj; j++) x[i+j] -= Band(j,i) * x[i];
+   }
+   for (Int_t i=fN-1; i>=0; i--) {
+      Double_t rxw = Band(0,i) * x[i];
+      Int_t nj = TMath::Min(fW, fN - 1 - i);
+      for (Int_t j=1; j<=nj; j++) rxw -= Band(j,i) * x[i+j];
+      x[i] = rxw;
+   }
+}
+
+void TKalBandMatrix::Solve(const Double_t *b, Double_t *x) const
+{
+   if (!fIsDecomposed) {
+      cerr << ">>>> Error!! TKalBandMatrix::Solve >>>>>>>>>>>>>>>>>>" << endl
+           << " Matrix not decomposed." << endl;
+      return;
+   }
+
+   std::vector<Double_t> rb(b + fN, b + fN + fNb);
+   if (x != b) for (Int_t i=0; i<fN; i++) x[i] = b[i];
+   SolveBand(x);
+   if (!fNb) return;
+
+   // x_border = S^-1 (b_border - mixed * band^-1 * b_band)
+   // x_band   = band^-1 * b_band - aux * x_border
+
+   for (Int_t a=0; a<fNb; a++) {
+      for (Int_t i=0; i<fN; i++) rb[a] -= fMixed[a * fN + i] * x[i];
+   }
+   for (Int_t a=0; a<fNb; a++) {
+      Double_t sum = 0.;
+      for (Int_t b2=0; b2<fNb; b2++) sum += fSinv[a * fNb + b2] * rb[b2];
+      x[fN + a] = sum;
+   }
+   for (Int_t i=0; i<fN; i++) {
+      for (Int_t a=0; a<fNb; a++) x[i] -= fAux[i * fNb + a] * x[fN + a];
+   }
+}
+
+//-------------------------------------------------------
+// Invert, GetInverse
+//-------------------------------------------------------
+
+void TKalBandMatrix::Invert()
+{
+   if (!fIsDecomposed) {
+      cerr << ">>>> Error!! TKalBandMatrix::Invert >>>>>>>>>>>>>>>>>" << endl
+           << " Matrix not decomposed." << endl;
+      return;
+   }
+
+   // Z = band^-1 from L^t*Z = D^-1*L^-1, column by column from the
+   // end, keeping only the elements inside the band.
+
+   fInv.assign(fBand.size(), 0.);
+   for (Int_t i=fN-1; i>=0; i--) {
+      Double_t rxw = Band(0,i);
+      for (Int_t j=i; j>=TMath::Max(0, i-fW); j--) {
+         Int_t kmax = TMath::Min(fN - 1, j + fW);
+         for (Int_t k=j+1; k<=kmax; k++) {
+            Int_t lo = TMath::Min(i,k);
+            rxw -= fInv[lo * (fW + 1) + TMath::Abs(i - k)] * Band(k-j,j);
+         }
+         fInv[j * (fW + 1) + (i - j)] = rxw;
+         rxw = 0.;
+      }
+   }
+   fIsInverted = kTRUE;
+}
+
+Double_t TKalBandMatrix::GetInverse(Int_t i, Int_t j) const
+{
+   if (!fIsInverted) return 0.;
+   if (i < j) { Int_t k = i; i = j; j = k; }
+
+   if (j >= fN) return fSinv[(i - fN) * fNb + (j - fN)];
+
+   if (i >= fN) {
+      Double_t sum = 0.;
+      for (Int_t b=0; b<fNb; b++) sum -= fAux[j * fNb + b] * fSinv[b * fNb + (i - fN)];
+      return sum;
+   }
+
+   if (i - j > fW) return 0.;
+   Double_t sum = fInv[j * (fW + 1) + (i - j)];
+   for (Int_t a=0; a<fNb; a++) {
+      for (Int_t b=0; b<fNb; b++) {
+         sum += fAux[i * fNb + a] * fSinv[a * fNb + b] * fAux[j * fNb + b];
+      }
+   }
+   return sum;
+}
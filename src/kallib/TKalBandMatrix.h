@@ -0,0 +1,96 @@
+#ifndef TKALBANDMATRIX_H
+#define TKALBANDMATRIX_H
+//*************************************************************************
+//* =======================
+//*  TKalBandMatrix Class
+//* =======================
+//*
+//* (Description)
+//*   Symmetric positive definite band matrix with an optional dense
+//*   border (a few extra rows and columns coupling to all others).
+//*   The band part is solved by a root-free Cholesky (L*D*L^t)
+//*   decomposition in O(n*width^2), the border by its Schur complement.
+//*   After Invert() the elements of the inverse inside the band and
+//*   the border are available, which is what a track fit needs for
+//*   the covariance matrix of its local parameters.
+//* (Requires)
+//*     TObject
+//* (Provides)
+//*     class TKalBandMatrix
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include <vector>           // from STL
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Bordered band matrix
+//  ------------------------------
+//
+class TKalBandMatrix : public TObject {
+public:
+   TKalBandMatrix(Int_t n = 0, Int_t width = 0, Int_t nborder = 0);
+   virtual ~TKalBandMatrix() {}
+
+   // Set dimensions: n band rows, width off-diagonals, nborder border
+   // rows. Indices 0..n-1 address the band, n..n+nborder-1 the border.
+
+   void     ResizeTo  (Int_t n, Int_t width, Int_t nborder = 0);
+   void     Zero      ();
+
+   // Add v to elements (i,j) and (j,i). Elements outside the band
+   // and border are silently dropped.
+
+   void     AddAt     (Int_t i, Int_t j, Double_t v);
+
+   // Add a symmetric block m (nidx x nidx, row-wise) at indices idx.
+
+   void     AddBlock  (Int_t nidx, const Int_t *idx, const Double_t *m);
+
+   // Decompose in place. Returns 1 if positive definite, 0 otherwise.
+
+   Int_t    Decompose ();
+
+   // Solve A*x = b, after Decompose(). b and x may be the same array.
+
+   void     Solve     (const Double_t *b, Double_t *x) const;
+
+   // Calculate the band and border parts of the inverse, after
+   // Decompose(). GetInverse(i,j) is valid for |i-j| <= width or if
+   // i or j is a border index.
+
+   void     Invert    ();
+   Double_t GetInverse(Int_t i, Int_t j) const;
+
+   inline Int_t  GetNband  () const { return fN;            }
+   inline Int_t  GetWidth  () const { return fW;            }
+   inline Int_t  GetNborder() const { return fNb;           }
+   inline Int_t  GetSize   () const { return fN + fNb;      }
+   inline Bool_t IsDecomposed() const { return fIsDecomposed; }
+
+private:
+   inline Double_t &Band(Int_t d, Int_t col)       { return fBand[col*(fW+1)+d]; }
+   inline Double_t  Band(Int_t d, Int_t col) const { return fBand[col*(fW+1)+d]; }
+
+   void     SolveBand (Double_t *x) const;
+
+private:
+   Int_t                 fN;             // band dimension
+   Int_t                 fW;             // number of off-diagonals
+   Int_t                 fNb;            // border dimension
+   Bool_t                fIsDecomposed;  // true after Decompose()
+   Bool_t                fIsInverted;    // true after Invert()
+   std::vector<Double_t> fBand;    // band, then L and D^-1: (col+d, col)
+   std::vector<Double_t> fMixed;   // border-band elements: nb x n
+   std::vector<Double_t> fBorder;  // border elements     : nb x nb
+   std::vector<Double_t> fAux;     // band^-1 * mixed^t  : n x nb
+   std::vector<Double_t> fSinv;    // inverse Schur complement: nb x nb
+   std::vector<Double_t> fInv;     // band part of band^-1: (col+d, col)
+
+   ClassDef(TKalBandMatrix,1)  // bordered band matrix
+};
+
+#endif
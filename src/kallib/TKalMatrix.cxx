@@ -11,6 +11,7 @@
 //* 	class TKalMatrix
 //* (Update Recored)
 //*   2003/09/30  K.Fujii	Original version.
+//*   2026/10/18  	Count inversions in TKalStats
 //*
 //*************************************************************************
 //
@@ -18,6 +19,7 @@
 #include <iomanip>
 #include "TString.h"
 #include "TKalMatrix.h"
+#include "TKalStats.h"
 
 //_____________________________________________________________________
 //  ------------------------------
@@ -49,12 +51,14 @@ TKalMatrix::TKalMatrix(TMatrixD::EMatrixCreatorsOp1 op,
                              const TKalMatrix &prototype)
               :TMatrixD(op, prototype)
 {
+   if (op == kInverted) KALSTATS_COUNT(kInversions);
 }
                                                                                 
 TKalMatrix::TKalMatrix(TMatrixD::EMatrixCreatorsOp1 op,
                              const TMatrixD &prototype)
               :TMatrixD(op, prototype)
 {
+   if (op == kInverted) KALSTATS_COUNT(kInversions);
 }
                                                                                 
 TKalMatrix::TKalMatrix(const TKalMatrix &a,
@@ -0,0 +1,262 @@
+//*************************************************************************
+//* ======================
+//*  TKalResMonitor Class
+//* ======================
+//*
+//* (Description)
+//*   Online monitor of smoothed residuals and pulls.
+//* (Requires)
+//*     TObject, TVKalSite
+//* (Provides)
+//*     class TKalResMonitor
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TKalResMonitor.h"     // from KalLib
+#include "TVKalSite.h"          // from KalLib
+#include "TMath.h"              // from ROOT
+
+#include <atomic>               // from STL
+#include <mutex>                // from STL
+#include <ostream>              // from STL
+#include <thread>               // from STL
+
+using namespace std;
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Per-thread buckets
+//  ------------------------------
+//
+//  A bucket is written by its thread only; the relaxed atomics let
+//  Merge() read it from another thread.
+
+struct TKalResMonitor::Bucket {
+   thread::id         fThread;
+   atomic<Double_t>  *fMom;
+   atomic<ULong64_t> *fHist;
+   Int_t              fNmom;
+   Int_t              fNhist;
+
+   Bucket(Int_t nmom, Int_t nhist)
+         : fThread(this_thread::get_id()),
+           fMom (new atomic<Double_t> [nmom]),
+           fHist(new atomic<ULong64_t>[nhist]),
+           fNmom (nmom),
+           fNhist(nhist)
+   {
+      Zero();
+   }
+
+   ~Bucket()
+   {
+      delete [] fMom;
+      delete [] fHist;
+   }
+
+   void Zero()
+   {
+      for (Int_t i=0; i<fNmom;  i++) fMom [i].store(0., memory_order_relaxed);
+      for (Int_t i=0; i<fNhist; i++) fHist[i].store(0 , memory_order_relaxed);
+   }
+};
+
+struct TKalResMonitor::Impl {
+   mutex            fMutex;
+   vector<Bucket *> fBuckets;
+};
+
+namespace {
+   template <class T>
+   inline void Inc(atomic<T> &a, T x)
+   {
+      a.store(a.load(memory_order_relaxed) + x, memory_order_relaxed);
+   }
+
+   atomic<ULong64_t> gSerial(0);
+
+   // last bucket used by this thread, valid while the serial matches
+
+   thread_local ULong64_t gCacheSerial = 0;
+   thread_local void     *gCacheBucket = 0;
+}
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Residual and pull monitor
+//  ------------------------------
+//
+ClassImp(TKalResMonitor)
+
+TKalResMonitor::TKalResMonitor(Int_t    nindex,
+                               Int_t    maxdim,
+                               Int_t    nbins,
+                               Double_t pullmax)
+               : fNindex (nindex),
+                 fMaxDim (maxdim),
+                 fNbins  (nbins),
+                 fPullMax(pullmax),
+                 fSerial (++gSerial),
+                 fImplPtr(new Impl)
+{
+}
+
+TKalResMonitor::~TKalResMonitor()
+{
+   for (UInt_t b=0; b<fImplPtr->fBuckets.size(); b++) delete fImplPtr->fBuckets[b];
+   delete fImplPtr;
+}
+
+TKalResMonitor::Bucket & TKalResMonitor::GetBucket()
+{
+   if (gCacheSerial == fSerial) return *static_cast<Bucket *>(gCacheBucket);
+
+   lock_guard<mutex> lock(fImplPtr->fMutex);
+   vector<Bucket *> &buckets = fImplPtr->fBuckets;
+   Bucket *bp = 0;
+   for (UInt_t b=0; b<buckets.size(); b++) {
+      if (buckets[b]->fThread == this_thread::get_id()) bp = buckets[b];
+   }
+   if (!bp) {
+      Int_t nslots = fNindex * fMaxDim;
+      bp = new Bucket(nslots * kNmoments, nslots * (fNbins + 2));
+      buckets.push_back(bp);
+   }
+   gCacheSerial = fSerial;
+   gCacheBucket = bp;
+   return *bp;
+}
+
+//-------------------------------------------------------
+// Fill
+//-------------------------------------------------------
+
+void TKalResMonitor::Fill(TVKalSite &site)
+{
+   Int_t index = site.GetMonitorIndex();
+   if (index < 0 || index >= fNindex) return;
+
+   TKalMatrix &r = site.GetResVec();
+   TKalMatrix &R = site.GetCovMat();
+   Bucket     &b = GetBucket();
+   Int_t       m = TMath::Min(site.GetDimension(), fMaxDim);
+   for (Int_t j=0; j<m; j++) {
+      Int_t    s    = index * fMaxDim + j;
+      Double_t res  = r(j,0);
+      Double_t pull = R(j,j) > 0. ? res / TMath::Sqrt(R(j,j)) : 0.;
+
+      atomic<Double_t> *mom = b.fMom + s * kNmoments;
+      Inc(mom[kN],        1.);
+      Inc(mom[kResSum],   res);
+      Inc(mom[kResSum2],  res * res);
+      Inc(mom[kPullSum],  pull);
+      Inc(mom[kPullSum2], pull * pull);
+
+      Int_t bin = pull < -fPullMax ? 0
+                : pull >= fPullMax ? fNbins + 1
+                : 1 + TMath::Min(fNbins - 1,
+                                 Int_t((pull + fPullMax) / (2. * fPullMax) * fNbins));
+      Inc(b.fHist[s * (fNbins + 2) + bin], ULong64_t(1));
+   }
+}
+
+//-------------------------------------------------------
+// Merge and Reset
+//-------------------------------------------------------
+
+void TKalResMonitor::Merge(Summary &s) const
+{
+   Int_t nslots = fNindex * fMaxDim;
+   s.fNindex  = fNindex;
+   s.fMaxDim  = fMaxDim;
+   s.fNbins   = fNbins;
+   s.fPullMax = fPullMax;
+   s.fMom .assign(nslots * kNmoments, 0.);
+   s.fHist.assign(nslots * (fNbins + 2), 0);
+
+   lock_guard<mutex> lock(fImplPtr->fMutex);
+   vector<Bucket *> &buckets = fImplPtr->fBuckets;
+   for (UInt_t b=0; b<buckets.size(); b++) {
+      Bucket &bk = *buckets[b];
+      for (Int_t i=0; i<bk.fNmom;  i++) s.fMom [i] += bk.fMom [i].load(memory_order_relaxed);
+      for (Int_t i=0; i<bk.fNhist; i++) s.fHist[i] += bk.fHist[i].load(memory_order_relaxed);
+   }
+}
+
+void TKalResMonitor::Reset()
+{
+   lock_guard<mutex> lock(fImplPtr->fMutex);
+   vector<Bucket *> &buckets = fImplPtr->fBuckets;
+   for (UInt_t b=0; b<buckets.size(); b++) buckets[b]->Zero();
+}
+
+//-------------------------------------------------------
+// JSON output
+//-------------------------------------------------------
+
+void TKalResMonitor::WriteJSON(ostream &out) const
+{
+   Summary s;
+   Merge(s);
+   out << "{\"nbins\":" << fNbins << ",\"pull_max\":" << fPullMax
+       << ",\"entries\":[";
+   Bool_t first = kTRUE;
+   for (Int_t i=0; i<fNindex; i++) {
+      for (Int_t j=0; j<fMaxDim; j++) {
+         if (s.GetEntries(i,j) == 0.) continue;
+         out << (first ? "" : ",") << "{\"index\":" << i << ",\"coord\":" << j
+             << ",\"n\":"         << s.GetEntries(i,j)
+             << ",\"res_mean\":"  << s.GetResMean(i,j)
+             << ",\"res_rms\":"   << s.GetResRMS(i,j)
+             << ",\"pull_mean\":" << s.GetPullMean(i,j)
+             << ",\"pull_rms\":"  << s.GetPullRMS(i,j)
+             << ",\"pull_hist\":[";
+         const ULong64_t *h = s.GetPullHist(i,j);
+         for (Int_t k=0; k<fNbins+2; k++) out << (k ? "," : "") << h[k];
+         out << "]}";
+         first = kFALSE;
+      }
+   }
+   out << "]}" << endl;
+}
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Summary
+//  ------------------------------
+//
+namespace {
+   inline Double_t Mean(const Double_t *mom, Int_t k)
+   {
+      return mom[TKalResMonitor::kN] > 0. ? mom[k] / mom[TKalResMonitor::kN] : 0.;
+   }
+
+   inline Double_t RMS(const Double_t *mom, Int_t k)
+   {
+      Double_t mean = Mean(mom, k);
+      Double_t var  = Mean(mom, k + 1) - mean * mean;
+      return var > 0. ? TMath::Sqrt(var) : 0.;
+   }
+}
+
+Double_t TKalResMonitor::Summary::GetResMean(Int_t i, Int_t j) const
+{
+   return Mean(&fMom[GetSlot(i,j) * kNmoments], kResSum);
+}
+
+Double_t TKalResMonitor::Summary::GetResRMS(Int_t i, Int_t j) const
+{
+   return RMS(&fMom[GetSlot(i,j) * kNmoments], kResSum);
+}
+
+Double_t TKalResMonitor::Summary::GetPullMean(Int_t i, Int_t j) const
+{
+   return Mean(&fMom[GetSlot(i,j) * kNmoments], kPullSum);
+}
+
+Double_t TKalResMonitor::Summary::GetPullRMS(Int_t i, Int_t j) const
+{
+   return RMS(&fMom[GetSlot(i,j) * kNmoments], kPullSum);
+}
@@ -0,0 +1,122 @@
+#ifndef TKALRESMONITOR_H
+#define TKALRESMONITOR_H
+//*************************************************************************
+//* ======================
+//*  TKalResMonitor Class
+//* ======================
+//*
+//* (Description)
+//*   Online monitor of smoothed residuals and pulls. Attached to a
+//*   Kalman system with TVKalSystem::SetResMonitor(), it is filled by
+//*   TVKalSite::Smooth() with every smoothed site whose
+//*   GetMonitorIndex() is in [0, nindex). For each index and each
+//*   measurement coordinate j < maxdim it accumulates the moments of
+//*   the residual r_j and of the pull r_j/sqrt(R_jj), and a histogram
+//*   of the pull with nbins bins in [-pullmax, pullmax] plus under-
+//*   and overflow.
+//*
+//*   Each filling thread has its own bucket, written without locks;
+//*   Merge() sums the buckets on demand and WriteJSON() writes the
+//*   indices with entries as one line.
+//* (Requires)
+//*     TObject, TVKalSite
+//* (Provides)
+//*     class TKalResMonitor
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include <iosfwd>           // from STL
+#include <vector>           // from STL
+
+class TVKalSite;
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Residual and pull monitor
+//  ------------------------------
+//
+class TKalResMonitor : public TObject {
+public:
+   enum EMoment { kN = 0,           // entries
+                  kResSum,          // sum of r
+                  kResSum2,         // sum of r^2
+                  kPullSum,         // sum of pulls
+                  kPullSum2,        // sum of pulls^2
+                  kNmoments };
+
+   // Sums over all buckets. Slot s = index * maxdim + j holds the
+   // moments at fMom[s*kNmoments] and the histogram at
+   // fHist[s*(nbins+2)]: underflow, nbins bins, overflow.
+
+   struct Summary {
+      Int_t                  fNindex;
+      Int_t                  fMaxDim;
+      Int_t                  fNbins;
+      Double_t               fPullMax;
+      std::vector<Double_t>  fMom;
+      std::vector<ULong64_t> fHist;
+
+      inline Int_t    GetSlot    (Int_t i, Int_t j) const { return i * fMaxDim + j; }
+      inline Double_t GetEntries (Int_t i, Int_t j) const
+                                 { return fMom[GetSlot(i,j) * kNmoments + kN]; }
+      inline const ULong64_t *GetPullHist(Int_t i, Int_t j) const
+                                 { return &fHist[GetSlot(i,j) * (fNbins + 2)]; }
+             Double_t GetResMean (Int_t i, Int_t j) const;
+             Double_t GetResRMS  (Int_t i, Int_t j) const;
+             Double_t GetPullMean(Int_t i, Int_t j) const;
+             Double_t GetPullRMS (Int_t i, Int_t j) const;
+   };
+
+   TKalResMonitor(Int_t    nindex  = 0,
+                  Int_t    maxdim  = 2,
+                  Int_t    nbins   = 50,
+                  Double_t pullmax = 5.);
+   virtual ~TKalResMonitor();
+
+   // Book the smoothed residual of site; a no-op if its monitor index
+   // is out of range
+
+   void     Fill    (TVKalSite &site);
+
+   // Sum the buckets of all threads; may run while others fill
+
+   void     Merge   (Summary &s) const;
+
+   // Zero all buckets; only while no thread fills
+
+   void     Reset   ();
+
+   // {"nbins":..,"pull_max":..,"entries":[{"index":..,"coord":..,"n":..,
+   //  "res_mean":..,"res_rms":..,"pull_mean":..,"pull_rms":..,"pull_hist":[..]},..]}
+
+   void     WriteJSON(std::ostream &out) const;
+
+   inline Int_t    GetNindex () const { return fNindex;  }
+   inline Int_t    GetMaxDim () const { return fMaxDim;  }
+   inline Int_t    GetNbins  () const { return fNbins;   }
+   inline Double_t GetPullMax() const { return fPullMax; }
+
+private:
+   TKalResMonitor(const TKalResMonitor &);
+   TKalResMonitor & operator=(const TKalResMonitor &);
+
+   struct Bucket;
+   struct Impl;
+
+   Bucket & GetBucket();
+
+private:
+   Int_t     fNindex;    // number of monitor indices
+   Int_t     fMaxDim;    // coordinates per index
+   Int_t     fNbins;     // pull histogram bins
+   Double_t  fPullMax;   // pull histogram range
+   ULong64_t fSerial;    //! identifies this monitor to the bucket cache
+   Impl     *fImplPtr;   //! buckets and their lock
+
+   ClassDef(TKalResMonitor,1)  // residual and pull monitor
+};
+
+#endif
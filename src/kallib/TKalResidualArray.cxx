@@ -0,0 +1,64 @@
+//*************************************************************************
+//* ==========================
+//*  TKalResidualArray Class
+//* ==========================
+//*
+//* (Description)
+//*   Unbiased residuals of all sites in flat arrays.
+//* (Requires)
+//*     TObject
+//* (Provides)
+//*     class TKalResidualArray
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TKalResidualArray.h"  // from KalLib
+#include "TKalMatrix.h"         // from KalLib
+#include "TMath.h"              // from ROOT
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Array of unbiased residuals
+//  ------------------------------
+//
+ClassImp(TKalResidualArray)
+
+void TKalResidualArray::Clear(Option_t *)
+{
+   fSite     .clear();
+   fResOffset.assign(1, 0);
+   fCovOffset.assign(1, 0);
+   fRes      .clear();
+   fCov      .clear();
+}
+
+void TKalResidualArray::Add(Int_t site, Int_t m, const Double_t *res, const Double_t *cov)
+{
+   fSite.push_back(site);
+   fRes .insert(fRes.end(), res, res + m);
+   fCov .insert(fCov.end(), cov, cov + m * m);
+   fResOffset.push_back(fRes.size());
+   fCovOffset.push_back(fCov.size());
+}
+
+Double_t TKalResidualArray::GetPull(Int_t i, Int_t j) const
+{
+   Double_t var = GetCovariance(i, j, j);
+   return var > 0. ? GetResidual(i, j) / TMath::Sqrt(var) : 0.;
+}
+
+Double_t TKalResidualArray::GetChi2(Int_t i) const
+{
+   Int_t      m = GetDimension(i);
+   TKalMatrix r(m,1);
+   TKalMatrix R(m,m);
+   for (Int_t j=0; j<m; j++) {
+      r(j,0) = GetResidual(i, j);
+      for (Int_t k=0; k<m; k++) R(j,k) = GetCovariance(i, j, k);
+   }
+   TKalMatrix rt  (TKalMatrix::kTransposed, r);
+   TKalMatrix Rinv(TKalMatrix::kInverted,   R);
+   return (rt * Rinv * r)(0,0);
+}
@@ -0,0 +1,71 @@
+#ifndef TKALRESIDUALARRAY_H
+#define TKALRESIDUALARRAY_H
+//*************************************************************************
+//* ==========================
+//*  TKalResidualArray Class
+//* ==========================
+//*
+//* (Description)
+//*   Unbiased (hit-excluded) residuals and their covariance matrices
+//*   for all sites of a Kalman system, stored back to back in flat
+//*   arrays. Filled by TVKalSystem::CalcUnbiasedResiduals().
+//* (Requires)
+//*     TObject
+//* (Provides)
+//*     class TKalResidualArray
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include <vector>           // from STL
+
+//_____________________________________________________________________
+//  ------------------------------
+//  Array of unbiased residuals
+//  ------------------------------
+//
+class TKalResidualArray : public TObject {
+public:
+   TKalResidualArray() {}
+   virtual ~TKalResidualArray() {}
+
+   void     Clear   (Option_t *opt = "");
+
+   // Append the residual of site (index in the system) with m
+   // components res[m] and covariance cov[m*m] (row-wise).
+
+   void     Add     (Int_t site, Int_t m, const Double_t *res, const Double_t *cov);
+
+   // Accessors for the i-th entry (i = 0 .. GetEntries()-1)
+
+   inline Int_t    GetEntries  ()             const { return fSite.size();                 }
+   inline Int_t    GetSiteIndex(Int_t i)      const { return fSite[i];                     }
+   inline Int_t    GetDimension(Int_t i)      const { return fResOffset[i+1] - fResOffset[i]; }
+   inline Double_t GetResidual (Int_t i, Int_t j) const
+                                                    { return fRes[fResOffset[i] + j];     }
+   inline Double_t GetCovariance(Int_t i, Int_t j, Int_t k) const
+                         { return fCov[fCovOffset[i] + j * GetDimension(i) + k]; }
+          Double_t GetPull     (Int_t i, Int_t j) const;
+          Double_t GetChi2     (Int_t i)          const;
+
+   // Flat storage: residuals of entry i start at GetResiduals() +
+   // GetResOffset(i), their covariance at GetCovariances() + GetCovOffset(i).
+
+   inline const Double_t *GetResiduals  ()        const { return fRes.empty() ? 0 : &fRes[0]; }
+   inline const Double_t *GetCovariances()        const { return fCov.empty() ? 0 : &fCov[0]; }
+   inline Int_t           GetResOffset  (Int_t i) const { return fResOffset[i];               }
+   inline Int_t           GetCovOffset  (Int_t i) const { return fCovOffset[i];               }
+
+private:
+   std::vector<Int_t>    fSite;                   // site index in the system
+   std::vector<Int_t>    fResOffset = {0};        // start of each entry in fRes
+   std::vector<Int_t>    fCovOffset = {0};        // start of each entry in fCov
+   std::vector<Double_t> fRes;                    // residuals
+   std::vector<Double_t> fCov;                    // covariance matrices
+
+   ClassDef(TKalResidualArray,1)  // array of unbiased residuals
+};
+
+#endif
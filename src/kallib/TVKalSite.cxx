@@ -13,6 +13,11 @@
 //* (Update Recored)
 //*   2003/09/30  K.Fujii	Original version.
 //*   2009/06/18  K.Fujii       Implement inverse Kalman filter
+//*   2026/10/18                TKalStats timers
+//*   2026/10/18                TKalStats allocation tags
+//*   2026/10/18                Fill the residual monitor in Smooth()
+//*   2026/10/18                Added Combine()
+//*   2026/10/18                Smooth() without residual update
 //*
 //*************************************************************************
 //
@@ -21,6 +26,9 @@
 #include <cstdlib>
 #include "TVKalSite.h"
 #include "TVKalState.h"
+#include "TVKalSystem.h"
+#include "TKalResMonitor.h"
+#include "TKalStats.h"
 
 //_____________________________________________________________________
 //  ------------------------------
@@ -39,7 +47,8 @@ TVKalSite::TVKalSite(Int_t m, Int_t p)
                     fHt(p,m),
                     fResVec(m,1),
                     fR(m,m),
-                    fDeltaChi2(0.)
+                    fDeltaChi2(0.),
+                    fIsResSmoothed(kFALSE)
 {
    // Create fStateVector at constractor of concreate class:
    // SetStateVector(new TXXXKalmanStateVector(.....))
@@ -55,6 +64,9 @@ TVKalSite::~TVKalSite()
 
 Bool_t TVKalSite::Filter()
 {
+   KALSTATS_TIMER(kFilter);
+   KALSTATS_ALLOC_TAG(kAllocFilter);
+
    // prea and preC should be preset by TVKalState::Propagate()
    TVKalState &prea = GetState(TVKalSite::kPredicted);
    TKalMatrix h = fM;
@@ -99,6 +111,7 @@ Bool_t TVKalSite::Filter()
    fResVec = fM - h;
    TKalMatrix curResVect = TKalMatrix(TKalMatrix::kTransposed, fResVec);
    fDeltaChi2 = (curResVect * G * fResVec + Kpullt * preCinv * Kpull)(0,0);
+   fIsResSmoothed = kFALSE;
 
    if (IsAccepted()) return kTRUE;
    else              return kFALSE;
@@ -108,9 +121,15 @@ Bool_t TVKalSite::Filter()
 // Smooth
 //---------------------------------------------------------------
 
-void TVKalSite::Smooth(TVKalSite &pre)
+void TVKalSite::Smooth(TVKalSite &pre, Bool_t res)
 {
-   if (&GetState(TVKalSite::kSmoothed)) return;
+   KALSTATS_TIMER(kSmooth);
+   KALSTATS_ALLOC_TAG(kAllocSmooth);
+
+   if (&GetState(TVKalSite::kSmoothed)) {
+      if (res && !fIsResSmoothed) SmoothResVec();
+      return;
+   }
 
    TVKalState &cura  = GetState(TVKalSite::kFiltered);
    TVKalState &prea  = pre.GetState(TVKalSite::kPredicted);
@@ -129,13 +148,83 @@ void TVKalSite::Smooth(TVKalSite &pre)
    Add(&CreateState(sv,scurC,TVKalSite::kSmoothed));
    SetOwner();
 
-   // Update residual vector
+   if (res) SmoothResVec();
+}
+
+//---------------------------------------------------------------
+// SmoothResVec
+//---------------------------------------------------------------
+//    Updates the residual vector of the filtered state, its covariance
+//    matrix, and the chi2 increment to those of the smoothed state.
 
-   fR       = fV - fH * scurC *fHt;
-   fResVec -= fH * (sv - cura);
+void TVKalSite::SmoothResVec()
+{
+   TVKalState &cura = GetState(TVKalSite::kFiltered);
+   TVKalState &sa   = GetState(TVKalSite::kSmoothed);
+
+   fR       = fV - fH * sa.GetCovMat() *fHt;
+   fResVec -= fH * (sa - cura);
    TKalMatrix curResVect = TKalMatrix(TKalMatrix::kTransposed, fResVec);
    TKalMatrix curRinv    = TKalMatrix(TKalMatrix::kInverted, fR);
    fDeltaChi2 = (curResVect * curRinv * fResVec)(0,0);
+   fIsResSmoothed = kTRUE;
+
+   TVKalSystem *sysPtr = TVKalSystem::GetCurInstancePtr();
+   if (sysPtr && sysPtr->GetResMonitor()) sysPtr->GetResMonitor()->Fill(*this);
+}
+
+//---------------------------------------------------------------
+// Combine
+//---------------------------------------------------------------
+//    With the filtered state a (covariance C) and the backward state
+//    b (covariance Cb) at the same site,
+//       C' = (C^-1 + Cb^-1)^-1,   a' = a + C' * Cb^-1 * (b - a)
+//    which needs no state of the site ahead, so that sites can be
+//    smoothed in any order.
+
+void TVKalSite::Combine(const TVKalState *bPtr,
+                              TKalMatrix *rPtr,
+                              TKalMatrix *RPtr)
+{
+   KALSTATS_TIMER(kSmooth);
+   KALSTATS_ALLOC_TAG(kAllocSmooth);
+
+   TVKalState &cura = GetState(TVKalSite::kFiltered);
+   TVKalState &prea = GetState(TVKalSite::kPredicted);
+
+   TKalMatrix bCinv = bPtr ? TKalMatrix(TKalMatrix::kInverted, bPtr->GetCovMat())
+                           : TKalMatrix();
+
+   if (!&GetState(TVKalSite::kSmoothed)) {
+      TKalMatrix scurC = cura.GetCovMat();
+      TKalMatrix sv    = cura;
+      if (bPtr) {
+         TKalMatrix curCinv = TKalMatrix(TKalMatrix::kInverted, scurC);
+         scurC = TKalMatrix(TKalMatrix::kInverted, curCinv + bCinv);
+         sv   += scurC * bCinv * (*bPtr - cura);
+      }
+      Add(&CreateState(sv,scurC,TVKalSite::kSmoothed));
+      SetOwner();
+   }
+   if (!fIsResSmoothed) SmoothResVec();
+
+   if (!rPtr) return;
+
+   // The same with the predicted state, which has not seen the hit
+
+   TKalMatrix uC = prea.GetCovMat();
+   TKalMatrix uv = prea;
+   if (bPtr) {
+      TKalMatrix preCinv = TKalMatrix(TKalMatrix::kInverted, uC);
+      uC  = TKalMatrix(TKalMatrix::kInverted, preCinv + bCinv);
+      uv += uC * bCinv * (*bPtr - prea);
+   }
+   rPtr->ResizeTo(fResVec);
+   *rPtr = fResVec - fH * (uv - GetState(TVKalSite::kSmoothed));
+   if (RPtr) {
+      RPtr->ResizeTo(fV);
+      *RPtr = fV + fH * uC * fHt;
+   }
 }
 
 //---------------------------------------------------------------
@@ -144,7 +233,10 @@ void TVKalSite::Smooth(TVKalSite &pre)
 
 void TVKalSite::InvFilter()
 {
+   KALSTATS_TIMER(kInvFilter);
+
    if (&GetState(TVKalSite::kInvFiltered)) return;
+   if (!fIsResSmoothed) SmoothResVec();
 
    TVKalState &sa = GetState(TVKalSite::kSmoothed);
    TKalMatrix pull = fResVec;
@@ -169,7 +261,7 @@ TKalMatrix TVKalSite::GetResVec (TVKalSite::EStType t)
 {
    using namespace std;
    TVKalState &a  = GetState(t);
-   TVKalState &sa = (&GetState(TVKalSite::kSmoothed) != 0
+   TVKalState &sa = (&GetState(TVKalSite::kSmoothed) != 0 && fIsResSmoothed
                     ? GetState(TVKalSite::kSmoothed)
                     : GetState(TVKalSite::kFiltered));
    if (!&a || !&sa) {
@@ -18,6 +18,9 @@
 //*   2005/08/25  A.Yamaguchi	Removed getter and setter for a new static
 //*                             data member, fgKalSysPtr.
 //*   2009/06/18  K.Fujii       Implement inverse Kalman filter
+//*   2026/10/18                Added GetMonitorIndex().
+//*   2026/10/18                Added Combine() for two-filter smoothing.
+//*   2026/10/18                Smooth() can leave the residual for later.
 //*
 //*************************************************************************
 //
@@ -61,7 +64,21 @@ public:
 
    virtual Bool_t  Filter();
 
-   virtual void    Smooth(TVKalSite &pre);
+   // Smoothing from the smoothed state of the site ahead. Unless res,
+   // the residual, its covariance matrix, and the chi2 increment stay
+   // those of the filtered state until asked for, see IsResSmoothed().
+
+   virtual void    Smooth(TVKalSite &pre, Bool_t res = kTRUE);
+
+   // Two-filter smoothing: the smoothed state is the weighted mean of
+   // the filtered state and bPtr, the state at this site of a filter
+   // run backwards that has not seen this site (0 if none). The
+   // residual with the hit excluded, from the predicted state and
+   // bPtr, goes to *rPtr and its covariance to *RPtr, if given.
+
+   virtual void    Combine(const TVKalState *bPtr,
+                                 TKalMatrix *rPtr = 0,
+                                 TKalMatrix *RPtr = 0);
 
    virtual void    InvFilter();
 
@@ -78,11 +95,18 @@ public:
    inline virtual TKalMatrix & GetResVec       ()   { return fResVec;       }
    inline virtual TKalMatrix & GetCovMat       ()   { return fR;            }
    inline virtual Double_t     GetDeltaChi2() const { return fDeltaChi2;    }
+   inline         Bool_t       IsResSmoothed() const { return fIsResSmoothed; }
           virtual TKalMatrix   GetResVec (EStType t);
 
+   // Index under which TKalResMonitor books this site, -1 if none
+
+   inline virtual Int_t        GetMonitorIndex() const { return -1; }
+
 private:
    // Private utility methods
 
+   void SmoothResVec();
+
    virtual TVKalState & CreateState(const TKalMatrix &sv, Int_t type = 0) = 0;
    virtual TVKalState & CreateState(const TKalMatrix &sv, const TKalMatrix &c,
                                     Int_t type = 0) = 0;
@@ -99,6 +123,7 @@ private:
    TKalMatrix     fResVec{};      // m - h(a): M(m,1)
    TKalMatrix     fR{};           // covariance matrix: M(m,m)
    Double_t       fDeltaChi2{};   // chi2 increment
+   Bool_t         fIsResSmoothed{}; // fResVec, fR, fDeltaChi2 smoothed
 
    ClassDef(TVKalSite,1)      // Base class for measurement vector objects
 };
@@ -11,11 +11,13 @@
 //* 	class TVKalState
 //* (Update Recored)
 //*   2003/09/30  K.Fujii	Original version
+//*   2026/10/18                TKalStats allocation tag
 //*
 //*************************************************************************
 //
 #include "TVKalState.h"
 #include "TVKalSite.h"
+#include "TKalStats.h"
 //_____________________________________________________________________
 //  ------------------------------
 //  Base Class for measurement vector used by Kalman filter
@@ -103,6 +105,8 @@ void TVKalState::Propagate(TVKalSite &to)
    //    fF:    propagator derivative       : F_k-1   = (@f_k-1/@a_k-1)
    //    fQ:    process noise from k-1 to k : Q_k-1)
 
+   KALSTATS_ALLOC_TAG(kAllocPropagate);
+
    TVKalState &prea    = MoveTo(to,fF,fQ);
    TVKalState *preaPtr = &prea;
 
@@ -12,14 +12,23 @@
 //* (Update Recored)
 //*   2003/09/30  K.Fujii	Original version.
 //*   2009/06/18  K.Fujii       Implement inverse Kalman filter
+//*   2026/10/18                Added CalcUnbiasedResiduals().
+//*   2026/10/18                Made fgCurInstancePtr thread local.
+//*   2026/10/18                Added the residual monitor.
+//*   2026/10/18                Added SmoothTwoFilter().
+//*   2026/10/18                Added GetSmoothedState().
+//*   2026/10/18                Unbiased residual of the last site from
+//*                             its predicted state.
 //*
 //*************************************************************************
 
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
+#include <vector>
 #include "TVKalSystem.h"
 #include "TVKalState.h"
+#include "TKalResidualArray.h"
 
 //_____________________________________________________________________
 //  ------------------------------
@@ -28,12 +37,13 @@
 //
 ClassImp(TVKalSystem)
 
-TVKalSystem *TVKalSystem::fgCurInstancePtr = 0;
+thread_local TVKalSystem *TVKalSystem::fgCurInstancePtr = 0;
 
 TVKalSystem::TVKalSystem(Int_t n) 
             :TObjArray(n),
              fCurSitePtr(0),
-             fChi2(0.)
+             fChi2(0.),
+             fResMonitorPtr(0)
 {
    if (!fgCurInstancePtr) fgCurInstancePtr = this;
 }
@@ -96,6 +106,8 @@ Int_t TVKalSystem::GetNDF(Bool_t self)
 
 void TVKalSystem::SmoothBackTo(Int_t k)
 {
+   SetCurInstancePtr(this);   // TVKalSite::Smooth() looks up the monitor
+
    TIter previous(this,kIterBackward);
    TIter cur     (this,kIterBackward);
 
@@ -106,6 +118,7 @@ void TVKalSystem::SmoothBackTo(Int_t k)
    if (!&scura) {
       curPtr->Add(&curPtr->CreateState(cura, cura.GetCovMat(),
                                        TVKalSite::kSmoothed));
+      curPtr->fIsResSmoothed = kTRUE;
    }
 
    while ((curPtr = static_cast<TVKalSite *>(cur())) && 
@@ -126,6 +139,76 @@ void TVKalSystem::SmoothAll()
    SmoothBackTo(0);
 }
 
+//-------------------------------------------------------
+// SmoothTwoFilter
+//-------------------------------------------------------
+//    Each site is combined with its backward state on its own, so
+//    the order does not matter; as after SmoothAll(), the first site
+//    is the current one in the end.
+
+void TVKalSystem::SmoothTwoFilter(const TObjArray         &bwd,
+                                        TKalResidualArray *resPtr)
+{
+   SetCurInstancePtr(this);   // TVKalSite::Combine() looks up the monitor
+
+   if (resPtr) resPtr->Clear();
+   Int_t nsites = GetEntries();
+   Int_t nbwd   = bwd.GetEntriesFast();
+   TKalMatrix r, R;
+   for (Int_t k=0; k<nsites; k++) {
+      TVKalSite  &site = *static_cast<TVKalSite *>(At(k));
+      const TVKalState *bPtr = k < nbwd ? static_cast<const TVKalState *>(bwd.UncheckedAt(k))
+                                        : 0;
+      if (resPtr && k > 0) {
+         site.Combine(bPtr, &r, &R);
+         resPtr->Add(k, site.GetDimension(), r.GetMatrixArray(), R.GetMatrixArray());
+      } else {
+         site.Combine(bPtr);
+      }
+   }
+   if (nsites) fCurSitePtr = static_cast<TVKalSite *>(At(0));
+}
+
+//-------------------------------------------------------
+// GetSmoothedState
+//-------------------------------------------------------
+
+TVKalState & TVKalSystem::GetSmoothedState(Int_t k, Bool_t res)
+{
+   using namespace std;
+   Int_t nsites = GetEntries();
+   if (k < 0 || k >= nsites) {
+      cerr << "::::: ERROR in TVKalSystem::GetSmoothedState(k=" << k << ")" << endl
+           << "  Site " << k << " nonexistent! Abort!"
+           << endl;
+      ::abort();
+   }
+   SetCurInstancePtr(this);   // TVKalSite::Smooth() looks up the monitor
+
+   // the last site, whose filtered state is the smoothed one
+
+   TVKalSite  *lastPtr = static_cast<TVKalSite *>(At(nsites-1));
+   if (!&lastPtr->GetState(TVKalSite::kSmoothed)) {
+      TVKalState &lasta = lastPtr->GetState(TVKalSite::kFiltered);
+      lastPtr->Add(&lastPtr->CreateState(lasta, lasta.GetCovMat(),
+                                         TVKalSite::kSmoothed));
+      lastPtr->fIsResSmoothed = kTRUE;
+   }
+
+   // the first site smoothed before from k on, and down from there
+
+   Int_t j = k;
+   while (!&static_cast<TVKalSite *>(At(j))->GetState(TVKalSite::kSmoothed)) j++;
+   for (Int_t i=j-1; i>=k; i--) {
+      static_cast<TVKalSite *>(At(i))->Smooth(*static_cast<TVKalSite *>(At(i+1)),
+                                              res && i == k);
+   }
+
+   TVKalSite &site = *static_cast<TVKalSite *>(At(k));
+   if (res && !site.fIsResSmoothed) site.SmoothResVec();
+   return site.GetState(TVKalSite::kSmoothed);
+}
+
 //-------------------------------------------------------
 // InvFilter
 //-------------------------------------------------------
@@ -153,3 +236,94 @@ void TVKalSystem::InvFilter(Int_t k)
    fCurSitePtr = curPtr;
    curPtr->InvFilter();
 }
+
+//-------------------------------------------------------
+// CalcUnbiasedResiduals
+//-------------------------------------------------------
+//    Runs the smoother from the last site back to site 1, keeping
+//    the smoothed state of the site ahead only, and converts each
+//    smoothed residual r (covariance R = V - H*C*H^t) into the
+//    residual with the hit excluded:
+//       r* = V * R^-1 * r,   R* = V * R^-1 * V
+//    This needs inversions of m x m matrices only, besides the one
+//    of the predicted covariance that smoothing needs anyway.
+//    Sites smoothed before are taken as they are. The residual of the
+//    last site is that of its predicted state.
+
+Int_t TVKalSystem::CalcUnbiasedResiduals(TKalResidualArray &res)
+{
+   res.Clear();
+   Int_t nsites = GetEntries();
+   if (nsites < 2) return 0;
+
+   TVKalSite  &last = *static_cast<TVKalSite *>(At(nsites-1));
+   TVKalState &lasta = last.GetState(TVKalSite::kFiltered);
+   TKalMatrix  sv(lasta);                 // smoothed state of site k
+   TKalMatrix  sC(lasta.GetCovMat());     // and its covariance
+
+   std::vector<Double_t> rbuf;            // r*  of sites n-1 .. 1
+   std::vector<Double_t> cbuf;            // R*  of sites n-1 .. 1
+
+   for (Int_t k=nsites-1; k>=1; k--) {
+      TVKalSite  &site = *static_cast<TVKalSite *>(At(k));
+      TVKalState &cura = site.GetState(TVKalSite::kFiltered);
+      TVKalState &sa   = site.GetState(TVKalSite::kSmoothed);
+      Bool_t      done = site.fIsResSmoothed || k == nsites-1;
+
+      if (&sa) {
+         sv = sa;
+         sC = sa.GetCovMat();
+      } else if (k < nsites-1) {
+         TVKalSite  &pre   = *static_cast<TVKalSite *>(At(k+1));
+         TVKalState &prea  = pre.GetState(TVKalSite::kPredicted);
+         TKalMatrix curC    = cura.GetCovMat();
+         TKalMatrix preCinv = TKalMatrix(TKalMatrix::kInverted, prea.GetCovMat());
+         TKalMatrix curA    = curC * cura.GetPropMat("T") * preCinv;
+         TKalMatrix curAt   = TKalMatrix(TKalMatrix::kTransposed, curA);
+         sC = curC + curA * (sC - prea.GetCovMat()) * curAt;
+         sv = cura + curA * (sv - prea);
+      }
+
+      // Smoothed residual: fResVec is already smoothed for sites
+      // whose residuals were smoothed before, filtered otherwise.
+
+      TKalMatrix r = site.fResVec;
+      if (!done) r -= site.fH * (sv - cura);
+      TKalMatrix R     = site.fV - site.fH * sC * site.fHt;
+      TKalMatrix VRinv = site.fV * TKalMatrix(TKalMatrix::kInverted, R);
+      TKalMatrix rstar = VRinv * r;
+      TKalMatrix Rstar = VRinv * site.fV;
+
+      // Without its hit the last site has the predicted state, whose
+      // residual is taken as it is rather than through the linearised
+      // measurement function: the prediction may be far off the hit.
+
+      if (k == nsites-1) {
+         TVKalState &prea = site.GetState(TVKalSite::kPredicted);
+         TKalMatrix  h    = site.fM;
+         if (&prea && site.CalcExpectedMeasVec(prea, h)) rstar = site.fM - h;
+      }
+
+      Int_t m = site.GetDimension();
+      for (Int_t i=0; i<m; i++) {
+         rbuf.push_back(rstar(i,0));
+         for (Int_t j=0; j<m; j++) cbuf.push_back(Rstar(i,j));
+      }
+   }
+
+   // Fill in site order
+
+   Int_t ir = rbuf.size();
+   Int_t ic = cbuf.size();
+   std::vector<Int_t> dims;
+   for (Int_t k=nsites-1; k>=1; k--) {
+      dims.push_back(static_cast<TVKalSite *>(At(k))->GetDimension());
+   }
+   for (Int_t k=1; k<nsites; k++) {
+      Int_t m = dims[nsites-1-k];
+      ir -= m;
+      ic -= m * m;
+      res.Add(k, m, &rbuf[ir], &cbuf[ic]);
+   }
+   return nsites - 1;
+}
@@ -15,6 +15,12 @@
 //*   2003/09/30  K.Fujii	Original version.
 //*   2005/08/25  A.Yamaguchi	Added fgCurInstancePtr and its getter & setter.
 //*   2009/06/18  K.Fujii       Implement inverse Kalman filter
+//*   2026/10/18                Added CalcUnbiasedResiduals().
+//*   2026/10/18                Made fgCurInstancePtr thread local.
+//*   2026/10/18                Added the residual monitor.
+//*   2026/10/18                Added SmoothTwoFilter().
+//*   2026/10/18                SetCurInstancePtr() made protected.
+//*   2026/10/18                Added GetSmoothedState().
 //*
 //*************************************************************************
 
@@ -27,6 +33,8 @@
 //  ------------------------------
 //
 class TKalMatrix;
+class TKalResidualArray;
+class TKalResMonitor;
 
 class TVKalSystem : public TObjArray {
 friend class TVKalSite;
@@ -44,8 +52,32 @@ public:
    virtual Bool_t AddAndFilter(TVKalSite &next);
    virtual void   SmoothBackTo(Int_t k);
    virtual void   SmoothAll();
+
+   // Two-filter alternative to SmoothAll(): bwd.At(i) is the state at
+   // site i of a filter run backwards from the last site, that has not
+   // seen site i (0 for the last site), at the pivot of the filtered
+   // state. The unbiased residuals of sites 1 .. n-1 go to *resPtr,
+   // if given. See TVKalSite::Combine().
+
+   virtual void   SmoothTwoFilter(const TObjArray         &bwd,
+                                        TKalResidualArray *resPtr = 0);
    virtual void   InvFilter(Int_t k);
 
+   // Smoothed state of site k, smoothing on demand only the sites from
+   // the first one smoothed before after k, or the last, down to k. The
+   // residuals and chi2 increments of the sites on the way are left as
+   // filtered, and so is that of site k unless res; see
+   // TVKalSite::Smooth(). The states stay at the sites, so that asking
+   // again costs nothing. Unlike SmoothBackTo(), the current site is
+   // left as it is.
+
+   virtual TVKalState & GetSmoothedState(Int_t k, Bool_t res = kFALSE);
+
+   // Unbiased residuals of sites 1 .. n-1 in one backward sweep,
+   // without adding states to the sites. Returns the number of sites.
+
+   virtual Int_t  CalcUnbiasedResiduals(TKalResidualArray &res);
+
    inline  void   Add(TObject *obj);
 
    // Getters
@@ -55,19 +87,27 @@ public:
                                    { return fCurSitePtr->GetState(t); }
    inline virtual Double_t     GetChi2() { return fChi2; }
           virtual Int_t        GetNDF (Bool_t self = kTRUE);
+   inline         TKalResMonitor *GetResMonitor() const { return fResMonitorPtr; }
    
    static         TVKalSystem *GetCurInstancePtr() { return fgCurInstancePtr; }
 
    // Setters
 
-private:
+   // Sites smoothed by this system are booked in *mp (not owned); 0 to detach
+
+   inline         void SetResMonitor(TKalResMonitor *mp) { fResMonitorPtr = mp; }
+
+protected:
+   // Threads started by a derived system must set it for themselves
+
    static void SetCurInstancePtr(TVKalSystem *ksp) { fgCurInstancePtr = ksp; }
 
 private:
    TVKalSite   *fCurSitePtr{};  // pointer to current site
    Double_t     fChi2{};        // current total chi2
+   TKalResMonitor *fResMonitorPtr{}; //! residual monitor, not owned
 
-   static TVKalSystem *fgCurInstancePtr;  //! currently active instance
+   static thread_local TVKalSystem *fgCurInstancePtr;  //! active instance of this thread
    
    ClassDef(TVKalSystem,1)  // Base class for Kalman Filter
 };
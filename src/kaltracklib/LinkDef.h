@@ -13,5 +13,14 @@
 #pragma link C++ class TVKalDetector+;
 #pragma link C++ class TKalFilterCond+;
 #pragma link C++ class TTrackFrame+;
+#pragma link C++ class TKalHitStore+;
+#pragma link C++ class TKalTrackSeeder+;
+#pragma link C++ class TKalBrokenLines+;
+#pragma link C++ class TKalTrackWriter+;
+#pragma link C++ class TKalTrackReader+;
+#pragma link C++ class TKalHitFile+;
+#pragma link C++ class TKalHitView+;
+#pragma link C++ class TKalCradleSnapshot+;
+#pragma link C++ class TKalExtrapolator+;
 
 #endif
@@ -0,0 +1,704 @@
+//*************************************************************************
+//* =======================
+//*  TKalBrokenLines Class
+//* =======================
+//*
+//* (Description)
+//*   Global track refit with explicit multiple scattering kinks.
+//* (Requires)
+//*     TKalTrack, TKalTrackSite, TKalDetCradle, TVMeasLayer,
+//*     TKalBandMatrix
+//* (Provides)
+//*     class TKalBrokenLines
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  No crossings behind the pivot on the way out.
+//*
+//*************************************************************************
+//
+// Notation
+//   a = (drho, phi0, kappa, dz, tanl [, t0]) at a point's pivot.
+//   u = (drho, dz) are the offsets, w = (phi0, tanl) the slopes, and
+//   omega = kappa*cos(lambda), which multiple scattering leaves
+//   unchanged, replaces kappa as curvature parameter.
+//   Offsets are fitted at the first and last points and at every
+//   point with a scatterer in between ("offset points"). The slopes
+//   between two neighbouring offset points follow from the offsets
+//   and omega through the propagator matrix; the scattering kink at
+//   an offset point is the difference of its outgoing and incoming
+//   slopes. Points without a scatterer are interpolated.
+//
+
+#include "TKalBrokenLines.h"  // from KalTrackLib
+#include "KalTrackDim.h"      // from KalTrackLib
+#include "TKalTrack.h"        // from KalTrackLib
+#include "TKalTrackSite.h"    // from KalTrackLib
+#include "TKalTrackState.h"   // from KalTrackLib
+#include "TKalDetCradle.h"    // from KalTrackLib
+#include "TVMeasLayer.h"      // from KalTrackLib
+#include "TVTrackHit.h"       // from KalTrackLib
+#include "TVSurface.h"        // from GeomLib
+#include "TVTrack.h"          // from GeomLib
+#include "TBField.h"          // from Bfield
+
+#include <memory>             // from STL
+
+using namespace std;
+
+namespace {
+   const Int_t kU[2] = { 0, 3 };   // offset  components of a
+   const Int_t kW[2] = { 1, 4 };   // slope   components of a
+   const Int_t kC    = 2;          // curvature component of a
+
+   // (@a/@q) for q = (drho, phi0, omega, dz, tanl)
+
+   void CalcDaDq(const TKalMatrix &sv, Bool_t isinb, TKalMatrix &dadq)
+   {
+      dadq.UnitMatrix();
+      if (!isinb) return;
+      Double_t cpa  = sv(2,0);
+      Double_t tnl  = sv(4,0);
+      Double_t csl2 = 1. / (1. + tnl * tnl);
+      dadq(2,2) = TMath::Sqrt(1. + tnl * tnl);
+      dadq(2,4) = cpa * tnl * csl2;
+   }
+}
+
+ClassImp(TKalBrokenLines)
+
+//_________________________________________________________________________
+// ------------------------------
+//  Ctor
+// ------------------------------
+//
+TKalBrokenLines::TKalBrokenLines()
+               : fMaxIter(1),
+                 fSdim(kSdim),
+                 fIsInB(kTRUE),
+                 fNb(0),
+                 fNlocal(0),
+                 fChi2(0.),
+                 fNDF(0),
+                 fT0(0.)
+{
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  Fit
+// ------------------------------
+//
+Int_t TKalBrokenLines::Fit(TKalTrack &kt)
+{
+   fSites.clear();
+   TIter next(&kt);
+   TKalTrackSite *sitePtr;
+   while ((sitePtr = static_cast<TKalTrackSite *>(next()))) {
+      if (!sitePtr->IsLocked()) fSites.push_back(sitePtr);
+   }
+   if (fSites.size() < 2) {
+      cerr << ">>>> Error!! TKalBrokenLines::Fit >>>>>>>>>>>>>>" << endl
+           << " Less than 2 sites to fit." << endl;
+      return 0;
+   }
+   if (!TBField::IsUsingUniformBfield()) {
+      cerr << ">>>> Error!! TKalBrokenLines::Fit >>>>>>>>>>>>>>" << endl
+           << " Non-uniform field not supported." << endl;
+      return 0;
+   }
+
+   TKalTrackSite        &last = *fSites.back();
+   const TKalTrackState &a0   = static_cast<const TKalTrackState &>(last.GetCurState());
+
+   fSdim  = a0.GetDimension();
+   fIsInB = last.IsInB();
+   fNb    = (fIsInB ? 1 : 0) + (fSdim == 6 ? 1 : 0);
+   fT0    = fSdim == 6 ? a0(5,0) : 0.;
+
+   unique_ptr<TVTrack> help(&a0.CreateTrack());
+
+   for (Int_t iter=0; iter<fMaxIter; iter++) {
+      if (iter) {
+         // Restart the reference from the fitted state at point 0
+
+         Int_t idx[8];
+         Int_t nloc = GetLocalIndex(0, idx);
+         const Point &pt = fPoints[0];
+         TKalMatrix sv(5,1);
+         for (Int_t i=0; i<5; i++) {
+            sv(i,0) = pt.fSv(i,0);
+            for (Int_t c=0; c<nloc; c++) sv(i,0) += pt.fG(i,c) * fX[idx[c]];
+         }
+         if (fSdim == 6) fT0 += fX[idx[nloc-1]];
+         help->SetTo(sv, pt.fX0);
+      }
+      if (!MakeReference(*help, fT0)) return 0;
+      if (!Solve())                   return 0;
+   }
+   return 1;
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  MakeReference
+// ------------------------------
+//    propagates hel from the last site to the first one, creating a
+//    point at every layer crossing, the same way as
+//    TKalDetCradle::Transport() moves a state between two sites.
+//
+Int_t TKalBrokenLines::MakeReference(TVTrack &hel, Double_t t0)
+{
+   static const Double_t kMergin = 1.0;
+   static const Double_t kEps    = 1.e-8;
+
+   fPoints.clear();
+   fMeas  .clear();
+
+   TKalTrackSite &last = *fSites.back();
+   TKalDetCradle &det  = const_cast<TKalDetCradle &>
+                            (static_cast<const TKalDetCradle &>
+                               (last.GetHit().GetMeasLayer().GetParent()));
+   if (!det.IsClosed()) {
+      cerr << ">>>> Error!! TKalBrokenLines::MakeReference >>>>" << endl
+           << " Detector cradle not closed." << endl;
+      return 0;
+   }
+
+   TKalMatrix DF(5,5);
+   TKalMatrix sv(5,1);
+   TVector3   xx;
+   Double_t   fid = 0.;
+
+   Point pt;
+   pt.fPrec[0] = pt.fPrec[1] = pt.fPrec[2] = 0.;
+   pt.fPair    = 0;
+
+   // First point: crossing with the layer of the last site
+
+   const TVMeasLayer &ml0 = last.GetHit().GetMeasLayer();
+   if (!dynamic_cast<const TVSurface &>(ml0).CalcXingPointWith(hel, xx, fid, 0, kEps)) {
+      cerr << ">>>> Error!! TKalBrokenLines::MakeReference >>>>" << endl
+           << " No crossing with the last layer." << endl;
+      return 0;
+   }
+   hel.MoveTo(xx, fid, &DF);
+   hel.PutInto(sv);
+   pt.fLayerPtr = &ml0;
+   pt.fSv.ResizeTo(5,1); pt.fSv = sv;
+   pt.fX0       = hel.GetPivot();
+   pt.fF.ResizeTo(5,5);  pt.fF.UnitMatrix();
+   fPoints.push_back(pt);
+   if (!AddSite(last, hel, t0)) return 0;
+
+   // Walk back to the first site
+
+   for (Int_t is=fSites.size()-2; is>=0; is--) {
+      TKalTrackSite     &site  = *fSites[is];
+      const TVMeasLayer &mlto  = site.GetHit().GetMeasLayer();
+      Int_t              fridx = fPoints.back().fLayerPtr->GetIndex();
+      Int_t              toidx = mlto.GetIndex();
+
+      if (toidx != fridx) {
+         TVector3 xfrom = fPoints.back().fX0;
+         TVector3 xto;
+         Double_t fito  = 0.;
+         const TVSurface &sto = dynamic_cast<const TVSurface &>(mlto);
+         sto.CalcXingPointWith(hel, xto, fito, 0, kEps);
+
+         TMatrixD dxdphi = hel.CalcDxDphi(fito);
+         TVector3 dxdphiv(dxdphi(0,0),dxdphi(1,0),dxdphi(2,0));
+         Bool_t   isout = -fito*dxdphiv.Dot(sto.GetOutwardNormal(xto)) < 0 ? kTRUE : kFALSE;
+         Int_t    di    = fridx > toidx ? -1 : 1;
+
+         // TVSurface::CalcXingPointWith(), used for planes, ignores the
+         // mode and may return a crossing on the arm of the helix behind.
+         // Walking outwards this can be nearer than xto, so crossings
+         // have to turn the same way as the one with layer to.
+
+         fid = 0.;
+         for (Int_t ito=fridx+di; (di>0 && ito<=toidx)||(di<0 && ito>=toidx); ito += di) {
+            Double_t fid_temp = fid;
+            if (!static_cast<TVSurface *>(det.At(ito))->CalcXingPointWith(hel, xx, fid, di, kEps)
+             || fid * fito < 0.
+             || (xx-xfrom).Mag() - kMergin > (xto-xfrom).Mag()) {
+               fid = fid_temp;
+               continue;
+            }
+
+            hel.MoveTo(xx, fid, &DF);
+
+            // Energy loss and scatterer at the new point, with the
+            // material between it and the point we came from. This is
+            // where Transport() puts them when the filter runs towards
+            // the last site.
+
+            const TVMeasLayer &ml = *dynamic_cast<TVMeasLayer *>(det.At(ito));
+            if (det.IsDEDXOn()) {
+               hel.PutInto(sv);
+               sv(2,0) += ml.GetEnergyLoss(!isout, hel, fid);
+               hel.SetTo(sv, hel.GetPivot());
+            }
+            hel.PutInto(sv);
+
+            pt.fLayerPtr = &ml;
+            pt.fSv       = sv;
+            pt.fX0       = hel.GetPivot();
+            pt.fF        = DF;
+            if (det.IsMSOn()) {
+               TKalMatrix Qms(5,5);
+               ml.CalcQms(!isout, hel, fid, Qms);
+               Double_t q11 = Qms(1,1), q14 = Qms(1,4), q44 = Qms(4,4);
+               Double_t qdet = q11 * q44 - q14 * q14;
+               if (qdet > 0.) {
+                  pt.fPrec[0] =  q44 / qdet;
+                  pt.fPrec[1] = -q14 / qdet;
+                  pt.fPrec[2] =  q11 / qdet;
+               }
+            }
+            fPoints.push_back(pt);
+            pt.fPrec[0] = pt.fPrec[1] = pt.fPrec[2] = 0.;
+            fid = 0.;
+         }
+
+         if (fPoints.back().fLayerPtr->GetIndex() != toidx) {
+            cerr << ">>>> Error!! TKalBrokenLines::MakeReference >>>>" << endl
+                 << " Layer " << toidx << " not reached from " << fridx << endl;
+            return 0;
+         }
+      }
+      if (!AddSite(site, hel, t0)) return 0;
+   }
+
+   // Back to site order. Copy rather than swap elements, since
+   // matrices of different shapes cannot be assigned to each other.
+
+   vector<Meas> meas(fMeas.rbegin(), fMeas.rend());
+   fMeas.swap(meas);
+   return 1;
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  AddSite
+// ------------------------------
+//    attaches site to the current (last) point. hel is at its pivot.
+//
+Int_t TKalBrokenLines::AddSite(TKalTrackSite &site, TVTrack &hel, Double_t t0)
+{
+   Point &pt = fPoints.back();
+
+   // Reference state with the pivot of the point: the state takes its
+   // pivot from the site, so lend the site the point's pivot.
+
+   TKalMatrix sv(fSdim,1);
+   for (Int_t i=0; i<5; i++) sv(i,0) = pt.fSv(i,0);
+   if (fSdim == 6) sv(5,0) = t0;
+
+   TVector3 x0s = site.GetPivot();
+   site.SetPivot(pt.fX0);
+   TKalTrackState a(sv, site, TVKalSite::kPredicted, fSdim);
+   site.SetPivot(x0s);
+
+   Int_t      mdim = site.GetDimension();
+   TKalMatrix h(mdim,1);
+   TKalMatrix H(mdim,fSdim);
+   if (!site.CalcExpectedMeasVec(a, h) || !site.CalcMeasVecDerivative(a, H)) {
+      cerr << ">>>> Error!! TKalBrokenLines::AddSite >>>>>>>>>>" << endl
+           << " No crossing with the layer of a site." << endl;
+      return 0;
+   }
+
+   Meas m;
+   m.fSitePtr = &site;
+   m.fPoint   = fPoints.size() - 1;
+   m.fRes.ResizeTo(mdim,1);
+   m.fRes     = site.GetMeasVec() - h;
+   m.fH.ResizeTo(mdim,fSdim);
+   m.fH       = H;
+
+   // (@h/@d) for a translation d of the layer: the track crosses the
+   // moved layer at xx - (1 - t*n^t/(n*t)) d, with t the tangent and
+   // n the normal at the crossing point xx (= the pivot).
+
+   const TVMeasLayer &ml = site.GetHit().GetMeasLayer();
+   const TVSurface   &ms = dynamic_cast<const TVSurface &>(ml);
+   TKalMatrix dsdx(ms.CalcDSDx(pt.fX0));
+   TMatrixD   dxdphi = hel.CalcDxDphi(0.);
+   Double_t   nt = 0.;
+   for (Int_t k=0; k<3; k++) nt += dsdx(0,k) * dxdphi(k,0);
+
+   TKalMatrix dxdd(3,5);
+   for (Int_t k=0; k<3; k++) dxdd(k,k) = 1.;
+   TKalMatrix dhdx(mdim,5);
+   ml.CalcDhDa(site.GetHit(), pt.fX0, dxdd, dhdx);
+
+   m.fDgl.ResizeTo(mdim,3);
+   for (Int_t i=0; i<mdim; i++) {
+      for (Int_t j=0; j<3; j++) {
+         Double_t sum = 0.;
+         for (Int_t k=0; k<3; k++) {
+            Double_t pkj = (k == j ? 1. : 0.) - dxdphi(k,0) * dsdx(0,j) / nt;
+            sum -= dhdx(i,k) * pkj;
+         }
+         m.fDgl(i,j) = sum;
+      }
+   }
+
+   fMeas.push_back(m);
+   return 1;
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  GetLocalIndex
+// ------------------------------
+//    indices of the local parameters used by points of pair r:
+//    u_r, u_r+1, [omega], [t0]. Returns their number.
+//
+Int_t TKalBrokenLines::GetLocalIndex(Int_t r, Int_t *idx) const
+{
+   Int_t nband = 2 * fOffsets.size();
+   Int_t n     = 0;
+   for (Int_t i=0; i<4; i++) idx[n++] = 2 * r + i;
+   if (fIsInB)      idx[n++] = nband;
+   if (fSdim == 6)  idx[n++] = nband + (fIsInB ? 1 : 0);
+   return n;
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  CalcKink
+// ------------------------------
+//    kink at offset point s as a function of u_s-1, u_s, u_s+1 and
+//    [omega], whose indices are returned in idx.
+//
+void TKalBrokenLines::CalcKink(Int_t s, TKalMatrix &K, Int_t *idx) const
+{
+   Int_t nk = 6 + (fIsInB ? 1 : 0);
+   K.ResizeTo(2, nk);
+   K.Zero();
+   for (Int_t i=0; i<6; i++) idx[i] = 2 * (s - 1) + i;
+   if (fIsInB) idx[6] = 2 * fOffsets.size();
+
+   for (Int_t i=0; i<2; i++) {
+      for (Int_t c=0; c<4; c++) {
+         K(i,c+2) += fWout[s](i,c);
+         K(i,c  ) -= fWin [s](i,c);
+      }
+      if (fIsInB) K(i,6) = fWout[s](i,4) - fWin[s](i,4);
+   }
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  Solve
+// ------------------------------
+//
+Int_t TKalBrokenLines::Solve()
+{
+   Int_t np = fPoints.size();
+   if (np < 2) {
+      cerr << ">>>> Error!! TKalBrokenLines::Solve >>>>>>>>>>>>" << endl
+           << " Less than 2 points." << endl;
+      return 0;
+   }
+
+   fOffsets.clear();
+   fOffsets.push_back(0);
+   for (Int_t k=1; k<np-1; k++) if (fPoints[k].fPrec[0] > 0.) fOffsets.push_back(k);
+   fOffsets.push_back(np-1);
+
+   Int_t noff  = fOffsets.size();
+   Int_t nband = 2 * noff;
+   fNlocal = nband + fNb;
+
+   // --------------------------------------------------------------
+   //  Local parameters at each point, pair by pair
+   // --------------------------------------------------------------
+
+   fWin .assign(noff, TKalMatrix(2,5));
+   fWout.assign(noff, TKalMatrix(2,5));
+
+   Int_t      idx[8];
+   Int_t      nloc = GetLocalIndex(0, idx);
+   TKalMatrix dadq(5,5);
+   TKalMatrix fc  (5,5);
+
+   for (Int_t r=0; r<noff-1; r++) {
+      Int_t ka = fOffsets[r];
+      Int_t kb = fOffsets[r+1];
+
+      CalcDaDq(fPoints[ka].fSv, fIsInB, dadq);
+      fc.UnitMatrix();
+      for (Int_t k=ka+1; k<=kb; k++) fc = fPoints[k].fF * fc;
+      TKalMatrix fq = fc * dadq;   // (@u_b/@q_a) in rows 0, 3
+
+      // w_a = W * (u_b - Fuu * u_a - Fuo * omega), W = Fuw^-1
+
+      Double_t fuw00 = fq(kU[0],kW[0]), fuw01 = fq(kU[0],kW[1]);
+      Double_t fuw10 = fq(kU[1],kW[0]), fuw11 = fq(kU[1],kW[1]);
+      Double_t det   = fuw00 * fuw11 - fuw01 * fuw10;
+      if (det == 0.) {
+         cerr << ">>>> Error!! TKalBrokenLines::Solve >>>>>>>>>>>>" << endl
+              << " Singular propagator between points " << ka << " and " << kb << endl;
+         return 0;
+      }
+      Double_t W[2][2] = { {  fuw11 / det, -fuw01 / det },
+                           { -fuw10 / det,  fuw00 / det } };
+
+      // q_a as a function of (u_a, u_b, omega)
+
+      TKalMatrix q(5,5);
+      q(kU[0],0) = 1.;
+      q(kU[1],1) = 1.;
+      q(kC   ,4) = 1.;
+      for (Int_t i=0; i<2; i++) {
+         for (Int_t c=0; c<2; c++) {
+            q(kW[i],2+c) = W[i][c];
+            for (Int_t j=0; j<2; j++) q(kW[i],c) -= W[i][j] * fq(kU[j],kU[c]);
+         }
+         for (Int_t j=0; j<2; j++) q(kW[i],4) -= W[i][j] * fq(kU[j],kC);
+      }
+      TKalMatrix e = dadq * q;
+      for (Int_t i=0; i<2; i++) {
+         for (Int_t c=0; c<5; c++) fWout[r](i,c) = q(kW[i],c);
+      }
+
+      // Points ka .. kb-1 (and kb for the last pair)
+
+      fc.UnitMatrix();
+      for (Int_t k=ka; k<=kb; k++) {
+         if (k > ka) fc = fPoints[k].fF * fc;
+         TKalMatrix g = fc * e;
+         if (k == kb) {
+            for (Int_t i=0; i<2; i++) {
+               for (Int_t c=0; c<5; c++) fWin[r+1](i,c) = g(kW[i],c);
+            }
+            if (r < noff - 2) break;
+         }
+         Point &pt = fPoints[k];
+         pt.fPair = r;
+         pt.fG.ResizeTo(fSdim, nloc);
+         pt.fG.Zero();
+         for (Int_t i=0; i<5; i++) {
+            for (Int_t c=0; c<4; c++) pt.fG(i,c) = g(i,c);
+            if (fIsInB) pt.fG(i,4) = g(i,4);
+         }
+         if (fSdim == 6) pt.fG(5,nloc-1) = 1.;
+      }
+   }
+
+   // --------------------------------------------------------------
+   //  Normal equations
+   // --------------------------------------------------------------
+
+   fMatrix.ResizeTo(nband, 5, fNb);
+   fX.assign(fNlocal, 0.);
+   vector<Double_t> blk(64);
+
+   Int_t nmeas = 0;
+   for (UInt_t im=0; im<fMeas.size(); im++) {
+      const Meas  &m  = fMeas[im];
+      const Point &pt = fPoints[m.fPoint];
+      GetLocalIndex(pt.fPair, idx);
+      Int_t      mdim = m.fRes.GetNrows();
+      TKalMatrix D    = m.fH * pt.fG;
+      TKalMatrix Vinv(TKalMatrix::kInverted, m.fSitePtr->GetMeasNoiseMat());
+      TKalMatrix Dt(TKalMatrix::kTransposed, D);
+      TKalMatrix DtVinv = Dt * Vinv;
+      TKalMatrix A      = DtVinv * D;
+      TKalMatrix b      = DtVinv * m.fRes;
+      for (Int_t i=0; i<nloc; i++) {
+         for (Int_t j=0; j<nloc; j++) blk[i*nloc+j] = A(i,j);
+         fX[idx[i]] += b(i,0);
+      }
+      fMatrix.AddBlock(nloc, idx, &blk[0]);
+      nmeas += mdim;
+   }
+
+   TKalMatrix K;
+   Int_t      kidx[8];
+   for (Int_t s=1; s<noff-1; s++) {
+      CalcKink(s, K, kidx);
+      const Double_t *p = fPoints[fOffsets[s]].fPrec;
+      Int_t nk = K.GetNcols();
+      for (Int_t i=0; i<nk; i++) {
+         for (Int_t j=0; j<nk; j++) {
+            blk[i*nk+j] = K(0,i) * (p[0] * K(0,j) + p[1] * K(1,j))
+                        + K(1,i) * (p[1] * K(0,j) + p[2] * K(1,j));
+         }
+      }
+      fMatrix.AddBlock(nk, kidx, &blk[0]);
+   }
+
+   fNDF = nmeas + 2 * (noff - 2) - fNlocal;
+   if (fNDF < 0) {
+      cerr << ">>>> Error!! TKalBrokenLines::Solve >>>>>>>>>>>>" << endl
+           << " Too few measurements: ndf = " << fNDF << endl;
+      return 0;
+   }
+
+   if (!fMatrix.Decompose()) return 0;
+   fMatrix.Solve(&fX[0], &fX[0]);
+   fMatrix.Invert();
+
+   // --------------------------------------------------------------
+   //  Chi2
+   // --------------------------------------------------------------
+
+   fChi2 = 0.;
+   for (UInt_t im=0; im<fMeas.size(); im++) {
+      TKalMatrix res;
+      GetResidual(im, res);
+      TKalMatrix Vinv(TKalMatrix::kInverted, fMeas[im].fSitePtr->GetMeasNoiseMat());
+      TKalMatrix rest(TKalMatrix::kTransposed, res);
+      fChi2 += (rest * Vinv * res)(0,0);
+   }
+   for (Int_t s=1; s<noff-1; s++) {
+      CalcKink(s, K, kidx);
+      const Double_t *p = fPoints[fOffsets[s]].fPrec;
+      Double_t b0 = 0., b1 = 0.;
+      for (Int_t c=0; c<K.GetNcols(); c++) {
+         b0 += K(0,c) * fX[kidx[c]];
+         b1 += K(1,c) * fX[kidx[c]];
+      }
+      fChi2 += p[0] * b0 * b0 + 2. * p[1] * b0 * b1 + p[2] * b1 * b1;
+   }
+   return 1;
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  Getters
+// ------------------------------
+//
+TKalTrackSite & TKalBrokenLines::GetSite(Int_t i) const
+{
+   return *fMeas[i].fSitePtr;
+}
+
+const TVector3 & TKalBrokenLines::GetPivot(Int_t i) const
+{
+   return fPoints[fMeas[i].fPoint].fX0;
+}
+
+Int_t TKalBrokenLines::GetState(Int_t i, TKalMatrix &sv, TKalMatrix &C) const
+{
+   if (i < 0 || i >= (Int_t)fMeas.size()) return 0;
+   const Point &pt = fPoints[fMeas[i].fPoint];
+
+   Int_t idx[8];
+   Int_t nloc = GetLocalIndex(pt.fPair, idx);
+
+   TKalMatrix cl(nloc,nloc);
+   for (Int_t c=0; c<nloc; c++) {
+      for (Int_t d=0; d<nloc; d++) cl(c,d) = fMatrix.GetInverse(idx[c], idx[d]);
+   }
+   TKalMatrix gt(TKalMatrix::kTransposed, pt.fG);
+   C.ResizeTo(fSdim,fSdim);
+   C = pt.fG * cl * gt;
+
+   sv.ResizeTo(fSdim,1);
+   for (Int_t k=0; k<fSdim; k++) {
+      sv(k,0) = k < 5 ? pt.fSv(k,0) : fT0;
+      for (Int_t c=0; c<nloc; c++) sv(k,0) += pt.fG(k,c) * fX[idx[c]];
+   }
+   return 1;
+}
+
+Int_t TKalBrokenLines::GetResidual(Int_t i, TKalMatrix &res) const
+{
+   if (i < 0 || i >= (Int_t)fMeas.size()) return 0;
+   TKalMatrix dlc;
+   Int_t      idx[8];
+   Int_t      nloc = GetLocalDerivatives(i, dlc, idx);
+   Int_t      mdim = dlc.GetNrows();
+   res.ResizeTo(mdim,1);
+   for (Int_t j=0; j<mdim; j++) {
+      res(j,0) = fMeas[i].fRes(j,0);
+      for (Int_t c=0; c<nloc; c++) res(j,0) -= dlc(j,c) * fX[idx[c]];
+   }
+   return 1;
+}
+
+Int_t TKalBrokenLines::GetLocalDerivatives(Int_t i, TKalMatrix &dlc, Int_t *lcidx) const
+{
+   const Meas  &m  = fMeas[i];
+   const Point &pt = fPoints[m.fPoint];
+   Int_t nloc = GetLocalIndex(pt.fPair, lcidx);
+   dlc.ResizeTo(m.fH.GetNrows(), nloc);
+   dlc = m.fH * pt.fG;
+   return nloc;
+}
+
+void TKalBrokenLines::GetGlobalDerivatives(Int_t i, TKalMatrix &dgl, Int_t *label) const
+{
+   const Meas &m = fMeas[i];
+   dgl.ResizeTo(m.fDgl.GetNrows(), 3);
+   dgl = m.fDgl;
+   Int_t index = m.fSitePtr->GetHit().GetMeasLayer().GetIndex();
+   for (Int_t k=0; k<3; k++) label[k] = 3 * index + k + 1;
+}
+
+//_________________________________________________________________________
+// ------------------------------
+//  MilleOut
+// ------------------------------
+//    writes one record in the binary format read by Millepede-II:
+//    nwords, then nwords/2 floats and nwords/2 ints. Each equation is
+//    (residual, 0) (dlc, local index) ... (sigma, 0) (dgl, label) ...
+//    Measurement errors are taken from the diagonal of the noise
+//    matrices, as the hits of this library are uncorrelated.
+//
+Int_t TKalBrokenLines::MilleOut(ostream &os) const
+{
+   vector<Float_t> fbuf(1, 0.);
+   vector<Int_t>   ibuf(1, 0);
+
+   TKalMatrix dlc;
+   TKalMatrix dgl;
+   Int_t      idx[8];
+   Int_t      label[3];
+   for (UInt_t im=0; im<fMeas.size(); im++) {
+      Int_t nloc = GetLocalDerivatives(im, dlc, idx);
+      GetGlobalDerivatives(im, dgl, label);
+      const TKalMatrix &V = fMeas[im].fSitePtr->GetMeasNoiseMat();
+      for (Int_t j=0; j<dlc.GetNrows(); j++) {
+         if (V(j,j) <= 0.) continue;
+         fbuf.push_back(fMeas[im].fRes(j,0)); ibuf.push_back(0);
+         for (Int_t c=0; c<nloc; c++) {
+            if (dlc(j,c) == 0.) continue;
+            fbuf.push_back(dlc(j,c)); ibuf.push_back(idx[c] + 1);
+         }
+         fbuf.push_back(TMath::Sqrt(V(j,j))); ibuf.push_back(0);
+         for (Int_t k=0; k<3; k++) {
+            if (dgl(j,k) == 0.) continue;
+            fbuf.push_back(dgl(j,k)); ibuf.push_back(label[k]);
+         }
+      }
+   }
+
+   TKalMatrix K;
+   Int_t      noff = fOffsets.size();
+   for (Int_t s=1; s<noff-1; s++) {
+      CalcKink(s, K, idx);
+      const Double_t *p = fPoints[fOffsets[s]].fPrec;
+      Double_t pdet = p[0] * p[2] - p[1] * p[1];
+      Double_t sg[2] = { TMath::Sqrt(p[2] / pdet), TMath::Sqrt(p[0] / pdet) };
+      for (Int_t j=0; j<2; j++) {
+         fbuf.push_back(0.); ibuf.push_back(0);
+         for (Int_t c=0; c<K.GetNcols(); c++) {
+            if (K(j,c) == 0.) continue;
+            fbuf.push_back(K(j,c)); ibuf.push_back(idx[c] + 1);
+         }
+         fbuf.push_back(sg[j]); ibuf.push_back(0);
+      }
+   }
+
+   if (fbuf.size() < 2) return 0;
+   Int_t nwords = 2 * fbuf.size();
+   os.write(reinterpret_cast<const char *>(&nwords), sizeof(Int_t));
+   os.write(reinterpret_cast<const char *>(&fbuf[0]), fbuf.size() * sizeof(Float_t));
+   os.write(reinterpret_cast<const char *>(&ibuf[0]), ibuf.size() * sizeof(Int_t));
+   return 1;
+}
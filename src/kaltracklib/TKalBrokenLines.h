@@ -0,0 +1,139 @@
+#ifndef TKALBROKENLINES_H
+#define TKALBROKENLINES_H
+//*************************************************************************
+//* =======================
+//*  TKalBrokenLines Class
+//* =======================
+//*
+//* (Description)
+//*   Global track refit with explicit multiple scattering kinks
+//*   (general broken lines). A reference trajectory is propagated from
+//*   the current state of the last site through every layer of the
+//*   detector cradle down to the first site. The fit parameters are
+//*   the (drho, dz) offsets at the ends and at every layer with
+//*   material in between, plus the curvature (kappa*cos(lambda)) and
+//*   t0 (sdim = 6) as common parameters. Scattering kinks between
+//*   neighbouring offsets are weighted with TVMeasLayer::CalcQms(),
+//*   measurements with the H matrices of their TKalTrackSite's.
+//*   The normal equations form a bordered band matrix, solved in
+//*   O(n) by TKalBandMatrix.
+//*   Besides the fitted states, the class provides per-site
+//*   derivatives w.r.t. the local fit parameters and a translation
+//*   of the measurement layer, in the layout of a Millepede record.
+//* (Requires)
+//*     TKalTrack, TKalTrackSite, TKalDetCradle, TVMeasLayer,
+//*     TKalBandMatrix
+//* (Provides)
+//*     class TKalBrokenLines
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TObject.h"          // from ROOT
+#include "TVector3.h"         // from ROOT
+#include "TKalMatrix.h"       // from KalLib
+#include "TKalBandMatrix.h"   // from KalLib
+#include <iostream>           // from STL
+#include <vector>             // from STL
+
+class TKalTrack;
+class TKalTrackSite;
+class TVMeasLayer;
+class TVTrack;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for broken lines refit
+//  ---------------------------------
+//
+class TKalBrokenLines : public TObject {
+public:
+   TKalBrokenLines();
+   virtual ~TKalBrokenLines() {}
+
+   // Fit all unlocked sites of kt. Sites are taken in the order of kt;
+   // consecutive sites on the same layer share one point. The cradle
+   // must be closed and the field uniform. Returns 1 on success.
+
+   Int_t    Fit(TKalTrack &kt);
+
+   inline Double_t   GetChi2   () const { return fChi2;          }
+   inline Int_t      GetNDF    () const { return fNDF;           }
+   inline Int_t      GetNsites () const { return fMeas.size();   }
+   inline Int_t      GetNpoints() const { return fPoints.size(); }
+   inline Int_t      GetNlocal () const { return fNlocal;        }
+
+   // Results per site i (0 = first site of kt). The fitted state
+   // has its pivot at the reference crossing with the site's layer.
+
+   TKalTrackSite  & GetSite    (Int_t i) const;
+   const TVector3 & GetPivot   (Int_t i) const;
+   Int_t            GetState   (Int_t i, TKalMatrix &sv, TKalMatrix &C) const;
+   Int_t            GetResidual(Int_t i, TKalMatrix &res) const;
+
+   // Derivatives of the predicted measurement of site i w.r.t. the
+   // local fit parameters (dlc, mdim x n, indices into the GetNlocal()
+   // parameters in lcidx, n returned) and w.r.t. a translation
+   // (x, y, z) of the measurement layer (dgl, mdim x 3, with labels
+   // 3*index+1, 3*index+2, 3*index+3 of the layer in the cradle).
+
+   Int_t    GetLocalDerivatives (Int_t i, TKalMatrix &dlc, Int_t *lcidx) const;
+   void     GetGlobalDerivatives(Int_t i, TKalMatrix &dgl, Int_t *label) const;
+
+   // Write the track as one binary Millepede record (measurements,
+   // then scattering kinks as pseudo-measurements). Returns 1 if
+   // something was written.
+
+   Int_t    MilleOut(std::ostream &os) const;
+
+   inline void SetMaxIter(Int_t n) { fMaxIter = n > 0 ? n : 1; }
+
+private:
+   struct Point {
+      const TVMeasLayer *fLayerPtr;  // layer crossed
+      TKalMatrix         fSv;        // reference parameters at fX0
+      TVector3           fX0;        // pivot: crossing with the layer
+      TKalMatrix         fF;         // propagator matrix from previous point
+      Double_t           fPrec[3];   // kink precision: (1,1), (1,4), (4,4)
+      Int_t              fPair;      // offsets (fPair, fPair+1) describe it
+      TKalMatrix         fG;         // d(parameters)/d(local), sdim x 4+nb
+   };
+
+   struct Meas {
+      TKalTrackSite     *fSitePtr;   // site
+      Int_t              fPoint;     // point the site is attached to
+      TKalMatrix         fRes;       // m - h at the reference
+      TKalMatrix         fH;         // (@h/@a) at the reference
+      TKalMatrix         fDgl;       // (@h/@(layer translation))
+   };
+
+   Int_t  MakeReference(TVTrack &hel, Double_t t0);
+   Int_t  AddSite      (TKalTrackSite &site, TVTrack &hel, Double_t t0);
+   Int_t  Solve        ();
+   Int_t  GetLocalIndex(Int_t pair, Int_t *idx) const;
+   void   CalcKink     (Int_t s, TKalMatrix &K, Int_t *idx) const;
+
+private:
+   Int_t                  fMaxIter;  // number of reference iterations
+   Int_t                  fSdim;     // state vector dimension
+   Bool_t                 fIsInB;    // false for straight tracks
+   Int_t                  fNb;       // number of common parameters
+   Int_t                  fNlocal;   // number of local fit parameters
+   Double_t               fChi2;     // chi2 of the fit
+   Int_t                  fNDF;      // degrees of freedom
+   Double_t               fT0;       // reference t0 (sdim = 6)
+
+   std::vector<TKalTrackSite *> fSites;   //! unlocked sites of the track
+   std::vector<Point>           fPoints;  //! points along the reference
+   std::vector<Meas>            fMeas;    //! measurements, in site order
+   std::vector<Int_t>           fOffsets; //! points carrying offsets
+   std::vector<TKalMatrix>      fWin;     //! incoming slopes at offsets
+   std::vector<TKalMatrix>      fWout;    //! outgoing slopes at offsets
+   TKalBandMatrix               fMatrix;  //! normal equations
+   std::vector<Double_t>        fX;       //! solution
+
+   ClassDef(TKalBrokenLines,1)  // broken lines refit
+};
+
+#endif
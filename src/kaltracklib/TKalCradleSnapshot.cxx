@@ -0,0 +1,265 @@
+//*************************************************************************
+//* ==========================
+//*  TKalCradleSnapshot Class
+//* ==========================
+//*
+//* (Description)
+//*   Binary snapshot of the closed state of a TKalDetCradle.
+//* (Requires)
+//*     TKalDetCradle, TVMeasLayer, TVSurface, TMaterial
+//* (Provides)
+//*     class TKalCradleSnapshot
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  A missing snapshot is no error in Restore().
+//*
+//*************************************************************************
+
+#include "TKalCradleSnapshot.h" // from KalTrackLib
+#include "TKalDetCradle.h"      // from KalTrackLib
+#include "TVMeasLayer.h"        // from KalTrackLib
+#include "TVSurface.h"          // from GeomLib
+#include "TMaterial.h"          // from ROOT
+#include "TVector3.h"           // from ROOT
+
+#include <cerrno>               // from STL
+#include <cstddef>              // from STL
+#include <cstring>              // from STL
+#include <fstream>              // from STL
+#include <iostream>             // from STL
+#include <map>                  // from STL
+#include <vector>               // from STL
+#include <fcntl.h>              // from POSIX
+#include <sys/mman.h>           // from POSIX
+#include <sys/stat.h>           // from POSIX
+#include <unistd.h>             // from POSIX
+
+using namespace std;
+
+namespace {
+   // Probe points [cm] spread over the size of a tracking detector
+
+   const Double_t kProbe[TKalCradleSnapshot::kNprobes][3] = {
+      {    3.,    1.,    2. }, {  -10.,    7.,  -25. },
+      {   40.,  -35.,   60. }, {  -90.,  120., -150. },
+      {  200.,   -5.,  230. }, {   -1., -160.,  -20. },
+      {   15.,  300.,    0.5}, { -250., -250.,  250. } };
+
+   // Hashed part of a layer record: everything after fIndex
+
+   const Int_t kHashOffset = offsetof(TKalCradleSnapshot::Layer, fIsActive);
+   const Int_t kHashLength = sizeof(TKalCradleSnapshot::Layer) - kHashOffset;
+
+   ULong64_t CombineHashes(const vector<TKalCradleSnapshot::Layer> &recs)
+   {
+      // sum of the layer hashes does not depend on the order
+
+      ULong64_t sum = 0;
+      for (UInt_t i=0; i<recs.size(); i++) sum += recs[i].fHash;
+      Int_t n = recs.size();
+      ULong64_t h = TKalCradleSnapshot::Hash(reinterpret_cast<const Char_t *>(&n),
+                                             sizeof(Int_t));
+      return TKalCradleSnapshot::Hash(reinterpret_cast<const Char_t *>(&sum),
+                                      sizeof(ULong64_t), h);
+   }
+
+   void FillLayers(const TKalDetCradle &det, vector<TKalCradleSnapshot::Layer> &recs)
+   {
+      recs.resize(det.GetEntriesFast());
+      for (UInt_t i=0; i<recs.size(); i++) {
+         TKalCradleSnapshot::FillLayer(*det.At(i), recs[i]);
+      }
+   }
+}
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for cradle snapshots
+//  ---------------------------------
+//
+ClassImp(TKalCradleSnapshot)
+
+//-------------------------------------------------------
+// Save
+//-------------------------------------------------------
+
+Bool_t TKalCradleSnapshot::Save(const Char_t *name, const TKalDetCradle &det)
+{
+   if (!det.IsClosed()) {
+      cerr << ">>>> Error!! TKalCradleSnapshot::Save >>>>>>>>>>>>" << endl
+           << " Cradle not closed" << endl;
+      return kFALSE;
+   }
+
+   vector<Layer> recs;
+   FillLayers(det, recs);
+
+   Header h;
+   memset(&h, 0, sizeof(Header));
+   h.fMagic    = kMagic;
+   h.fVersion  = kVersion;
+   h.fRecSize  = sizeof(Layer);
+   h.fNlayers  = recs.size();
+   h.fGeomHash = CombineHashes(recs);
+   h.fNbytes   = sizeof(Header) + recs.size() * sizeof(Layer);
+
+   ULong64_t sum = Hash(reinterpret_cast<const Char_t *>(&h), sizeof(Header));
+   if (recs.size()) {
+      sum = Hash(reinterpret_cast<const Char_t *>(&recs[0]),
+                 recs.size() * sizeof(Layer), sum);
+   }
+   h.fChecksum = UInt_t(sum);
+
+   ofstream out(name, ios::binary);
+   out.write(reinterpret_cast<const Char_t *>(&h), sizeof(Header));
+   if (recs.size()) {
+      out.write(reinterpret_cast<const Char_t *>(&recs[0]), recs.size() * sizeof(Layer));
+   }
+   if (!out) {
+      cerr << ">>>> Error!! TKalCradleSnapshot::Save >>>>>>>>>>>>" << endl
+           << " Cannot write " << name << endl;
+      return kFALSE;
+   }
+   return kTRUE;
+}
+
+//-------------------------------------------------------
+// Restore
+//-------------------------------------------------------
+
+Bool_t TKalCradleSnapshot::Restore(const Char_t *name, TKalDetCradle &det)
+{
+   if (det.IsClosed()) {
+      cerr << ">>>> Error!! TKalCradleSnapshot::Restore >>>>>>>>>" << endl
+           << " Cradle already closed" << endl;
+      return kFALSE;
+   }
+
+   // no snapshot yet: the caller closes the cradle and saves one
+
+   Int_t fd = open(name, O_RDONLY);
+   if (fd < 0 && errno == ENOENT) return kFALSE;
+
+   struct stat st;
+   if (fd < 0 || fstat(fd, &st) < 0 || st.st_size < Long64_t(sizeof(Header))) {
+      cerr << ">>>> Error!! TKalCradleSnapshot::Restore >>>>>>>>>" << endl
+           << " Cannot open " << name << endl;
+      if (fd >= 0) close(fd);
+      return kFALSE;
+   }
+   void *p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (p == MAP_FAILED) {
+      cerr << ">>>> Error!! TKalCradleSnapshot::Restore >>>>>>>>>" << endl
+           << " Cannot map " << name << endl;
+      return kFALSE;
+   }
+
+   const Char_t *bp   = static_cast<const Char_t *>(p);
+   const Header &h    = *reinterpret_cast<const Header *>(bp);
+   const Layer  *recp = reinterpret_cast<const Layer *>(bp + sizeof(Header));
+
+   const Char_t *err = 0;
+   if (h.fMagic != kMagic || h.fVersion > kVersion || h.fRecSize != sizeof(Layer)
+    || h.fNbytes != st.st_size
+    || h.fNbytes != sizeof(Header) + h.fNlayers * sizeof(Layer)) {
+      err = "is not a valid snapshot";
+   } else {
+      Header hh = h;
+      hh.fChecksum = 0;
+      ULong64_t sum = Hash(reinterpret_cast<const Char_t *>(&hh), sizeof(Header));
+      sum = Hash(reinterpret_cast<const Char_t *>(recp), h.fNlayers * sizeof(Layer), sum);
+      if (UInt_t(sum) != h.fChecksum) err = "has a bad checksum";
+   }
+
+   // match the layers of det to the records by their hashes
+
+   Int_t nlayers = det.GetEntriesFast();
+   vector<TObject *> objs;
+   if (!err) {
+      vector<Layer> recs;
+      FillLayers(det, recs);
+      if (h.fNlayers != nlayers || CombineHashes(recs) != h.fGeomHash) {
+         err = "does not match the geometry";
+      } else {
+         multimap<ULong64_t, Int_t> pos;
+         for (Int_t i=0; i<nlayers; i++) pos.insert(make_pair(recs[i].fHash, i));
+         objs.resize(nlayers);
+         for (Int_t i=0; i<nlayers && !err; i++) {
+            multimap<ULong64_t, Int_t>::iterator it = pos.find(recp[i].fHash);
+            if (it == pos.end()) {
+               err = "does not match the geometry";
+            } else {
+               objs[i] = det.At(it->second);
+               pos.erase(it);
+            }
+         }
+      }
+   }
+   if (err) {
+      cerr << ">>>> Error!! TKalCradleSnapshot::Restore >>>>>>>>>" << endl
+           << " " << name << " " << err << endl;
+      munmap(p, st.st_size);
+      return kFALSE;
+   }
+
+   for (Int_t i=0; i<nlayers; i++) {
+      det.AddAt(objs[i], i);
+      dynamic_cast<TVMeasLayer *>(objs[i])->SetIndex(recp[i].fIndex);
+   }
+   det.Restore();
+
+   munmap(p, st.st_size);
+   return kTRUE;
+}
+
+//-------------------------------------------------------
+// Hashes
+//-------------------------------------------------------
+
+ULong64_t TKalCradleSnapshot::GetGeometryHash(const TKalDetCradle &det)
+{
+   vector<Layer> recs;
+   FillLayers(det, recs);
+   return CombineHashes(recs);
+}
+
+void TKalCradleSnapshot::FillLayer(const TObject &obj, Layer &rec)
+{
+   memset(&rec, 0, sizeof(Layer));   // padding enters the hash
+
+   const TVMeasLayer &ml = dynamic_cast<const TVMeasLayer &>(obj);
+   const TVSurface   *sp = dynamic_cast<const TVSurface *>(&obj);
+
+   rec.fIndex    = ml.GetIndex();
+   rec.fIsActive = ml.IsActive();
+   for (Int_t io=0; io<2; io++) {
+      const TMaterial &m = ml.GetMaterial(io);
+      rec.fMaterial[io][0] = m.GetA();
+      rec.fMaterial[io][1] = m.GetZ();
+      rec.fMaterial[io][2] = m.GetDensity();
+      rec.fMaterial[io][3] = m.GetRadLength();
+   }
+   if (sp) {
+      rec.fSortingPolicy = sp->GetSortingPolicy();
+      for (Int_t i=0; i<kNprobes; i++) {
+         rec.fProbe[i] = sp->CalcS(TVector3(kProbe[i][0], kProbe[i][1], kProbe[i][2]));
+      }
+   }
+   strncpy(rec.fClass, obj.ClassName(),      kNameLen - 1);
+   strncpy(rec.fName,  ml.GetName().Data(),  kNameLen - 1);
+   const TObject *dp = dynamic_cast<const TObject *>(&ml.GetParent(kFALSE));
+   if (dp && dp != &obj) strncpy(rec.fDetector, dp->ClassName(), kNameLen - 1);
+
+   rec.fHash = Hash(reinterpret_cast<const Char_t *>(&rec) + kHashOffset, kHashLength);
+}
+
+ULong64_t TKalCradleSnapshot::Hash(const Char_t *buf, Int_t n, ULong64_t h)
+{
+   // 64 bit FNV-1a; pass the result as h to continue over another buffer
+   for (Int_t i=0; i<n; i++) {
+      h ^= static_cast<UChar_t>(buf[i]);
+      h *= 1099511628211ull;
+   }
+   return h;
+}
@@ -0,0 +1,105 @@
+#ifndef TKALCRADLESNAPSHOT_H
+#define TKALCRADLESNAPSHOT_H
+//*************************************************************************
+//* ==========================
+//*  TKalCradleSnapshot Class
+//* ==========================
+//*
+//* (Description)
+//*   Binary snapshot of the closed state of a TKalDetCradle.
+//*   Save() dumps, for each layer in the sorted order, its index,
+//*   class, name, parent detector, active flag, sorting policy, inner
+//*   and outer materials and the values of its surface function at a
+//*   fixed set of probe points, together with a hash of all of these.
+//*
+//*     Header   (32 bytes)  magic, version, record size, number of
+//*                          layers, geometry hash, file size, checksum
+//*     Layer    (n times)   Layer record below
+//*
+//*   Restore() maps a snapshot into memory and closes a cradle, into
+//*   which the same detectors have been installed, in the stored order
+//*   and with the stored indices, without sorting. The layers of the
+//*   cradle are hashed the same way and must match the snapshot one by
+//*   one, so that a snapshot of an old geometry is refused.
+//*   Layers are C++ objects built by their detectors, so the snapshot
+//*   does not replace their construction: it replaces what Close()
+//*   computes from them.
+//* (Requires)
+//*     TKalDetCradle, TVMeasLayer, TVSurface, TMaterial
+//* (Provides)
+//*     class TKalCradleSnapshot
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  A missing snapshot is no error in Restore().
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+
+class TKalDetCradle;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for cradle snapshots
+//  ---------------------------------
+//
+class TKalCradleSnapshot : public TObject {
+public:
+   enum { kNprobes = 8,        // probe points of the surface function
+          kNameLen = 32 };     // length of the name fields
+
+   // File header, as laid out in the file
+
+   struct Header {
+      UInt_t    fMagic;        // kMagic
+      UShort_t  fVersion;      // kVersion
+      UShort_t  fRecSize;      // sizeof(Layer)
+      Int_t     fNlayers;      // number of layers
+      Int_t     fPad;          // unused
+      ULong64_t fGeomHash;     // GetGeometryHash() of the cradle
+      UInt_t    fNbytes;       // file size
+      UInt_t    fChecksum;     // FNV-1a of the file
+   };
+
+   // Layer record
+
+   struct Layer {
+      ULong64_t fHash;                 // hash of the fields below
+      Int_t     fIndex;                // layer index
+      Int_t     fIsActive;             // IsActive()
+      Double_t  fSortingPolicy;        // GetSortingPolicy()
+      Double_t  fMaterial[2][4];       // in/out: A, Z, density, X0
+      Double_t  fProbe[kNprobes];      // CalcS() at the probe points
+      Char_t    fClass   [kNameLen];   // layer class
+      Char_t    fName    [kNameLen];   // layer name
+      Char_t    fDetector[kNameLen];   // parent detector class
+   };
+
+   static const UInt_t   kMagic   = 0x504e534b;  // "KSNP"
+   static const UShort_t kVersion = 1;
+
+   TKalCradleSnapshot() {}
+   virtual ~TKalCradleSnapshot() {}
+
+   // Write the closed cradle det to file name
+
+   static Bool_t    Save   (const Char_t *name, const TKalDetCradle &det);
+
+   // Close det as stored in file name. Returns kFALSE, leaving det
+   // open, if the file is missing, invalid or does not match the
+   // geometry; only a missing file is not reported on cerr.
+
+   static Bool_t    Restore(const Char_t *name, TKalDetCradle &det);
+
+   // Hash of the layers of det, independent of their order
+
+   static ULong64_t GetGeometryHash(const TKalDetCradle &det);
+
+   static void      FillLayer(const TObject &obj, Layer &rec);
+   static ULong64_t Hash     (const Char_t *buf, Int_t n,
+                              ULong64_t     h = 14695981039346656037ull);
+
+   ClassDef(TKalCradleSnapshot,1)  // cradle snapshot
+};
+
+#endif
@@ -20,6 +20,30 @@
 //*                              for which pivot is at the expected hit.
 //*   2012/11/29  K.Fujii        Moved GetEnergyLoss and CalcQms from
 //*                              TKalDetCradle.
+//*   2026/10/18                 Added Restore().
+//*   2026/10/18                 TKalStats counters in Transport().
+//*   2026/10/18                 Transport() takes the crossings with
+//*                              runs of coaxial cylinders from
+//*                              TCylinderBank batches.
+//*   2026/10/18                 Navigation through the typed layer
+//*                              table built by MakeTable().
+//*   2026/10/18                 Transport() skips layers out of reach
+//*                              of the helix, see CanCross().
+//*   2026/10/18                 Crossing searches in Transport() and
+//*                              Transport2() start from a predicted
+//*                              turning angle, see PredictPhi().
+//*   2026/10/18                 Straight tracks: closed-form crossings,
+//*                              sparse propagator matrices, and no
+//*                              energy loss on the kappa slot.
+//*   2026/10/18                 Transport() follows loopers through
+//*                              their turning points to the crossing
+//*                              at the hit, see TransportLooper().
+//*   2026/10/18                 Transport() aims at the crossing at the
+//*                              hit also where no turning point is
+//*                              passed on the way.
+//*   2026/10/18                 Step() and Transport2() call the
+//*                              virtual GetEnergyLoss() and CalcQms()
+//*                              of the layer.
 //*
 //*************************************************************************
 
@@ -30,16 +54,37 @@
 #include "TKalTrackState.h"  // from KalTrackLib
 #include "TKalTrack.h"       // from KalTrackLib
 #include "TVSurface.h"       // from GeomLib
+#include "TCylinder.h"       // from GeomLib
+#include "TPlane.h"          // from GeomLib
+#include "TCutCone.h"        // from GeomLib
+#include "TCylinderBank.h"   // from GeomLib
 #include "TVTrack.h"         // from GeomLib
+#include "THelicalTrack.h"   // from GeomLib
 #include "TBField.h"         // from Bfield
+#include "TKalStats.h"       // from Utils
 #include "TRungeKuttaTrack.h"
 
+#include <algorithm>         // from STL
 #include <iostream>          // from STL
 
 ClassImp(TKalDetCradle)
 
 Bool_t   TKalDetCradle::fUseRKTrack= kFALSE;
 
+namespace {
+   // largest distance of hel, a helix in a uniform field, from the z axis
+
+   Double_t CalcRmax(const TVTrack &hel)
+   {
+      Double_t rho = hel.GetRho();
+      Double_t rdr = rho + hel.GetDrho();
+      const TVector3 &x0 = hel.GetPivot();
+      Double_t xc  = x0.X() + rdr*TMath::Cos(hel.GetPhi0());
+      Double_t yc  = x0.Y() + rdr*TMath::Sin(hel.GetPhi0());
+      return TMath::Sqrt(xc*xc + yc*yc) + TMath::Abs(rho);
+   }
+}
+
 //_________________________________________________________________________
 //  ----------------------------------
 //   Ctors and Dtor
@@ -49,6 +94,7 @@ TKalDetCradle::TKalDetCradle(Int_t n)
              : TObjArray(n), fIsMSON(kTRUE), fIsDEDXON(kTRUE),
                fDone(kFALSE), fIsClosed(kFALSE)
 {
+   fBanks.SetOwner();
 }
 
 TKalDetCradle::~TKalDetCradle()
@@ -109,7 +155,10 @@ void TKalDetCradle::Transport(const TKalTrackSite  &from,   // site from
 		this->Transport2(from, ml_to, x0, sv, F, Q, help);
 	} 
 	else {
-		this->Transport(from, ml_to, x0, sv, F, Q, help);
+		// the hit tells which crossing of a looper to go to
+		TVector3 xhit = to.GetGlobalPivot();
+		this->Transport(from, ml_to, x0, sv, F, Q, help,
+		                to.GetDimension() > 1 ? &xhit : 0);
 	}
 
     TVTrack &hel = *help;
@@ -121,23 +170,8 @@ void TKalDetCradle::Transport(const TKalTrackSite  &from,   // site from
     if (to.GetDimension() > 1) {
         
         double fid = 0.;
-        Int_t sdim = sv.GetNrows();              // number of track parameters
-	if(to.GetHit().GetBfield()!=0.) {
-        TKalMatrix DF(sdim, sdim);               // propagator matrix segment
-        
-        hel.MoveTo(to.GetGlobalPivot(), fid, &DF, 0, kFALSE);     // move pivot to actual hit (to)
-
-        F = DF * F;                              // update F accordingly
+        hel.PropagateTo(to.GetGlobalPivot(), fid, F, 0, kFALSE); // move pivot to actual hit (to) and update F accordingly
         hel.PutInto(sv);                         // save updated hel to sv
-   }
-   else {
-	   TKalMatrix DF(sdim, sdim);
-
-  	   TStraightTrack strtrk(sv, x0);
-  	   strtrk.MoveTo(to.GetPivot(), fid, &DF);     // move pivot to actual hit (to)
-  	   F = DF * F;                                 // update F accordingly
-  	   strtrk.PutInto(sv);                         // save updated hel to sv
-   }
     
   } else {
 	    TVector3 x0g = x0;
@@ -179,6 +213,8 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
 //    transports state (sv) from site (from) to layer (ml_to), taking into
 //    account multiple scattering and energy loss and updates state (sv),
 //    fills pivot in x0, propagator matrix (F), and process noise matrix (Q).
+//    Of the crossings of a helix with layer ml_to, it goes to that at
+//    the hit xhitPtr, if given, through the turning points on the way.
 //
 
 int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
@@ -187,8 +223,11 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
                                    TKalMatrix     &sv,    // state vector
                                    TKalMatrix     &F,     // propagator matrix
                                    TKalMatrix     &Q,     // process noise matrix
-                           std::unique_ptr<TVTrack> &help)  // pointer to update track object
+                           std::unique_ptr<TVTrack> &help,  // pointer to update track object
+                             const TVector3       *xhitPtr) // hit on layer to, if any
 {
+  KALSTATS_TIMER(kTransport);
+
   // ---------------------------------------------------------------------
   //  Sort measurement layers in this cradle if not
   // ---------------------------------------------------------------------
@@ -209,7 +248,8 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
     TVector3 xto;                                   // reference point at destination to be returned by CalcXingPointWith
     Double_t fito = 0;                              // deflection angle to destination to be returned by CalcXingPointWith
     
-    const TVSurface *sfp = dynamic_cast<const TVSurface *>(&ml_to);// surface at destination
+    const Layer     &lto = fLayers[toidx];
+    const TVSurface *sfp = lto.fSurfPtr;            // surface at destination
     
 	double eps = 1.e-8;
 
@@ -217,7 +257,43 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
 		eps = 1.e-5;
 	}
 
-    sfp->CalcXingPointWith(hel, xto, fito, 0, eps);
+    CalcXingPoint(lto, hel, xto, fito, 0, eps, PredictPhi(lto, hel, fito) > 0);
+
+    // a looper crosses the destination surface more than once: take the
+    // crossing at the hit, and if the helix turns back inwards on its
+    // way there, walk the layers through the turning points instead of
+    // in index order. A track passing by the z axis, whose next turning
+    // point is a minimum, keeps the walk in index order.
+    static const Double_t kHitDist = 1.;    // [cm] retarget beyond this
+
+    THelicalTrack *hlp = hel.IsInB() && TBField::IsUsingUniformBfield()
+                       ? dynamic_cast<THelicalTrack *>(&hel) : 0;
+    if (hlp) {
+        TVector3 xhx  = xto;
+        Double_t fih  = fito;
+        Bool_t   near = xhitPtr && (xto - *xhitPtr).Mag() > kHitDist
+                                && CalcXingPointNear(lto, *hlp, *xhitPtr, xhx, fih, eps);
+        Double_t phiturn = 0.;
+        Int_t    type    = 0;
+        if (fih != 0. && hlp->CalcTurningPoint(fih, phiturn, type)
+                      && type > 0 && TMath::Abs(phiturn) < TMath::Abs(fih)) {
+            if (near) KALSTATS_COUNT(kLooperRetargets);
+            Int_t sdim = sv.GetNrows();
+            F.UnitMatrix();
+            Q.Zero();
+            TKalMatrix Qms(sdim, sdim);
+            TransportLooper(*hlp, fridx, toidx, fih, eps, sv, F, Q, Qms);
+            x0 = hel.GetPivot();
+            hel.PutInto(sv);
+            return 0;
+        }
+        // no turning point on the way: the closest crossing may still be
+        // on the other branch of the looper, so aim at the one at the hit
+        if (near) {
+            xto  = xhx;
+            fito = fih;
+        }
+    }
 
     // as mode is 0 here the closest point crossing point is taken
     // this means that if we are at the top of a looping track
@@ -243,12 +319,25 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
     F.UnitMatrix();                            // set the propagator matrix to the unit matrix
     Q.Zero();                                  // zero the noise matrix
     
-    TKalMatrix DF(sdim, sdim);                 // propagator matrix segment
+    TKalMatrix Qms(sdim, sdim);                // process noise of a step
     
+    // crossings with the cylinders of a bank, computed in one go for all
+    // layers up to toidx and valid until dE/dx changes the helix circle
+    static thread_local TCylinderBank::Xings xings;
+    xings.Clear();
+
     // ---------------------------------------------------------------------
     //  Loop over layers and transport sv, F, and Q step by step
     // ---------------------------------------------------------------------
     Int_t ifr = fridx; // set index to the index of the intitial starting layer
+
+    // a helix turning back before layer ito reaches none from there on
+    static const Double_t kTol = 1.e-3;
+    Double_t rmax = hlp ? CalcRmax(hel) : 0.;
+
+    // crossings in the direction of flight to the destination, which
+    // for a helix on its way back inwards is not that of di
+    Int_t dir = hlp && fito != 0. ? (fito*hel.GetRho() < 0. ? +1 : -1) : di;
     
     // here we make first make sure that the helix is at the crossing point of the current surface.
     // this is necessary to ensure that the material is only accounted for between fridx and toidx
@@ -257,10 +346,36 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
     for (Int_t ito=fridx; (di>0 && ito<=toidx)||(di<0 && ito>=toidx); ito += di) {
         
         Double_t fid_temp = fid; // deflection angle from the last layer crossing
+
+        if (hlp && di > 0 && fLayers[ito].fRreach > rmax + kTol) break;
         
-        int mode = ito!=fridx ? di : 0; // need to move to the from site as the helix may not be on the crossing point yet, meaning that the eloss and ms will be incorrectely attributed ...
+        int mode = ito!=fridx ? dir : 0; // need to move to the from site as the helix may not be on the crossing point yet, meaning that the eloss and ms will be incorrectely attributed ...
         
-        if (static_cast<TVSurface *>(At(ito))->CalcXingPointWith(hel, xx, fid, mode, eps)) { // if we have a crossing point at this surface, note di specifies if we are moving forwards or backwards
+        const Layer         &l   = fLayers[ito];
+        const TCylinderBank *bkp = l.fBankPtr;
+        if (bkp && !xings.Contains(bkp, ito - bkp->GetIndex())) {
+            // with dE/dx the helix changes after every layer but the first
+            Int_t last = di > 0 ? TMath::Min(toidx, bkp->GetIndex() + bkp->GetNcylinders() - 1)
+                                : TMath::Max(toidx, bkp->GetIndex());
+            Int_t n    = TMath::Abs(last - ito) + 1;
+            if (IsDEDXOn()) n = TMath::Min(n, ito == fridx ? 2 : 1);
+            bkp->CalcXingPointsWith(hel, TMath::Min(ito, ito + di*(n-1)) - bkp->GetIndex(), n, xings);
+        }
+
+        Int_t nxing;
+        Int_t pred;
+        if (bkp && xings.Contains(bkp, ito - bkp->GetIndex())) {
+            nxing = bkp->GetXingPoint(hel, xings, ito - bkp->GetIndex(), xx, fid, mode);
+            KALSTATS_COUNT(kXingBanked);
+        } else if (!CanCross(l, hel)) {
+            nxing = 0;
+        } else if ((pred = PredictPhi(l, hel, fid)) < 0) {
+            nxing = 0;                        // the helix misses the surface
+        } else {
+            nxing = CalcXingPoint(l, hel, xx, fid, mode, eps, pred > 0);
+        }
+
+        if (nxing) { // if we have a crossing point at this surface, note di specifies if we are moving forwards or backwards
 
             //=====================
             // FIXME
@@ -272,6 +387,7 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
             // reset the deflection angle and skip this layer
             // this would at stop layers being added which are too far away but I am not sure how this will work with the problem described above.
             if( (xx-xfrom).Mag() - kMergin > (xto-xfrom).Mag() ){
+                KALSTATS_COUNT(kLayersSkipped);
                 fid = fid_temp;
                 continue ;
             }
@@ -279,30 +395,17 @@ int TKalDetCradle::Transport(const TKalTrackSite  &from,  // site from
             // ENDFIXME
             //=====================
 
-            const TVMeasLayer   &ml  = *dynamic_cast<TVMeasLayer *>(At(ifr)); // get the last layer
+            const Layer         &lfr = fLayers[ifr]; // get the last layer
       
-            
-            TKalMatrix Qms(sdim, sdim);
-            if (IsMSOn()&& ito!=fridx ){
-                
-                ml.CalcQms(isout, hel, fid, Qms); // Qms for this step, using the fact that the material was found to be outgoing or incomming above, and the distance from the last layer
-            }
-            
-            hel.MoveTo(xx, fid, &DF);         // move the helix to the present crossing point, DF will simply have its values overwritten so it could be explicitly set to unity here
-            if (sdim == 6) DF(5, 5) = 1.;     // t0 stays the same
-            F = DF * F;                       // update F
-            TKalMatrix DFt  = TKalMatrix(TMatrixD::kTransposed, DF);
-            
-            Q = DF * (Q + Qms) * DFt;         // transport Q to the present crossing point
-            
-            if (IsDEDXOn() && ito!=fridx) {
-                hel.PutInto(sv);              // copy hel to sv
-                // whether the helix is moving forwards or backwards is calculated using the sign of the charge and the sign of the deflection angle
-                // Bool_t isfwd = ((cpa > 0 && df < 0) || (cpa <= 0 && df > 0)) ? kForward : kBackward;  // taken from TVMeasurmentLayer::GetEnergyLoss  not df = fid
-                sv(2,0) += ml.GetEnergyLoss(isout, hel, fid); // correct for dE/dx, returns delta kappa i.e. the change in pt
-                hel.SetTo(sv, hel.GetPivot());                // save sv back to hel
+            // move the helix to the present crossing point with the
+            // material of the last layer, using the fact that it was found
+            // to be outgoing or incomming above, except for the first step
+            if (Step(hel, ito!=fridx ? lfr.fLayerPtr : 0, isout, xx, fid, sv, F, Q, Qms)) {
+                xings.Clear();                                // new helix circle
+                if (hlp) rmax = CalcRmax(hel);
             }
             ifr = ito; // for the next iteration set the "previous" layer to the current layer moved to
+            KALSTATS_COUNT(kLayersVisited);
 
             //fg: need to set the deflection angle to 0. as we moved the helix to a new position
             //    as this fid is used in the next call to TVSurface::CalcXingPointWith(), i.e. to
@@ -337,6 +440,8 @@ int TKalDetCradle::Transport2(const TKalTrackSite  &from,  // site from
                                     TKalMatrix     &Q,     // process noise matrix
                            std::unique_ptr<TVTrack> &help)  // pointer to update track object
 {
+  KALSTATS_TIMER(kTransport2);
+
   // ---------------------------------------------------------------------
   //  Sort measurement layers in this cradle if not
   // ---------------------------------------------------------------------
@@ -384,7 +489,7 @@ int TKalDetCradle::Transport2(const TKalTrackSite  &from,  // site from
 	// in which the mode is always 0.
     int mode = ito!=fridx ? di : 0;  
 
-    const TVMeasLayer   &ml  = *dynamic_cast<TVMeasLayer *>(At(ifr)); // get the last layer 
+    const Layer         &lfr = fLayers[ifr]; // get the last layer 
 	
 	//The crossing point between a TRungeKuttaTrack and a TVSurface
     TVector3 rkxx;
@@ -401,7 +506,7 @@ int TKalDetCradle::Transport2(const TKalTrackSite  &from,  // site from
 		// helix is defined by local track parameters.
 	    // xx is a global coordinate.
 		// angle fid is difference of direction for pivot and crossing point in a helix.
-		dynamic_cast<TVSurface *>(At(ito))->CalcXingPointWith(hel, xx, fid, mode);
+		fLayers[ito].fSurfPtr->CalcXingPointWith(hel, xx, fid, mode);
 	}
 	else {
 	    // If ito!=fridx, it means the track will move from the currnt pivot (crossing point)
@@ -409,15 +514,27 @@ int TKalDetCradle::Transport2(const TKalTrackSite  &from,  // site from
 		// Considering the non-uniformity of the magnetic field, we use the Runge-Kutta track model here, 
 		// and we create a runge-kutta track to calculate the crossing point.		
 
+		// The search starts from the path length to the crossing of the
+		// helix, which differs from that of the track only through the
+		// change of the field over the step.
+
+		Double_t fih  = 0.;
+		Bool_t   warm = CalcXingPoint(fLayers[ito], hel, rkxx, fih, mode, 1.e-8);
+		if (warm) {
+			Double_t tnl = hel.GetTanLambda();
+			step = -hel.GetRho() * fih * TMath::Sqrt(1. + tnl*tnl);
+			KALSTATS_COUNT(kXingWarmStarts);
+		}
+
 		rk.SetFromTrack(hel);
 
-		dynamic_cast<TVSurface *>(At(ito))->CalcXingPointWith(rk, rkxx, step, mode);
+		CalcXingPoint(fLayers[ito], rk, rkxx, step, mode, 1.e-8, warm);
     }
 
     TKalMatrix Qms(sdim, sdim);                                       
 
     if (IsMSOn()&& ito!=fridx ){
-        ml.CalcQms(isout, hel, fid, Qms);                  
+        lfr.fLayerPtr->CalcQms(isout, hel, fid, Qms);
 	   	// Qms for this step, using the fact that the material was found to be outgoing 
 		// or incomming above, and the distance from the last layer 
     }
@@ -454,12 +571,13 @@ int TKalDetCradle::Transport2(const TKalTrackSite  &from,  // site from
 		// Bool_t isfwd = ((cpa > 0 && df < 0) || (cpa <= 0 && df > 0)) ? kForward : kBackward;  
 		// taken from TVMeasurmentLayer::GetEnergyLoss  not df = fid
         
-		sv(2,0) += ml.GetEnergyLoss(isout, hel, fid); 
+		sv(2,0) += lfr.fLayerPtr->GetEnergyLoss(isout, hel, fid); 
 		// correct for dE/dx, returns delta kappa i.e. the change in pt 
         hel.SetTo(sv, hel.GetPivot());                // save sv back to hel
       }
       
 	  ifr = ito; // for the next iteration set the "previous" layer to the current layer moved to 
+	  KALSTATS_COUNT(kLayersVisited);
 
   } // end of loop over surfaces
   
@@ -492,6 +610,573 @@ void TKalDetCradle::Update()
         mlp->SetIndex(i++);
     }
     
+    MakeTable();
+}
+
+//_________________________________________________________________________
+// -----------------
+//  Restore
+// -----------------
+//    closes this cradle in the order and with the indices restored
+//    by TKalCradleSnapshot, without sorting.
+//
+void TKalDetCradle::Restore()
+{
+    fIsClosed = kTRUE;
+    fDone     = kTRUE;
+    fSorted   = kTRUE;
+
+    MakeTable();
+}
+
+//_________________________________________________________________________
+// -----------------
+//  MakeTable
+// -----------------
+//    fills the navigation table: for each layer its shape and shape
+//    parameters, so that Transport() needs no casts or virtual calls to
+//    find crossings. Layers that do not opt in with TVSurface::GetShape()
+//    keep kOther and are called virtually. Each run of consecutive
+//    coaxial cylinders goes into a TCylinderBank, whose
+//    index is that of its first layer. fRreach bounds the distance from
+//    the z axis of the cylinders and the bounded surfaces, and is 0 for
+//    the other surfaces.
+//
+void TKalDetCradle::MakeTable()
+{
+    fBanks.Delete();
+    fLayers.assign(GetEntriesFast(), Layer());
+
+    TCylinderBank *bkp = 0;
+    for (Int_t i=0; i<GetEntriesFast(); i++) {
+        Layer &l    = fLayers[i];
+        l.fLayerPtr = dynamic_cast<TVMeasLayer *>(At(i));
+        l.fSurfPtr  = dynamic_cast<TVSurface *>(At(i));
+        l.fShape    = l.fSurfPtr ? l.fSurfPtr->GetShape() : TVSurface::kOther;
+        l.fBounded  = l.fSurfPtr && l.fSurfPtr->GetBoundingVolume(l.fVolume);
+
+        const TCylinder *cp = 0;
+        const TPlane    *pp = 0;
+        const TCutCone  *kp = 0;
+        if      (l.fShape == TVSurface::kCylinder && (cp = dynamic_cast<const TCylinder *>(l.fSurfPtr))) {
+            l.fXc[0] = cp->GetXc().X();
+            l.fXc[1] = cp->GetXc().Y();
+            l.fXc[2] = cp->GetXc().Z();
+            l.fR     = cp->GetR();
+        } else if (l.fShape == TVSurface::kPlane && (pp = dynamic_cast<const TPlane *>(l.fSurfPtr))) {
+            l.fXc[0]     = pp->GetXc().X();
+            l.fXc[1]     = pp->GetXc().Y();
+            l.fXc[2]     = pp->GetXc().Z();
+            l.fNormal[0] = pp->GetNormal().X();
+            l.fNormal[1] = pp->GetNormal().Y();
+            l.fNormal[2] = pp->GetNormal().Z();
+        } else if (l.fShape == TVSurface::kCutCone && (kp = dynamic_cast<const TCutCone *>(l.fSurfPtr))) {
+            l.fXc[0] = kp->GetXc().X();
+            l.fXc[1] = kp->GetXc().Y();
+            l.fXc[2] = kp->GetXc().Z();
+            l.fTanA  = kp->GetTanA();
+        } else {
+            l.fShape = TVSurface::kOther;
+        }
+
+        // lower bound of the distance of the surface from the z axis
+
+        const TVSurface::BoundingVolume &bv = l.fVolume;
+        if (cp) {
+            l.fRreach = l.fR - TMath::Sqrt(l.fXc[0]*l.fXc[0] + l.fXc[1]*l.fXc[1]);
+        } else if (l.fBounded) {
+            Double_t d = TMath::Sqrt(bv.fXc*bv.fXc + bv.fYc*bv.fYc);
+            l.fRreach  = TMath::Max(bv.fRmin - d, d - bv.fRmax);
+        }
+        l.fRreach = TMath::Max(l.fRreach, 0.);
+
+        if (!cp) {
+            bkp = 0;
+            continue;
+        }
+        if (bkp && !bkp->IsCoaxial(*cp)) bkp = 0;
+        if (!bkp) {
+            bkp = new TCylinderBank(i);
+            fBanks.Add(bkp);
+        }
+        bkp->Add(*cp);
+        l.fBankPtr = bkp;
+    }
+
+    // and of all the layers after it
+    for (Int_t i=Int_t(fLayers.size())-2; i>=0; i--) {
+        fLayers[i].fRreach = TMath::Min(fLayers[i].fRreach, fLayers[i+1].fRreach);
+    }
+}
+
+//_________________________________________________________________________
+// -----------------
+//  CalcXingPoint
+// -----------------
+//    crossing of hel with layer l, as l.fSurfPtr->CalcXingPointWith()
+//    returns it. Cylinders in a uniform field take it from their bank;
+//    otherwise cylinders, planes, and cones run the Newtonian method of
+//    TVSurface::CalcXingPointWith() with S and dS/dx evaluated inline.
+//    It starts from the phi passed in; warm tells that this is a
+//    predicted one, for the statistics. Straight tracks go to the
+//    closed-form crossings of the surfaces.
+//
+Int_t TKalDetCradle::CalcXingPoint(const Layer    &l,
+                                   const TVTrack  &hel,
+                                         TVector3 &xx,
+                                         Double_t &phi,
+                                         Int_t     mode,
+                                         Double_t  eps,
+                                         Bool_t    warm) const
+{
+   if (l.fShape == TVSurface::kOther || !hel.IsInB()) {
+      return l.fSurfPtr->CalcXingPointWith(hel, xx, phi, mode, eps);
+   }
+
+   if (l.fShape == TVSurface::kCylinder && hel.IsInB()
+                                        && TBField::IsUsingUniformBfield()) {
+      static thread_local TCylinderBank::Xings xs;
+      const TCylinderBank &bank = *l.fBankPtr;
+      Int_t i = Int_t(&l - &fLayers[0]) - bank.GetIndex();
+      bank.CalcXingPointsWith(hel, i, 1, xs, eps);
+      return bank.GetXingPoint(hel, xs, i, xx, phi, mode);
+   }
+
+   KALSTATS_TIMER(kXing);
+   KALSTATS_ALLOC_TAG(kAllocXing);
+
+   // as TVSurface::CalcXingPointWith(), which always uses eps = 1.e-5
+   // and mode = 0, i.e. accepts the crossing in either direction
+
+   static const Double_t    tolerance  = 1.e-5;
+   static const Int_t       maxcount   = 100;
+   static const Double_t    initlambda = 1.e-10;
+   static const Double_t    lambdaincr = 10.;
+   static const Double_t    lambdadecr = 0.1;
+
+   const Double_t *xc = l.fXc;
+   const Double_t *nv = l.fNormal;
+
+   xx = hel.CalcXAt(phi);
+
+   Double_t  lastphi =  phi;
+   Double_t  lasts   =  1.e10;
+   Double_t  lambda  =  initlambda;
+
+   TVector3  lastxx  =  xx;
+   Int_t     count   =  0;
+
+   Double_t s;
+
+   while (1) {
+      if (count > maxcount) {
+         phi     = lastphi;
+         xx      = lastxx;
+         KALSTATS_COUNT(kXingMaxCount);
+         return 0;
+      }
+      count++;
+      KALSTATS_COUNT(kXingIterations);
+      KALSTATS_ADD(kXingWarmIterations, warm);
+
+      Double_t dx = xx.X() - xc[0];
+      Double_t dy = xx.Y() - xc[1];
+      Double_t dz = xx.Z() - xc[2];
+      if (l.fShape == TVSurface::kPlane) {
+         s = dx*nv[0] + dy*nv[1] + dz*nv[2];
+      } else if (l.fShape == TVSurface::kCutCone) {
+         Double_t r = TMath::Sqrt(dx*dx + dy*dy);
+         s = (r - dz*l.fTanA) * (r + dz*l.fTanA);
+      } else {
+         s = dx*dx + dy*dy - l.fR*l.fR;
+      }
+      if (TMath::Abs(s) < tolerance) break;
+      if (TMath::Abs(s) < TMath::Abs(lasts)) {
+         lasts   = s;
+         lastphi = phi;
+         lastxx  = xx;
+         lambda *= lambdadecr;
+      } else {
+         s       = lasts;
+         phi     = lastphi;
+         xx      = lastxx;
+         lambda *= lambdaincr;
+         dx      = xx.X() - xc[0];
+         dy      = xx.Y() - xc[1];
+         dz      = xx.Z() - xc[2];
+      }
+      Double_t dsdx[3];
+      if (l.fShape == TVSurface::kPlane) {
+         dsdx[0] = nv[0];
+         dsdx[1] = nv[1];
+         dsdx[2] = nv[2];
+      } else if (l.fShape == TVSurface::kCutCone) {
+         dsdx[0] =  2.* dx;
+         dsdx[1] =  2.* dy;
+         dsdx[2] = -2.* dz * l.fTanA * l.fTanA;
+      } else {
+         dsdx[0] = 2.*dx;
+         dsdx[1] = 2.*dy;
+         dsdx[2] = 0.;
+      }
+      TMatrixD dxdphi = hel.CalcDxDphi(phi);
+      Double_t dsdphi = dsdx[0]*dxdphi(0,0) + dsdx[1]*dxdphi(1,0) + dsdx[2]*dxdphi(2,0);
+      Double_t denom  = (1 + lambda) * dsdphi;
+      phi -= s / denom;
+      xx   = hel.CalcXAt(phi);
+   }
+
+   if (l.fSurfPtr->IsOnSurface(xx)) return 1;
+   KALSTATS_COUNT(kXingOffSurface);
+   return 0;
+}
+
+//_________________________________________________________________________
+// -----------------
+//  CanCross
+// -----------------
+//    returns kFALSE if hel, a helix in a uniform field, misses the
+//    bounding volume of layer l, so that no crossing search could find
+//    a point accepted by IsOnSurface(). The helix is in the z range of
+//    the volume for an interval of turning angles phi; over it the
+//    squared distance of the helix from the axis of the volume,
+//      (d - |rho|)^2 + 2 |rho| d (1 - cos(phi0 + phi - beta')),
+//    d being that of the helix centre at azimuth beta, takes a range
+//    that must overlap [rmin^2, rmax^2].
+//
+Bool_t TKalDetCradle::CanCross(const Layer &l, const TVTrack &hel) const
+{
+    if (!l.fBounded || !hel.IsInB() || !TBField::IsUsingUniformBfield()) return kTRUE;
+
+    static const Double_t kTol   = 1.e-3;   // > tolerances of crossing search and IsOnSurface()
+    static const Double_t kPi    = TMath::Pi();
+    static const Double_t kTwoPi = 2.*TMath::Pi();
+
+    KALSTATS_COUNT(ECounter(TKalStats::kBVCheckOther + l.fShape));
+
+    const TVSurface::BoundingVolume &bv = l.fVolume;
+
+    Double_t  fi0 = hel.GetPhi0();
+    Double_t  rho = hel.GetRho();
+    Double_t  rdr = rho + hel.GetDrho();
+    const TVector3 &x0 = hel.GetPivot();
+    Double_t  dx  = x0.X() + rdr*TMath::Cos(fi0) - bv.fXc;   // helix centre
+    Double_t  dy  = x0.Y() + rdr*TMath::Sin(fi0) - bv.fYc;   // from the axis
+    Double_t  zc  = x0.Z() + hel.GetDz();
+    Double_t  rtl = rho*hel.GetTanLambda();                  // z = zc - rtl*phi
+    Double_t  zmin = bv.fZmin - kTol;
+    Double_t  zmax = bv.fZmax + kTol;
+
+    // turning angles in the z range; the whole circle if a turn or more
+
+    Bool_t   full   = kTRUE;
+    Double_t phimin = 0.;
+    Double_t phimax = 0.;
+    if (rtl == 0.) {
+        if (zc < zmin || zc > zmax) {
+            KALSTATS_COUNT(ECounter(TKalStats::kBVRejectOther + l.fShape));
+            return kFALSE;
+        }
+    } else {
+        phimin = (zc - zmax) / rtl;
+        phimax = (zc - zmin) / rtl;
+        if (phimin > phimax) std::swap(phimin, phimax);
+        full   = phimax - phimin >= kTwoPi;
+    }
+
+    // range of w = 1 - cos(v) over the interval, v = phi0 + phi - beta
+    // for rho > 0 and shifted by pi for rho < 0
+
+    Double_t arho = TMath::Abs(rho);
+    Double_t d    = TMath::Sqrt(dx*dx + dy*dy);
+    Double_t wmin = 0.;
+    Double_t wmax = 2.;
+    if (!full) {
+        Double_t beta = TMath::ATan2(dy, dx) + (rho < 0. ? kPi : 0.);
+        Double_t v1   = fi0 + phimin - beta;
+        Double_t v2   = fi0 + phimax - beta;
+        Double_t s1   = TMath::Sin(0.5*v1);
+        Double_t s2   = TMath::Sin(0.5*v2);
+        Double_t w1   = 2.*s1*s1;
+        Double_t w2   = 2.*s2*s2;
+        if (TMath::Ceil(v1/kTwoPi)*kTwoPi > v2)             wmin = TMath::Min(w1, w2);
+        if (TMath::Ceil((v1 - kPi)/kTwoPi)*kTwoPi + kPi > v2) wmax = TMath::Max(w1, w2);
+    }
+    Double_t dd   = d - arho;
+    Double_t r2lo = dd*dd + 2.*arho*d*wmin;
+    Double_t r2hi = dd*dd + 2.*arho*d*wmax;
+    Double_t rmin = bv.fRmin - kTol;
+    Double_t rmax = bv.fRmax + kTol;
+    if ((rmin > 0. && r2hi < rmin*rmin) || r2lo > rmax*rmax) {
+        KALSTATS_COUNT(ECounter(TKalStats::kBVRejectOther + l.fShape));
+        return kFALSE;
+    }
+    return kTRUE;
+}
+
+//_________________________________________________________________________
+// -----------------
+//  PredictPhi
+// -----------------
+//    predicts the turning angle phi at which hel, a helix in a uniform
+//    field, crosses layer l, as the start of the crossing search, which
+//    otherwise has to walk the arc from the pivot. For a plane parallel
+//    to the field, with normal n at azimuth theta, the crossing
+//      n.(C - xc) - rho cos(phi0 + phi - theta) = 0,
+//    C being the helix centre, is solved exactly for the root closest
+//    to the pivot; if it has none within the tolerance of the search,
+//    the search could not converge. For other planes and for cones,
+//    S(phi) is expanded to second order at the pivot. Returns 1 with
+//    phi set, 0 if there is no prediction, leaving phi as it is, and
+//    -1 if the helix does not cross the surface.
+//
+Int_t TKalDetCradle::PredictPhi(const Layer &l, const TVTrack &hel, Double_t &phi) const
+{
+    if (l.fShape != TVSurface::kPlane && l.fShape != TVSurface::kCutCone) return 0;
+    if (!hel.IsInB() || !TBField::IsUsingUniformBfield()) return 0;
+
+    static const Double_t kTol   = 1.e-5;   // that of the crossing search
+    static const Double_t kPi    = TMath::Pi();
+    static const Double_t kTwoPi = 2.*TMath::Pi();
+
+    Double_t  fi0  = hel.GetPhi0();
+    Double_t  csf0 = TMath::Cos(fi0);
+    Double_t  snf0 = TMath::Sin(fi0);
+    Double_t  rho  = hel.GetRho();
+    Double_t  dr   = hel.GetDrho();
+    Double_t  rtl  = rho*hel.GetTanLambda();               // z = zc - rtl*phi
+    const TVector3 &x0 = hel.GetPivot();
+    const Double_t *xc = l.fXc;
+    Double_t  dx   = x0.X() + dr*csf0 - xc[0];             // point at phi = 0
+    Double_t  dy   = x0.Y() + dr*snf0 - xc[1];             // relative to xc
+    Double_t  dz   = x0.Z() + hel.GetDz() - xc[2];
+
+    // S and its first two derivatives at phi = 0
+
+    Double_t s0, s1, s2;
+    if (l.fShape == TVSurface::kPlane) {
+        const Double_t *nv = l.fNormal;
+        if (nv[2] == 0.) {
+            Double_t q = (nv[0]*(dx + rho*csf0) + nv[1]*(dy + rho*snf0)) / rho;
+            if (TMath::Abs(rho)*(TMath::Abs(q) - 1.) > kTol) {
+                KALSTATS_COUNT(kXingNoRoot);
+                return -1;
+            }
+            Double_t a    = TMath::ACos(TMath::Max(-1., TMath::Min(1., q)));
+            Double_t base = TMath::ATan2(nv[1], nv[0]) - fi0;
+            Double_t best = kTwoPi;
+            for (Int_t i=0; i<2; i++) {
+                Double_t fi = base + (i ? -a : a);
+                fi -= kTwoPi*TMath::Floor((fi + kPi)/kTwoPi);  // to [-pi, pi)
+                if (TMath::Abs(fi) < TMath::Abs(best)) best = fi;
+            }
+            phi = best;
+            KALSTATS_COUNT(kXingWarmStarts);
+            return 1;
+        }
+        s0 = nv[0]*dx + nv[1]*dy + nv[2]*dz;
+        s1 = rho*(nv[0]*snf0 - nv[1]*csf0) - nv[2]*rtl;
+        s2 = rho*(nv[0]*csf0 + nv[1]*snf0);
+    } else {
+        Double_t t2 = l.fTanA*l.fTanA;
+        s0 = dx*dx + dy*dy - t2*dz*dz;
+        s1 = 2.*rho*(dx*snf0 - dy*csf0) + 2.*t2*rtl*dz;
+        s2 = 2.*rho*(rho + dx*csf0 + dy*snf0) - 2.*t2*rtl*rtl;
+    }
+
+    // root of s0 + s1 phi + s2 phi^2/2 closest to phi = 0
+
+    Double_t disc = s1*s1 - 2.*s2*s0;
+    if (disc < 0.) return 0;
+    Double_t denom = s1 + TMath::Sign(TMath::Sqrt(disc), s1);
+    if (denom == 0.) return 0;
+    Double_t fi = -2.*s0/denom;
+    if (TMath::Abs(fi) > kPi) return 0;
+    phi = fi;
+    KALSTATS_COUNT(kXingWarmStarts);
+    return 1;
+}
+
+//_________________________________________________________________________
+// -----------------
+//  CalcXingPointNear
+// -----------------
+//    replaces the crossing (xx, phi) of hel with layer l by the crossing
+//    closest to the hit xhit and returns kTRUE, if any is closer. In
+//    either direction the candidates are the first crossing from the
+//    pivot and the first after the next turning point; a looper on the
+//    surface of l at the pivot crosses it again only after the turn.
+//
+Bool_t TKalDetCradle::CalcXingPointNear(const Layer         &l,
+                                      const THelicalTrack &hel,
+                                      const TVector3      &xhit,
+                                            TVector3      &xx,
+                                            Double_t      &phi,
+                                            Double_t       eps) const
+{
+    static const Double_t kMinPhi = 1.e-6;   // the crossing at the pivot
+
+    Double_t dmin = (xx - xhit).Mag();
+    Bool_t   done = kFALSE;
+    for (Int_t m=-1; m<=1; m+=2) {
+        Double_t dir = -m*hel.GetRho();      // sign of phi in direction m
+        for (Int_t k=0; k<2; k++) {
+            THelicalTrack h(hel);
+            Double_t      fit = 0.;
+            if (k) {
+                Double_t phiturn = 0.;
+                Int_t    type    = 0;
+                if (!hel.CalcTurningPoint(dir, phiturn, type)) break;
+                h.MoveTo(hel.CalcXAt(phiturn), fit, 0, 0, kFALSE);
+            }
+            TVector3 xc;
+            Double_t fi   = 0.;
+            Int_t    pred = PredictPhi(l, h, fi);
+            if (pred < 0 || !CalcXingPoint(l, h, xc, fi, m, eps, pred > 0)) continue;
+            if (!k && TMath::Abs(fi) < kMinPhi) continue;
+            Double_t d = (xc - xhit).Mag();
+            if (d < dmin) {
+                dmin = d;
+                xx   = xc;
+                phi  = fit + fi;
+                done = kTRUE;
+            }
+        }
+    }
+    return done;
 }
 
+//_________________________________________________________________________
+// -----------------
+//  Step
+// -----------------
+//    moves hel to xx at fid, adding the multiple scattering and energy
+//    loss in the material of layer ml (if any) on the side isout, and updates F and Q in place as
+//      F = DF * F,  Q = DF * (Q + Qms) * DF^T.
+//    sv and Qms are work space. Returns kTRUE if the energy loss changed
+//    the helix circle.
+//
+Bool_t TKalDetCradle::Step(      TVTrack               &hel,
+                           const TVMeasLayer           *ml,
+                                 Bool_t                 isout,
+                           const TVector3              &xx,
+                                 Double_t              &fid,
+                                 TKalMatrix            &sv,
+                                 TKalMatrix            &F,
+                                 TKalMatrix            &Q,
+                                 TKalMatrix            &Qms) const
+{
+    if (ml && IsMSOn()) {
+        Qms.Zero();
+        ml->CalcQms(isout, hel, fid, Qms);
+        Q += Qms;
+    }
 
+    hel.PropagateTo(xx, fid, F, &Q);
+
+    // a straight track has a fixed momentum, see TStraightTrack::SetMomentum()
+    if (ml && IsDEDXOn() && hel.IsInB()) {
+        hel.PutInto(sv);
+        sv(2,0) += ml->GetEnergyLoss(isout, hel, fid);   // delta kappa
+        hel.SetTo(sv, hel.GetPivot());
+        return kTRUE;
+    }
+    return kFALSE;
+}
+
+//_________________________________________________________________________
+// -----------------
+//  TransportLooper
+// -----------------
+//    transports hel, a helix in a uniform field, from layer fridx to its
+//    crossing with layer toidx at turning angle phit, passing turning
+//    points of its distance from the z axis on the way. Between two
+//    turning points the distance is monotonic, so that the layers are
+//    walked in index order: outwards before a maximum, up to the first
+//    one out of reach, and inwards before a minimum; the track then
+//    steps to the turning point and walks back from the last layer
+//    crossed. The layer to is looked for only after the last turn. At
+//    most kMaxTurns turns are followed, so a track spiralling in the
+//    field takes bounded time; the track goes straight to phit if it
+//    does not reach layer to. Multiple scattering and energy loss are
+//    added for the material between the layers, as in Transport().
+//
+void TKalDetCradle::TransportLooper(THelicalTrack &hel,
+                                    Int_t          fridx,
+                                    Int_t          toidx,
+                                    Double_t       phit,
+                                    Double_t       eps,
+                                    TKalMatrix    &sv,
+                                    TKalMatrix    &F,
+                                    TKalMatrix    &Q,
+                                    TKalMatrix    &Qms) const
+{
+    static const Int_t    kMaxTurns = 8;
+    static const Double_t kTol      = 1.e-3;    // [cm]
+
+    Int_t mode = phit*hel.GetRho() < 0. ? +1 : -1;   // direction of flight
+    Int_t nl   = Int_t(fLayers.size());
+
+    // onto the surface of the site from, without material
+
+    TVector3 xx;
+    Double_t fid  = 0.;
+    Int_t    pred = PredictPhi(fLayers[fridx], hel, fid);
+    if (pred >= 0 && CalcXingPoint(fLayers[fridx], hel, xx, fid, 0, eps, pred > 0)) {
+        Step(hel, 0, kFALSE, xx, fid, sv, F, Q, Qms);
+        phit -= fid;
+    }
+
+    Int_t  ifr   = fridx;
+    Bool_t isout = kFALSE;
+    for (Int_t iturn=0; iturn<=kMaxTurns; iturn++) {
+        Double_t phiturn = 0.;
+        Int_t    type    = 0;
+        Bool_t   last    = iturn == kMaxTurns
+                        || !hel.CalcTurningPoint(phit, phiturn, type)
+                        || TMath::Abs(phit) <= TMath::Abs(phiturn);
+        Double_t phiend  = last ? phit : phiturn;
+        Double_t rturn   = hel.CalcXAt(phiturn).Perp();
+        Int_t    di      = last ? (toidx > ifr ? +1 : -1) : type;
+        if (!iturn) isout = di > 0;
+
+        // layers crossed before the turning point; after a turn the
+        // last layer crossed comes again
+
+        for (Int_t ito = iturn ? ifr : ifr + di; ito >= 0 && ito < nl; ito += di) {
+            const Layer &l = fLayers[ito];
+            Bool_t target  = last && ito == toidx;
+            if (last && (ito - toidx)*di > 0)           break;
+            if (!last && di > 0 && l.fRreach > rturn + kTol) break;
+            if (!CanCross(l, hel)) continue;
+            fid  = 0.;
+            pred = PredictPhi(l, hel, fid);
+            if (pred < 0 || !CalcXingPoint(l, hel, xx, fid, mode, eps, pred > 0)) continue;
+            if (!target && (fid*phiend <= 0. || TMath::Abs(fid) >= TMath::Abs(phiend))) {
+                continue;
+            }
+
+            Step(hel, fLayers[ifr].fLayerPtr, isout, xx, fid, sv, F, Q, Qms);
+            isout   = di > 0;
+            ifr     = ito;
+            phit   -= fid;
+            phiend -= fid;
+            KALSTATS_COUNT(kLayersVisited);
+            if (target) return;
+        }
+        if (last) break;
+
+        // to the turning point, in the material left behind
+
+        if (!hel.CalcTurningPoint(phit, phiturn, type)) break;
+        fid = phiturn;
+        Step(hel, fLayers[ifr].fLayerPtr, isout, hel.CalcXAt(phiturn), fid, sv, F, Q, Qms);
+        phit -= fid;
+        KALSTATS_COUNT(kLooperTurns);
+    }
+
+    // layer to not reached: straight to the crossing found at the start
+
+    fid = phit;
+    Step(hel, fLayers[ifr].fLayerPtr, isout, hel.CalcXAt(phit), fid, sv, F, Q, Qms);
+}
@@ -20,6 +20,18 @@
 //*                              Transport() to do their functions.
 //*   2010/04/06  K.Fujii        Modified Transport() to allow a 1-dim hit,
 //*                              for which pivot is at the xpected hit.
+//*   2026/10/18                 Added Restore() for TKalCradleSnapshot.
+//*   2026/10/18                 Cylinder banks for Transport().
+//*   2026/10/18                 Typed layer table for navigation.
+//*   2026/10/18                 Bounding volumes in the layer table.
+//*   2026/10/18                 Warm-started crossing searches.
+//*   2026/10/18                 Straight-line fast path in Transport().
+//*   2026/10/18                 TKalExtrapolator uses the layer table.
+//*   2026/10/18                 Transport() steps with PropagateTo().
+//*   2026/10/18                 Looper navigation in Transport().
+//*   2026/10/18                 Added IsUsingRungeKuttaTrack().
+//*   2026/10/18                 Materials through the virtual
+//*                              GetEnergyLoss() and CalcQms().
 //*
 //*************************************************************************
 
@@ -27,13 +39,17 @@
 #include "TAttElement.h"   // from Utils
 #include "TKalMatrix.h"    // from KalTrackLib
 #include "TKalTrack.h"     // from KalTrackLib
+#include "TVMeasLayer.h"   // from KalTrackLib
+#include "TVSurface.h"     // from GeomLib
 #include <memory>          // from STL
+#include <vector>          // from STL
 
 class TKalTrackSite;
 class TVKalDetector;
-class TVMeasLayer;
 class TVTrack;
 class TMaterial;
+class TCylinderBank;
+class THelicalTrack;
 
 //_____________________________________________________________________
 //  ------------------------------
@@ -42,6 +58,32 @@ class TMaterial;
 
 class TKalDetCradle : public TObjArray, public TAttElement {
 public:
+   // Navigation entry of a layer, filled when the cradle is closed:
+   // the surface shape (TVSurface::EShape) with its parameters and the
+   // layer. The navigation in Transport() and Transport2() dispatches
+   // on the shape; the materials are those of the virtual
+   // GetEnergyLoss() and CalcQms() of the layer. The
+   // bounding volume of the surface, if any, lets Transport() skip
+   // layers out of reach of the helix without a crossing search, and
+   // a lower bound of the distance from the z axis of the layer and
+   // all those after it ends the walk of a helix that turns back
+   // before them.
+
+   struct Layer {
+      Int_t                      fShape;     // TVSurface::EShape
+      TVMeasLayer               *fLayerPtr;  // layer
+      TVSurface                 *fSurfPtr;   // its surface
+      const TCylinderBank       *fBankPtr;   // kCylinder: bank holding it
+      Double_t                   fXc[3];     // centre
+      Double_t                   fNormal[3]; // kPlane: unit normal
+      Double_t                   fR;         // kCylinder: radius
+      Double_t                   fTanA;      // kCutCone: tan(half angle)
+      Bool_t                     fBounded;   // fVolume is set
+      TVSurface::BoundingVolume  fVolume;    // see CanCross()
+      Double_t                   fRreach;    // min. distance from z axis
+                                             // from this layer on
+   };
+
    TKalDetCradle(Int_t n = 1);
    virtual ~TKalDetCradle();
 
@@ -78,7 +120,8 @@ public:
                         TKalMatrix     &sv,   // state vector
                         TKalMatrix     &F,    // propagator matrix
                         TKalMatrix     &Q,    // process noise matrix
-			std::unique_ptr<TVTrack> &help);// pointer to updated track object
+			std::unique_ptr<TVTrack> &help,  // pointer to updated track object
+                  const TVector3       *xhitPtr = 0); // hit on layer to, if any
 
    int  Transport2(const TKalTrackSite  &from,   // site from
                   const TVMeasLayer     &to,     // layer to reach
@@ -88,16 +131,66 @@ public:
                         TKalMatrix      &Q,      // process noise matrix
 			std::unique_ptr<TVTrack>    &help);  // pointer to updated track object
 
-   static void SetUseRungeKuttaTrack(Bool_t b) { fUseRKTrack = b; }
+   static void   SetUseRungeKuttaTrack(Bool_t b) { fUseRKTrack = b;    }
+   static Bool_t IsUsingRungeKuttaTrack()        { return fUseRKTrack; }
+
+   // Navigation entry of layer i; the cradle must be closed
+
+   inline const Layer & GetLayer(Int_t i) const { return fLayers[i]; }
 
 private:
    void Update();
+   void Restore();
+   void MakeTable();
+
+   Int_t CalcXingPoint(const Layer    &l,
+                       const TVTrack  &hel,
+                             TVector3 &xx,
+                             Double_t &phi,
+                             Int_t     mode,
+                             Double_t  eps,
+                             Bool_t    warm = kFALSE) const;
+
+   Bool_t CanCross  (const Layer &l, const TVTrack &hel) const;
+   Int_t  PredictPhi(const Layer &l, const TVTrack &hel, Double_t &phi) const;
+
+   Bool_t CalcXingPointNear(const Layer         &l,
+                            const THelicalTrack &hel,
+                            const TVector3      &xhit,
+                                  TVector3      &xx,
+                                  Double_t      &phi,
+                                  Double_t       eps) const;
+
+   Bool_t Step(      TVTrack               &hel,
+               const TVMeasLayer           *ml,
+                     Bool_t                 isout,
+               const TVector3              &xx,
+                     Double_t              &fid,
+                     TKalMatrix            &sv,
+                     TKalMatrix            &F,
+                     TKalMatrix            &Q,
+                     TKalMatrix            &Qms) const;
+
+   void   TransportLooper(THelicalTrack &hel,
+                          Int_t          fridx,
+                          Int_t          toidx,
+                          Double_t       phit,
+                          Double_t       eps,
+                          TKalMatrix    &sv,
+                          TKalMatrix    &F,
+                          TKalMatrix    &Q,
+                          TKalMatrix    &Qms) const;
+
+   friend class TKalCradleSnapshot;
+   friend class TKalExtrapolator;
 
 private:
    Bool_t    fIsMSON{};         //! switch for multiple scattering
    Bool_t    fIsDEDXON{};       //! switch for energy loss
    Bool_t    fDone{};           //! flag to tell if sorting done
    Bool_t    fIsClosed{};       //! flag to tell if cradle closed
+   TObjArray fBanks;            //! banks of consecutive coaxial cylinders
+   std::vector<Layer> fLayers;  //! navigation table, by layer index
 
    static Bool_t   fUseRKTrack;
 
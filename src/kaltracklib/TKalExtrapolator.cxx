@@ -0,0 +1,412 @@
+//*************************************************************************
+//* ========================
+//*  TKalExtrapolator Class
+//* ========================
+//*
+//* (Description)
+//*   Extrapolation of a track state to a surface, a point, or a path
+//*   length.
+//* (Requires)
+//*     TKalDetCradle, TKalTrackState, THelicalTrack, TStraightTrack
+//* (Provides)
+//*     class TKalExtrapolator
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Layer walk split at the turning points of a looper.
+//*   2026/10/18  Walk starts on the layer surface; long steps in
+//*               quarter turns.
+//*   2026/10/18  Materials through the virtual GetEnergyLoss() and
+//*               CalcQms() of the layer.
+//*
+//*************************************************************************
+
+#include "TKalExtrapolator.h" // from KalTrackLib
+#include "TKalDetCradle.h"    // from KalTrackLib
+#include "TKalTrackSite.h"    // from KalTrackLib
+#include "TKalTrackState.h"   // from KalTrackLib
+#include "TVTrackHit.h"       // from KalTrackLib
+#include "TVSurface.h"        // from GeomLib
+#include "TBField.h"          // from Bfield
+#include "TMath.h"            // from ROOT
+
+#include <iostream>           // from STL
+
+using namespace std;
+
+//_________________________________________________________________________
+//  ----------------------------------
+//   Class for track extrapolation
+//  ----------------------------------
+//
+ClassImp(TKalExtrapolator)
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Ctors and Dtor
+//  ----------------------------------
+
+TKalExtrapolator::TKalExtrapolator(const TKalDetCradle *cradle, Int_t sdim)
+                 : fCradlePtr(cradle),
+                   fIsMatOn(kTRUE),
+                   fSdim(sdim),
+                   fTarget(kNone),
+                   fSurfPtr(0),
+                   fMode(0),
+                   fXt(),
+                   fLt(0.),
+                   fHelix(),
+                   fLine(),
+                   fHelixWork(),
+                   fLineWork(),
+                   fA(5,1),
+                   fQms(sdim,sdim),
+                   fTmp(sdim,sdim),
+                   fQ(sdim,sdim),
+                   fX0(),
+                   fSv(sdim,1),
+                   fC(sdim,sdim),
+                   fF(sdim,sdim),
+                   fLength(0.),
+                   fNlayers(0)
+{
+}
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Implementation of public methods
+//  ----------------------------------
+
+void TKalExtrapolator::SetTarget(const TVSurface &s, Int_t mode)
+{
+   fTarget  = kSurface;
+   fSurfPtr = &s;
+   fMode    = mode;
+}
+
+void TKalExtrapolator::SetTarget(const TVector3 &x)
+{
+   fTarget  = kPoint;
+   fXt      = x;
+}
+
+void TKalExtrapolator::SetTarget(Double_t length)
+{
+   fTarget  = kPathLength;
+   fLt      = length;
+}
+
+Int_t TKalExtrapolator::Extrapolate(const TKalTrackState &a)
+{
+   if (a.GetNrows() != fSdim) {
+      cerr << ">>>> Error!! TKalExtrapolator::Extrapolate >>>>>>>>" << endl
+           << " State dimension " << a.GetNrows() << " instead of " << fSdim << endl;
+      return 0;
+   }
+   const TKalTrackSite &site = static_cast<const TKalTrackSite &>(a.GetSite());
+   const TVector3      &x0v  = a.GetPivot();
+   Double_t x0[3] = { x0v.X(), x0v.Y(), x0v.Z() };
+   return Extrapolate(site.GetHit().GetMeasLayer().GetIndex(), site.GetBfield(),
+                      x0, a.GetMatrixArray(), a.GetCovMat().GetMatrixArray());
+}
+
+Int_t TKalExtrapolator::Extrapolate(      Int_t     layer,
+                                          Double_t  b,
+                                    const Double_t *x0,
+                                    const Double_t *sv,
+                                    const Double_t *cov)
+{
+   if (!fTarget) {
+      cerr << ">>>> Error!! TKalExtrapolator::Extrapolate >>>>>>>>" << endl
+           << " No target set.                                   " << endl;
+      return 0;
+   }
+   if (!TBField::IsUsingUniformBfield()) {
+      cerr << ">>>> Error!! TKalExtrapolator::Extrapolate >>>>>>>>" << endl
+           << " Only in a uniform field.                         " << endl;
+      return 0;
+   }
+
+   // ---------------------------------------------
+   // (1) Track and target
+   // ---------------------------------------------
+
+   for (Int_t i=0; i<5; i++) fA(i,0) = sv[i];
+   TVTrack &hel = b != 0. ? static_cast<TVTrack &>(fHelix)
+                          : static_cast<TVTrack &>(fLine);
+   hel.SetTo(fA, TVector3(x0[0], x0[1], x0[2]));
+   hel.SetMagField(b);
+   if (b == 0.) fLine.SetMomentum(TStraightTrack::GetDefaultMomentum());
+
+   fF.UnitMatrix();
+   fQ.Zero();
+   fLength  = 0.;
+   fNlayers = 0;
+
+   Double_t phit = 0.;
+   TVector3 xt;
+   if (!CalcTarget(hel, fLt, fMode, phit, xt)) return 0;
+
+   // ---------------------------------------------
+   // (2) Cradle layers on the way to the target
+   // ---------------------------------------------
+   //   A layer counts if the track crosses it, in the direction of
+   //   flight, before the target. Each step adds the material of the
+   //   layer left behind, as in TKalDetCradle::Transport(). Between two
+   //   turning points of its distance from the z axis a helix crosses
+   //   the layers in index order, outwards before a maximum and
+   //   inwards before a minimum, so that the walk is split at the
+   //   turning points before the target as in
+   //   TKalDetCradle::TransportLooper(): the track steps to the turning
+   //   point and walks back from the last layer crossed, for at most
+   //   kMaxTurns turns. A straight track goes outwards if the target is
+   //   at a larger radius than the pivot, inwards otherwise.
+
+   static const Int_t    kMaxTurns = 8;
+   static const Double_t kTol      = 1.e-3;    // [cm]
+
+   const TVMeasLayer   *ml    = 0;
+   Bool_t               mlout = kFALSE;
+   const TKalDetCradle *cp    = fCradlePtr;
+   Int_t nl = cp ? Int_t(cp->fLayers.size()) : 0;
+   if (fIsMatOn && layer >= 0 && layer < nl && (cp->IsMSOn() || cp->IsDEDXOn())) {
+      // onto the surface of the layer of the state, without material,
+      // as the pivot of a site is at its hit
+
+      Double_t fid  = 0.;
+      Int_t    pred = cp->PredictPhi(cp->fLayers[layer], hel, fid);
+      TVector3 xx;
+      if (pred >= 0 && cp->CalcXingPoint(cp->fLayers[layer], hel, xx, fid, 0, 1.e-8, pred > 0)) {
+         Step(hel, 0, kFALSE, xx, fid);
+         phit -= fid;
+      }
+
+      const THelicalTrack *hlp = hel.IsInB() ? &fHelix : 0;
+      Int_t mode = (hel.IsInB() ? phit*hel.GetRho() < 0. : phit > 0.) ? +1 : -1;
+
+      Int_t  ifr    = layer;
+      Bool_t looper = kFALSE;
+      Bool_t isout  = kFALSE;
+      for (Int_t iturn=0; iturn<=kMaxTurns; iturn++) {
+         Double_t phiturn = 0.;
+         Int_t    type    = 0;
+         Bool_t   turn    = hlp && hlp->CalcTurningPoint(phit, phiturn, type);
+         Bool_t   last    = iturn == kMaxTurns || !turn
+                         || TMath::Abs(phit) <= TMath::Abs(phiturn);
+         Double_t rturn   = turn ? hel.CalcXAt(phiturn).Perp() : 0.;
+         Int_t    di      = turn ? type
+                                 : (xt.Perp() >= hel.CalcXAt(0.).Perp() ? +1 : -1);
+
+         // without a turn the material side is that at the target, as
+         // in Transport(); a looper takes the side it walks to, as in
+         // TransportLooper()
+         if (!iturn) {
+            looper = !last;
+            isout  = di > 0;
+            if (!looper && fTarget == kSurface) {
+               TMatrixD dxdphi = hel.CalcDxDphi(phit);
+               TVector3 dxdphiv(dxdphi(0,0),dxdphi(1,0),dxdphi(2,0));
+               isout = -phit*dxdphiv.Dot(fSurfPtr->GetOutwardNormal(xt)) < 0 ? kTRUE : kFALSE;
+            }
+            ml    = cp->fLayers[layer].fLayerPtr;
+            mlout = isout;
+         }
+         if (looper) isout = di > 0;
+
+         // layers crossed before the turning point or the target, less
+         // kTol before it counting as at it; after a turn the last layer
+         // crossed comes again
+
+         Double_t phiend = last ? phit : phiturn;
+         for (Int_t i = iturn ? ifr : ifr + di; i>=0 && i<nl; i+=di) {
+            const TKalDetCradle::Layer &l = cp->fLayers[i];
+            if (!last && di > 0 && l.fRreach > rturn + kTol) break;
+            if (!cp->CanCross(l, hel)) continue;
+            Double_t phi = 0.;
+            pred = cp->PredictPhi(l, hel, phi);
+            if (pred < 0) continue;
+            if (!cp->CalcXingPoint(l, hel, xx, phi, mode, 1.e-8, pred > 0)) continue;
+            Double_t tol = hel.IsInB() ? kTol/TMath::Abs(hel.GetRho()) : kTol;
+            if (phi*phiend <= 0. || TMath::Abs(phi) >= TMath::Abs(phiend) - tol) continue;
+
+            Double_t cpa = hel.GetKappa();
+            Step(hel, ml, mlout, xx, phi);
+            ml    = l.fLayerPtr;
+            mlout = isout;
+            ifr = i;
+            fNlayers++;
+
+            // the target as seen from the new pivot: on the same circle
+            // unless the energy loss changed it
+            phiend -= phi;
+            if (hel.GetKappa() == cpa) {
+               phit -= phi;
+            } else if (!CalcTarget(hel, fLt - fLength, mode, phit, xt)) {
+               return 0;
+            }
+            if (last) phiend = phit;
+         }
+         if (last) break;
+
+         // to the turning point, in the material left behind
+
+         if (!hlp->CalcTurningPoint(phit, phiturn, type)) break;
+         Double_t cpa = hel.GetKappa();
+         Step(hel, ml, mlout, hel.CalcXAt(phiturn), phiturn);
+         if (hel.GetKappa() == cpa) {
+            phit -= phiturn;
+         } else if (!CalcTarget(hel, fLt - fLength, mode, phit, xt)) {
+            return 0;
+         }
+      }
+   }
+
+   // ---------------------------------------------
+   // (3) Last step to the target
+   // ---------------------------------------------
+
+   Step(hel, ml, mlout, fTarget == kPoint ? fXt : xt, phit);
+
+   // ---------------------------------------------
+   // (4) Results: C' = F C F^T + Q
+   // ---------------------------------------------
+
+   fX0 = hel.GetPivot();
+   hel.PutInto(fSv);
+   if (fSdim == 6) fSv(5,0) = sv[5];
+
+   Double_t *c = fC.GetMatrixArray();
+   for (Int_t i=0; i<fSdim*fSdim; i++) c[i] = cov[i];
+   fTmp.Mult(fF, fC);
+   fC.MultT(fTmp, fF);
+   fC += fQ;
+   return 1;
+}
+
+Int_t TKalExtrapolator::Extrapolate(      Int_t     n,
+                                    const Int_t    *layer,
+                                          Double_t  b,
+                                    const Double_t *x0,
+                                    const Double_t *sv,
+                                    const Double_t *cov,
+                                          Double_t *x0out,
+                                          Double_t *svout,
+                                          Double_t *covout,
+                                          Double_t *jac,
+                                          Int_t    *ok)
+{
+   Int_t nok = 0;
+   Int_t nsv = fSdim;
+   Int_t ncv = fSdim*fSdim;
+   for (Int_t it=0; it<n; it++) {
+      Int_t stat = Extrapolate(layer ? layer[it] : -1, b,
+                               x0 + 3*it, sv + nsv*it, cov + ncv*it);
+      if (ok) ok[it] = stat;
+      if (!stat) continue;
+      nok++;
+      x0out[3*it  ] = fX0.X();
+      x0out[3*it+1] = fX0.Y();
+      x0out[3*it+2] = fX0.Z();
+      const Double_t *svp = fSv.GetMatrixArray();
+      const Double_t *cvp = fC .GetMatrixArray();
+      const Double_t *fp  = fF .GetMatrixArray();
+      for (Int_t i=0; i<nsv; i++) svout [nsv*it+i] = svp[i];
+      for (Int_t i=0; i<ncv; i++) covout[ncv*it+i] = cvp[i];
+      if (jac) {
+         for (Int_t i=0; i<ncv; i++) jac[ncv*it+i] = fp[i];
+      }
+   }
+   return nok;
+}
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Private methods
+//  ----------------------------------
+
+//_________________________________________________________________________
+// -----------------
+//  CalcTarget
+// -----------------
+//    turning angle phi (path parameter t for a straight track) and
+//    position xx on hel of the target; length is the path length left
+//    for a kPathLength target and mode the direction in which a surface
+//    is looked for. Returns 0 if hel misses the target.
+//
+Int_t TKalExtrapolator::CalcTarget(const TVTrack  &hel,
+                                         Double_t  length,
+                                         Int_t     mode,
+                                         Double_t &phi,
+                                         TVector3 &xx)
+{
+   phi = 0.;
+   if (fTarget == kSurface) {
+      return fSurfPtr->CalcXingPointWith(hel, xx, phi, mode);
+   }
+   if (fTarget == kPoint) {
+      if (hel.IsInB()) {
+         fHelixWork = fHelix;
+         fHelixWork.MoveTo(fXt, phi, 0, 0, kFALSE);
+
+         // MoveTo() takes the closest approach within half a turn; of
+         // the turns through it that nearest the point in z
+         Double_t dzturn = -hel.GetRho()*hel.GetTanLambda()*TMath::TwoPi();
+         if (TMath::Abs(dzturn) > 0.) {
+            Double_t n = TMath::Nint((fXt.Z() - hel.CalcXAt(phi).Z())/dzturn);
+            phi += n*TMath::TwoPi();
+         }
+      } else {
+         fLineWork = fLine;
+         fLineWork.MoveTo(fXt, phi);
+      }
+   } else {
+      Double_t cslinv = TMath::Sqrt(1. + hel.GetTanLambda()*hel.GetTanLambda());
+      phi = hel.IsInB() ? -length/(hel.GetRho()*cslinv) : length/cslinv;
+   }
+   xx = hel.CalcXAt(phi);
+   return 1;
+}
+
+//_________________________________________________________________________
+// -----------------
+//  Step
+// -----------------
+//    moves hel to xx at phi, adding the multiple scattering and energy
+//    loss in the material of layer ml (if any) on the side isout, and updates F and Q as
+//      F = DF * F,  Q = DF * (Q + Qms) * DF^T.
+//    A helix moves its pivot the shorter way round the circle, see
+//    THelicalTrack::CalcMove(), so that a longer step goes in quarter
+//    turns.
+//
+void TKalExtrapolator::Step(      TVTrack                &hel,
+                            const TVMeasLayer            *ml,
+                                  Bool_t                  isout,
+                            const TVector3               &xx,
+                                  Double_t                phi)
+{
+   Double_t cslinv = TMath::Sqrt(1. + hel.GetTanLambda()*hel.GetTanLambda());
+   fLength += hel.IsInB() ? -hel.GetRho()*phi*cslinv : phi*cslinv;
+
+   if (ml && fCradlePtr->IsMSOn()) {
+      fQms.Zero();
+      ml->CalcQms(isout, hel, phi, fQms);
+      fQ += fQms;
+   }
+
+   Double_t phitot = phi;
+   if (hel.IsInB()) {
+      static const Double_t kMaxPhi = TMath::PiOver2();
+      while (TMath::Abs(phi) > kMaxPhi) {
+         Double_t fid = phi > 0. ? kMaxPhi : -kMaxPhi;
+         hel.PropagateTo(hel.CalcXAt(fid), fid, fF, &fQ);
+         phi -= fid;
+      }
+   }
+   hel.PropagateTo(xx, phi, fF, &fQ);
+
+   // a straight track has a fixed momentum, see TStraightTrack::SetMomentum()
+   if (ml && fCradlePtr->IsDEDXOn() && hel.IsInB()) {
+      hel.PutInto(fA);
+      fA(2,0) += ml->GetEnergyLoss(isout, hel, phitot);
+      hel.SetTo(fA, hel.GetPivot());
+   }
+}
@@ -0,0 +1,162 @@
+#ifndef TKALEXTRAPOLATOR_H
+#define TKALEXTRAPOLATOR_H
+//*************************************************************************
+//* ========================
+//*  TKalExtrapolator Class
+//* ========================
+//*
+//* (Description)
+//*   Extrapolation of a track state, without a site to go to, to
+//*     a surface       : the crossing with any TVSurface,
+//*     a point         : the pivot is moved to the point, so that the
+//*                       point of closest approach in the xy plane is
+//*                       at phi = 0 (drho and dz are the impact
+//*                       parameters); of the turns of a helix, that
+//*                       nearest the point in z, or
+//*     a path length   : the point at that 3-dim path length from the
+//*                       pivot, negative backwards.
+//*   The result is the state vector at the new pivot, its covariance
+//*   matrix, and the propagator matrix (Jacobian) of the whole step.
+//*   If a closed TKalDetCradle is given, multiple scattering and
+//*   energy loss in the cradle layers crossed on the way are added as
+//*   in TKalDetCradle::Transport(), starting from the layer of the
+//*   state. The layers are visited in index order between the turning
+//*   points of the distance from the z axis, outwards before a maximum
+//*   and inwards before a minimum, so that a looper is followed out to
+//*   its turn and back in as in TKalDetCradle::TransportLooper().
+//*   The track is a helix, or a straight line in zero field, in a
+//*   uniform field.
+//*
+//*   The extrapolator keeps its tracks and matrices, so that after
+//*   the first call it allocates nothing. The batch version takes the
+//*   states of many tracks in plain arrays and extrapolates them all
+//*   to the same target.
+//* (Requires)
+//*     TKalDetCradle, TKalTrackState, THelicalTrack, TStraightTrack
+//* (Provides)
+//*     class TKalExtrapolator
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Loopers walk the layers through their turning points.
+//*   2026/10/18  Point target on the turn nearest to it in z.
+//*
+//*************************************************************************
+
+#include "TObject.h"          // from ROOT
+#include "TVector3.h"         // from ROOT
+#include "TKalMatrix.h"       // from KalLib
+#include "KalTrackDim.h"      // from KalTrackLib
+#include "THelicalTrack.h"    // from GeomLib
+#include "TStraightTrack.h"   // from GeomLib
+#include "TVMeasLayer.h"      // from KalTrackLib
+
+class TKalDetCradle;
+class TKalTrackState;
+class TVSurface;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for track extrapolation
+//  ---------------------------------
+//
+class TKalExtrapolator : public TObject {
+public:
+   enum ETarget { kNone = 0, kSurface, kPoint, kPathLength };
+
+   TKalExtrapolator(const TKalDetCradle *cradle = 0, Int_t sdim = kSdim);
+   virtual ~TKalExtrapolator() {}
+
+   // Target of the following extrapolations. mode is that of
+   // TVSurface::CalcXingPointWith(): (-1,0,+1) = (bwd,closest,fwd).
+
+   void   SetTarget(const TVSurface &s, Int_t mode = 0);
+   void   SetTarget(const TVector3  &x);
+   void   SetTarget(      Double_t   length);
+
+   // Material effects of the cradle layers; on by default with a
+   // cradle, as switched on in the cradle
+
+   inline void   SetCradle       (const TKalDetCradle *c) { fCradlePtr = c; }
+   inline void   SwitchOnMaterial ()       { fIsMatOn = kTRUE;  }
+   inline void   SwitchOffMaterial()       { fIsMatOn = kFALSE; }
+   inline Bool_t IsMaterialOn     () const { return fIsMatOn;   }
+
+   // Extrapolate a state of a track site. Returns 1 on success, 0 if
+   // the track does not reach the target.
+
+   Int_t  Extrapolate(const TKalTrackState &a);
+
+   // Extrapolate a state given by its pivot x0[3], state vector
+   // sv[sdim] and covariance matrix cov[sdim*sdim] (row-major) in
+   // field b [T]; layer is the cradle layer it is on, < 0 if none.
+
+   Int_t  Extrapolate(      Int_t     layer,
+                            Double_t  b,
+                      const Double_t *x0,
+                      const Double_t *sv,
+                      const Double_t *cov);
+
+   // Batch version: track i has its pivot at x0[3i], its state at
+   // sv[sdim*i] and cov[sdim*sdim*i], and is on cradle layer layer[i]
+   // (no layers if layer = 0). The results go to the same places of
+   // x0out, svout, covout, and jac (if given) and the status to ok (if
+   // given). Returns the number of successful extrapolations.
+
+   Int_t  Extrapolate(      Int_t     n,
+                      const Int_t    *layer,
+                            Double_t  b,
+                      const Double_t *x0,
+                      const Double_t *sv,
+                      const Double_t *cov,
+                            Double_t *x0out,
+                            Double_t *svout,
+                            Double_t *covout,
+                            Double_t *jac = 0,
+                            Int_t    *ok  = 0);
+
+   // Results of the last successful extrapolation
+
+   inline const TVector3   & GetPivot     () const { return fX0;     }
+   inline const TKalMatrix & GetStateVec  () const { return fSv;     }
+   inline const TKalMatrix & GetCovMat    () const { return fC;      }
+   inline const TKalMatrix & GetJacobian  () const { return fF;      }
+   inline       Double_t     GetPathLength() const { return fLength; }
+   inline       Int_t        GetNlayers   () const { return fNlayers; }
+
+private:
+   Int_t  CalcTarget(const TVTrack &hel, Double_t length, Int_t mode,
+                     Double_t &phi, TVector3 &xx);
+   void   Step      (TVTrack &hel, const TVMeasLayer *ml, Bool_t isout,
+                     const TVector3 &xx, Double_t phi);
+
+private:
+   const TKalDetCradle *fCradlePtr;   // cradle for the materials
+   Bool_t               fIsMatOn;     // switch for the materials
+   Int_t                fSdim;        // state vector dimension
+
+   Int_t                fTarget;      // ETarget
+   const TVSurface     *fSurfPtr;     // kSurface: surface
+   Int_t                fMode;        // kSurface: mode
+   TVector3             fXt;          // kPoint: point
+   Double_t             fLt;          // kPathLength: path length
+
+   THelicalTrack        fHelix;       //! track in field
+   TStraightTrack       fLine;        //! track in zero field
+   THelicalTrack        fHelixWork;   //! copies for kPoint
+   TStraightTrack       fLineWork;    //!
+   TKalMatrix           fA;           //! helix parameters
+   TKalMatrix           fQms;         //! process noise of a step
+   TKalMatrix           fTmp;         //! scratch
+   TKalMatrix           fQ;           //! process noise
+
+   TVector3             fX0;          // pivot
+   TKalMatrix           fSv;          // state vector
+   TKalMatrix           fC;           // covariance matrix
+   TKalMatrix           fF;           // propagator matrix
+   Double_t             fLength;      // path length
+   Int_t                fNlayers;     // cradle layers crossed
+
+   ClassDef(TKalExtrapolator,1)  // track extrapolator
+};
+
+#endif
@@ -0,0 +1,363 @@
+//*************************************************************************
+//* ===================
+//*  TKalHitFile Class
+//* ===================
+//*
+//* (Description)
+//*   Columnar hit file for batch fitting jobs.
+//* (Requires)
+//*     TVTrackHit, TKalHitView, TKalDetCradle
+//* (Provides)
+//*     class TKalHitFile
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TKalHitFile.h"        // from KalTrackLib
+#include "TKalHitView.h"        // from KalTrackLib
+#include "TKalDetCradle.h"      // from KalTrackLib
+#include "TVTrackHit.h"         // from KalTrackLib
+#include "TVMeasLayer.h"        // from KalTrackLib
+#include "TMath.h"              // from ROOT
+
+#include <cstring>              // from STL
+#include <fstream>              // from STL
+#include <iostream>             // from STL
+#include <fcntl.h>              // from POSIX
+#include <sys/mman.h>           // from POSIX
+#include <sys/stat.h>           // from POSIX
+#include <unistd.h>             // from POSIX
+
+using namespace std;
+
+namespace {
+   // File header, followed by the columns, each aligned to kAlign bytes
+
+   struct Header {
+      UInt_t   fMagic;
+      UShort_t fVersion;
+      UShort_t fMdim;
+      Int_t    fNevents;
+      Int_t    fPad;
+      Long64_t fNhits;
+      Long64_t fColOffset[TKalHitFile::kNcolumns];
+   };
+
+   const UInt_t   kMagic   = 0x5449484b;  // "KHIT"
+   const UShort_t kVersion = 1;
+   const Long64_t kAlign   = 64;
+}
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for columnar hit files
+//  ---------------------------------
+//
+ClassImp(TKalHitFile)
+
+//-------------------------------------------------------
+// Ctor and Dtor
+//-------------------------------------------------------
+
+TKalHitFile::TKalHitFile(const Char_t *name, Option_t *opt)
+           : fIsOpen(kFALSE),
+             fIsWritable(kFALSE),
+             fMdim(kMdim),
+             fNevents(0),
+             fNhits(0),
+             fPrefetchDepth(4),
+             fPrefetched(-1),
+             fMapPtr(0),
+             fMapLen(0),
+             fCradlePtr(0)
+{
+   SetColumns();
+   if (name) Open(name, opt);
+}
+
+TKalHitFile::~TKalHitFile()
+{
+   Close();
+   for (UInt_t i=0; i<fViews.size(); i++) delete fViews[i];
+}
+
+//-------------------------------------------------------
+// Open, Close
+//-------------------------------------------------------
+
+Bool_t TKalHitFile::Open(const Char_t *name, Option_t *opt)
+{
+   Close();
+   fName = name;
+   TString option(opt);
+   option.ToUpper();
+
+   if (option == "RECREATE") {
+      fIsOpen     = kTRUE;
+      fIsWritable = kTRUE;
+      fMdim       = kMdim;
+      fEvent.assign(1, 0);
+      return kTRUE;
+   }
+
+   Int_t fd = open(name, O_RDONLY);
+   struct stat st;
+   if (fd < 0 || fstat(fd, &st) < 0 || st.st_size < Long64_t(sizeof(Header))) {
+      cerr << ">>>> Error!! TKalHitFile::Open >>>>>>>>>>>>>>>>>>>" << endl
+           << " Cannot open " << name << endl;
+      if (fd >= 0) close(fd);
+      return kFALSE;
+   }
+   void *p = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (p == MAP_FAILED) {
+      cerr << ">>>> Error!! TKalHitFile::Open >>>>>>>>>>>>>>>>>>>" << endl
+           << " Cannot map " << name << endl;
+      return kFALSE;
+   }
+   fMapPtr = static_cast<Char_t *>(p);
+   fMapLen = st.st_size;
+
+   const Header &h = *reinterpret_cast<const Header *>(fMapPtr);
+   Bool_t ok = h.fMagic == kMagic && h.fVersion <= kVersion;
+   if (ok) {
+      Long64_t n  = h.fNhits;
+      Long64_t sz[kNcolumns] = { (h.fNevents + 1) * Long64_t(sizeof(Long64_t)),
+                                 n * Long64_t(sizeof(Int_t)),
+                                 n * Long64_t(sizeof(Int_t)),
+                                 n * 2 * h.fMdim * Long64_t(sizeof(Double_t)),
+                                 n * h.fMdim * Long64_t(sizeof(Double_t)),
+                                 n * Long64_t(sizeof(Int_t)),
+                                 n * Long64_t(sizeof(Double_t)),
+                                 n * Long64_t(sizeof(Int_t)),
+                                 n * Long64_t(sizeof(Int_t)) };
+      for (Int_t c=0; c<kNcolumns; c++) {
+         fColOffset[c] = h.fColOffset[c];
+         if (fColOffset[c] % kAlign || fColOffset[c] + sz[c] > fMapLen) ok = kFALSE;
+      }
+   }
+   if (!ok) {
+      cerr << ">>>> Error!! TKalHitFile::Open >>>>>>>>>>>>>>>>>>>" << endl
+           << " " << name << " is not a valid hit file" << endl;
+      Close();
+      return kFALSE;
+   }
+
+   fMdim    = h.fMdim;
+   fNevents = h.fNevents;
+   fNhits   = h.fNhits;
+   fIsOpen  = kTRUE;
+   SetColumns();
+   madvise(fMapPtr, fMapLen, MADV_SEQUENTIAL);
+   return kTRUE;
+}
+
+void TKalHitFile::Close(Option_t *)
+{
+   if (fIsOpen && fIsWritable) WriteColumns();
+   if (fMapPtr) munmap(fMapPtr, fMapLen);
+
+   fMapPtr     = 0;
+   fMapLen     = 0;
+   fIsOpen     = kFALSE;
+   fIsWritable = kFALSE;
+   fNevents    = 0;
+   fNhits      = 0;
+   fPrefetched = -1;
+   SetColumns();
+
+   fEvent  .clear();
+   fLayer  .clear();
+   fDim    .clear();
+   fMeas   .clear();
+   fDhDt0  .clear();
+   fFlag   .clear();
+   fBfield .clear();
+   fTrackID.clear();
+   fCandID .clear();
+}
+
+void TKalHitFile::SetColumns()
+{
+   if (!fMapPtr) {
+      fEventPtr   = 0;
+      fLayerPtr   = fDimPtr = fFlagPtr = fTrackIDPtr = fCandIDPtr = 0;
+      fMeasPtr    = fDhDt0Ptr = fBfieldPtr = 0;
+      for (Int_t c=0; c<kNcolumns; c++) fColOffset[c] = 0;
+      return;
+   }
+   fEventPtr   = reinterpret_cast<const Long64_t *>(fMapPtr + fColOffset[kEvent  ]);
+   fLayerPtr   = reinterpret_cast<const Int_t    *>(fMapPtr + fColOffset[kLayer  ]);
+   fDimPtr     = reinterpret_cast<const Int_t    *>(fMapPtr + fColOffset[kDim    ]);
+   fMeasPtr    = reinterpret_cast<const Double_t *>(fMapPtr + fColOffset[kMeas   ]);
+   fDhDt0Ptr   = reinterpret_cast<const Double_t *>(fMapPtr + fColOffset[kDhDt0  ]);
+   fFlagPtr    = reinterpret_cast<const Int_t    *>(fMapPtr + fColOffset[kFlag   ]);
+   fBfieldPtr  = reinterpret_cast<const Double_t *>(fMapPtr + fColOffset[kBfield ]);
+   fTrackIDPtr = reinterpret_cast<const Int_t    *>(fMapPtr + fColOffset[kTrackID]);
+   fCandIDPtr  = reinterpret_cast<const Int_t    *>(fMapPtr + fColOffset[kCandID ]);
+}
+
+//-------------------------------------------------------
+// Writing
+//-------------------------------------------------------
+
+void TKalHitFile::AddHit(const TVTrackHit &ht,
+                         const Double_t   *dhdt0,
+                               Int_t       flag,
+                               Int_t       trackid,
+                               Int_t       candid)
+{
+   if (!fIsWritable) {
+      cerr << ">>>> Error!! TKalHitFile::AddHit >>>>>>>>>>>>>>>>>" << endl
+           << " File not opened for writing." << endl;
+      return;
+   }
+   Int_t m = ht.GetDimension();
+   fLayer.push_back(ht.GetMeasLayer().GetIndex());
+   fDim  .push_back(m);
+   for (Int_t i=0; i<fMdim; i++) {
+      fMeas .push_back(i < m ? ht(i,0) : 0.);
+      fMeas .push_back(i < m ? ht(i,1) : 0.);
+      fDhDt0.push_back(i < m && dhdt0 ? dhdt0[i] : 0.);
+   }
+   fFlag   .push_back(flag);
+   fBfield .push_back(ht.GetBfield());
+   fTrackID.push_back(trackid);
+   fCandID .push_back(candid);
+}
+
+void TKalHitFile::EndEvent()
+{
+   if (fIsWritable) fEvent.push_back(fLayer.size());
+}
+
+void TKalHitFile::WriteColumns()
+{
+   if (fEvent.back() != Long64_t(fLayer.size())) EndEvent();
+
+   const Char_t *data[kNcolumns] = {
+      reinterpret_cast<const Char_t *>(fEvent  .data()),
+      reinterpret_cast<const Char_t *>(fLayer  .data()),
+      reinterpret_cast<const Char_t *>(fDim    .data()),
+      reinterpret_cast<const Char_t *>(fMeas   .data()),
+      reinterpret_cast<const Char_t *>(fDhDt0  .data()),
+      reinterpret_cast<const Char_t *>(fFlag   .data()),
+      reinterpret_cast<const Char_t *>(fBfield .data()),
+      reinterpret_cast<const Char_t *>(fTrackID.data()),
+      reinterpret_cast<const Char_t *>(fCandID .data()) };
+   Long64_t size[kNcolumns] = {
+      Long64_t(fEvent  .size() * sizeof(Long64_t)),
+      Long64_t(fLayer  .size() * sizeof(Int_t)),
+      Long64_t(fDim    .size() * sizeof(Int_t)),
+      Long64_t(fMeas   .size() * sizeof(Double_t)),
+      Long64_t(fDhDt0  .size() * sizeof(Double_t)),
+      Long64_t(fFlag   .size() * sizeof(Int_t)),
+      Long64_t(fBfield .size() * sizeof(Double_t)),
+      Long64_t(fTrackID.size() * sizeof(Int_t)),
+      Long64_t(fCandID .size() * sizeof(Int_t)) };
+
+   Header h;
+   memset(&h, 0, sizeof(Header));
+   h.fMagic   = kMagic;
+   h.fVersion = kVersion;
+   h.fMdim    = fMdim;
+   h.fNevents = fEvent.size() - 1;
+   h.fNhits   = fLayer.size();
+   Long64_t pos = sizeof(Header);
+   for (Int_t c=0; c<kNcolumns; c++) {
+      pos = (pos + kAlign - 1) / kAlign * kAlign;
+      h.fColOffset[c] = pos;
+      pos += size[c];
+   }
+
+   ofstream out(fName.Data(), ios::binary | ios::trunc);
+   out.write(reinterpret_cast<const Char_t *>(&h), sizeof(Header));
+   Long64_t cur = sizeof(Header);
+   static const Char_t kZeros[kAlign] = {0};
+   for (Int_t c=0; c<kNcolumns; c++) {
+      out.write(kZeros, h.fColOffset[c] - cur);
+      out.write(data[c], size[c]);
+      cur = h.fColOffset[c] + size[c];
+   }
+   if (!out) {
+      cerr << ">>>> Error!! TKalHitFile::WriteColumns >>>>>>>>>>>" << endl
+           << " Write to " << fName << " failed." << endl;
+   }
+}
+
+//-------------------------------------------------------
+// Reading
+//-------------------------------------------------------
+
+Int_t TKalHitFile::GetEvent(Int_t ev, const TKalDetCradle &det, TObjArray &hits)
+{
+   hits.Clear();
+   if (!fMapPtr || ev < 0 || ev >= fNevents) return 0;
+
+   // read ahead the events not yet asked for
+
+   if (ev > fPrefetched || ev < fPrefetched - fPrefetchDepth) fPrefetched = ev;
+   Int_t last = TMath::Min(ev + fPrefetchDepth, fNevents - 1);
+   for (Int_t i=fPrefetched+1; i<=last; i++) Prefetch(i);
+   fPrefetched = TMath::Max(fPrefetched, last);
+
+   Long64_t first = GetFirstHit(ev);
+   Int_t    n     = GetNhits(ev);
+   if (Int_t(fViews.size()) < n) fViews.resize(n, 0);
+
+   // layers by index, looked up once per cradle
+
+   Int_t nlayers = det.GetEntriesFast();
+   if (fCradlePtr != &det || Int_t(fLayers.size()) != nlayers) {
+      fCradlePtr = &det;
+      fLayers.assign(nlayers, 0);
+      for (Int_t i=0; i<nlayers; i++) {
+         TVMeasLayer *mlp = dynamic_cast<TVMeasLayer *>(det.At(i));
+         if (mlp && mlp->GetIndex() == i) fLayers[i] = mlp;
+      }
+   }
+
+   for (Int_t i=0; i<n; i++) {
+      Long64_t     row   = first + i;
+      Int_t        index = GetLayer(row);
+      TVMeasLayer *mlp   = index >= 0 && index < nlayers ? fLayers[index] : 0;
+      if (!mlp) {
+         cerr << ">>>> Error!! TKalHitFile::GetEvent >>>>>>>>>>>>>>>" << endl
+              << " Hit " << row << ": no layer " << index << endl;
+         continue;
+      }
+      Int_t m = GetDimension(row);
+      if (!fViews[i] || fViews[i]->GetDimension() != m) {
+         delete fViews[i];
+         fViews[i] = new TKalHitView(m);
+      }
+      fViews[i]->Set(*this, row, *mlp);
+      hits.Add(fViews[i]);
+   }
+   return hits.GetEntriesFast();
+}
+
+void TKalHitFile::Prefetch(Int_t ev) const
+{
+   if (!fMapPtr || ev < 0 || ev >= fNevents) return;
+
+   static const Long64_t kPage = sysconf(_SC_PAGESIZE);
+   Long64_t first = GetFirstHit(ev);
+   Long64_t n     = GetNhits(ev);
+   Long64_t width[kNcolumns] = { 0,
+                                 sizeof(Int_t),
+                                 sizeof(Int_t),
+                                 2 * fMdim * Long64_t(sizeof(Double_t)),
+                                 fMdim * Long64_t(sizeof(Double_t)),
+                                 sizeof(Int_t),
+                                 sizeof(Double_t),
+                                 sizeof(Int_t),
+                                 sizeof(Int_t) };
+   for (Int_t c=kLayer; c<kNcolumns; c++) {
+      Long64_t beg = fColOffset[c] + first * width[c];
+      Long64_t end = beg + n * width[c];
+      beg = beg / kPage * kPage;
+      madvise(fMapPtr + beg, end - beg, MADV_WILLNEED);
+   }
+}
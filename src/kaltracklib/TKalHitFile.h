@@ -0,0 +1,149 @@
+#ifndef TKALHITFILE_H
+#define TKALHITFILE_H
+//*************************************************************************
+//* ===================
+//*  TKalHitFile Class
+//* ===================
+//*
+//* (Description)
+//*   Columnar hit file for batch fitting jobs.
+//*   Hits of all events are stored column by column in contiguous
+//*   arrays: layer index, dimension, measurement vector and errors
+//*   as (x, dx) pairs, d(measurement)/d(t0), a detector specific flag
+//*   (e.g. the TPC side), B field, track id and candidate id, plus the
+//*   first hit of every event. A file opened for reading is mapped
+//*   into memory and the columns are accessed in place. GetEvent()
+//*   turns the hits of an event into reused TKalHitView objects and
+//*   asks the system to read ahead the pages of the following events.
+//* (Requires)
+//*     TVTrackHit, TKalHitView, TKalDetCradle
+//* (Provides)
+//*     class TKalHitFile
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include "TObjArray.h"      // from ROOT
+#include "TString.h"        // from ROOT
+#include "KalTrackDim.h"    // from KalTrackLib
+#include <vector>           // from STL
+
+class TVTrackHit;
+class TVMeasLayer;
+class TKalHitView;
+class TKalDetCradle;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for columnar hit files
+//  ---------------------------------
+//
+class TKalHitFile : public TObject {
+public:
+   enum EColumn { kEvent = 0,   // Long64_t [nevents+1]: first hit
+                  kLayer,       // Int_t    [nhits]    : layer index
+                  kDim,         // Int_t    [nhits]    : dimension
+                  kMeas,        // Double_t [nhits*2*mdim]: (x, dx) pairs
+                  kDhDt0,       // Double_t [nhits*mdim]  : d(x)/d(t0)
+                  kFlag,        // Int_t    [nhits]    : detector flag
+                  kBfield,      // Double_t [nhits]    : B field
+                  kTrackID,     // Int_t    [nhits]    : track id
+                  kCandID,      // Int_t    [nhits]    : candidate id
+                  kNcolumns };
+
+   // opt = "READ" (mapped) or "RECREATE"
+
+   TKalHitFile(const Char_t *name = 0, Option_t *opt = "READ");
+   virtual ~TKalHitFile();
+
+   Bool_t Open (const Char_t *name, Option_t *opt = "READ");
+   void   Close(Option_t *opt = "");
+
+   inline Bool_t IsOpen    () const { return fIsOpen;     }
+   inline Bool_t IsWritable() const { return fIsWritable; }
+
+   // Writing: AddHit() for all hits of an event, then EndEvent().
+   // The columns are written out at Close().
+
+   void   AddHit  (const TVTrackHit &ht,
+                   const Double_t   *dhdt0   = 0,
+                         Int_t       flag    = 0,
+                         Int_t       trackid = -1,
+                         Int_t       candid  = -1);
+   void   EndEvent();
+
+   // Reading: columns of hit i
+
+   inline Int_t    GetNevents  () const { return fNevents; }
+   inline Long64_t GetNhits    () const { return fNhits;   }
+   inline Int_t    GetMdim     () const { return fMdim;    }
+   inline Long64_t GetFirstHit (Int_t ev) const { return fEventPtr[ev];                  }
+   inline Int_t    GetNhits    (Int_t ev) const { return fEventPtr[ev+1] - fEventPtr[ev]; }
+
+   inline Int_t    GetLayer    (Long64_t i) const { return fLayerPtr  [i];               }
+   inline Int_t    GetDimension(Long64_t i) const { return fDimPtr    [i];               }
+   inline const Double_t *GetMeas (Long64_t i) const { return fMeasPtr  + i * 2 * fMdim; }
+   inline const Double_t *GetDhDt0(Long64_t i) const { return fDhDt0Ptr + i * fMdim;     }
+   inline Int_t    GetFlag     (Long64_t i) const { return fFlagPtr   [i];               }
+   inline Double_t GetBfield   (Long64_t i) const { return fBfieldPtr [i];               }
+   inline Int_t    GetTrackID  (Long64_t i) const { return fTrackIDPtr[i];               }
+   inline Int_t    GetCandID   (Long64_t i) const { return fCandIDPtr [i];               }
+
+   // Fill hits with views on the hits of event ev, whose layers are
+   // taken from det by index. The views are owned by this file and
+   // reused by the next call: clear hits, do not delete them.
+   // Events ev+1 .. ev+depth are prefetched. Returns the number of hits.
+
+   Int_t  GetEvent(Int_t ev, const TKalDetCradle &det, TObjArray &hits);
+   void   Prefetch(Int_t ev) const;
+
+   inline void SetPrefetchDepth(Int_t n) { fPrefetchDepth = n; }
+
+private:
+   void   SetColumns();
+   void   WriteColumns();
+
+private:
+   TString                  fName;          // file name
+   Bool_t                   fIsOpen;        // true if open
+   Bool_t                   fIsWritable;    // true if opened for writing
+   Int_t                    fMdim;          // max. hit dimension
+   Int_t                    fNevents;       // number of events
+   Long64_t                 fNhits;         // number of hits
+   Int_t                    fPrefetchDepth; // events to read ahead
+   Int_t                    fPrefetched;    // last event read ahead
+
+   Char_t                  *fMapPtr;        //! mapped file
+   Long64_t                 fMapLen;        //  mapped length
+   Long64_t                 fColOffset[kNcolumns]; // column offsets in file
+
+   const Long64_t          *fEventPtr;      //! columns
+   const Int_t             *fLayerPtr;      //!
+   const Int_t             *fDimPtr;        //!
+   const Double_t          *fMeasPtr;       //!
+   const Double_t          *fDhDt0Ptr;      //!
+   const Int_t             *fFlagPtr;       //!
+   const Double_t          *fBfieldPtr;     //!
+   const Int_t             *fTrackIDPtr;    //!
+   const Int_t             *fCandIDPtr;     //!
+
+   std::vector<Long64_t>    fEvent;         //! columns being written
+   std::vector<Int_t>       fLayer;         //!
+   std::vector<Int_t>       fDim;           //!
+   std::vector<Double_t>    fMeas;          //!
+   std::vector<Double_t>    fDhDt0;         //!
+   std::vector<Int_t>       fFlag;          //!
+   std::vector<Double_t>    fBfield;        //!
+   std::vector<Int_t>       fTrackID;       //!
+   std::vector<Int_t>       fCandID;        //!
+
+   std::vector<TKalHitView *> fViews;       //! reused hit views
+   const TKalDetCradle       *fCradlePtr;   //! cradle of fLayers
+   std::vector<TVMeasLayer *> fLayers;      //! layers by index
+
+   ClassDef(TKalHitFile,1)  // columnar hit file
+};
+
+#endif
@@ -0,0 +1,387 @@
+//*************************************************************************
+//* =====================
+//*  TKalHitStore Class
+//* =====================
+//*
+//* (Description)
+//*   Per-layer binned hit container for fast compatible-hit lookup.
+//* (Requires)
+//*     TVTrackHit, TVMeasLayer, TKalTrackState
+//* (Provides)
+//*     class TKalHitStore
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  1-dim layers are tested hit by hit; mixed-dimension
+//*               layers are refused.
+//*
+//*************************************************************************
+
+#include "TKalHitStore.h"     // from KalTrackLib
+#include "TKalTrackState.h"   // from KalTrackLib
+#include "TVTrackHit.h"       // from KalTrackLib
+#include "TVMeasLayer.h"      // from KalTrackLib
+#include "TVSurface.h"        // from GeomLib
+#include "TPlane.h"           // from GeomLib
+#include "TBField.h"          // from Bfield
+#include "TMath.h"            // from ROOT
+
+#include <iostream>           // from STL
+#include <memory>             // from STL
+
+using namespace std;
+
+//_________________________________________________________________________
+//  ----------------------------------
+//   Class for binned hit storage
+//  ----------------------------------
+//
+ClassImp(TKalHitStore)
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Ctors and Dtor
+//  ----------------------------------
+
+TKalHitStore::TKalHitStore(Int_t nubins, Int_t nvbins)
+             : fNubins(nubins > 0 ? nubins : 1),
+               fNvbins(nvbins > 0 ? nvbins : 1),
+               fIsBuilt(kFALSE),
+               fLayers()
+{
+}
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Implementation of public methods
+//  ----------------------------------
+
+void TKalHitStore::Add(const TVTrackHit &hit)
+{
+   const TVMeasLayer &ml  = hit.GetMeasLayer();
+   Int_t              idx = ml.GetIndex();
+   if (idx < 0) {
+      cerr << ">>>> Error!! TKalHitStore::Add >>>>>>>>>>>>>>>>>" << endl
+           << " Negative layer index. Close the cradle first.    " << endl;
+      return;
+   }
+   if (idx >= GetNlayers()) {
+      Layer empty;
+      empty.fLayerPtr = 0;
+      fLayers.resize(idx+1, empty);
+   }
+
+   Layer &lyr = fLayers[idx];
+   if (!lyr.fLayerPtr) InitLayer(lyr, hit);
+
+   // The grid type is fixed by the first hit on the layer. 1-dim and
+   // n-dim hits are not binned in the same coordinates, so a layer
+   // mixing both is refused.
+
+   if ((lyr.fType == kMeas1D) != (hit.GetDimension() < 2)) {
+      cerr << ">>>> Error!! TKalHitStore::Add >>>>>>>>>>>>>>>>>" << endl
+           << " Hit dimension " << hit.GetDimension()
+           << " differs from that of layer " << idx << "." << endl
+           << " Mixed-dimension layers are not supported. Hit ignored." << endl;
+      return;
+   }
+
+   Entry e;
+   e.fHitPtr = &hit;
+   if (lyr.fType == kMeas1D) {
+      // A 1-dim hit carries no 3-dim position; keep its measured
+      // coordinate for the per-hit test in FindCompatibleHits().
+      e.fU  = hit.GetX (0);
+      e.fDu = hit.GetDX(0);
+      e.fV  = 0.;
+      e.fDv = 0.;
+   } else {
+      Double_t dx = 0.;
+      for (Int_t i=0; i<hit.GetDimension(); i++) {
+         dx = TMath::Max(dx, hit.GetDX(i));
+      }
+      TVector3 xv = ml.HitToXv(hit);
+      CalcUV(lyr, xv, e.fU, e.fV);
+      e.fDu = dx;
+      e.fDv = dx;
+      if (lyr.fType == kPhiZ) {
+         Double_t r = xv.Perp();
+         e.fDu = r > 0. ? dx/r : TMath::Pi();
+      }
+   }
+   lyr.fEntries.push_back(e);
+
+   fIsBuilt = kFALSE;
+}
+
+void TKalHitStore::Add(const TObjArray &hits)
+{
+   TIter next(&hits);
+   TVTrackHit *hitp;
+   while ((hitp = dynamic_cast<TVTrackHit *>(next()))) Add(*hitp);
+}
+
+void TKalHitStore::Build()
+{
+   // Sort the hits of each layer into its grid with a counting sort,
+   // so that the hits of a cell are contiguous in fEntries.
+
+   vector<Entry> sorted;
+   vector<Int_t> cell;
+
+   for (UInt_t l=0; l<fLayers.size(); l++) {
+      Layer &lyr = fLayers[l];
+      Int_t  n   = lyr.fEntries.size();
+      if (!n) {
+         lyr.fNu = lyr.fNv = 0;
+         lyr.fCellStart.assign(1, 0);
+         continue;
+      }
+
+      Double_t umin = lyr.fEntries[0].fU, umax = umin;
+      Double_t vmin = lyr.fEntries[0].fV, vmax = vmin;
+      lyr.fDuMax = lyr.fDvMax = 0.;
+      for (Int_t i=0; i<n; i++) {
+         const Entry &e = lyr.fEntries[i];
+         umin = TMath::Min(umin, e.fU); umax = TMath::Max(umax, e.fU);
+         vmin = TMath::Min(vmin, e.fV); vmax = TMath::Max(vmax, e.fV);
+         lyr.fDuMax = TMath::Max(lyr.fDuMax, e.fDu);
+         lyr.fDvMax = TMath::Max(lyr.fDvMax, e.fDv);
+      }
+      if (lyr.fType == kPhiZ) {   // phi bins always cover the full circle
+         umin = -TMath::Pi();
+         umax =  TMath::Pi();
+      }
+
+      Bool_t binned = lyr.fType != kMeas1D;   // 1-dim layers are scanned
+      lyr.fNu   = umax > umin && binned ? TMath::Min(fNubins, n) : 1;
+      lyr.fNv   = vmax > vmin && binned ? TMath::Min(fNvbins, n) : 1;
+      lyr.fUmin = umin;
+      lyr.fVmin = vmin;
+      lyr.fUwid = umax > umin ? (umax - umin)/lyr.fNu : 1.;
+      lyr.fVwid = vmax > vmin ? (vmax - vmin)/lyr.fNv : 1.;
+
+      Int_t ncells = lyr.fNu * lyr.fNv;
+      lyr.fCellStart.assign(ncells+1, 0);
+      cell.resize(n);
+      for (Int_t i=0; i<n; i++) {
+         const Entry &e = lyr.fEntries[i];
+         Int_t iu = TMath::Min(Int_t((e.fU - umin)/lyr.fUwid), lyr.fNu-1);
+         Int_t iv = TMath::Min(Int_t((e.fV - vmin)/lyr.fVwid), lyr.fNv-1);
+         cell[i] = iu * lyr.fNv + iv;
+         lyr.fCellStart[cell[i]+1]++;
+      }
+      for (Int_t c=0; c<ncells; c++) lyr.fCellStart[c+1] += lyr.fCellStart[c];
+
+      sorted.resize(n);
+      vector<Int_t> fill(lyr.fCellStart.begin(), lyr.fCellStart.end()-1);
+      for (Int_t i=0; i<n; i++) sorted[fill[cell[i]]++] = lyr.fEntries[i];
+      lyr.fEntries.swap(sorted);
+   }
+
+   fIsBuilt = kTRUE;
+}
+
+void TKalHitStore::Clear(Option_t *)
+{
+   // Keep the layer slots and their capacity for the next event.
+   for (UInt_t l=0; l<fLayers.size(); l++) {
+      fLayers[l].fEntries.clear();
+      fLayers[l].fCellStart.assign(1, 0);
+      fLayers[l].fNu = fLayers[l].fNv = 0;
+   }
+   fIsBuilt = kFALSE;
+}
+
+Int_t TKalHitStore::GetNhits(Int_t index) const
+{
+   if (index < 0 || index >= GetNlayers()) return 0;
+   return fLayers[index].fEntries.size();
+}
+
+Int_t TKalHitStore::FindCompatibleHits(const TKalTrackState                 &a,
+                                       const TVMeasLayer                    &ml,
+                                             Double_t                        nsigma,
+                                             std::vector<const TVTrackHit *> &hits) const
+{
+   if (!fIsBuilt) {
+      cerr << ">>>> Error!! TKalHitStore::FindCompatibleHits >>>>" << endl
+           << " Build() must be called before querying.          " << endl;
+      return 0;
+   }
+
+   Int_t idx = ml.GetIndex();
+   if (idx < 0 || idx >= GetNlayers() || fLayers[idx].fEntries.empty()) return 0;
+   const Layer &lyr = fLayers[idx];
+
+   // ---------------------------------------------
+   // Predicted crossing point and its derivatives
+   // ---------------------------------------------
+
+   std::unique_ptr<TVTrack> hel(&a.CreateTrack());
+   const TVSurface &ms = dynamic_cast<const TVSurface &>(ml);
+
+   TVector3 xx;
+   Double_t phi = 0.;
+   Int_t    ok;
+   if (!TBField::IsUsingUniformBfield()) ok = ms.CalcXingPointWith(*hel,xx,phi,1.e-5);
+   else                                  ok = ms.CalcXingPointWith(*hel,xx,phi);
+   if (!ok) return 0;
+
+   TKalMatrix dsdx   = ms.CalcDSDx(xx);
+   TKalMatrix dxda   = hel->CalcDxDa(phi);
+   TKalMatrix dxdphi = hel->CalcDxDphi(phi);
+   TKalMatrix dphida = dsdx * dxda;
+   Double_t   denom  = -(dsdx * dxdphi)(0,0);
+   dphida *= 1/denom;
+   TKalMatrix dxphiada = dxdphi * dphida + dxda;   // (@x(phi(a),a)/@a)
+
+   // ---------------------------------------------
+   // Window half-widths in grid coordinates
+   // ---------------------------------------------
+
+   const TKalMatrix &C  = a.GetCovMat();
+
+   if (lyr.fType == kMeas1D) {
+      // The expected measurement and H = (@h/@a) may depend on the hit
+      // itself (drift sign, wire, stereo angle, ...), so there is no
+      // hit-independent grid coordinate: compute them per candidate.
+      Int_t nfound = 0;
+      Int_t sdim   = a.GetNrows();
+      TKalMatrix H(1, sdim);
+      for (UInt_t i=0; i<lyr.fEntries.size(); i++) {
+         const Entry      &e  = lyr.fEntries[i];
+         const TVTrackHit &ht = *e.fHitPtr;
+         ml.CalcDhDa(ht, xx, dxphiada, H);
+         Double_t ddu = e.fU - ml.XvToMv(ht, xx)(0,0);
+         Double_t su2 = 0.;
+         for (Int_t k=0; k<sdim; k++) {
+            for (Int_t l=0; l<sdim; l++) su2 += H(0,k) * C(k,l) * H(0,l);
+         }
+         if (ddu*ddu > nsigma*nsigma*(su2 + e.fDu*e.fDu)) continue;
+         hits.push_back(e.fHitPtr);
+         nfound++;
+      }
+      return nfound;
+   }
+
+   Double_t u0, v0;
+   Double_t su2 = 0., sv2 = 0.;
+
+   CalcUV(lyr, xx, u0, v0);
+
+   TVector3 gu, gv;   // (@u/@x), (@v/@x)
+   if (lyr.fType == kPhiZ) {
+      Double_t r2 = xx.Perp2();
+      if (r2 <= 0.) r2 = 1.;
+      gu.SetXYZ(-xx.Y()/r2, xx.X()/r2, 0.);
+      gv.SetXYZ(0., 0., 1.);
+   } else {
+      gu = lyr.fEu;
+      gv = lyr.fEv;
+   }
+
+   const Int_t np = 5;
+   Double_t dudA[np], dvdA[np];
+   for (Int_t j=0; j<np; j++) {
+      dudA[j] = gu.X()*dxphiada(0,j) + gu.Y()*dxphiada(1,j) + gu.Z()*dxphiada(2,j);
+      dvdA[j] = gv.X()*dxphiada(0,j) + gv.Y()*dxphiada(1,j) + gv.Z()*dxphiada(2,j);
+   }
+   for (Int_t i=0; i<np; i++) {
+      for (Int_t j=0; j<np; j++) {
+         su2 += dudA[i] * C(i,j) * dudA[j];
+         sv2 += dvdA[i] * C(i,j) * dvdA[j];
+      }
+   }
+
+   Double_t du = nsigma * TMath::Sqrt(su2 + lyr.fDuMax*lyr.fDuMax);
+   Double_t dv = nsigma * TMath::Sqrt(sv2 + lyr.fDvMax*lyr.fDvMax);
+
+   // ---------------------------------------------
+   // Scan the cells inside the window
+   // ---------------------------------------------
+
+   Int_t iulo = TMath::FloorNint((u0 - du - lyr.fUmin)/lyr.fUwid);
+   Int_t iuhi = TMath::FloorNint((u0 + du - lyr.fUmin)/lyr.fUwid);
+   Int_t ivlo = TMath::Max(TMath::FloorNint((v0 - dv - lyr.fVmin)/lyr.fVwid), 0);
+   Int_t ivhi = TMath::Min(TMath::FloorNint((v0 + dv - lyr.fVmin)/lyr.fVwid), lyr.fNv-1);
+   if (lyr.fType == kPhiZ) {
+      if (iuhi - iulo >= lyr.fNu) { iulo = 0; iuhi = lyr.fNu-1; }
+   } else {
+      iulo = TMath::Max(iulo, 0);
+      iuhi = TMath::Min(iuhi, lyr.fNu-1);
+   }
+   if (iulo > iuhi || ivlo > ivhi) return 0;
+
+   Int_t nfound = 0;
+   for (Int_t iu=iulo; iu<=iuhi; iu++) {
+      Int_t ju = iu % lyr.fNu;   // phi wraps around
+      if (ju < 0) ju += lyr.fNu;
+      Int_t first = lyr.fCellStart[ju*lyr.fNv + ivlo];
+      Int_t last  = lyr.fCellStart[ju*lyr.fNv + ivhi + 1];
+      for (Int_t i=first; i<last; i++) {
+         const Entry &e = lyr.fEntries[i];
+         Double_t ddu = e.fU - u0;
+         if (lyr.fType == kPhiZ) {
+            if      (ddu >  TMath::Pi()) ddu -= TMath::TwoPi();
+            else if (ddu < -TMath::Pi()) ddu += TMath::TwoPi();
+         }
+         Double_t ddv = e.fV - v0;
+         if (ddu*ddu > nsigma*nsigma*(su2 + e.fDu*e.fDu)) continue;
+         if (ddv*ddv > nsigma*nsigma*(sv2 + e.fDv*e.fDv)) continue;
+         hits.push_back(e.fHitPtr);
+         nfound++;
+      }
+   }
+   return nfound;
+}
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Private methods
+//  ----------------------------------
+
+void TKalHitStore::InitLayer(Layer &lyr, const TVTrackHit &hit) const
+{
+   const TVMeasLayer &ml = hit.GetMeasLayer();
+   lyr.fLayerPtr = &ml;
+   lyr.fType     = kPhiZ;
+   lyr.fNu       = lyr.fNv = 0;
+   lyr.fUmin     = lyr.fVmin = 0.;
+   lyr.fUwid     = lyr.fVwid = 1.;
+   lyr.fDuMax    = lyr.fDvMax = 0.;
+   lyr.fCellStart.assign(1, 0);
+
+   // Flat planes use local (u, v) axes spanning the plane; everything
+   // else is binned in global (phi, z).
+
+   if (hit.GetDimension() < 2) {
+      lyr.fType = kMeas1D;
+      return;
+   }
+
+   const TPlane *pp = dynamic_cast<const TPlane *>(&ml);
+   if (pp) {
+      TVector3 n = pp->GetNormal().Unit();
+      TVector3 e = TMath::Abs(n.Z()) < 0.9 ? TVector3(0.,0.,1.)
+                                           : TVector3(1.,0.,0.);
+      lyr.fType = kUV;
+      lyr.fXc   = pp->GetXc();
+      lyr.fEu   = e.Cross(n).Unit();
+      lyr.fEv   = n.Cross(lyr.fEu);
+   }
+}
+
+void TKalHitStore::CalcUV(const Layer    &lyr,
+                          const TVector3 &xv,
+                                Double_t &u,
+                                Double_t &v) const
+{
+   if (lyr.fType == kPhiZ) {
+      u = xv.Phi();
+      v = xv.Z();
+   } else {
+      TVector3 dx = xv - lyr.fXc;
+      u = dx.Dot(lyr.fEu);
+      v = dx.Dot(lyr.fEv);
+   }
+}
@@ -0,0 +1,110 @@
+#ifndef TKALHITSTORE_H
+#define TKALHITSTORE_H
+//*************************************************************************
+//* =====================
+//*  TKalHitStore Class
+//* =====================
+//*
+//* (Description)
+//*   Per-layer binned hit container for fast compatible-hit lookup.
+//*   Hits are grouped by TVMeasLayer::GetIndex() and sorted into a
+//*   (phi, z) grid, or a local (u, v) grid for flat planes, once per
+//*   event. A predicted track state at a layer then only visits the
+//*   grid cells inside its n-sigma window instead of all hits.
+//*   Layers with 1-dim hits have no hit-independent grid coordinate
+//*   and are scanned hit by hit. All hits on a layer must have the
+//*   same dimension (1-dim or not).
+//* (Requires)
+//*     TVTrackHit, TVMeasLayer, TKalTrackState
+//* (Provides)
+//*     class TKalHitStore
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  1-dim layers are tested hit by hit; mixed-dimension
+//*               layers are refused.
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include "TObjArray.h"      // from ROOT
+#include "TVector3.h"       // from ROOT
+#include <vector>           // from STL
+
+class TVTrackHit;
+class TVMeasLayer;
+class TKalTrackState;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for binned hit storage
+//  ---------------------------------
+//
+class TKalHitStore : public TObject {
+public:
+   TKalHitStore(Int_t nubins = 64, Int_t nvbins = 32);
+   virtual ~TKalHitStore() {}
+
+   // Filling: Add() hits, then Build() once per event.
+   // Layer indices are those set by TKalDetCradle::Close().
+
+   void   Add  (const TVTrackHit &hit);
+   void   Add  (const TObjArray  &hits);
+   void   Build();
+   void   Clear(Option_t *opt = "");
+
+   // Query: hits on layer ml whose position is within nsigma of the
+   // position predicted by state a, using a's covariance matrix.
+   // Returns the number of hits appended to hits.
+
+   Int_t  FindCompatibleHits(const TKalTrackState                 &a,
+                             const TVMeasLayer                    &ml,
+                                   Double_t                        nsigma,
+                                   std::vector<const TVTrackHit *> &hits) const;
+
+   Int_t  GetNhits (Int_t index) const;
+   inline Int_t  GetNlayers() const { return fLayers.size(); }
+   inline Bool_t IsBuilt   () const { return fIsBuilt;       }
+
+private:
+   enum EGridType { kPhiZ = 0, kUV, kMeas1D };
+
+   struct Entry {
+      Double_t          fU;       // 1st grid coordinate (phi, u or m)
+      Double_t          fV;       // 2nd grid coordinate (z or v)
+      Double_t          fDu;      // hit error along u
+      Double_t          fDv;      // hit error along v
+      const TVTrackHit *fHitPtr;  // pointer to hit
+   };
+
+   struct Layer {
+      const TVMeasLayer  *fLayerPtr;   // measurement layer
+      Int_t               fType;       // grid type
+      TVector3            fXc;         // origin   (kUV only)
+      TVector3            fEu;         // u axis   (kUV only)
+      TVector3            fEv;         // v axis   (kUV only)
+      Int_t               fNu;         // number of u bins
+      Int_t               fNv;         // number of v bins
+      Double_t            fUmin;       // lower edge in u
+      Double_t            fUwid;       // bin width  in u
+      Double_t            fVmin;       // lower edge in v
+      Double_t            fVwid;       // bin width  in v
+      Double_t            fDuMax;      // largest hit error along u
+      Double_t            fDvMax;      // largest hit error along v
+      std::vector<Int_t>  fCellStart;  // cell offsets into fEntries
+      std::vector<Entry>  fEntries;    // hits, sorted by cell
+   };
+
+   void   InitLayer (Layer &lyr, const TVTrackHit &hit) const;
+   void   CalcUV    (const Layer &lyr, const TVector3 &xv,
+                           Double_t &u, Double_t &v) const;
+
+private:
+   Int_t               fNubins;    // max. number of u bins per layer
+   Int_t               fNvbins;    // max. number of v bins per layer
+   Bool_t              fIsBuilt;   // true after Build()
+   std::vector<Layer>  fLayers;    //! per-layer grids, indexed by GetIndex()
+
+   ClassDef(TKalHitStore,1)  // binned hit store
+};
+
+#endif
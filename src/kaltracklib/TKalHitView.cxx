@@ -0,0 +1,66 @@
+//*************************************************************************
+//* ===================
+//*  TKalHitView Class
+//* ===================
+//*
+//* (Description)
+//*   Hit class on a row of a TKalHitFile.
+//* (Requires)
+//*     TVTrackHit, TKalHitFile
+//* (Provides)
+//*     class TKalHitView
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TKalHitView.h"    // from KalTrackLib
+#include "TKalHitFile.h"    // from KalTrackLib
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Hit view class
+//  ---------------------------------
+//
+ClassImp(TKalHitView)
+
+TKalHitView::TKalHitView(Int_t m)
+           : TVTrackHit(m),
+             fFilePtr(0),
+             fRow(-1)
+{
+}
+
+void TKalHitView::Set(const TKalHitFile &file, Long64_t row, const TVMeasLayer &ms)
+{
+   fFilePtr = &file;
+   fRow     = row;
+   SetHit(ms, file.GetMeas(row), file.GetBfield(row));
+}
+
+TKalMatrix TKalHitView::XvToMv(const TVector3 &xv, Double_t t0) const
+{
+   TKalMatrix h = GetMeasLayer().XvToMv(*this, xv);
+   for (Int_t i=0; i<GetDimension(); i++) h(i,0) += GetDhDt0(i) * t0;
+   return h;
+}
+
+Double_t TKalHitView::GetDhDt0(Int_t i) const
+{
+   return fFilePtr ? fFilePtr->GetDhDt0(fRow)[i] : 0.;
+}
+
+Int_t TKalHitView::GetFlag() const
+{
+   return fFilePtr ? fFilePtr->GetFlag(fRow) : 0;
+}
+
+Int_t TKalHitView::GetTrackID() const
+{
+   return fFilePtr ? fFilePtr->GetTrackID(fRow) : -1;
+}
+
+Int_t TKalHitView::GetCandID() const
+{
+   return fFilePtr ? fFilePtr->GetCandID(fRow) : -1;
+}
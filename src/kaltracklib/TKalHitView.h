@@ -0,0 +1,56 @@
+#ifndef TKALHITVIEW_H
+#define TKALHITVIEW_H
+//*************************************************************************
+//* ===================
+//*  TKalHitView Class
+//* ===================
+//*
+//* (Description)
+//*   Hit class on a row of a TKalHitFile.
+//*   The (x, dx) pairs are copied into the in-object matrix storage;
+//*   all other columns are read from the mapped file through the row
+//*   index. Views are created and reused by TKalHitFile::GetEvent(),
+//*   so filling an event does not allocate hits.
+//*   The expected measurement vector is that of the measurement layer,
+//*   shifted by d(x)/d(t0) * t0.
+//* (Requires)
+//*     TVTrackHit, TKalHitFile
+//* (Provides)
+//*     class TKalHitView
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TVTrackHit.h"     // from KalTrackLib
+
+class TKalHitFile;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Hit view class
+//  ---------------------------------
+//
+class TKalHitView : public TVTrackHit {
+public:
+   TKalHitView(Int_t m = kMdim);
+   virtual ~TKalHitView() {}
+
+   void  Set(const TKalHitFile &file, Long64_t row, const TVMeasLayer &ms);
+
+   virtual TKalMatrix XvToMv(const TVector3 &xv, Double_t t0) const;
+
+   inline  Long64_t   GetRow    () const { return fRow;  }
+           Double_t   GetDhDt0  (Int_t i) const;
+           Int_t      GetFlag   () const;
+           Int_t      GetTrackID() const;
+           Int_t      GetCandID () const;
+
+private:
+   const TKalHitFile *fFilePtr;   //! file
+   Long64_t           fRow;       //  row in the file
+
+   ClassDef(TKalHitView,1)  // hit view on a hit file row
+};
+
+#endif
@@ -14,14 +14,21 @@
 //*   2005/02/23  A.Yamaguchi   Added a new data member, fMass.
 //*   2005/08/25  K.Fujii       Added drawable attribute.
 //*   2005/08/26  K.Fujii       Removed drawable attribute.
+//*   2026/10/18                Added FilterAndSmooth().
 //*
 //*************************************************************************
                                                                                 
 #include "TKalTrackState.h"    // from KalTrackLib
 #include "TKalTrackSite.h"     // from KalTrackLib
 #include "TKalTrack.h"         // from KalTrackLib
+#include "TKalDetCradle.h"     // from KalTrackLib
+#include "TKalResidualArray.h" // from KalLib
+#include "TBField.h"           // from Bfield
 #include <iostream>            // from STL
+#include <memory>             // from STL
 #include <sstream>            // from STL
+#include <thread>             // from STL
+#include <vector>             // from STL
 
 using namespace std;
 #if __GNUC__ < 4 && !defined(__STRICT_ANSI__)
@@ -56,7 +63,131 @@ TKalTrack::TKalTrack(Int_t n)
 // -----------------
 //    chi^2-fits hits belonging to this track to a single helix.
 //
-Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf)
+//    The inverse measurement noise matrices are computed once. Each
+//    iteration then evaluates the residuals and H matrices of all
+//    sites in one pass, split into blocks of sites over fgNThreads
+//    threads. The per-site contributions to H^t V^-1 H and
+//    H^t V^-1 r are summed in site order, so the result does not
+//    depend on the number of threads. Threads are started per pass and
+//    only for blocks of 64 sites or more; fewer sites are evaluated on
+//    the calling thread.
+//
+namespace {
+   struct TSiteCache {
+      Int_t                         fSdim;   // state vector dimension
+      std::vector<TKalTrackSite *>  fSites;  // unlocked sites
+      std::vector<Int_t>            fMdim;   // meas. dimension per site
+      std::vector<Int_t>            fMoff;   // offset into fMeas
+      std::vector<Int_t>            fVoff;   // offset into fVinv
+      std::vector<Double_t>         fMeas;   // meas. vectors
+      std::vector<Double_t>         fVinv;   // inverse noise matrices
+      std::vector<Int_t>            fOK;     // site accepted in last pass
+      std::vector<Double_t>         fSum;    // per-site H^tWH, H^tWr, chi2
+   };
+
+   // Evaluate sites [first, last) at state a.
+   void EvalSites(TSiteCache &c, const TKalTrackState &a, Int_t first, Int_t last)
+   {
+      const Int_t sdim = c.fSdim;
+      const Int_t nsum = sdim*sdim + sdim + 1;
+      Int_t       mdim = 0;
+      TKalMatrix  h, H;
+      Double_t    r[kMdim], wr[kMdim], wh[kMdim*kSdim];
+
+      for (Int_t i=first; i<last; i++) {
+         TKalTrackSite &site = *c.fSites[i];
+         if (c.fMdim[i] != mdim) {
+            mdim = c.fMdim[i];
+            h.ResizeTo(mdim, 1);
+            H.ResizeTo(mdim, sdim);
+         }
+         c.fOK[i] = site.CalcExpectedMeasVec  (a, h) &&
+                    site.CalcMeasVecDerivative(a, H);
+         if (!c.fOK[i]) continue;
+
+         const Double_t *m    = &c.fMeas[c.fMoff[i]];
+         const Double_t *vinv = &c.fVinv[c.fVoff[i]];
+         const Double_t *hp   = h.GetMatrixArray();
+         const Double_t *Hp   = H.GetMatrixArray();
+         for (Int_t k=0; k<mdim; k++) r[k] = m[k] - hp[k];
+         for (Int_t k=0; k<mdim; k++) {
+            wr[k] = 0.;
+            for (Int_t l=0; l<mdim; l++) wr[k] += vinv[k*mdim+l] * r[l];
+            for (Int_t j=0; j<sdim; j++) {
+               Double_t sum = 0.;
+               for (Int_t l=0; l<mdim; l++) sum += vinv[k*mdim+l] * Hp[l*sdim+j];
+               wh[k*sdim+j] = sum;
+            }
+         }
+
+         Double_t *out = &c.fSum[i*nsum];
+         for (Int_t j=0; j<sdim; j++) {
+            for (Int_t l=0; l<sdim; l++) {
+               Double_t sum = 0.;
+               for (Int_t k=0; k<mdim; k++) sum += Hp[k*sdim+j] * wh[k*sdim+l];
+               out[j*sdim+l] = sum;
+            }
+            Double_t sum = 0.;
+            for (Int_t k=0; k<mdim; k++) sum += Hp[k*sdim+j] * wr[k];
+            out[sdim*sdim+j] = sum;
+         }
+         Double_t chi2 = 0.;
+         for (Int_t k=0; k<mdim; k++) chi2 += r[k] * wr[k];
+         out[sdim*sdim+sdim] = chi2;
+      }
+   }
+
+   // Fill dchi2da = r^t V^-1 H and d2chi2dada = H^t V^-1 H summed over
+   // sites and return chi2. ndf is set from the accepted sites.
+   Double_t Accumulate(TSiteCache &c, const TKalTrackState &a,
+                       TKalMatrix &dchi2da, TKalMatrix &d2chi2dada,
+                       Int_t &ndf, Int_t nthreads)
+   {
+      const Int_t sdim   = c.fSdim;
+      const Int_t nsum   = sdim*sdim + sdim + 1;
+      const Int_t nsites = c.fSites.size();
+
+      // Starting and joining a thread costs about as much as evaluating
+      // 10 sites, so each thread is given at least kMinSitesPerThread.
+
+      static const Int_t kMinSitesPerThread = 64;
+      if (nthreads > nsites/kMinSitesPerThread) nthreads = nsites/kMinSitesPerThread;
+      if (nthreads <= 1) {
+         EvalSites(c, a, 0, nsites);
+      } else {
+         std::vector<std::thread> workers;
+         Int_t nper = (nsites + nthreads - 1)/nthreads;
+         for (Int_t t=1; t<nthreads; t++) {
+            Int_t first = t*nper;
+            Int_t last  = TMath::Min(first + nper, nsites);
+            if (first < last) workers.push_back(std::thread(EvalSites, std::ref(c), std::cref(a), first, last));
+         }
+         EvalSites(c, a, 0, TMath::Min(nper, nsites));
+         for (UInt_t t=0; t<workers.size(); t++) workers[t].join();
+      }
+
+      Double_t *g = dchi2da   .GetMatrixArray();
+      Double_t *A = d2chi2dada.GetMatrixArray();
+      for (Int_t j=0; j<sdim;      j++) g[j] = 0.;
+      for (Int_t j=0; j<sdim*sdim; j++) A[j] = 0.;
+      Double_t chi2 = 0.;
+      ndf = -sdim;
+      for (Int_t i=0; i<nsites; i++) {
+         if (!c.fOK[i]) continue;
+         const Double_t *in = &c.fSum[i*nsum];
+         for (Int_t j=0; j<sdim*sdim; j++) A[j] += in[j];
+         for (Int_t j=0; j<sdim;      j++) g[j] += in[sdim*sdim+j];
+         chi2 += in[sdim*sdim+sdim];
+         ndf  += c.fMdim[i];
+      }
+      return chi2;
+   }
+}
+
+Int_t TKalTrack::fgNThreads = 1;
+
+Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf,
+                               Int_t method)
 {
    // Define static constants...
  
@@ -66,6 +197,7 @@ Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf)
    static const Double_t kLincr   = 10.;
    static const Double_t kLdecr   = 0.1;
    static const Int_t    kLoopMax = 100;
+   static const Int_t    kHalfMax = 10;     // max. step halvings (Gauss-Newton)
 
    // Initialize return values...
 
@@ -75,29 +207,90 @@ Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf)
    Int_t      nloops   = 0;
 
    ndf = 0;
-   Int_t      nsites   = 0;
    Double_t   chi2     = 0.;
 
-   // Prepare som matrices
+   // Cache measurement vectors and inverse noise matrices
 
-   TIter      next(this);
-   TKalTrackSite &site0 = *(TKalTrackSite *)next();
+   Int_t sdim = a.GetDimension();
 
-   Int_t mdim = site0.GetDimension();
-   Int_t sdim = site0.GetCurState().GetDimension();
+   TSiteCache cache;
+   cache.fSdim = sdim;
+   TIter      next(this);
+   TKalTrackSite *sitePtr = 0;
+   while ((sitePtr = (TKalTrackSite *)next())) {
+      if (sitePtr->IsLocked()) continue;
+      Int_t mdim = sitePtr->GetDimension();
+      if (mdim > kMdim) {
+         cerr << "TKalTrack::FitToHelix >>>>>>>>>>>>>>"
+              << " Unsupported measurement dimension = " << mdim << endl;
+         continue;
+      }
+      TKalMatrix vinv(TKalMatrix::kInverted, sitePtr->GetMeasNoiseMat());
+      cache.fSites.push_back(sitePtr);
+      cache.fMdim .push_back(mdim);
+      cache.fMoff .push_back(cache.fMeas.size());
+      cache.fVoff .push_back(cache.fVinv.size());
+      for (Int_t k=0; k<mdim; k++) {
+         cache.fMeas.push_back(sitePtr->GetMeasVec()(k,0));
+         for (Int_t l=0; l<mdim; l++) cache.fVinv.push_back(vinv(k,l));
+      }
+   }
+   Int_t nsites = cache.fSites.size();
+   cache.fOK .resize(nsites);
+   cache.fSum.resize(nsites * (sdim*sdim + sdim + 1));
 
    TKalMatrix    dchi2dabest(1   , sdim);
    TKalMatrix    dchi2da    (1   , sdim);
    TKalMatrix    d2chi2dada (sdim, sdim);
    TKalMatrix    d2chi2best (sdim, sdim);
-   TKalMatrix    curh       (mdim, 1   );
-   TKalMatrix    curH       (mdim, sdim);
-   //   TKalMatrix    curHt      (sdim, mdim);
-   TKalMatrix    curVinv    (mdim, mdim);
-   TKalMatrix    curResVec  (mdim, 1   );
+
+   if (method == kGaussNewton) {
+
+      // Gauss-Newton steps, halved until chi2 decreases
+
+      chi2 = Accumulate(cache, a, dchi2da, d2chi2dada, ndf, fgNThreads);
+      TKalTrackState atry(a);
+      TKalMatrix     dchi2try(1, sdim);
+      TKalMatrix     d2chi2try(sdim, sdim);
+      Int_t          ndftry = 0;
+      while (1) {
+         if (nloops > kLoopMax) {
+            cerr << "TKalTrack::FitToHelix >>>>>>>>>>>>>>"
+                 << " Loop count limit reached. nloops = " << nloops << endl;
+            break;
+         }
+         nloops++;
+
+         TKalMatrix d2chi2dadainv(TKalMatrix::kInverted, d2chi2dada);
+         TKalMatrix dchi2daT     (TKalMatrix::kTransposed, dchi2da);
+         TKalMatrix da = d2chi2dadainv * dchi2daT;
+
+         Double_t chi2try = kChi2Dum;
+         Int_t    nhalf   = 0;
+         for (; nhalf<kHalfMax; nhalf++) {
+            atry  = a;
+            atry += da;
+            chi2try = Accumulate(cache, atry, dchi2try, d2chi2try, ndftry, fgNThreads);
+            if (chi2try <= chi2) break;
+            da *= 0.5;
+         }
+         if (nhalf == kHalfMax) break;       // no further decrease
+
+         Double_t dchi2 = chi2 - chi2try;
+         a          = atry;
+         dchi2da    = dchi2try;
+         d2chi2dada = d2chi2try;
+         ndf        = ndftry;
+         chi2       = chi2try;
+         if (dchi2 < kChi2Tol) break;
+      }
+      C = TKalMatrix(TKalMatrix::kInverted, d2chi2dada);
+      return chi2;
+   }
 
    // Minimization loop starts here
 
+   Int_t ndfbest = 0;
    while (1) {
        if (nloops > kLoopMax) {
           cerr << "TKalTrack::FitToHelix >>>>>>>>>>>>>>"
@@ -108,38 +301,9 @@ Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf)
        }
        nloops++;
 
-       d2chi2dada.Zero();
-       dchi2da.Zero();
-       chi2 = 0;
-
        // Loop over hits and accumulate chi2
 
-       next.Reset();
-       TKalTrackSite *sitePtr = 0;
-       nsites  = 0;
-       while ((sitePtr = (TKalTrackSite *)next())) {
-           TKalTrackSite   &site = *sitePtr;
-
-           if (site.IsLocked())                      continue;
-           if (!site.CalcExpectedMeasVec  (a, curh)) continue;
-           if (!site.CalcMeasVecDerivative(a, curH)) continue;
-           nsites++;	// site accepted
-
-           //dchi2/da
-           curVinv   = TKalMatrix(TKalMatrix::kInverted,site.GetMeasNoiseMat());
-           curResVec = site.GetMeasVec() - curh;
-
-           TKalMatrix curResVecT(TKalMatrix::kTransposed, curResVec);
-           dchi2da += (curResVecT * curVinv * curH);
-
-           // accumulate chi2
-           Double_t delchi2 = (curResVecT * curVinv * curResVec)(0,0);
-           chi2 += delchi2;
-
-           // inverse covariance matrix
-           TKalMatrix curHtr(TKalMatrix::kTransposed, curH);
-           d2chi2dada += (curHtr * curVinv * curH);
-       }
+       chi2 = Accumulate(cache, a, dchi2da, d2chi2dada, ndf, fgNThreads);
 
        //
        // if (chi2best - chi2) < kChi2Tol, break while loop.
@@ -147,6 +311,7 @@ Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf)
 
        if (TMath::Abs(chi2best - chi2) < kChi2Tol) {
            d2chi2best = d2chi2dada;
+           ndfbest    = ndf;
            break;
        }
 
@@ -156,9 +321,11 @@ Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf)
            abest       = (TKalTrackState &)a;
            dchi2dabest = dchi2da;
            d2chi2best  = d2chi2dada;
+           ndfbest     = ndf;
            lambda     *= kLdecr;
        } else {
            // chi2 increased. Restore the current best
+           a           = abest;
            dchi2da     = dchi2dabest;
            d2chi2dada  = d2chi2best;
            lambda     *= kLincr;
@@ -175,13 +342,248 @@ Double_t TKalTrack::FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf)
        a += (d2chi2dadainv * dchi2daT);
    }
 
-   ndf  = nsites * mdim - sdim;
+   ndf  = ndfbest;
    C    = TKalMatrix(TKalMatrix::kInverted, d2chi2best);
 
    return chi2;
 }
 
 
+//_________________________________________________________________________
+// -----------------
+//  FilterAndSmooth
+// -----------------
+//    The backward filter starts at the last site from a state there
+//    with its covariance matrix scaled up by kCovScale, so that it adds
+//    next to nothing to the combination. It only reads the sites.
+//    After the forward filter it steps back over each gap with the
+//    inverse of the forward step, whose propagator and process noise
+//    matrices the filtered states keep, and takes the hits linearized
+//    where the forward filter did: the same layers, material and energy
+//    loss as the forward filter, and so the same smoothed states as
+//    SmoothAll(). With multiple scattering and energy loss off and the
+//    pivots of all sites set by their 2-dim hits, it runs on a second
+//    thread instead, stepping back with TKalDetCradle::Transport(),
+//    which is then the inverse of the forward step but taken at the
+//    backward states; the pivots of 1-dim hits are set by the forward
+//    filter. The backward filter is run again over the accepted sites
+//    if the forward filter rejected any. Outside a uniform field or with
+//    TRungeKuttaTrack, which TKalDetCradle::Transport() does not step
+//    backwards here, the sites are smoothed by SmoothAll() instead.
+//
+namespace {
+   // Seed of the backward filter at the last of sites: with fwd set,
+   // the filtered state there, which is also the smoothed one, so that
+   // the seed does not pull the smoothed states off those of
+   // SmoothAll(); otherwise the first filtered state moved there
+   TKalTrackState *MakeBackwardSeed(const std::vector<TKalTrackSite *> &sites,
+                                          Bool_t                        fwd)
+   {
+      static const Double_t kCovScale = 1.e4;
+
+      TKalTrackSite  &last = *sites.back();
+      TVKalState     &a    = (fwd ? sites.back() : sites.front())->GetState(TVKalSite::kFiltered);
+      Int_t           sdim = a.GetDimension();
+      TKalMatrix      sv(a);
+      TKalMatrix      C (a.GetCovMat());
+      std::unique_ptr<TVTrack> hel(&static_cast<TKalTrackState &>(a).CreateTrack());
+      Double_t        fid  = 0.;
+      hel->MoveTo(last.GetGlobalPivot(), fid, C);
+      hel->PutInto(sv);
+      C *= kCovScale;
+      return new TKalTrackState(sv, C, last, hel->GetPivot(), TVKalSite::kPredicted, sdim);
+   }
+
+   // Filter sites backwards from the last one, starting from seed
+   // there. bwd[i] is set to the state at site i predicted from sites
+   // i+1 .. n-1, the seed at the last site. With fwd set, the sites
+   // are those of the forward filter and its steps are inverted;
+   // otherwise Transport() steps backwards. ok is kFALSE if a site is
+   // missed.
+   void FilterBackward(const std::vector<TKalTrackSite *> &sites,
+                             TKalTrackState               *seed,
+                             Bool_t                        fwd,
+                             TObjArray                    &bwd,
+                             Bool_t                       &ok)
+   {
+      Int_t nsites = sites.size();
+      Int_t sdim   = seed->GetDimension();
+      bwd.Clear();
+      bwd.Expand(nsites);
+      bwd.AddAt(seed, nsites-1);
+
+      ok = kFALSE;
+      TKalMatrix h, H;
+      TKalMatrix F(sdim,sdim), Q(sdim,sdim), sv(sdim,1);
+      for (Int_t i=nsites-1; i>0; i--) {
+         TKalTrackSite  &site = *sites[i];
+         TKalTrackState &prea = *static_cast<TKalTrackState *>(bwd.UncheckedAt(i));
+
+         // filtered state, as in TVKalSite::Filter(), with the hit
+         // linearized where the forward filter did, if fwd is set
+
+         TVKalState &lina = fwd ? site.GetState(TVKalSite::kPredicted) : prea;
+         Int_t m = site.GetDimension();
+         h.ResizeTo(m, 1);
+         H.ResizeTo(m, sdim);
+         if (!site.CalcExpectedMeasVec(lina, h) || !site.CalcMeasVecDerivative(lina, H)) return;
+         TKalMatrix dlin    = prea - lina;
+         dlin(1,0) -= TMath::TwoPi() * TMath::Nint(dlin(1,0) / TMath::TwoPi());
+         TKalMatrix Ht      = TKalMatrix(TKalMatrix::kTransposed, H);
+         TKalMatrix G       = TKalMatrix(TKalMatrix::kInverted, site.GetMeasNoiseMat());
+         TKalMatrix preCinv = TKalMatrix(TKalMatrix::kInverted, prea.GetCovMat());
+         TKalMatrix curC    = TKalMatrix(TKalMatrix::kInverted, preCinv + Ht * G * H);
+         TKalMatrix av      = prea + curC * Ht * G * (site.GetMeasVec() - h - H * dlin);
+         TKalTrackSite &to  = *sites[i-1];
+
+         // to the site before, with the forward step linearized at the
+         // filtered state af there and fa = f(af) its prediction here:
+         // from a = fa + F (a' - af) + w, <w w^T> = Q,
+         //    a' = af + F^-1 (a - fa),  C' = F^-1 (C + Q) F^-T
+
+         if (fwd) {
+            TVKalState &af   = to  .GetState(TVKalSite::kFiltered);
+            TVKalState &fa   = site.GetState(TVKalSite::kPredicted);
+            TKalMatrix  da   = av - fa;
+            da(1,0) -= TMath::TwoPi() * TMath::Nint(da(1,0) / TMath::TwoPi());
+            TKalMatrix  Finv  = TKalMatrix(TKalMatrix::kInverted, af.GetPropMat());
+            TKalMatrix  Finvt = TKalMatrix(TKalMatrix::kTransposed, Finv);
+            TKalMatrix  bv    = af + Finv * da;
+            TKalMatrix  preC  = Finv * (curC + af.GetProcNoiseMat()) * Finvt;
+            bwd.AddAt(new TKalTrackState(bv, preC, to,
+                                         static_cast<TKalTrackState &>(af).GetPivot(),
+                                         TVKalSite::kPredicted, sdim), i-1);
+            continue;
+         }
+
+         // to the site before, as in TKalTrackState::MoveTo()
+
+         TKalTrackState cura(av, curC, site, prea.GetPivot(), TVKalSite::kFiltered, sdim);
+         TKalDetCradle &det = const_cast<TKalDetCradle &>
+                                 (static_cast<const TKalDetCradle &>
+                                    (site.GetHit().GetMeasLayer().GetParent()));
+         std::unique_ptr<TVTrack> help(&cura.CreateTrack());
+         TVector3 x0;
+         TVector3 xhit = to.GetGlobalPivot();
+         det.Transport(site, to.GetHit().GetMeasLayer(), x0, sv, F, Q, help, &xhit);
+         if (to.GetDimension() > 1) {
+            Double_t fid = 0.;
+            help->PropagateTo(xhit, fid, F, 0, kFALSE);
+            help->PutInto(sv);
+         }
+         if (sdim == 6) {
+            sv(5,0) = av(5,0);
+            F (5,5) = 1.;
+         }
+         TKalMatrix Ft   = TKalMatrix(TKalMatrix::kTransposed, F);
+         TKalMatrix preC = F * curC * Ft + Q;
+         bwd.AddAt(new TKalTrackState(sv, preC, to, help->GetPivot(),
+                                      TVKalSite::kPredicted, sdim), i-1);
+      }
+      ok = kTRUE;
+   }
+}
+
+Int_t TKalTrack::FilterAndSmooth(TObjArray &sites, TKalResidualArray *resPtr)
+{
+   Int_t nseed  = GetEntries();
+   Int_t nsites = sites.GetEntriesFast();
+   if (!nseed) {
+      cerr << ">>>> Error!! TKalTrack::FilterAndSmooth >>>>>>>>" << endl
+           << " No seed site.                                     " << endl;
+      return 0;
+   }
+
+   Bool_t twofilter = TBField::IsUsingUniformBfield()
+                   && !TKalDetCradle::IsUsingRungeKuttaTrack();
+
+   // all sites in the order of the system
+
+   std::vector<TKalTrackSite *> all;
+   for (Int_t i=0; i<nseed;  i++) all.push_back(static_cast<TKalTrackSite *>(At(i)));
+   for (Int_t i=0; i<nsites; i++) all.push_back(static_cast<TKalTrackSite *>(sites.UncheckedAt(i)));
+
+   const TKalDetCradle &det = static_cast<const TKalDetCradle &>
+                                 (all.front()->GetHit().GetMeasLayer().GetParent());
+   Bool_t parallel = twofilter && det.IsClosed() && nsites > 0
+                  && !det.IsMSOn() && !det.IsDEDXOn();
+   for (UInt_t i=0; i<all.size() && parallel; i++) {
+      if (all[i]->GetDimension() < 2) parallel = kFALSE;
+   }
+
+   TObjArray   bwd;
+   Bool_t      bwdok = kFALSE;
+   std::thread worker;
+   bwd.SetOwner();
+   if (parallel) {
+      // the current instance, through which the track is looked up,
+      // is per thread
+      TKalTrackState *seedp = MakeBackwardSeed(all, kFALSE);
+      worker = std::thread([this, &all, seedp, &bwd, &bwdok] {
+                              SetCurInstancePtr(this);
+                              FilterBackward(all, seedp, kFALSE, bwd, bwdok);
+                           });
+   }
+
+   Int_t nok = 0;
+   for (Int_t i=0; i<nsites; i++) {
+      TVKalSite &site = *static_cast<TVKalSite *>(sites.UncheckedAt(i));
+      if (AddAndFilter(site)) {
+         sites.RemoveAt(i);
+         nok++;
+      }
+   }
+   sites.Compress();
+   if (parallel) worker.join();
+
+   if (!twofilter) {
+      SmoothAll();
+      if (resPtr) CalcUnbiasedResiduals(*resPtr);
+      return nok;
+   }
+
+   // the backward filter over the sites accepted
+
+   if (!parallel || nok < nsites) {
+      all.clear();
+      for (Int_t i=0; i<GetEntries(); i++) all.push_back(static_cast<TKalTrackSite *>(At(i)));
+      SetCurInstancePtr(this);
+      FilterBackward(all, MakeBackwardSeed(all, kTRUE), kTRUE, bwd, bwdok);
+   }
+   if (!bwdok) {
+      SmoothAll();
+      if (resPtr) CalcUnbiasedResiduals(*resPtr);
+      return nok;
+   }
+
+   // backward states at the pivots of the filtered ones, with phi0
+   // next to theirs; the seed at the last site has seen no site
+
+   Int_t nall = GetEntries();
+   delete bwd.RemoveAt(nall-1);
+   for (Int_t i=0; i<nall-1; i++) {
+      TKalTrackState &b = *static_cast<TKalTrackState *>(bwd.UncheckedAt(i));
+      TKalTrackState &a = static_cast<TKalTrackState &>
+                             (all[i]->GetState(TVKalSite::kFiltered));
+      if (b.GetPivot() != a.GetPivot()) {
+         TKalMatrix sv(b);
+         TKalMatrix C (b.GetCovMat());
+         std::unique_ptr<TVTrack> hel(&b.CreateTrack());
+         Double_t fid = 0.;
+         hel->MoveTo(a.GetPivot(), fid, C);
+         hel->PutInto(sv);
+         delete bwd.RemoveAt(i);
+         bwd.AddAt(new TKalTrackState(sv, C, *all[i], a.GetPivot(),
+                                      TVKalSite::kPredicted, sv.GetNrows()), i);
+      }
+      TKalTrackState &bb = *static_cast<TKalTrackState *>(bwd.UncheckedAt(i));
+      bb(1,0) -= TMath::TwoPi() * TMath::Nint((bb(1,0) - a(1,0)) / TMath::TwoPi());
+   }
+
+   SmoothTwoFilter(bwd, resPtr);
+   return nok;
+}
+
 std::string TKalTrack::toString() {
   
   //  std::string s ;
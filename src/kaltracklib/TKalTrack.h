@@ -18,12 +18,18 @@
 //*   2005/08/15  K.Fujii       Removed fDir and its getter and setter.
 //*   2005/08/25  K.Fujii       Added Drawable attribute.
 //*   2005/08/26  K.Fujii       Removed Drawable attribute.
+//*   2026/10/18                Batched, optionally threaded site loop
+//*                             and Gauss-Newton option in FitToHelix.
+//*   2026/10/18                Added FilterAndSmooth(), a two-filter
+//*                             smoother.
 //*
 //*************************************************************************
                                                                                 
 #include "TVKalSystem.h"       // from KalLib
 #include "TKalTrackState.h"    // from KalTrackLib
 
+class TKalResidualArray;
+
 //_________________________________________________________________________
 //  ------------------------------
 //   TKalTrack: Kalman Track class
@@ -37,7 +43,30 @@ public:
    inline virtual void      SetMass(Double_t m)           { fMass = m;    }
    inline virtual Double_t  GetMass()             const   { return fMass; }
 
-   Double_t FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf);
+   enum EFitMethod { kLevenbergMarquardt = 0, kGaussNewton };
+
+   Double_t FitToHelix(TKalTrackState &a, TKalMatrix &C, Int_t &ndf,
+                       Int_t method = kLevenbergMarquardt);
+
+   // Two-filter smoother, an alternative to AddAndFilter() of each of
+   // sites in turn followed by SmoothAll(): a filter runs over the
+   // same sites backwards from the last one, and each site is then
+   // smoothed as the weighted mean of the two, see SmoothTwoFilter().
+   // With the material off and 2-dim hits only, the backward filter
+   // runs on a second thread while the sites are added and filtered on
+   // this one; otherwise it runs after it and the smoothed states are
+   // those of SmoothAll().
+   // The first site of this track holds the seed, as for AddAndFilter().
+   // Accepted sites are moved from sites to this track, rejected ones
+   // stay in sites. The unbiased residuals go to *resPtr, if given.
+   // Returns the number of sites accepted.
+
+   Int_t    FilterAndSmooth(TObjArray &sites, TKalResidualArray *resPtr = 0);
+
+   // Max. number of threads used to evaluate sites in FitToHelix;
+   // each thread gets at least 64 sites
+   static  void     SetNThreads(Int_t n) { fgNThreads = n > 0 ? n : 1; }
+   static  Int_t    GetNThreads()        { return fgNThreads;           }
 
 
   std::string toString() ;
@@ -45,6 +74,8 @@ public:
 private:
   Double_t     fMass{};        // mass [GeV]
 
+  static Int_t fgNThreads;     //! number of threads for FitToHelix
+
 #if __GNUC__ < 4 && !defined(__STRICT_ANSI__)
    static const Double_t kMpi = 0.13957018; //! pion mass [GeV]
 #else
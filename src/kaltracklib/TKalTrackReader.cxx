@@ -0,0 +1,184 @@
+//*************************************************************************
+//* =======================
+//*  TKalTrackReader Class
+//* =======================
+//*
+//* (Description)
+//*   Reader of the binary track records written by TKalTrackWriter.
+//* (Requires)
+//*     TKalTrackWriter, TKalTrackState
+//* (Provides)
+//*     class TKalTrackReader
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TKalTrackReader.h"    // from KalTrackLib
+#include "TKalTrackSite.h"      // from KalTrackLib
+#include "TKalTrackState.h"     // from KalTrackLib
+#include <cstring>              // from STL
+
+using namespace std;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for track record input
+//  ---------------------------------
+//
+ClassImp(TKalTrackReader)
+
+//-------------------------------------------------------
+// Ctor
+//-------------------------------------------------------
+
+TKalTrackReader::TKalTrackReader(const Char_t *buf, Long64_t len)
+{
+   SetBuffer(buf, len);
+}
+
+void TKalTrackReader::SetBuffer(const Char_t *buf, Long64_t len)
+{
+   fBuf = buf;
+   fLen = buf ? len : 0;
+   Rewind();
+}
+
+void TKalTrackReader::Rewind()
+{
+   fPos       = 0;
+   fBlockPtr  = 0;
+   fStateSize = 0;
+   fRealSize  = 0;
+   fIsBad     = kFALSE;
+   memset(&fHeader, 0, sizeof(TKalTrackWriter::Header));
+}
+
+//-------------------------------------------------------
+// Next
+//-------------------------------------------------------
+
+Bool_t TKalTrackReader::Next()
+{
+   fBlockPtr = 0;
+   if (fIsBad || fPos + Long64_t(sizeof(TKalTrackWriter::Header)) > fLen) return kFALSE;
+
+   const Char_t *bp = fBuf + fPos;
+   memcpy(&fHeader, bp, sizeof(TKalTrackWriter::Header));
+
+   const Char_t *err = 0;
+   if (fHeader.fMagic != TKalTrackWriter::kMagic) {
+      err = "Bad magic number";
+   } else if (fHeader.fVersion > TKalTrackWriter::kVersion) {
+      err = "Unknown version";
+   } else {
+      fStateSize = TKalTrackWriter::GetStateSize(fHeader.fSdim, fHeader.fFlags);
+      fRealSize  = IsFloat32() ? sizeof(Float_t) : sizeof(Double_t);
+      if (fHeader.fNbytes != sizeof(TKalTrackWriter::Header)
+                           + fHeader.fNstates * fStateSize
+       || fPos + fHeader.fNbytes > fLen) {
+         err = "Bad block size";
+      } else {
+         // checksum over the block with the checksum field zeroed
+
+         TKalTrackWriter::Header h = fHeader;
+         h.fChecksum = 0;
+         UInt_t sum = TKalTrackWriter::Checksum(reinterpret_cast<const Char_t *>(&h),
+                                                sizeof(TKalTrackWriter::Header));
+         sum = TKalTrackWriter::Checksum(bp + sizeof(TKalTrackWriter::Header),
+                                         fHeader.fNbytes - sizeof(TKalTrackWriter::Header),
+                                         sum);
+         if (sum != fHeader.fChecksum) err = "Checksum mismatch";
+      }
+   }
+   if (err) {
+      cerr << ">>>> Error!! TKalTrackReader::Next >>>>>>>>>>>>>>>" << endl
+           << " " << err << " in block at byte " << fPos << endl;
+      fIsBad = kTRUE;
+      return kFALSE;
+   }
+
+   fBlockPtr = bp;
+   fPos     += fHeader.fNbytes;
+   return kTRUE;
+}
+
+//-------------------------------------------------------
+// State getters
+//-------------------------------------------------------
+
+Int_t TKalTrackReader::GetSiteIndex(Int_t i) const
+{
+   Int_t site;
+   memcpy(&site, fBlockPtr + sizeof(TKalTrackWriter::Header) + i * fStateSize,
+          sizeof(Int_t));
+   return site;
+}
+
+Int_t TKalTrackReader::GetStateType(Int_t i) const
+{
+   return static_cast<UChar_t>
+          (fBlockPtr[sizeof(TKalTrackWriter::Header) + i * fStateSize + 4]);
+}
+
+Double_t TKalTrackReader::GetValue(Int_t i, Int_t n) const
+{
+   const Char_t *p = fBlockPtr + sizeof(TKalTrackWriter::Header)
+                   + i * fStateSize + 8 + n * fRealSize;
+   if (IsFloat32()) {
+      Float_t f;
+      memcpy(&f, p, sizeof(Float_t));
+      return f;
+   } else {
+      Double_t d;
+      memcpy(&d, p, sizeof(Double_t));
+      return d;
+   }
+}
+
+TVector3 TKalTrackReader::GetPivot(Int_t i) const
+{
+   return TVector3(GetValue(i,0), GetValue(i,1), GetValue(i,2));
+}
+
+Double_t TKalTrackReader::GetStateVec(Int_t i, Int_t j) const
+{
+   return GetValue(i, 3 + j);
+}
+
+Double_t TKalTrackReader::GetCovMat(Int_t i, Int_t j, Int_t k) const
+{
+   if (j < k) { Int_t t = j; j = k; k = t; }  // lower triangle
+   return GetValue(i, 3 + fHeader.fSdim + j * (j + 1) / 2 + k);
+}
+
+void TKalTrackReader::GetState(Int_t i, TKalMatrix &sv, TKalMatrix &C) const
+{
+   Int_t sdim = fHeader.fSdim;
+   sv.ResizeTo(sdim, 1);
+   C .ResizeTo(sdim, sdim);
+   Int_t n = 3;
+   for (Int_t j=0; j<sdim; j++) sv(j,0) = GetValue(i, n++);
+   for (Int_t j=0; j<sdim; j++) {
+      for (Int_t k=0; k<=j; k++) C(j,k) = C(k,j) = GetValue(i, n++);
+   }
+}
+
+//-------------------------------------------------------
+// Conversions
+//-------------------------------------------------------
+
+THelicalTrack TKalTrackReader::GetHelix(Int_t i) const
+{
+   TKalMatrix a(5,1);
+   for (Int_t j=0; j<5; j++) a(j,0) = GetStateVec(i, j);
+   return THelicalTrack(a, GetPivot(i), fHeader.fBfield);
+}
+
+TKalTrackState * TKalTrackReader::CreateState(Int_t i, TKalTrackSite &site) const
+{
+   TKalMatrix sv, C;
+   GetState(i, sv, C);
+   site.SetPivot(GetPivot(i));
+   return new TKalTrackState(sv, C, site, GetStateType(i), fHeader.fSdim);
+}
@@ -0,0 +1,98 @@
+#ifndef TKALTRACKREADER_H
+#define TKALTRACKREADER_H
+//*************************************************************************
+//* =======================
+//*  TKalTrackReader Class
+//* =======================
+//*
+//* (Description)
+//*   Reader of the binary track records written by TKalTrackWriter.
+//*   The reader walks over a memory buffer (a file read into memory
+//*   or mapped) without copying it: Next() checks the header and the
+//*   checksum of the next block, and the getters decode values
+//*   directly from the buffer.
+//* (Requires)
+//*     TKalTrackWriter, TKalTrackState
+//* (Provides)
+//*     class TKalTrackReader
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*
+//*************************************************************************
+
+#include "TObject.h"            // from ROOT
+#include "TVector3.h"           // from ROOT
+#include "TKalMatrix.h"         // from KalLib
+#include "THelicalTrack.h"      // from GeomLib
+#include "TKalTrackWriter.h"    // from KalTrackLib
+
+class TKalTrackSite;
+class TKalTrackState;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for track record input
+//  ---------------------------------
+//
+class TKalTrackReader : public TObject {
+public:
+   TKalTrackReader(const Char_t *buf = 0, Long64_t len = 0);
+   virtual ~TKalTrackReader() {}
+
+   // The buffer must stay valid while the reader is used.
+
+   void   SetBuffer(const Char_t *buf, Long64_t len);
+   void   Rewind   ();
+
+   // Go to the next track. Returns kFALSE at the end of the buffer
+   // or at a corrupt block (then IsBad() is true).
+
+   Bool_t Next();
+   inline Bool_t IsBad() const { return fIsBad; }
+
+   // Current track
+
+   inline Int_t    GetTrackID() const { return fHeader.fTrackID;         }
+   inline Int_t    GetNstates() const { return fHeader.fNstates;         }
+   inline Int_t    GetSdim   () const { return fHeader.fSdim;            }
+   inline Int_t    GetNDF    () const { return fHeader.fNDF;             }
+   inline Double_t GetChi2   () const { return fHeader.fChi2;            }
+   inline Double_t GetBfield () const { return fHeader.fBfield;          }
+   inline Bool_t   IsFloat32 () const
+                   { return fHeader.fFlags & TKalTrackWriter::kFloat32; }
+
+   // i-th state of the current track
+
+   Int_t      GetSiteIndex(Int_t i) const;
+   Int_t      GetStateType(Int_t i) const;
+   TVector3   GetPivot    (Int_t i) const;
+   Double_t   GetStateVec (Int_t i, Int_t j) const;
+   Double_t   GetCovMat   (Int_t i, Int_t j, Int_t k) const;
+   void       GetState    (Int_t i, TKalMatrix &sv, TKalMatrix &C) const;
+
+   // Helix at the pivot of the i-th state (uniform field)
+
+   THelicalTrack    GetHelix   (Int_t i) const;
+
+   // New state for site. The pivot of site is set to that of
+   // the i-th state. The caller owns the state.
+
+   TKalTrackState * CreateState(Int_t i, TKalTrackSite &site) const;
+
+private:
+   Double_t GetValue(Int_t i, Int_t n) const;
+
+private:
+   const Char_t              *fBuf;       //! buffer
+   Long64_t                   fLen;       // buffer length
+   Long64_t                   fPos;       // start of the next block
+   const Char_t              *fBlockPtr;  //! current block
+   TKalTrackWriter::Header    fHeader;    //! header of the current block
+   Int_t                      fStateSize; // bytes per state
+   Int_t                      fRealSize;  // bytes per number
+   Bool_t                     fIsBad;     // true if a corrupt block was met
+
+   ClassDef(TKalTrackReader,1)  // track record reader
+};
+
+#endif
@@ -0,0 +1,493 @@
+//*************************************************************************
+//* =======================
+//*  TKalTrackSeeder Class
+//* =======================
+//*
+//* (Description)
+//*   Initial track state from all hits of a track candidate.
+//* (Requires)
+//*     TKalTrackSite, TKalTrackState, TVTrackHit
+//* (Provides)
+//*     class TKalTrackSeeder
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Straight-line seed for b = 0.
+//*
+//*************************************************************************
+
+#include "TKalTrackSeeder.h"  // from KalTrackLib
+#include "TKalTrackSite.h"    // from KalTrackLib
+#include "TKalTrackState.h"   // from KalTrackLib
+#include "TVTrackHit.h"       // from KalTrackLib
+#include "THelicalTrack.h"    // from GeomLib
+#include "TMath.h"            // from ROOT
+
+#include <iostream>           // from STL
+
+using namespace std;
+
+namespace {
+   // Inverse of a symmetric 3x3 matrix a (row-major) by cofactors.
+   // Returns the determinant; ai is untouched if it vanishes.
+   Double_t InvertSym3(const Double_t *a, Double_t *ai)
+   {
+      Double_t c00 = a[4]*a[8] - a[5]*a[7];
+      Double_t c01 = a[5]*a[6] - a[3]*a[8];
+      Double_t c02 = a[3]*a[7] - a[4]*a[6];
+      Double_t det = a[0]*c00 + a[1]*c01 + a[2]*c02;
+      if (det == 0. || !TMath::Finite(det)) return 0.;
+      Double_t c11 = a[0]*a[8] - a[2]*a[6];
+      Double_t c12 = a[1]*a[6] - a[0]*a[7];
+      Double_t c22 = a[0]*a[4] - a[1]*a[3];
+      ai[0] = c00/det; ai[1] = c01/det; ai[2] = c02/det;
+      ai[3] = c01/det; ai[4] = c11/det; ai[5] = c12/det;
+      ai[6] = c02/det; ai[7] = c12/det; ai[8] = c22/det;
+      return det;
+   }
+}
+
+//_________________________________________________________________________
+//  ----------------------------------
+//   Class for track seeding
+//  ----------------------------------
+//
+ClassImp(TKalTrackSeeder)
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Ctors and Dtor
+//  ----------------------------------
+
+TKalTrackSeeder::TKalTrackSeeder(Int_t sdim)
+                : fSdim(sdim),
+                  fMaxIter(5),
+                  fCovScale(1.),
+                  fT0Err(1.e2),
+                  fSv(sdim,1),
+                  fC(sdim,sdim),
+                  fX0(),
+                  fChi2(0.),
+                  fNDF(0),
+                  fBuf(),
+                  fWbuf()
+{
+}
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Implementation of public methods
+//  ----------------------------------
+
+Int_t TKalTrackSeeder::Fit(const TObjArray &hits, Bool_t dir)
+{
+   // Only hits with at least 2 dimensions give a space point.
+
+   Int_t nhits = hits.GetEntriesFast();
+   fBuf.resize(5*nhits);
+   Double_t *x   = &fBuf[0];
+   Double_t *y   = x + nhits;
+   Double_t *z   = y + nhits;
+   Double_t *drp = z + nhits;
+   Double_t *dz  = drp + nhits;
+
+   Int_t    n = 0;
+   Double_t b = 0.;
+   for (Int_t i=0; i<nhits; i++) {
+      const TVTrackHit *hp = dynamic_cast<const TVTrackHit *>(hits.At(i));
+      if (!hp || hp->GetDimension() < 2) continue;
+      TVector3 xv = hp->GetMeasLayer().HitToXv(*hp);
+      if (!n) b = hp->GetBfield();
+      x  [n] = xv.X();
+      y  [n] = xv.Y();
+      z  [n] = xv.Z();
+      drp[n] = hp->GetDX(0);
+      dz [n] = hp->GetDX(1);
+      n++;
+   }
+   return Fit(n, x, y, z, drp, dz, b, dir);
+}
+
+Int_t TKalTrackSeeder::Fit(      Int_t     n,
+                           const Double_t *x,
+                           const Double_t *y,
+                           const Double_t *z,
+                           const Double_t *drphi,
+                           const Double_t *dz,
+                                 Double_t  b,
+                                 Bool_t    dir)
+{
+   fChi2 = 0.;
+   fNDF  = 0;
+   if (n < 3) return 0;
+
+   // alpha = 0 tells FitLine() that the track is a straight line
+
+   Double_t alpha = 0.;
+   if (b != 0.) {
+      THelicalTrack hel(0.,0.,1.,0.,0.,0.,0.,0.,b);
+      alpha = hel.GetPtoR();
+   }
+
+   fWbuf.resize(2*n);
+   Double_t *wr = &fWbuf[0];
+   Double_t *wz = wr + n;
+   for (Int_t i=0; i<n; i++) {
+      wr[i] = drphi[i] > 0. ? 1./(drphi[i]*drphi[i]) : 1.;
+      wz[i] = dz   [i] > 0. ? 1./(dz   [i]*dz   [i]) : 1.;
+   }
+
+   fX0.SetXYZ(x[0], y[0], z[0]);
+
+   Double_t a[3], ca[9], bl[2], cb[4];
+   if (b != 0.) {
+      if (!FitCircle  (n, x, y, wr, alpha, dir, a, ca)) return 0;
+   } else {
+      if (!FitStraight(n, x, y, wr, dir, a, ca)) return 0;
+   }
+   if (!FitLine  (n, x, y, z, wz, alpha, a, bl, cb)) return 0;
+
+   fSv.Zero();
+   fC .Zero();
+   fSv(0,0) = a[0];
+   fSv(1,0) = a[1];
+   fSv(2,0) = a[2];
+   fSv(3,0) = bl[0];
+   fSv(4,0) = bl[1];
+   for (Int_t i=0; i<3; i++) {
+      for (Int_t j=0; j<3; j++) fC(i,j) = fCovScale * ca[3*i+j];
+   }
+   for (Int_t i=0; i<2; i++) {
+      for (Int_t j=0; j<2; j++) fC(3+i,3+j) = fCovScale * cb[2*i+j];
+   }
+   if (fSdim == 6) fC(5,5) = fT0Err * fT0Err;
+
+   fNDF = b != 0. ? 2*n - 5 : 2*n - 4;
+   return 1;
+}
+
+Int_t TKalTrackSeeder::Fit(      Int_t     ncand,
+                           const Int_t    *offs,
+                           const Double_t *x,
+                           const Double_t *y,
+                           const Double_t *z,
+                           const Double_t *drphi,
+                           const Double_t *dz,
+                                 Double_t  b,
+                                 Bool_t    dir,
+                                 Double_t *sv,
+                                 Double_t *cov,
+                                 Int_t    *ok)
+{
+   Int_t nok = 0;
+   Int_t nsv = fSdim;
+   Int_t ncv = fSdim*fSdim;
+   for (Int_t ic=0; ic<ncand; ic++) {
+      Int_t first = offs[ic];
+      Int_t n     = offs[ic+1] - first;
+      Int_t stat  = Fit(n, x+first, y+first, z+first,
+                           drphi+first, dz+first, b, dir);
+      if (ok) ok[ic] = stat;
+      if (!stat) continue;
+      nok++;
+      const Double_t *svp = fSv.GetMatrixArray();
+      const Double_t *cvp = fC .GetMatrixArray();
+      for (Int_t i=0; i<nsv; i++) sv [ic*nsv+i] = svp[i];
+      for (Int_t i=0; i<ncv; i++) cov[ic*ncv+i] = cvp[i];
+   }
+   return nok;
+}
+
+void TKalTrackSeeder::InitSite(TKalTrackSite &site) const
+{
+   site.SetPivot(fX0);
+   site.SetOwner();
+   site.Add(new TKalTrackState(fSv,fC,site,TVKalSite::kPredicted,fSdim));
+   site.Add(new TKalTrackState(fSv,fC,site,TVKalSite::kFiltered ,fSdim));
+}
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Private methods
+//  ----------------------------------
+
+Int_t TKalTrackSeeder::FitCircle(      Int_t     n,
+                                 const Double_t *x,
+                                 const Double_t *y,
+                                 const Double_t *w,
+                                       Double_t  alpha,
+                                       Bool_t    dir,
+                                       Double_t *a,
+                                       Double_t *ca)
+{
+   // ---------------------------------------------
+   // (1) Conformal circle fit
+   // ---------------------------------------------
+   //   Points (u, v, u^2+v^2) on the paraboloid lie on the plane
+   //   u^2+v^2 + D u + E v + F = 0. Coordinates are taken relative
+   //   to the weighted centroid for numerical stability.
+
+   Double_t sw = 0., xm = 0., ym = 0.;
+   for (Int_t i=0; i<n; i++) {
+      sw += w[i];
+      xm += w[i]*x[i];
+      ym += w[i]*y[i];
+   }
+   xm /= sw;
+   ym /= sw;
+
+   Double_t m[9] = {0.,0.,0., 0.,0.,0., 0.,0.,0.};
+   Double_t g[3] = {0.,0.,0.};
+   for (Int_t i=0; i<n; i++) {
+      Double_t u  = x[i] - xm;
+      Double_t v  = y[i] - ym;
+      Double_t r2 = u*u + v*v;
+      m[0] += w[i]*u*u; m[1] += w[i]*u*v; m[2] += w[i]*u;
+                        m[4] += w[i]*v*v; m[5] += w[i]*v;
+                                          m[8] += w[i];
+      g[0] -= w[i]*r2*u;
+      g[1] -= w[i]*r2*v;
+      g[2] -= w[i]*r2;
+   }
+   m[3] = m[1]; m[6] = m[2]; m[7] = m[5];
+
+   Double_t mi[9];
+   if (!InvertSym3(m, mi)) return 0;
+   Double_t dd = mi[0]*g[0] + mi[1]*g[1] + mi[2]*g[2];
+   Double_t ee = mi[3]*g[0] + mi[4]*g[1] + mi[5]*g[2];
+   Double_t ff = mi[6]*g[0] + mi[7]*g[1] + mi[8]*g[2];
+   Double_t xc = xm - 0.5*dd;
+   Double_t yc = ym - 0.5*ee;
+   Double_t r2 = 0.25*(dd*dd + ee*ee) - ff;
+   if (!(r2 > 0.)) return 0;
+
+   // ---------------------------------------------
+   // (2) Helix parameters at the pivot
+   // ---------------------------------------------
+   //   The particle moves along (-sin(phi0), cos(phi0)) at the pivot
+   //   and the circle center is at x0 + (drho + rho)*(cos(phi0), sin(phi0)).
+
+   Double_t dcx = xc - x[0];
+   Double_t dcy = yc - y[0];
+   Double_t dc  = TMath::Sqrt(dcx*dcx + dcy*dcy);
+   if (dc == 0.) return 0;
+   Double_t tx  = x[1] - x[0];
+   Double_t ty  = y[1] - y[0];
+   if (dir == kIterBackward) { tx = -tx; ty = -ty; }
+
+   Double_t s   = (-dcy*tx + dcx*ty) >= 0. ? 1. : -1.;
+   Double_t rho = s * TMath::Sqrt(r2);
+   a[0] = s * dc - rho;
+   a[1] = TMath::ATan2(s*dcy, s*dcx);
+   a[2] = alpha/rho;
+
+   // ---------------------------------------------
+   // (3) Gauss-Newton on the distances to the circle
+   // ---------------------------------------------
+   //   eps_i = |rho| - |x_i - xc| with xc depending on a.
+
+   Double_t h[9], hi[9], jr[3], chi2 = 0.;
+   Bool_t   converged = kFALSE;
+   for (Int_t iter=0; ; iter++) {
+      rho = alpha/a[2];
+      s   = rho > 0. ? 1. : -1.;
+      Double_t csf0 = TMath::Cos(a[1]);
+      Double_t snf0 = TMath::Sin(a[1]);
+      Double_t rdr  = a[0] + rho;
+      xc = x[0] + rdr*csf0;
+      yc = y[0] + rdr*snf0;
+
+      for (Int_t k=0; k<9; k++) h[k] = 0.;
+      for (Int_t k=0; k<3; k++) jr[k] = 0.;
+      chi2 = 0.;
+      for (Int_t i=0; i<n; i++) {
+         Double_t ux  = x[i] - xc;
+         Double_t uy  = y[i] - yc;
+         Double_t d   = TMath::Sqrt(ux*ux + uy*uy);
+         if (d == 0.) return 0;
+         ux /= d;
+         uy /= d;
+         Double_t un  = ux*csf0 + uy*snf0;
+         Double_t ut  = uy*csf0 - ux*snf0;
+         Double_t eps = s*rho - d;
+         Double_t j0  = un;
+         Double_t j1  = rdr*ut;
+         Double_t j2  = -(rho/a[2])*(s + un);
+         h[0] += w[i]*j0*j0; h[1] += w[i]*j0*j1; h[2] += w[i]*j0*j2;
+                             h[4] += w[i]*j1*j1; h[5] += w[i]*j1*j2;
+                                                 h[8] += w[i]*j2*j2;
+         jr[0] += w[i]*j0*eps;
+         jr[1] += w[i]*j1*eps;
+         jr[2] += w[i]*j2*eps;
+         chi2  += w[i]*eps*eps;
+      }
+      h[3] = h[1]; h[6] = h[2]; h[7] = h[5];
+      if (!InvertSym3(h, hi)) return 0;
+      if (converged || iter >= fMaxIter) break;   // hi at the final a
+
+      Double_t da0 = -(hi[0]*jr[0] + hi[1]*jr[1] + hi[2]*jr[2]);
+      Double_t da1 = -(hi[3]*jr[0] + hi[4]*jr[1] + hi[5]*jr[2]);
+      Double_t da2 = -(hi[6]*jr[0] + hi[7]*jr[1] + hi[8]*jr[2]);
+      if ((a[2] + da2)*a[2] <= 0.) da2 = -0.5*a[2];   // keep the charge
+      a[0] += da0;
+      a[1] += da1;
+      a[2] += da2;
+      converged = TMath::Abs(da0) < 1.e-6 && TMath::Abs(da1) < 1.e-9 &&
+                  TMath::Abs(da2) < 1.e-9*TMath::Abs(a[2]);
+   }
+
+   // Scattering and other effects not in the hit errors show up as
+   // chi2/ndf > 1; scale the covariance accordingly.
+   Double_t scale = n > 3 ? TMath::Max(1., chi2/(n-3)) : 1.;
+   for (Int_t k=0; k<9; k++) ca[k] = scale * hi[k];
+   fChi2 += chi2;
+   return 1;
+}
+
+Int_t TKalTrackSeeder::FitStraight(      Int_t     n,
+                                   const Double_t *x,
+                                   const Double_t *y,
+                                   const Double_t *w,
+                                         Bool_t    dir,
+                                         Double_t *a,
+                                         Double_t *ca)
+{
+   // ---------------------------------------------
+   // (1) Principal axis of the weighted points
+   // ---------------------------------------------
+   //   The line through the weighted centroid along the major axis
+   //   of the scatter matrix minimises the weighted sum of squared
+   //   distances; it is oriented along the hit sequence.
+
+   Double_t sw = 0., xm = 0., ym = 0.;
+   for (Int_t i=0; i<n; i++) {
+      sw += w[i];
+      xm += w[i]*x[i];
+      ym += w[i]*y[i];
+   }
+   xm /= sw;
+   ym /= sw;
+
+   Double_t sxx = 0., sxy = 0., syy = 0.;
+   for (Int_t i=0; i<n; i++) {
+      Double_t u = x[i] - xm;
+      Double_t v = y[i] - ym;
+      sxx += w[i]*u*u;
+      sxy += w[i]*u*v;
+      syy += w[i]*v*v;
+   }
+   Double_t th = 0.5*TMath::ATan2(2.*sxy, sxx - syy);
+   Double_t ux = TMath::Cos(th);
+   Double_t uy = TMath::Sin(th);
+   Double_t tx = x[n-1] - x[0];
+   Double_t ty = y[n-1] - y[0];
+   if (dir == kIterBackward) { tx = -tx; ty = -ty; }
+   if (ux*tx + uy*ty < 0.) { ux = -ux; uy = -uy; }
+
+   // ---------------------------------------------
+   // (2) Line parameters at the pivot
+   // ---------------------------------------------
+   //   The track moves along (-sin(phi0), cos(phi0)) and passes
+   //   through x0 + drho*(cos(phi0), sin(phi0)), see TStraightTrack.
+
+   a[1] = TMath::ATan2(-ux, uy);
+   Double_t csf0 = TMath::Cos(a[1]);
+   Double_t snf0 = TMath::Sin(a[1]);
+   a[0] = (xm - x[0])*csf0 + (ym - y[0])*snf0;
+   a[2] = 0.;
+
+   // ---------------------------------------------
+   // (3) Covariance of (drho, phi0)
+   // ---------------------------------------------
+   //   eps_i = (x_i - x0).(cos(phi0), sin(phi0)) - drho, with
+   //   d eps_i/d drho = -1 and d eps_i/d phi0 = t_i, the path length.
+
+   Double_t h0 = 0., h1 = 0., h2 = 0., chi2 = 0.;
+   for (Int_t i=0; i<n; i++) {
+      Double_t t   = -(x[i] - x[0])*snf0 + (y[i] - y[0])*csf0;
+      Double_t eps = (x[i] - x[0])*csf0 + (y[i] - y[0])*snf0 - a[0];
+      h0   += w[i];
+      h1   -= w[i]*t;
+      h2   += w[i]*t*t;
+      chi2 += w[i]*eps*eps;
+   }
+   Double_t det = h0*h2 - h1*h1;
+   if (!(det > 0.)) return 0;
+
+   // kappa is not fitted: it keeps a unit variance and no correlations
+
+   Double_t scale = n > 2 ? TMath::Max(1., chi2/(n-2)) : 1.;
+   for (Int_t k=0; k<9; k++) ca[k] = 0.;
+   ca[0] =  scale * h2/det;
+   ca[1] = -scale * h1/det;
+   ca[3] = -scale * h1/det;
+   ca[4] =  scale * h0/det;
+   ca[8] =  1.;
+   fChi2 += chi2;
+   return 1;
+}
+
+Int_t TKalTrackSeeder::FitLine(      Int_t     n,
+                               const Double_t *x,
+                               const Double_t *y,
+                               const Double_t *z,
+                               const Double_t *w,
+                                     Double_t  alpha,
+                               const Double_t *a,
+                                     Double_t *bl,
+                                     Double_t *cb)
+{
+   // z(phi) = z0 + dz - rho*tanl*phi: a straight line in the
+   // transverse path length s = -rho*phi, with phi unwrapped along
+   // the hit sequence. For a straight track (alpha = 0) s is the
+   // path length along the line itself.
+
+   static const Double_t kPi    = TMath::Pi();
+   static const Double_t kTwoPi = 2.*kPi;
+
+   Double_t csf0 = TMath::Cos(a[1]);
+   Double_t snf0 = TMath::Sin(a[1]);
+   Double_t rho  = alpha != 0. ? alpha/a[2] : 0.;
+   Double_t xc   = x[0] + (a[0] + rho)*csf0;
+   Double_t yc   = y[0] + (a[0] + rho)*snf0;
+   Double_t sgn  = rho > 0. ? 1. : -1.;
+
+   Double_t s0 = 0., s1 = 0., s2 = 0., t0 = 0., t1 = 0., t2 = 0.;
+   Double_t phiprev = 0.;
+   for (Int_t i=0; i<n; i++) {
+      Double_t s;
+      if (alpha != 0.) {
+         Double_t phi = TMath::ATan2(-sgn*(y[i]-yc), -sgn*(x[i]-xc)) - a[1];
+         while (phi - phiprev >  kPi) phi -= kTwoPi;
+         while (phi - phiprev < -kPi) phi += kTwoPi;
+         phiprev = phi;
+         s = -rho*phi;
+      } else {
+         s = -(x[i]-x[0])*snf0 + (y[i]-y[0])*csf0;
+      }
+      Double_t zz = z[i] - z[0];
+      s0 += w[i];
+      s1 += w[i]*s;
+      s2 += w[i]*s*s;
+      t0 += w[i]*zz;
+      t1 += w[i]*s*zz;
+      t2 += w[i]*zz*zz;
+   }
+   Double_t det = s0*s2 - s1*s1;
+   if (!(det > 0.)) return 0;
+
+   bl[0] = (s2*t0 - s1*t1)/det;   // dz
+   bl[1] = (s0*t1 - s1*t0)/det;   // tanl
+
+   // sum w (zz - dz - tanl*s)^2
+   Double_t chi2 = t2 - 2.*(bl[0]*t0 + bl[1]*t1)
+                 + bl[0]*bl[0]*s0 + 2.*bl[0]*bl[1]*s1 + bl[1]*bl[1]*s2;
+   chi2 = TMath::Max(chi2, 0.);
+   fChi2 += chi2;
+
+   Double_t scale = n > 2 ? TMath::Max(1., chi2/(n-2)) : 1.;
+   cb[0] =  scale * s2/det;
+   cb[1] = -scale * s1/det;
+   cb[2] = -scale * s1/det;
+   cb[3] =  scale * s0/det;
+   return 1;
+}
@@ -0,0 +1,131 @@
+#ifndef TKALTRACKSEEDER_H
+#define TKALTRACKSEEDER_H
+//*************************************************************************
+//* =======================
+//*  TKalTrackSeeder Class
+//* =======================
+//*
+//* (Description)
+//*   Initial track state from all hits of a track candidate.
+//*   A conformal (paraboloid) circle fit gives the starting circle,
+//*   which is refined by a few Gauss-Newton steps in (drho, phi0,
+//*   kappa) at the pivot, followed by a linear s-z fit for (dz, tanl).
+//*   The resulting state vector and covariance matrix replace the
+//*   3-point helix and dummy error matrix used to start the filter.
+//*   Without magnetic field the seed is a straight line: a principal
+//*   axis fit in the transverse plane for (drho, phi0), kappa = 0 and
+//*   not fitted, and the same s-z fit along the line.
+//* (Requires)
+//*     TKalTrackSite, TKalTrackState, TVTrackHit
+//* (Provides)
+//*     class TKalTrackSeeder
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Straight-line seed for b = 0.
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include "TObjArray.h"      // from ROOT
+#include "TVector3.h"       // from ROOT
+#include "TKalMatrix.h"     // from KalLib
+#include "KalTrackDim.h"    // from KalTrackLib
+#include <vector>           // from STL
+
+class TKalTrackSite;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for track seeding
+//  ---------------------------------
+//
+class TKalTrackSeeder : public TObject {
+public:
+   TKalTrackSeeder(Int_t sdim = kSdim);
+   virtual ~TKalTrackSeeder() {}
+
+   // Fit the hits in the order they are going to be filtered.
+   // dir has the meaning of THelicalTrack(x1,x2,x3,b,dir): the
+   // resulting helix points from the last to the first hit if
+   // dir = kIterBackward. The pivot is at the first 2-dim hit.
+   // Returns 1 on success, 0 otherwise.
+
+   Int_t  Fit(const TObjArray &hits, Bool_t dir = kIterForward);
+
+   // Same on plain arrays of n space points with transverse and
+   // longitudinal errors, in field b [T].
+
+   Int_t  Fit(      Int_t     n,
+              const Double_t *x,
+              const Double_t *y,
+              const Double_t *z,
+              const Double_t *drphi,
+              const Double_t *dz,
+                    Double_t  b,
+                    Bool_t    dir = kIterForward);
+
+   // Batch version: candidate i uses points [offs[i], offs[i+1]).
+   // Writes sdim parameters per candidate to sv and sdim*sdim
+   // covariance elements to cov, and the status to ok (if given).
+   // Returns the number of successful fits.
+
+   Int_t  Fit(      Int_t     ncand,
+              const Int_t    *offs,
+              const Double_t *x,
+              const Double_t *y,
+              const Double_t *z,
+              const Double_t *drphi,
+              const Double_t *dz,
+                    Double_t  b,
+                    Bool_t    dir,
+                    Double_t *sv,
+                    Double_t *cov,
+                    Int_t    *ok = 0);
+
+   // Put the seed into site as its predicted and filtered states.
+   // The site pivot is moved to the seed pivot.
+
+   void   InitSite(TKalTrackSite &site) const;
+
+   inline const TKalMatrix & GetStateVec() const { return fSv;    }
+   inline const TKalMatrix & GetCovMat  () const { return fC;     }
+   inline const TVector3   & GetPivot   () const { return fX0;    }
+   inline       Double_t     GetChi2    () const { return fChi2;  }
+   inline       Int_t        GetNDF     () const { return fNDF;   }
+
+   // The seed covariance is multiplied by fCovScale; values > 1 avoid
+   // counting the hits twice when the same hits are filtered later.
+   inline void  SetCovScale(Double_t s)  { fCovScale = s;    }
+   inline void  SetT0Error (Double_t e)  { fT0Err    = e;    }
+   inline void  SetMaxIter (Int_t    n)  { fMaxIter  = n;    }
+
+private:
+   Int_t  FitCircle(Int_t n, const Double_t *x, const Double_t *y,
+                    const Double_t *w, Double_t alpha, Bool_t dir,
+                    Double_t *a, Double_t *ca);
+   Int_t  FitStraight(Int_t n, const Double_t *x, const Double_t *y,
+                    const Double_t *w, Bool_t dir,
+                    Double_t *a, Double_t *ca);
+   Int_t  FitLine  (Int_t n, const Double_t *x, const Double_t *y,
+                    const Double_t *z, const Double_t *w,
+                    Double_t alpha, const Double_t *a,
+                    Double_t *b, Double_t *cb);
+
+private:
+   Int_t       fSdim;       // state vector dimension
+   Int_t       fMaxIter;    // max. number of Gauss-Newton iterations
+   Double_t    fCovScale;   // covariance scale factor
+   Double_t    fT0Err;      // t0 error (sdim = 6 only)
+   TKalMatrix  fSv;         // fitted state vector
+   TKalMatrix  fC;          // its covariance matrix
+   TVector3    fX0;         // pivot
+   Double_t    fChi2;       // chi2 of circle + line fits
+   Int_t       fNDF;        // degrees of freedom
+
+   std::vector<Double_t> fBuf;   //! scratch buffer for hit coordinates
+   std::vector<Double_t> fWbuf;  //! scratch buffer for weights
+
+   ClassDef(TKalTrackSeeder,1)  // track seeder
+};
+
+#endif
@@ -15,6 +15,7 @@
 //*                                 for which pivot is at the xpected hit.
 //*                                 Modified IsAccepted() to allow user-
 //*                                 defined filter conditions.
+//*   2026/10/18                    Added GetMonitorIndex().
 //*
 //*************************************************************************
 
@@ -22,6 +23,7 @@
 #include "TKalTrackState.h"   // from KalTrackLib
 #include "TVTrackHit.h"       // from KalTrackLib
 #include "TKalFilterCond.h"   // from KalTrackLib
+#include "TVMeasLayer.h"      // from KalTrackLib
 #include "TVSurface.h"        // from GeomLib
 #include "TBField.h"          // from Bfield
 
@@ -183,6 +185,11 @@ Bool_t TKalTrackSite::IsAccepted()
    else          return kTRUE;
 }
 
+Int_t TKalTrackSite::GetMonitorIndex() const
+{
+   return GetHit().GetMeasLayer().GetIndex();
+}
+
 void TKalTrackSite::DebugPrint() const
 {
    cout << " dchi2 = " << GetDeltaChi2()   << endl;
@@ -16,6 +16,7 @@
 //*   2004/09/17  K.Fujii           Added ownership flag.
 //*   2010/04/06  K.Fujii           Added a setter for the pivot and a
 //*                                 condition object
+//*   2026/10/18                    Added GetMonitorIndex().
 //*
 //*************************************************************************
 
@@ -50,6 +51,8 @@ public:
 
    void         DebugPrint() const;
 
+   Int_t        GetMonitorIndex() const;   // index of the measurement layer
+
    inline       TTrackFrame GetFrame() const { return fFrame; }
 
    inline  void SetFrame(TTrackFrame frame) { fFrame = frame; }
@@ -17,6 +17,7 @@
 //*                                 function.
 //*   2010/04/06  K.Fujii           Modified MoveTo to allow a 1-dim hit,
 //*                                 for which pivot is at the xpected hit.
+//*   2026/10/18                    Added a c-tor with an explicit pivot.
 //*
 //*************************************************************************
 
@@ -72,6 +73,14 @@ TKalTrackState::TKalTrackState(const TKalMatrix &sv, const TKalMatrix &c,
 {
 }
 
+TKalTrackState::TKalTrackState(const TKalMatrix &sv, const TKalMatrix &c,
+                               const TVKalSite &site, const TVector3 &x0,
+                                     Int_t type, Int_t p) 
+           : TVKalState(sv,c,site,type,p),
+             fX0(x0)
+{
+}
+
 //_________________________________________________________________________
 // ----------------------------------------------
 //  Implementation of base-class pure virtuals
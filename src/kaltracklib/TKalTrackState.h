@@ -18,6 +18,8 @@
 //*   2005/08/13  K.Fujii           Removed CalcProcessNoise method.
 //*   2010/04/06  K.Fujii           Modified MoveTo to allow a 1-dim hit,
 //*                                 for which pivot is at the xpected hit.
+//*   2026/10/18                    Added GetPivot().
+//*   2026/10/18                    Added a c-tor with an explicit pivot.
 //*
 //*************************************************************************
 
@@ -49,6 +51,10 @@ public:
                         Int_t		 type		  = 0, Int_t p = kSdim);
    TKalTrackState(const TKalMatrix	&sv, const TKalMatrix &c,
                   const TVKalSite	&site, Int_t type = 0, Int_t p = kSdim);
+   // pivot x0 instead of that of the site, which is not read
+   TKalTrackState(const TKalMatrix	&sv, const TKalMatrix &c,
+                  const TVKalSite	&site, const TVector3 &x0,
+                        Int_t		 type		  = 0, Int_t p = kSdim);
    virtual ~TKalTrackState() {}
                                                                                 
    // Implementation of paraent class pure virtuals
@@ -69,6 +75,8 @@ public:
    TStraightTrack  GetLine () const;
    TVTrack        &CreateTrack() const;
 
+   inline const TVector3 & GetPivot() const { return fX0; }
+
 private:
 
    TVector3 fX0{};		// local pivot
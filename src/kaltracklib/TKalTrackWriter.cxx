@@ -0,0 +1,210 @@
+//*************************************************************************
+//* =======================
+//*  TKalTrackWriter Class
+//* =======================
+//*
+//* (Description)
+//*   Streaming writer of compact binary track records.
+//* (Requires)
+//*     TKalTrack, TKalTrackSite, TKalTrackState
+//* (Provides)
+//*     class TKalTrackWriter
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Added GetMatrixSize().
+//*
+//*************************************************************************
+
+#include "TKalTrackWriter.h"    // from KalTrackLib
+#include "TKalTrack.h"          // from KalTrackLib
+#include "TKalTrackSite.h"      // from KalTrackLib
+#include "TKalTrackState.h"     // from KalTrackLib
+#include "TBufferFile.h"        // from ROOT
+#include <cstring>              // from STL
+
+using namespace std;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for track record output
+//  ---------------------------------
+//
+ClassImp(TKalTrackWriter)
+
+//-------------------------------------------------------
+// Ctor
+//-------------------------------------------------------
+
+TKalTrackWriter::TKalTrackWriter(ostream &os, Int_t flags)
+               : fOsPtr(&os),
+                 fFlags(flags),
+                 fSdim(0),
+                 fNtracks(0),
+                 fNbytes(0)
+{
+   memset(&fHeader, 0, sizeof(Header));
+}
+
+//-------------------------------------------------------
+// WriteTrack
+//-------------------------------------------------------
+
+Int_t TKalTrackWriter::WriteTrack(TKalTrack &kt, Int_t select, Int_t id)
+{
+   Int_t nsites = kt.GetEntries();
+   if (!nsites) return 0;
+
+   TKalTrackSite &last = *static_cast<TKalTrackSite *>(kt.At(nsites-1));
+   BeginTrack(id < 0 ? fNtracks : id, last.GetBfield(), kt.GetChi2(), kt.GetNDF());
+
+   for (Int_t i=0; i<nsites; i++) {
+      Bool_t selected = (select & kAllSites)
+                     || (i == 0          && (select & kFirstSite))
+                     || (i == nsites - 1 && (select & kLastSite));
+      if (!selected) continue;
+
+      TKalTrackSite &site = *static_cast<TKalTrackSite *>(kt.At(i));
+      Int_t type = site.GetEntries() > TVKalSite::kSmoothed ? TVKalSite::kSmoothed
+                                                            : site.GetEntries() - 1;
+      if (type < 0) continue;
+      AddState(static_cast<TKalTrackState &>(site.GetState(TVKalSite::EStType(type))),
+               i, type);
+   }
+   return EndTrack();
+}
+
+//-------------------------------------------------------
+// BeginTrack, AddState, EndTrack
+//-------------------------------------------------------
+
+void TKalTrackWriter::BeginTrack(Int_t id, Double_t bfield, Double_t chi2, Int_t ndf)
+{
+   memset(&fHeader, 0, sizeof(Header));
+   fHeader.fMagic    = kMagic;
+   fHeader.fVersion  = kVersion;
+   fHeader.fFlags    = fFlags;
+   fHeader.fTrackID  = id;
+   fHeader.fNDF      = ndf;
+   fHeader.fBfield   = bfield;
+   fHeader.fChi2     = chi2;
+   fSdim = 0;
+   fBlock.resize(sizeof(Header));
+}
+
+void TKalTrackWriter::AddState(const TKalTrackState &a, Int_t site, Int_t type)
+{
+   Int_t sdim = a.GetDimension();
+   if (!fSdim) {
+      fSdim = sdim;
+      fHeader.fSdim = sdim;
+   } else if (sdim != fSdim) {
+      cerr << ">>>> Error!! TKalTrackWriter::AddState >>>>>>>>>>>" << endl
+           << " State dimension " << sdim << " != " << fSdim << endl;
+      return;
+   }
+
+   Char_t tag[8] = {0};
+   memcpy(tag, &site, sizeof(Int_t));
+   tag[4] = type;
+   fBlock.insert(fBlock.end(), tag, tag + 8);
+
+   TVector3 x0 = static_cast<const TKalTrackSite &>(a.GetSite()).GetPivot();
+   Put(x0.X());
+   Put(x0.Y());
+   Put(x0.Z());
+   for (Int_t i=0; i<sdim; i++) Put(a(i,0));
+   const TKalMatrix &c = a.GetCovMat();
+   for (Int_t i=0; i<sdim; i++) {
+      for (Int_t j=0; j<=i; j++) Put(c(i,j));
+   }
+   fHeader.fNstates++;
+}
+
+Int_t TKalTrackWriter::EndTrack()
+{
+   fHeader.fNbytes   = fBlock.size();
+   fHeader.fChecksum = 0;
+   memcpy(&fBlock[0], &fHeader, sizeof(Header));
+   fHeader.fChecksum = Checksum(&fBlock[0], fBlock.size());
+   memcpy(&fBlock[0], &fHeader, sizeof(Header));
+
+   fOsPtr->write(&fBlock[0], fBlock.size());
+   if (!*fOsPtr) {
+      cerr << ">>>> Error!! TKalTrackWriter::EndTrack >>>>>>>>>>>" << endl
+           << " Write failed." << endl;
+      return 0;
+   }
+   fNtracks++;
+   fNbytes += fBlock.size();
+   return fBlock.size();
+}
+
+void TKalTrackWriter::Put(Double_t v)
+{
+   if (fFlags & kFloat32) {
+      Float_t f = v;
+      const Char_t *p = reinterpret_cast<const Char_t *>(&f);
+      fBlock.insert(fBlock.end(), p, p + sizeof(Float_t));
+   } else {
+      const Char_t *p = reinterpret_cast<const Char_t *>(&v);
+      fBlock.insert(fBlock.end(), p, p + sizeof(Double_t));
+   }
+}
+
+//-------------------------------------------------------
+// Static utilities
+//-------------------------------------------------------
+
+Int_t TKalTrackWriter::GetStreamedSize(const TObject &obj)
+{
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteObject(&obj);
+   return buf.Length();
+}
+
+Long64_t TKalTrackWriter::GetMatrixSize(TKalTrack &kt)
+{
+   // A ROOT buffer holds every element of the site matrices (M, V, H,
+   // H^t, residual, R) and of the state matrices (a, F, F^t, Q, C),
+   // plus object headers and versions not counted here.
+
+   Long64_t n = 0;
+   TIter next(&kt);
+   TKalTrackSite *sitep;
+   while ((sitep = static_cast<TKalTrackSite *>(next()))) {
+      TKalTrackSite &site = *sitep;
+      Int_t sdim = 0;
+      for (Int_t t=0; t<site.GetEntriesFast(); t++) {
+         const TVKalState *ap = static_cast<TVKalState *>(site.UncheckedAt(t));
+         if (!ap) continue;
+         sdim = ap->GetNrows();
+         n   += ap->GetNoElements()
+              + ap->GetPropMat().GetNoElements()
+              + ap->GetPropMat("T").GetNoElements()
+              + ap->GetProcNoiseMat().GetNoElements()
+              + ap->GetCovMat().GetNoElements();
+      }
+      n += site.GetMeasVec().GetNoElements()
+         + site.GetMeasNoiseMat().GetNoElements()
+         + site.GetResVec().GetNoElements()
+         + site.GetCovMat().GetNoElements()
+         + 2 * site.GetDimension() * sdim;           // H and H^t
+   }
+   return n * sizeof(Double_t);
+}
+
+Int_t TKalTrackWriter::GetStateSize(Int_t sdim, Int_t flags)
+{
+   Int_t nreal = 3 + sdim + sdim * (sdim + 1) / 2;
+   return 8 + nreal * ((flags & kFloat32) ? sizeof(Float_t) : sizeof(Double_t));
+}
+
+UInt_t TKalTrackWriter::Checksum(const Char_t *buf, Int_t n, UInt_t h)
+{
+   // FNV-1a; pass the result as h to continue over another buffer
+   for (Int_t i=0; i<n; i++) {
+      h ^= static_cast<UChar_t>(buf[i]);
+      h *= 16777619u;
+   }
+   return h;
+}
@@ -0,0 +1,125 @@
+#ifndef TKALTRACKWRITER_H
+#define TKALTRACKWRITER_H
+//*************************************************************************
+//* =======================
+//*  TKalTrackWriter Class
+//* =======================
+//*
+//* (Description)
+//*   Streaming writer of compact binary track records.
+//*   Each track is written as one self-contained block:
+//*
+//*     Header   (48 bytes)  magic, version, flags, sdim, track id,
+//*                          number of states, ndf, block size,
+//*                          B field, chi2, checksum
+//*     State    (n times)   site index (Int_t), state type (UChar_t),
+//*                          3 padding bytes, then pivot (3), state
+//*                          vector (sdim) and the lower triangle of
+//*                          the covariance matrix (sdim*(sdim+1)/2,
+//*                          row by row) as Double_t, or as Float_t
+//*                          if kFloat32 is set.
+//*
+//*   The checksum is FNV-1a over the whole block with the checksum
+//*   field set to zero. Numbers are in native byte order.
+//*   Propagator and process noise matrices are not written.
+//*   TKalTrackReader reads the blocks back.
+//* (Requires)
+//*     TKalTrack, TKalTrackSite, TKalTrackState
+//* (Provides)
+//*     class TKalTrackWriter
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Added GetMatrixSize().
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include <iostream>         // from STL
+#include <vector>           // from STL
+
+class TKalTrack;
+class TKalTrackState;
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for track record output
+//  ---------------------------------
+//
+class TKalTrackWriter : public TObject {
+public:
+   enum EFlags  { kFloat32   = 1 };
+   enum ESelect { kFirstSite = 1,      // state at the first site
+                  kLastSite  = 2,      // state at the last site
+                  kAllSites  = 4 };    // states at all sites
+
+   // Block header, as laid out in the output
+
+   struct Header {
+      UInt_t   fMagic;       // kMagic
+      UShort_t fVersion;     // kVersion
+      UChar_t  fFlags;       // EFlags
+      UChar_t  fSdim;        // state vector dimension
+      Int_t    fTrackID;     // track id given by the user
+      UShort_t fNstates;     // number of states in the block
+      UShort_t fReserved;    // unused
+      Int_t    fNDF;         // degrees of freedom of the track
+      UInt_t   fNbytes;      // block size including the header
+      Double_t fBfield;      // B field [kG]
+      Double_t fChi2;        // chi2 of the track
+      UInt_t   fChecksum;    // FNV-1a of the block
+      UInt_t   fPad;         // unused
+   };
+
+   static const UInt_t   kMagic   = 0x4b54524b;  // "KRTK"
+   static const UShort_t kVersion = 1;
+
+   TKalTrackWriter(std::ostream &os, Int_t flags = 0);
+   virtual ~TKalTrackWriter() {}
+
+   // Write the current states of the selected sites of kt (smoothed
+   // if available, else filtered). Returns the bytes written.
+
+   Int_t  WriteTrack(TKalTrack &kt, Int_t select = kFirstSite | kLastSite,
+                     Int_t id = -1);
+
+   // Low level interface: one BeginTrack(), any number of AddState(),
+   // one EndTrack() per track. EndTrack() returns the bytes written.
+
+   void   BeginTrack(Int_t id, Double_t bfield, Double_t chi2 = 0., Int_t ndf = 0);
+   void   AddState  (const TKalTrackState &a, Int_t site, Int_t type);
+   Int_t  EndTrack  ();
+
+   inline Int_t    GetNtracks      () const { return fNtracks; }
+   inline Long64_t GetNbytes       () const { return fNbytes;  }
+   inline Double_t GetBytesPerTrack() const
+                   { return fNtracks ? Double_t(fNbytes) / fNtracks : 0.; }
+
+   // Size of obj in a ROOT buffer, to compare with the record size
+
+   static Int_t   GetStreamedSize(const TObject &obj);
+
+   // Bytes of the matrix elements held by the sites of kt and their
+   // states; a lower bound of GetStreamedSize(kt) without ROOT I/O
+
+   static Long64_t GetMatrixSize(TKalTrack &kt);
+
+   static Int_t   GetStateSize(Int_t sdim, Int_t flags);
+   static UInt_t  Checksum    (const Char_t *buf, Int_t n,
+                               UInt_t        h = 2166136261u);
+
+private:
+   void   Put(Double_t v);
+
+private:
+   std::ostream      *fOsPtr;     //! output stream
+   Int_t              fFlags;     // EFlags
+   Int_t              fSdim;      // state dimension of the current track
+   Header             fHeader;    //! header of the current track
+   std::vector<Char_t> fBlock;    //! current block
+   Int_t              fNtracks;   // number of tracks written
+   Long64_t           fNbytes;    // number of bytes written
+
+   ClassDef(TKalTrackWriter,1)  // track record writer
+};
+
+#endif
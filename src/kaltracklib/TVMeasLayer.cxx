@@ -25,6 +25,10 @@
 //*                                 default value set to "TVMeasLayer"
 //*                                 and corresponding member function
 //*                                 TString GetName()
+//*   2026/10/18                    Split the material constants off
+//*                                 GetEnergyLoss() and CalcQms().
+//*   2026/10/18                    No kappa noise for straight tracks.
+//*   2026/10/18                    Material constants computed once.
 //*
 //*************************************************************************
 
@@ -48,6 +52,8 @@ TVMeasLayer::TVMeasLayer(TMaterial     &matIn,
              fIsActive(isactive),
              fname(name)
 {
+   SetMatConst(matIn,  fMatConst[0]);
+   SetMatConst(matOut, fMatConst[1]);
 }
 
 //_________________________________________________________________________
@@ -63,6 +69,70 @@ TVMeasLayer::TVMeasLayer(TMaterial     &matIn,
 Double_t TVMeasLayer::GetEnergyLoss(      Bool_t    isoutgoing,
                                     const TVTrack  &hel,
                                           Double_t  df) const
+{
+   const TMaterial *mp = &GetMaterial(isoutgoing);
+   if (mp == (isoutgoing ? fMaterialOutPtr : fMaterialInPtr)) {
+      return CalcEnergyLoss(fMatConst[isoutgoing ? 1 : 0], hel, df);
+   }
+   MatConst mat;
+   SetMatConst(*mp, mat);
+   return CalcEnergyLoss(mat, hel, df);
+}
+
+//_________________________________________________________________________
+// -----------------
+//  CalQms
+// -----------------
+//    calculates process noise matrix for multiple scattering with
+//    thin layer approximation.
+//
+void TVMeasLayer::CalcQms(      Bool_t       isoutgoing,
+                          const TVTrack     &hel,
+                                Double_t     df,
+                                TKalMatrix  &Qms) const
+{
+   const TMaterial *mp = &GetMaterial(isoutgoing);
+   if (mp == (isoutgoing ? fMaterialOutPtr : fMaterialInPtr)) {
+      CalcMSNoise(fMatConst[isoutgoing ? 1 : 0], hel, df, Qms);
+      return;
+   }
+   MatConst mat;
+   SetMatConst(*mp, mat);
+   CalcMSNoise(mat, hel, df, Qms);
+}
+
+//_________________________________________________________________________
+// -----------------
+//  SetMatConst
+// -----------------
+//    fills the constants of material m.
+//
+void TVMeasLayer::SetMatConst(const TMaterial &m, MatConst &mat)
+{
+   Double_t dnsty = m.GetDensity();		// density
+   Double_t A     = m.GetA();                   // atomic mass
+   Double_t Z     = m.GetZ();                   // atomic number
+   //Double_t I    = Z * 1.e-8;			// mean excitation energy [GeV]
+   //Double_t I    = (2.4 +Z) * 1.e-8;		// mean excitation energy [GeV]
+   Double_t I    = (9.76 * Z + 58.8 * TMath::Power(Z, -0.19)) * 1.e-9;
+   Double_t hwp  = 28.816 * TMath::Sqrt(dnsty * Z/A) * 1.e-9;
+
+   mat.fDensity = dnsty;
+   mat.fA       = A;
+   mat.fZ       = Z;
+   mat.fI       = I;
+   mat.fC0      = - (2. * log(I/hwp) + 1.);
+   mat.fX0Inv   = 1. / m.GetRadLength();  // radiation length inverse
+}
+
+//_________________________________________________________________________
+// -----------------
+//  CalcEnergyLoss
+// -----------------
+//
+Double_t TVMeasLayer::CalcEnergyLoss(const MatConst &mat,
+                                     const TVTrack  &hel,
+                                           Double_t  df)
 {
    Double_t cpa    = hel.GetKappa();
    Double_t tnl    = hel.GetTanLambda(); 
@@ -83,19 +153,15 @@ Double_t TVMeasLayer::GetEnergyLoss(      Bool_t    isoutgoing,
    TKalTrack *ktp  = static_cast<TKalTrack *>(TVKalSystem::GetCurInstancePtr());
    Double_t   mass = ktp ? ktp->GetMass() : kMpi;
 
-   const TMaterial &mat = GetMaterial(isoutgoing);
-   Double_t dnsty = mat.GetDensity();		// density
-   Double_t A     = mat.GetA();                 // atomic mass
-   Double_t Z     = mat.GetZ();                 // atomic number
-   //Double_t I    = Z * 1.e-8;			// mean excitation energy [GeV]
-   //Double_t I    = (2.4 +Z) * 1.e-8;		// mean excitation energy [GeV]
-   Double_t I    = (9.76 * Z + 58.8 * TMath::Power(Z, -0.19)) * 1.e-9;
-   Double_t hwp  = 28.816 * TMath::Sqrt(dnsty * Z/A) * 1.e-9;
+   Double_t dnsty = mat.fDensity;
+   Double_t A     = mat.fA;
+   Double_t Z     = mat.fZ;
+   Double_t I     = mat.fI;
    Double_t bg2  = mom2 / (mass * mass);
    Double_t gm2  = 1. + bg2;
    Double_t meM  = kMe / mass;
    Double_t x    = log10(TMath::Sqrt(bg2));
-   Double_t C0   = - (2. * log(I/hwp) + 1.);
+   Double_t C0   = mat.fC0;
    Double_t a    = -C0/27.;
    Double_t del;
    if (x >= 3.)            del = 4.606 * x + C0;
@@ -128,15 +194,13 @@ Double_t TVMeasLayer::GetEnergyLoss(      Bool_t    isoutgoing,
 
 //_________________________________________________________________________
 // -----------------
-//  CalQms
+//  CalcMSNoise
 // -----------------
-//    calculates process noise matrix for multiple scattering with
-//    thin layer approximation.
 //
-void TVMeasLayer::CalcQms(      Bool_t       isoutgoing,
-                          const TVTrack     &hel,
-                                Double_t     df,
-                                TKalMatrix  &Qms) const
+void TVMeasLayer::CalcMSNoise(const MatConst   &mat,
+                              const TVTrack    &hel,
+                                    Double_t    df,
+                                    TKalMatrix &Qms)
 {
    Double_t cpa    = hel.GetKappa();
    Double_t tnl    = hel.GetTanLambda(); 
@@ -145,15 +209,15 @@ void TVMeasLayer::CalcQms(      Bool_t       isoutgoing,
    Double_t cpatnl = cpa * tnl;
    Double_t cslinv = TMath::Sqrt(tnl21);
    Double_t mom    = TMath::Abs(1. / cpa) * cslinv;
-   if(!hel.IsInB()) mom = hel.GetMomentum();
+   // For straight track, the momentum is fixed and kappa is not fitted.
+   if(!hel.IsInB()) { mom = hel.GetMomentum(); cpatnl = 0.; }
 
    static const Double_t kMpi = 0.13957018; // pion mass [GeV]
    TKalTrack *ktp  = static_cast<TKalTrack *>(TVKalSystem::GetCurInstancePtr());
    Double_t   mass = ktp ? ktp->GetMass() : kMpi;
    Double_t   beta = mom / TMath::Sqrt(mom * mom + mass * mass);
 
-   const TMaterial &mat = GetMaterial(isoutgoing);
-   Double_t x0inv = 1. / mat.GetRadLength();  // radiation length inverse
+   Double_t x0inv = mat.fX0Inv;  // radiation length inverse
 
    // *Calculate sigma_ms0 =============================================
    static const Double_t kMS1  = 0.0136;
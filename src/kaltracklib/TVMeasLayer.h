@@ -25,6 +25,11 @@
 //*                                 default value set to "TVMeasLayer"
 //*                                 and corresponding member function
 //*                                 TString GetName()  
+//*   2026/10/18                    Added MatConst and the static
+//*                                 CalcEnergyLoss() and CalcMSNoise()
+//*                                 used by TKalDetCradle.
+//*   2026/10/18                    Constants of the materials kept in
+//*                                 fMatConst.
 //*
 //*************************************************************************
 
@@ -39,6 +44,18 @@ class TVTrackHit;
 
 class TVMeasLayer : public TAttElement {
 public:
+   // Material constants used by the energy loss and multiple
+   // scattering formulae, see SetMatConst()
+
+   struct MatConst {
+      Double_t fDensity;   // density [g/cm^3]
+      Double_t fA;         // atomic mass
+      Double_t fZ;         // atomic number
+      Double_t fI;         // mean excitation energy [GeV]
+      Double_t fC0;        // density effect: -(2 ln(I/hw_p) + 1)
+      Double_t fX0Inv;     // radiation length inverse [1/cm]
+   };
+
    // Ctors and Dtor
    TVMeasLayer(const TVMeasLayer&) = default ;
    TVMeasLayer& operator=(const TVMeasLayer&) = default ;
@@ -74,6 +91,21 @@ public:
                                            TKalMatrix &Qms) const;
 
   inline TString       GetName() const { return fname;    }
+
+   // GetEnergyLoss() and CalcQms() with the constants of the material
+   // traversed taken from mat. The layer keeps those of its own inner
+   // and outer materials; an override of GetMaterial() returning
+   // another material has its constants computed on each call.
+
+   static void       SetMatConst   (const TMaterial &m,
+                                          MatConst  &mat);
+   static Double_t   CalcEnergyLoss(const MatConst  &mat,
+                                    const TVTrack   &hel,
+                                          Double_t   df);
+   static void       CalcMSNoise   (const MatConst  &mat,
+                                    const TVTrack   &hel,
+                                          Double_t   df,
+                                          TKalMatrix &Qms);
   
 private:
    TMaterial     *fMaterialInPtr{};   // pointer of inner Material
@@ -81,6 +113,7 @@ private:
    Int_t          fIndex{};           // index in TKalDetCradle
    Bool_t         fIsActive{};        // flag to tell layer is active or not
   const Char_t   *fname{};
+   MatConst       fMatConst[2];       //! constants of inner [0] and outer [1] Material
    ClassDef(TVMeasLayer,1)      // Measurement layer interface class
 };
 
@@ -10,6 +10,7 @@
 //*     class TVTrackHit
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
+//*   2026/10/18                    Added SetHit() for hit views.
 //*
 //*************************************************************************
 
@@ -52,3 +53,18 @@ TVTrackHit::TVTrackHit(const TVTrackHit &hit)
 TVTrackHit::~TVTrackHit()
 {
 }
+
+//_________________________________________________________________________
+//  ----------------------------------
+//  Setter for reused hits
+//  ----------------------------------
+
+void TVTrackHit::SetHit(const TVMeasLayer &ms, const Double_t *xdx, Double_t b)
+{
+   fMeasLayerPtr = const_cast<TVMeasLayer *>(&ms);
+   fBfield       = b;
+   for (Int_t i=0; i<fDim; i++) {
+      (*this)(i,0) = xdx[2*i];
+      (*this)(i,1) = xdx[2*i+1];
+   }
+}
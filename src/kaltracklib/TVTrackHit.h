@@ -14,6 +14,7 @@
 //* (Update Recored)
 //*   2003/09/30  Y.Nakashima       Original version.
 //*   2005/08/11  K.Fujii           Removed fXX and its getter and setter.
+//*   2026/10/18                    Added SetHit() for hit views.
 //*
 //*************************************************************************
 
@@ -47,6 +48,12 @@ public:
 
   //   virtual void       DebugPrint(Option_t *opt = "")        const = 0;
 
+protected:
+   // Reset layer, B field and the (x, dx) pairs xdx[2*m] of an
+   // existing hit, for hit classes that are reused (TKalHitView).
+
+   void SetHit(const TVMeasLayer &ms, const Double_t *xdx, Double_t b);
+
 private:
    Int_t         fDim{};            // dimension of coordinate space
    Double_t      fBfield{};         // B field
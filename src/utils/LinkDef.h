@@ -7,5 +7,6 @@
 #pragma link C++ class TAttDrawable+;
 #pragma link C++ class TAttElement+;
 #pragma link C++ class TAttLockable+;
+#pragma link C++ class TKalStats+;
 
 #endif
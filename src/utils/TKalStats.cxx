@@ -0,0 +1,316 @@
+//*************************************************************************
+//* =================
+//*  TKalStats Class
+//* =================
+//*
+//* (Description)
+//*   Counters and cycle timers for the hot paths of the fit, and the
+//*   allocation accounting with its global operator new.
+//* (Requires)
+//*     TObject
+//* (Provides)
+//*     class TKalStats
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Added allocation accounting.
+//*
+//*************************************************************************
+
+#include "TKalStats.h"          // from Utils
+
+#include <atomic>               // from STL
+#include <chrono>               // from STL
+#include <cstdlib>              // from STL
+#include <cstring>              // from STL
+#include <mutex>                // from STL
+#include <new>                  // from STL
+#include <vector>               // from STL
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>          // from compiler
+#endif
+
+using namespace std;
+
+namespace {
+   // Per-thread block, written by its thread only. The relaxed atomics
+   // let GetSnapshot() read it from another thread.
+
+   struct Block {
+      atomic<ULong64_t> fCount [TKalStats::kNcounters];
+      atomic<ULong64_t> fCalls [TKalStats::kNtimers];
+      atomic<ULong64_t> fCycles[TKalStats::kNtimers];
+      atomic<ULong64_t> fAllocs[TKalStats::kNallocTags];
+      atomic<ULong64_t> fBytes [TKalStats::kNallocTags];
+
+      Block()
+      {
+         for (Int_t i=0; i<TKalStats::kNcounters;  i++) fCount[i] = 0;
+         for (Int_t i=0; i<TKalStats::kNtimers;    i++) fCalls[i] = fCycles[i] = 0;
+         for (Int_t i=0; i<TKalStats::kNallocTags; i++) fAllocs[i] = fBytes[i] = 0;
+      }
+   };
+
+   inline void Inc(atomic<ULong64_t> &a, ULong64_t n)
+   {
+      a.store(a.load(memory_order_relaxed) + n, memory_order_relaxed);
+   }
+
+   // Blocks are never deleted, so that the counts of finished threads
+   // stay in the sums; Reset() moves the baseline instead of clearing.
+   // The list is created on first use, since operator new may need it
+   // before the static constructors of this file have run.
+
+   mutex               gMutex;
+   TKalStats::Snapshot gBaseline;
+
+   // Allocations made here while gInternal is set are not counted
+
+   thread_local Block               *gBlockPtr = 0;
+   thread_local TKalStats::EAllocTag gAllocTag = TKalStats::kAllocOther;
+   thread_local Bool_t               gInternal = kFALSE;
+
+   vector<Block *> *NewBlocks()
+   {
+      Bool_t saved = gInternal;
+      gInternal = kTRUE;
+      vector<Block *> *bp = new vector<Block *>;
+      bp->reserve(64);
+      gInternal = saved;
+      return bp;
+   }
+
+   vector<Block *> &Blocks()
+   {
+      static vector<Block *> *blocksPtr = NewBlocks();
+      return *blocksPtr;
+   }
+
+   Block &GetBlock()
+   {
+      if (!gBlockPtr) {
+         Bool_t saved = gInternal;
+         gInternal = kTRUE;
+         Block *bp = new Block;
+         {
+            lock_guard<mutex> lock(gMutex);
+            Blocks().push_back(bp);
+         }
+         gBlockPtr = bp;
+         gInternal = saved;
+      }
+      return *gBlockPtr;
+   }
+
+   void SumBlocks(TKalStats::Snapshot &s)
+   {
+      memset(&s, 0, sizeof(TKalStats::Snapshot));
+      vector<Block *> &blocks = Blocks();
+      for (UInt_t b=0; b<blocks.size(); b++) {
+         Block &blk = *blocks[b];
+         for (Int_t i=0; i<TKalStats::kNcounters; i++) {
+            s.fCount[i] += blk.fCount[i].load(memory_order_relaxed);
+         }
+         for (Int_t i=0; i<TKalStats::kNtimers; i++) {
+            s.fCalls [i] += blk.fCalls [i].load(memory_order_relaxed);
+            s.fCycles[i] += blk.fCycles[i].load(memory_order_relaxed);
+         }
+         for (Int_t i=0; i<TKalStats::kNallocTags; i++) {
+            s.fAllocs[i] += blk.fAllocs[i].load(memory_order_relaxed);
+            s.fBytes [i] += blk.fBytes [i].load(memory_order_relaxed);
+         }
+      }
+   }
+
+   const Char_t *kCounterNames[TKalStats::kNcounters] = {
+      "layers_visited", "layers_skipped", "xing_iterations", "xing_maxcount",
+      "xing_off_surface", "rk_steps", "field_evals", "inversions", "xing_banked",
+      "bv_check_other", "bv_check_cylinder", "bv_check_plane", "bv_check_cutcone",
+      "bv_reject_other", "bv_reject_cylinder", "bv_reject_plane", "bv_reject_cutcone",
+      "xing_warm_starts", "xing_warm_iterations", "xing_no_root",
+      "looper_turns", "looper_retargets" };
+
+   const Char_t *kTimerNames[TKalStats::kNtimers] = {
+      "filter", "smooth", "inv_filter", "transport", "transport2", "xing" };
+
+   const Char_t *kAllocTagNames[TKalStats::kNallocTags] = {
+      "other", "propagate", "filter", "smooth", "xing", "rk_jacobian" };
+}
+
+#ifdef __KALSTATS_ALLOC__
+//_________________________________________________________________________
+//  ---------------------------------
+//  Counting global operator new
+//  ---------------------------------
+//
+namespace {
+   void *CountedAlloc(size_t n)
+   {
+      void *p = malloc(n ? n : 1);
+      if (!p) throw bad_alloc();
+      TKalStats::AddAlloc(n);
+      return p;
+   }
+}
+
+void *operator new  (size_t n)                         { return CountedAlloc(n); }
+void *operator new[](size_t n)                         { return CountedAlloc(n); }
+void *operator new  (size_t n, const nothrow_t &) noexcept
+{
+   try { return CountedAlloc(n); } catch (...) { return 0; }
+}
+void *operator new[](size_t n, const nothrow_t &) noexcept
+{
+   try { return CountedAlloc(n); } catch (...) { return 0; }
+}
+void  operator delete  (void *p) noexcept              { free(p); }
+void  operator delete[](void *p) noexcept              { free(p); }
+void  operator delete  (void *p, size_t) noexcept      { free(p); }
+void  operator delete[](void *p, size_t) noexcept      { free(p); }
+#endif
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for fit statistics
+//  ---------------------------------
+//
+ClassImp(TKalStats)
+
+Bool_t TKalStats::IsEnabled()
+{
+#ifdef __KALSTATS__
+   return kTRUE;
+#else
+   return kFALSE;
+#endif
+}
+
+void TKalStats::Add(ECounter c, ULong64_t n)
+{
+   Inc(GetBlock().fCount[c], n);
+}
+
+void TKalStats::AddTime(ETimer t, ULong64_t cycles)
+{
+   Block &blk = GetBlock();
+   Inc(blk.fCalls [t], 1);
+   Inc(blk.fCycles[t], cycles);
+}
+
+//-------------------------------------------------------
+// Allocation accounting
+//-------------------------------------------------------
+
+Bool_t TKalStats::IsAllocEnabled()
+{
+#ifdef __KALSTATS_ALLOC__
+   return kTRUE;
+#else
+   return kFALSE;
+#endif
+}
+
+void TKalStats::AddAlloc(ULong64_t n)
+{
+   if (gInternal) return;   // the block of this thread itself
+   Block &blk = GetBlock();
+   Inc(blk.fAllocs[gAllocTag], 1);
+   Inc(blk.fBytes [gAllocTag], n);
+}
+
+TKalStats::EAllocTag TKalStats::SetAllocTag(EAllocTag t)
+{
+   EAllocTag saved = gAllocTag;
+   gAllocTag = t;
+   return saved;
+}
+
+//-------------------------------------------------------
+// Snapshot and Reset
+//-------------------------------------------------------
+
+void TKalStats::GetSnapshot(Snapshot &s)
+{
+   lock_guard<mutex> lock(gMutex);
+   SumBlocks(s);
+   for (Int_t i=0; i<kNcounters; i++) s.fCount[i] -= gBaseline.fCount[i];
+   for (Int_t i=0; i<kNtimers; i++) {
+      s.fCalls [i] -= gBaseline.fCalls [i];
+      s.fCycles[i] -= gBaseline.fCycles[i];
+   }
+   for (Int_t i=0; i<kNallocTags; i++) {
+      s.fAllocs[i] -= gBaseline.fAllocs[i];
+      s.fBytes [i] -= gBaseline.fBytes [i];
+   }
+}
+
+void TKalStats::Reset()
+{
+   lock_guard<mutex> lock(gMutex);
+   SumBlocks(gBaseline);
+}
+
+//-------------------------------------------------------
+// JSON output
+//-------------------------------------------------------
+
+void TKalStats::WriteJSON(ostream &out)
+{
+   Snapshot s;
+   GetSnapshot(s);
+   WriteJSON(out, s);
+}
+
+void TKalStats::WriteJSON(ostream &out, const Snapshot &s)
+{
+#if defined(__x86_64__) || defined(__i386__)
+   const Char_t *clock = "tsc";
+#else
+   const Char_t *clock = "ns";
+#endif
+   out << "{\"enabled\":" << (IsEnabled() ? "true" : "false")
+       << ",\"clock\":\"" << clock << "\",\"counters\":{";
+   for (Int_t i=0; i<kNcounters; i++) {
+      out << (i ? "," : "") << "\"" << kCounterNames[i] << "\":" << s.fCount[i];
+   }
+   out << "},\"timers\":{";
+   for (Int_t i=0; i<kNtimers; i++) {
+      out << (i ? "," : "") << "\"" << kTimerNames[i] << "\":{\"calls\":"
+          << s.fCalls[i] << ",\"cycles\":" << s.fCycles[i] << "}";
+   }
+   out << "},\"alloc_enabled\":" << (IsAllocEnabled() ? "true" : "false")
+       << ",\"allocs\":{";
+   for (Int_t i=0; i<kNallocTags; i++) {
+      out << (i ? "," : "") << "\"" << kAllocTagNames[i] << "\":{\"count\":"
+          << s.fAllocs[i] << ",\"bytes\":" << s.fBytes[i] << "}";
+   }
+   out << "}}" << endl;
+}
+
+//-------------------------------------------------------
+// Names and clock
+//-------------------------------------------------------
+
+const Char_t *TKalStats::GetCounterName(ECounter c)
+{
+   return kCounterNames[c];
+}
+
+const Char_t *TKalStats::GetTimerName(ETimer t)
+{
+   return kTimerNames[t];
+}
+
+const Char_t *TKalStats::GetAllocTagName(EAllocTag t)
+{
+   return kAllocTagNames[t];
+}
+
+ULong64_t TKalStats::GetCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+   return __rdtsc();
+#else
+   return chrono::duration_cast<chrono::nanoseconds>(
+             chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
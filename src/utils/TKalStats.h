@@ -0,0 +1,180 @@
+#ifndef TKALSTATS_H
+#define TKALSTATS_H
+//*************************************************************************
+//* =================
+//*  TKalStats Class
+//* =================
+//*
+//* (Description)
+//*   Counters and cycle timers for the hot paths of the fit:
+//*   TVKalSite::Filter, Smooth and InvFilter, TKalDetCradle::Transport
+//*   and Transport2, TVSurface::CalcXingPointWith, TRungeKuttaTrack
+//*   steps and field evaluations, and matrix inversions.
+//*
+//*   The instrumentation is compiled in only with -D__KALSTATS__
+//*   (cmake -DBUILD_WITH_STATS=ON); otherwise the KALSTATS_ macros
+//*   expand to nothing and GetSnapshot() returns zeros.
+//*
+//*   Each thread counts into its own block, so counting takes no lock.
+//*   GetSnapshot() sums the blocks of all threads, including those that
+//*   have finished, since the last Reset(). Timers are inclusive: the
+//*   time of CalcXingPointWith is also part of that of Transport.
+//*   Times are in cycles of GetCycles(), the time stamp counter on x86
+//*   and nanoseconds elsewhere.
+//*
+//*   With -D__KALSTATS_ALLOC__ (cmake -DBUILD_WITH_ALLOC_STATS=ON) the
+//*   library also replaces the global operator new and counts every
+//*   allocation and its bytes under the tag of the innermost
+//*   KALSTATS_ALLOC_TAG scope of the allocating thread: propagate,
+//*   filter, smooth, crossing search or RK Jacobian, "other" outside
+//*   them. A program with its own operator new must then leave it out.
+//* (Requires)
+//*     TObject
+//* (Provides)
+//*     class TKalStats
+//* (Update Recored)
+//*   2026/10/18  Original version.
+//*   2026/10/18  Added allocation accounting.
+//*   2026/10/18  Added kXingBanked.
+//*   2026/10/18  Added the bounding-volume counters.
+//*   2026/10/18  Added the warm-start counters.
+//*   2026/10/18  Added the looper counters.
+//*
+//*************************************************************************
+
+#include "TObject.h"        // from ROOT
+#include <iostream>         // from STL
+
+//_________________________________________________________________________
+//  ---------------------------------
+//  Class for fit statistics
+//  ---------------------------------
+//
+class TKalStats : public TObject {
+public:
+   enum ECounter { kLayersVisited = 0,   // layers crossed in Transport/2
+                   kLayersSkipped,       // crossings beyond kMergin
+                   kXingIterations,      // Newton steps in CalcXingPointWith
+                   kXingMaxCount,        // loop limit reached
+                   kXingOffSurface,      // crossings refused by IsOnSurface
+                   kRKSteps,             // Runge-Kutta steps
+                   kFieldEvals,          // field evaluations in the RK track
+                   kInversions,          // TKalMatrix inversions
+                   kXingBanked,          // crossings taken from a TCylinderBank
+                   kBVCheckOther,        // bounding-volume checks in Transport
+                   kBVCheckCylinder,     //   by TVSurface::EShape
+                   kBVCheckPlane,        //
+                   kBVCheckCutCone,      //
+                   kBVRejectOther,       // crossing searches they saved
+                   kBVRejectCylinder,    //   by TVSurface::EShape
+                   kBVRejectPlane,       //
+                   kBVRejectCutCone,     //
+                   kXingWarmStarts,      // searches from a predicted phi or step
+                   kXingWarmIterations,  // Newton steps of these searches
+                   kXingNoRoot,          // searches saved by a prediction of no crossing
+                   kLooperTurns,         // turning points passed in Transport
+                   kLooperRetargets,     // destinations moved to the crossing at the hit
+                   kNcounters };
+
+   enum ETimer   { kFilter = 0,          // TVKalSite::Filter
+                   kSmooth,              // TVKalSite::Smooth
+                   kInvFilter,           // TVKalSite::InvFilter
+                   kTransport,           // TKalDetCradle::Transport
+                   kTransport2,          // TKalDetCradle::Transport2
+                   kXing,                // TVSurface::CalcXingPointWith
+                   kNtimers };
+
+   enum EAllocTag { kAllocOther = 0,     // outside the tagged stages
+                    kAllocPropagate,     // TVKalState::Propagate
+                    kAllocFilter,        // TVKalSite::Filter
+                    kAllocSmooth,        // TVKalSite::Smooth
+                    kAllocXing,          // TVSurface::CalcXingPointWith
+                    kAllocRKJacobian,    // TRungeKuttaTrack::MoveTo
+                    kNallocTags };
+
+   struct Snapshot {
+      ULong64_t fCount [kNcounters];     // counters
+      ULong64_t fCalls [kNtimers];       // calls of the timed methods
+      ULong64_t fCycles[kNtimers];       // cycles spent in them
+      ULong64_t fAllocs[kNallocTags];    // allocations per tag
+      ULong64_t fBytes [kNallocTags];    // bytes allocated per tag
+   };
+
+   // Scoped timer: adds the cycles of its lifetime to timer t
+
+   class Timer {
+   public:
+      Timer(ETimer t) : fTimer(t), fStart(GetCycles()) {}
+      ~Timer() { AddTime(fTimer, GetCycles() - fStart); }
+   private:
+      ETimer    fTimer;
+      ULong64_t fStart;
+   };
+
+   // Scoped allocation tag: allocations of this thread during its
+   // lifetime go to tag t, unless an inner scope sets another one
+
+   class AllocTag {
+   public:
+      AllocTag(EAllocTag t) : fSaved(SetAllocTag(t)) {}
+      ~AllocTag() { SetAllocTag(fSaved); }
+   private:
+      EAllocTag fSaved;
+   };
+
+   TKalStats() {}
+   virtual ~TKalStats() {}
+
+   // kTRUE if built with -D__KALSTATS__
+
+   static Bool_t        IsEnabled  ();
+
+   static void          Add        (ECounter c, ULong64_t n = 1);
+   static void          AddTime    (ETimer   t, ULong64_t cycles);
+
+   // kTRUE if built with -D__KALSTATS_ALLOC__
+
+   static Bool_t        IsAllocEnabled();
+
+   // Counts an allocation of n bytes under the current tag of this
+   // thread; SetAllocTag() returns the previous tag
+
+   static void          AddAlloc   (ULong64_t n);
+   static EAllocTag     SetAllocTag(EAllocTag t);
+
+   // Sum over all threads since the last Reset()
+
+   static void          GetSnapshot(Snapshot &s);
+   static void          Reset      ();
+
+   // {"enabled":..,"clock":..,"counters":{..},"timers":{name:{"calls":..,"cycles":..}},
+   //  "alloc_enabled":..,"allocs":{tag:{"count":..,"bytes":..}}}
+
+   static void          WriteJSON  (std::ostream &out);
+   static void          WriteJSON  (std::ostream &out, const Snapshot &s);
+
+   static const Char_t *GetCounterName(ECounter c);
+   static const Char_t *GetTimerName  (ETimer   t);
+   static const Char_t *GetAllocTagName(EAllocTag t);
+   static ULong64_t     GetCycles  ();
+
+   ClassDef(TKalStats,1)  // fit statistics
+};
+
+#ifdef __KALSTATS__
+#define KALSTATS_ADD(c,n)  TKalStats::Add(TKalStats::c, n)
+#define KALSTATS_COUNT(c)  TKalStats::Add(TKalStats::c)
+#define KALSTATS_TIMER(t)  TKalStats::Timer kalStatsTimer(TKalStats::t)
+#else
+#define KALSTATS_ADD(c,n)
+#define KALSTATS_COUNT(c)
+#define KALSTATS_TIMER(t)
+#endif
+
+#ifdef __KALSTATS_ALLOC__
+#define KALSTATS_ALLOC_TAG(t)  TKalStats::AllocTag kalStatsAllocTag(TKalStats::t)
+#else
+#define KALSTATS_ALLOC_TAG(t)
+#endif
+
+#endif